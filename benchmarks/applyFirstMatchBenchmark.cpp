@@ -105,6 +105,27 @@ constexpr auto a18 = prs::details::makeFirstMatch(0,
             std::make_tuple(13, 13), std::make_tuple(14, 14), std::make_tuple(15, 15),
         std::make_tuple(16, 16), std::make_tuple(17, 17), std::make_tuple(18, 18));
 
+template <size_t ...Is>
+constexpr auto makeSequenceMatch(std::index_sequence<Is...>) noexcept {
+    return prs::details::makeFirstMatch(0, std::make_tuple(static_cast<int>(Is + 1), static_cast<int>(Is + 1))...);
+}
+
+/**
+ * Custom equality forces the linear scan
+ */
+template <size_t ...Is>
+constexpr auto makeSequenceMatchLinear(std::index_sequence<Is...>) noexcept {
+    constexpr auto eq = [](int key, unsigned value) noexcept {
+        return static_cast<unsigned>(key) == value;
+    };
+    return prs::details::makeFirstMatchEq(0, eq, std::make_tuple(static_cast<int>(Is + 1), static_cast<int>(Is + 1))...);
+}
+
+constexpr auto a32 = makeSequenceMatch(std::make_index_sequence<32>{});
+constexpr auto a32Linear = makeSequenceMatchLinear(std::make_index_sequence<32>{});
+constexpr auto a128 = makeSequenceMatch(std::make_index_sequence<128>{});
+constexpr auto a128Linear = makeSequenceMatchLinear(std::make_index_sequence<128>{});
+
 using Map = std::map<unsigned, unsigned>;
 using UnorderedMap = std::unordered_map<unsigned, unsigned>;
 
@@ -123,6 +144,14 @@ BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap9ItemsMiss, UnorderedMap{}, 9, 20);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value18Items, a18, 19);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, Map18Items, Map{}, 18, 19);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap18Items, UnorderedMap{}, 18, 19);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value32Items, a32, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Linear32Items, a32Linear, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, Map32Items, Map{}, 32, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap32Items, UnorderedMap{}, 32, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value128Items, a128, 160);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Linear128Items, a128Linear, 160);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, Map128Items, Map{}, 128, 160);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap128Items, UnorderedMap{}, 128, 160);
 
 #else
 
@@ -130,5 +159,10 @@ BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value9ItemsMiss, a9, 20);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchSwitch9, If9ItemsMiss, 20);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, Map9ItemsMiss, Map{}, 9, 20);
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap9ItemsMiss, UnorderedMap{}, 9, 20);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value32Items, a32, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Linear32Items, a32Linear, 40);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Value128Items, a128, 160);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatch, Linear128Items, a128Linear, 160);
+BENCHMARK_CAPTURE(BM_ApplyFirstMatchMap, UMap128Items, UnorderedMap{}, 128, 160);
 
 #endif
@@ -2,6 +2,7 @@
 
 #include <parsecpp/full.hpp>
 #include <iostream>
+#include <utility>
 
 #include "benchmarkHelper.hpp"
 
@@ -352,6 +353,35 @@ static inline const std::unordered_map<std::string_view, int> umap23 = {
 };
 
 
+template <typename Parser, typename Tests>
+void BM_KeywordStrings(benchmark::State& state, Parser const& parser, Tests const& tests, size_t sampleCount) {
+    for (auto _ : state) {
+        for (auto const& t : tests) {
+            prs::Stream stream{t};
+            benchmark::DoNotOptimize(parser(stream));
+        }
+    }
+    state.SetItemsProcessed(tests.size() * state.iterations());
+}
+
+template <prs::ConstexprString ...words, size_t ...indexes>
+auto literalChain(std::index_sequence<indexes...>) noexcept {
+    return ((prs::literal<words>() >> prs::pure(indexes)) | ...);
+}
+
+template <prs::ConstexprString ...words>
+auto literalChain() noexcept {
+    return literalChain<words...>(std::index_sequence_for<decltype(words)...>{});
+}
+
+using prs::operator""_prs;
+
+#define WORDS4 "positions"_prs, "balance_and_position"_prs, "liquidation-warning"_prs, "account-greeks"_prs
+#define WORDS7 WORDS4, "orders"_prs, "orders-algo"_prs, "algo-advance"_prs
+#define WORDS12 WORDS7, "filler1"_prs, "filler2"_prs, "filler3"_prs, "filler4"_prs, "filler5"_prs
+#define WORDS18 WORDS12, "filler6"_prs, "filler7"_prs, "filler8"_prs, "filler9"_prs, "filler10"_prs, "filler11"_prs
+#define WORDS23 WORDS18, "filler12"_prs, "filler13"_prs, "filler14"_prs, "filler15"_prs, "filler16"_prs
+
 #define GEN_TEST_FOR(n) \
 static inline auto challengeW ## n = generateChallengeSamplesWithWeights(n); \
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchStrings, Apply ## n ## Weights, apply ## n, challengeW ## n, n);\
@@ -362,6 +392,8 @@ static inline auto challengeR ## n = generateChallengeSamplesWithoutWeights(n);\
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchStrings, Apply ## n ## Random, apply ## n, challengeR ## n, n);\
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMapStrings, ApplyMap ## n ## Random, map ## n, challengeR ## n, n);\
 BENCHMARK_CAPTURE(BM_ApplyFirstMatchMapStrings, ApplyUMap ## n ## Random, umap ## n, challengeR ## n, n);\
+BENCHMARK_CAPTURE(BM_KeywordStrings, Keyword ## n ## Random, prs::keyword<WORDS ## n>(), challengeR ## n, n);\
+BENCHMARK_CAPTURE(BM_KeywordStrings, LiteralChain ## n ## Random, literalChain<WORDS ## n>(), challengeR ## n, n);\
 
 #ifdef ENABLE_HARD_BENCHMARK
 GEN_TEST_FOR(4)
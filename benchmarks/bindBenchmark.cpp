@@ -88,9 +88,38 @@ void BM_TagParser(benchmark::State& state, P parser, std::string const& filename
     state.SetBytesProcessed(test.size() * state.iterations());
 }
 
+/**
+ * One parser instance is shared by all threads
+ */
+template <template<typename,typename> typename Storage>
+void BM_TagParserShared(benchmark::State& state) {
+    static auto const parser = bindCacheTag<Storage>();
+    static std::string const test = readFile("./tags.txt");
+    for (auto _ : state) {
+        Stream s{test};
+        auto result = parser(s);
+        if (result.isError()) {
+            state.SkipWithError("Cannot parse");
+        } else if (result.data().size() != 30) {
+            state.SkipWithError("Wrong answer");
+        }
+    }
+
+    state.SetBytesProcessed(test.size() * state.iterations());
+}
+
+template <typename K, typename V>
+using PerThreadClockStorage = details::PerThreadStorage<K, V, details::ClockStorage>;
+
 BENCHMARK_CAPTURE(BM_TagParser, Bind, bindTag(), "./tags.txt");
 BENCHMARK_CAPTURE(BM_TagParser, BindMapCache, bindCacheTag<details::MapStorage>(), "./tags.txt");
 BENCHMARK_CAPTURE(BM_TagParser, BindHashMapCache, bindCacheTag<details::HashMapStorage>(), "./tags.txt");
 BENCHMARK_CAPTURE(BM_TagParser, BindVectorCache, bindCacheTag<details::VectorStorage>(), "./tags.txt");
+BENCHMARK_CAPTURE(BM_TagParser, BindShardedCache, bindCacheTag<details::ShardedStorage>(), "./tags.txt");
+BENCHMARK_CAPTURE(BM_TagParser, BindClockCache, bindCacheTag<details::ClockStorage>(), "./tags.txt");
 BENCHMARK_CAPTURE(BM_TagParser, Cmp, cmpTag(), "./tags.txt");
 BENCHMARK_CAPTURE(BM_TagParser, CmpV2, cmpTagV2(), "./tags.txt");
+
+BENCHMARK_TEMPLATE(BM_TagParserShared, details::ShardedStorage)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TagParserShared, details::PerThreadStorage)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_TagParserShared, PerThreadClockStorage)->ThreadRange(1, 8)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <benchmark/benchmark.h>
+
+#include <parsecpp/full.hpp>
+
+#include "benchmarkHelper.hpp"
+
+#include <charconv>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace prs;
+
+namespace {
+
+/**
+ * JSON recognizer without captures
+ */
+std::shared_ptr<vm::Program const> jsonProgram() {
+    using namespace vm;
+    Grammar g;
+    auto value = g.rule();
+
+    auto ws = many(chars(CharSet::anyOf(' ', '\t', '\n', '\r')));
+    auto plain = chars(CharSet::anyOf('"', '\\').inverse());
+    auto string = ch('"') >> many(plain) >> many(ch('\\') >> any() >> many(plain)) >> ch('"');
+    auto digits = many1(range('0', '9'));
+    auto number = opt(ch('-')) >> digits >> opt(ch('.') >> digits)
+            >> opt(chars(CharSet::anyOf('e', 'E')) >> opt(chars(CharSet::anyOf('+', '-'))) >> digits);
+    auto member = string >> ws >> ch(':') >> ws >> value;
+    auto object = ch('{') >> ws >> opt(member >> many(ch(',') >> ws >> member)) >> ch('}');
+    auto array = ch('[') >> ws >> opt(value >> many(ch(',') >> ws >> value)) >> ch(']');
+
+    g.define(value, (object | array | string | number | lit("true") | lit("false") | lit("null")) >> ws);
+    return std::make_shared<Program const>(g.compile(ws >> value));
+}
+
+auto jsonVm() {
+    return vm::toParser(jsonProgram());
+}
+
+
+/**
+ * The same grammar by combinators, nothing is built
+ */
+Parser<Drop> jsonValue() noexcept {
+    auto ws = skipChars(' ', '\t', '\n', '\r');
+    auto digits = charFrom('0', '1', '2', '3', '4', '5', '6', '7', '8', '9')
+            >> skipChars('0', '1', '2', '3', '4', '5', '6', '7', '8', '9');
+    auto number = (charFrom('-').drop().maybe() >> digits >> (charFrom('.') >> digits).maybe()
+            >> (charFrom('e', 'E') >> charFrom('+', '-').drop().maybe() >> digits).maybe()).drop();
+    auto string = (charFrom('"') >> escapedStringView<'"'>()).drop();
+    auto value = lazyCached(jsonValue, AutoTagV);
+    auto member = string >> ws >> charFrom(':') >> ws >> value;
+    auto object = (charFrom('{') >> ws >> member.repeat(charFrom(',') >> ws) >> charFrom('}')).drop();
+    auto array = (charFrom('[') >> ws >> value.repeat(charFrom(',') >> ws) >> charFrom(']')).drop();
+
+    return (choice(object, array, string, number, literal<"true"_prs>().drop(), literal<"false"_prs>().drop(), literal<"null"_prs>().drop())
+            >> ws).toCommonType();
+}
+
+auto jsonCombinator() {
+    return skipChars(' ', '\t', '\n', '\r') >> jsonValue();
+}
+
+
+using Stack = std::vector<double>;
+
+std::shared_ptr<vm::Program const> calcProgram() {
+    using namespace vm;
+    Grammar g;
+    auto expr = g.rule();
+    auto term = g.rule();
+    auto factor = g.rule();
+
+    auto ws = many(ch(' '));
+    auto digits = many1(range('0', '9'));
+    auto number = capture(digits >> opt(ch('.') >> digits), 0) >> ws;
+
+    g.define(factor, number | (ch('(') >> ws >> expr >> ch(')') >> ws));
+    g.define(term, factor >> many(capture(chars(CharSet::anyOf('*', '/')) >> ws >> factor, 1)));
+    g.define(expr, ws >> term >> many(capture(chars(CharSet::anyOf('+', '-')) >> ws >> term, 1)));
+    return std::make_shared<Program const>(g.compile(expr));
+}
+
+double applyOp(char op, double lhs, double rhs) noexcept {
+    switch (op) {
+        case '+': return lhs + rhs;
+        case '-': return lhs - rhs;
+        case '*': return lhs * rhs;
+        default: return lhs / rhs;
+    }
+}
+
+auto calcVm() {
+    std::vector<vm::Action<Stack>> actions{
+        [](std::string_view text, Stack& stack) {
+            double value = 0;
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            stack.push_back(value);
+        },
+        [](std::string_view text, Stack& stack) {
+            double const rhs = stack.back();
+            stack.pop_back();
+            stack.back() = applyOp(text.front(), stack.back(), rhs);
+        }
+    };
+    return vm::toParser(calcProgram(), std::move(actions), [](Stack const& stack) {
+        return stack.back();
+    });
+}
+
+
+using Ops = std::vector<std::pair<char, double>>;
+
+std::pair<char, double> makeOp(char op, double rhs) noexcept {
+    return {op, rhs};
+}
+
+double fold(double lhs, Ops const& ops) noexcept {
+    for (auto const& [op, rhs] : ops) {
+        lhs = applyOp(op, lhs, rhs);
+    }
+    return lhs;
+}
+
+Parser<double> calcExpr() noexcept;
+
+Parser<double> calcFactor() noexcept {
+    return ((number<double>() << spaces())
+            | (charFromSpaces('(') >> lazyCached(calcExpr, AutoTagV) << charFromSpaces(')'))).toCommonType();
+}
+
+Parser<double> calcTerm() noexcept {
+    auto op = liftM(makeOp, charFromSpaces('*', '/'), calcFactor());
+    return liftM(fold, calcFactor(), op.repeat()).toCommonType();
+}
+
+Parser<double> calcExpr() noexcept {
+    auto op = liftM(makeOp, charFromSpaces('+', '-'), calcTerm());
+    return (spaces() >> liftM(fold, calcTerm(), op.repeat())).toCommonType();
+}
+
+std::string calcText(size_t n) {
+    std::string out;
+    for (size_t i = 0; i != n; ++i) {
+        out += "(12.5 + 3) * 4 - 7 / (2 + 1.25) + ";
+    }
+    return out + "1";
+}
+
+}
+
+
+template <typename Fn>
+static void BM_BytecodeJson(benchmark::State& state, std::string filename, Fn makeParser) {
+    auto parser = makeParser();
+    std::string json = readFile(filename);
+    for (auto _ : state) {
+        Stream s(json);
+        auto data = parser(s);
+        if (data.isError()) {
+            state.SkipWithError("Cannot parse json");
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(json.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_BytecodeJson, 100k, "100k.json", jsonVm)->Name("BM_BytecodeJson_100k/Vm");
+BENCHMARK_CAPTURE(BM_BytecodeJson, 100k, "100k.json", jsonCombinator)->Name("BM_BytecodeJson_100k/Combinator");
+BENCHMARK_CAPTURE(BM_BytecodeJson, canada, "canada.json", jsonVm)->Name("BM_BytecodeJson_canada/Vm");
+BENCHMARK_CAPTURE(BM_BytecodeJson, canada, "canada.json", jsonCombinator)->Name("BM_BytecodeJson_canada/Combinator");
+BENCHMARK_CAPTURE(BM_BytecodeJson, binance, "binance.json", jsonVm)->Name("BM_BytecodeJson_binance/Vm");
+BENCHMARK_CAPTURE(BM_BytecodeJson, binance, "binance.json", jsonCombinator)->Name("BM_BytecodeJson_binance/Combinator");
+
+
+template <typename Fn>
+static void BM_BytecodeCalc(benchmark::State& state, Fn makeParser) {
+    auto parser = makeParser();
+    std::string text = calcText(state.range(0));
+    for (auto _ : state) {
+        Stream s(text);
+        auto data = parser(s);
+        if (data.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse expression");
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(text.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_BytecodeCalc, Vm, calcVm)->Arg(1)->Arg(100);
+BENCHMARK_CAPTURE(BM_BytecodeCalc, Combinator, calcExpr)->Arg(1)->Arg(100);
\ No newline at end of file
@@ -194,6 +194,21 @@ static void BM_toArray(benchmark::State& state, Parser const& parser) {
     state.SetBytesProcessed(CHALLENGE.size() * state.iterations());
 }
 
+template <ParserType Parser>
+static void BM_toArrayInto(benchmark::State& state, Parser const& parser) {
+    GetParserResult<Parser> out;
+    for (auto _ : state) {
+        Stream s{CHALLENGE};
+
+        if (parser.parseInto(s, out).isError()) {
+            throw std::runtime_error("Cannot parse");
+        } else if (out.size() != 100) {
+            throw std::runtime_error("size");
+        }
+    }
+    state.SetBytesProcessed(CHALLENGE.size() * state.iterations());
+}
+
 static inline auto insideParser = charFrom('{') >> letters<false, std::string_view>() << charFrom('}');
 
 BENCHMARK_CAPTURE(BM_toArray, Loop, constructParserInLoopRepeat(insideParser));
@@ -207,3 +222,7 @@ BENCHMARK_CAPTURE(BM_toArray, ReserveDoWhile, doWhile<100>(insideParser));
 BENCHMARK_CAPTURE(BM_toArray, ReserveDoWhileNoCtx, doWhileNoCtx<100>(insideParser));
 BENCHMARK_CAPTURE(BM_toArray, ReserveYcomb, Ycomb<100>(insideParser));
 BENCHMARK_CAPTURE(BM_toArray, ReserveClass, doWhileClass<100>(insideParser));
+BENCHMARK_CAPTURE(BM_toArray, ReserveRepeat, insideParser.repeat<100>());
+BENCHMARK_CAPTURE(BM_toArray, ReserveAdaptive, insideParser.repeatAdaptive());
+BENCHMARK_CAPTURE(BM_toArray, Repeat, insideParser.repeat());
+BENCHMARK_CAPTURE(BM_toArrayInto, RepeatInto, insideParser.repeat());
@@ -25,4 +25,23 @@ static void BM_ErrorHandling(benchmark::State& state) {
     state.SetBytesProcessed(ERROR_A_LOT_OF_TIMES.size() * state.iterations());
 }
 
-BENCHMARK(BM_ErrorHandling);
\ No newline at end of file
+BENCHMARK(BM_ErrorHandling);
+
+static constexpr std::string_view OR_ERROR_A_LOT_OF_TIMES = "key1=1;key2=abc;key3=!;key4=def;key5=!;";
+
+static void BM_ErrorHandlingOr(benchmark::State& state) {
+    auto value = number<int>().fmap([](int) { return 0; })
+               | letters<false>().fmap([](auto) { return 1; })
+               | charFrom<'!'>().fmap([](char) { return 2; });
+    auto parser = ((letters<true>() >> charFrom<'='>()) >> value << charFrom<';'>()).repeat();
+
+    for (auto _ : state) {
+        Stream s(OR_ERROR_A_LOT_OF_TIMES);
+        auto data = parser(s);
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(OR_ERROR_A_LOT_OF_TIMES.size() * state.iterations());
+}
+
+BENCHMARK(BM_ErrorHandlingOr);
\ No newline at end of file
@@ -28,12 +28,58 @@ static void BM_jsonFile(benchmark::State& state, std::string filename, Fn parseA
     state.SetBytesProcessed(json.size() * state.iterations());
 }
 
+template <typename Fn>
+static void BM_jsonFileMmap(benchmark::State& state, std::string filename, Fn parseAny) {
+    auto parser = parseAny();
+    MappedFile json{filename};
+    for (auto _ : state) {
+        Stream s = json.stream();
+        auto data = parser(s);
+        if (data.isError()) {
+            state.SkipWithError("Cannot parse json");
+        }
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    state.SetBytesProcessed(json.size() * state.iterations());
+}
+
+template <typename Fn>
+static void BM_jsonFileArena(benchmark::State& state, std::string filename, Fn parseAny) {
+    auto parser = parseAny();
+    std::string json = readFile(filename);
+    ParseArena arena;
+    size_t heapAllocations = 0;
+    for (auto _ : state) {
+        {
+            Stream s(json);
+            ArenaCtx ctx{arena};
+            auto data = parser(s, ctx);
+            if (data.isError()) {
+                state.SkipWithError("Cannot parse json");
+            }
+            benchmark::DoNotOptimize(data.data());
+        }
+        heapAllocations += arena.heapAllocations();
+        arena.reset();
+    }
+
+    state.counters["heapAllocations"] = benchmark::Counter(static_cast<double>(heapAllocations), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(json.size() * state.iterations());
+}
+
 #define BENCH_JSON(ns) \
 \
 BENCHMARK_CAPTURE(BM_jsonFile, 100k,  "100k.json", impl##ns::parseAny)->Name("BM_jsonFile_100k/"#ns);\
 BENCHMARK_CAPTURE(BM_jsonFile, canada, "canada.json", impl##ns::parseAny)->Name("BM_jsonFile_canada/" #ns);\
 BENCHMARK_CAPTURE(BM_jsonFile, binance, "binance.json", impl##ns::parseAny)->Name("BM_jsonFile_binance/" #ns);
 
+#define BENCH_JSON_MMAP(ns) \
+\
+BENCHMARK_CAPTURE(BM_jsonFileMmap, 100k,  "100k.json", impl##ns::parseAny)->Name("BM_jsonFileMmap_100k/"#ns);\
+BENCHMARK_CAPTURE(BM_jsonFileMmap, canada, "canada.json", impl##ns::parseAny)->Name("BM_jsonFileMmap_canada/" #ns);\
+BENCHMARK_CAPTURE(BM_jsonFileMmap, binance, "binance.json", impl##ns::parseAny)->Name("BM_jsonFileMmap_binance/" #ns);
+
 #define BENCH_JSON_HARD(ns) \
 \
 BENCHMARK_CAPTURE(BM_jsonFile, 64kb, "64kb.json", impl##ns::parseAny)->Name("BM_jsonFile_64kb/" #ns);\
@@ -49,6 +95,24 @@ BENCHMARK_CAPTURE(BM_jsonFile, 5mb_min, "5mb-min.json", impl##ns::parseAny)->Nam
 BENCH_JSON(Lazy);
 BENCH_JSON(LazyCached);
 BENCH_JSON(SelfLazy);
+BENCH_JSON(Predictive);
+
+BENCH_JSON_MMAP(LazyCached);
+
+#define BENCH_JSON_MAP(container) \
+\
+BENCHMARK_CAPTURE(BM_jsonFile, 100k,  "100k.json", implMap::Impl<container##Container>::parseAny)->Name("BM_jsonFile_100k/"#container);\
+BENCHMARK_CAPTURE(BM_jsonFile, canada, "canada.json", implMap::Impl<container##Container>::parseAny)->Name("BM_jsonFile_canada/" #container);\
+BENCHMARK_CAPTURE(BM_jsonFile, binance, "binance.json", implMap::Impl<container##Container>::parseAny)->Name("BM_jsonFile_binance/" #container);
+
+BENCH_JSON_MAP(StdMap);
+BENCH_JSON_MAP(FlatMap);
+BENCH_JSON_MAP(HashMap);
+BENCH_JSON_MAP(PairVector);
+
+BENCHMARK_CAPTURE(BM_jsonFileArena, 100k,  "100k.json", implArena::parseAny)->Name("BM_jsonFile_100k/Arena");
+BENCHMARK_CAPTURE(BM_jsonFileArena, canada, "canada.json", implArena::parseAny)->Name("BM_jsonFile_canada/Arena");
+BENCHMARK_CAPTURE(BM_jsonFileArena, binance, "binance.json", implArena::parseAny)->Name("BM_jsonFile_binance/Arena");
 
 #ifdef ENABLE_HARD_BENCHMARK
 BENCH_JSON_HARD(Lazy);
@@ -57,3 +121,5 @@ BENCH_JSON_HARD(SelfLazy);
 #endif
 
 #undef BENCH_JSON
+#undef BENCH_JSON_MMAP
+#undef BENCH_JSON_MAP
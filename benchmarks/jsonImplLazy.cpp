@@ -179,6 +179,47 @@ inline PJ parseArray() noexcept {
 }
 
 
+namespace implPredictive {
+
+PJ parseObject() noexcept;
+PJ parseArray() noexcept;
+
+struct ObjectTag;
+struct ArrayTag;
+
+inline auto parseAny() noexcept {
+    return choice(lazyCached<ObjectTag>(parseObject).withFirstSet(charFromSpaces('{').firstSet())
+                  , lazyCached<ArrayTag>(parseArray).withFirstSet(charFromSpaces('[').firstSet())
+                  , parseString()
+                  , parseDouble()
+                  , parseUndefined()
+                  , parseBool());
+}
+
+
+inline PJ parseObject() noexcept {
+    auto parserPre = charFromSpaces('{');
+    auto parserKey = spaces() >> between('"') << charFromSpaces(':');
+    auto parserDelim = charFromSpaces(',');
+    auto parserPost = charFromSpaces('}');
+    return (parserPre >>
+                      (toMap(parserKey, parseAny(), parserDelim) >>= Make{})
+                      << parserPost).toCommonType();
+}
+
+
+inline PJ parseArray() noexcept {
+    auto parserPre = charFromSpaces('[');
+    auto parserDelim = charFromSpaces(',');
+    auto parserPost = charFromSpaces(']');
+    return (parserPre >>
+                      (parseAny().repeat<10>(parserDelim) >>= Make{})
+                      << parserPost).toCommonType();
+}
+
+}
+
+
 namespace implSelfLazy {
 
 
@@ -218,4 +259,112 @@ inline auto parseAny() noexcept {
     });
 }
 
-}
\ No newline at end of file
+}
+
+namespace implArena {
+
+struct ArenaJson {
+    using Array = ArenaVector<ArenaJson>;
+    using Object = ArenaMap<std::string_view, ArenaJson>;
+
+    std::variant<double, std::string_view, bool, Json::Null, Array, Object> value;
+};
+
+using PJ = Parser<ArenaJson, ArenaCtx>;
+using Make = details::MakeClass<ArenaJson>;
+
+PJ parseObject() noexcept;
+PJ parseArray() noexcept;
+
+struct ObjectTag;
+struct ArrayTag;
+
+inline auto parseAny() noexcept {
+    return lazyCached<ObjectTag>(parseObject)
+           | lazyCached<ArrayTag>(parseArray)
+           | (between('"') >>= Make{})
+           | (number() >>= Make{})
+           | ((spaces() >> literal("null") >> spaces() >> pure(Json::Null{})) >>= Make{})
+           | ((spaces() >> (literal("false") >> pure(false)) | (literal("true") >> pure(true))) >>= Make{});
+}
+
+
+inline PJ parseObject() noexcept {
+    auto parserPre = charFromSpaces('{');
+    auto parserKey = spaces() >> between('"') << charFromSpaces(':');
+    auto parserDelim = charFromSpaces(',');
+    auto parserPost = charFromSpaces('}');
+    return (parserPre >>
+                      (arenaToMap(parserKey, parseAny(), parserDelim) >>= Make{})
+                      << parserPost).toCommonType();
+}
+
+
+inline PJ parseArray() noexcept {
+    auto parserPre = charFromSpaces('[');
+    auto parserDelim = charFromSpaces(',');
+    auto parserPost = charFromSpaces(']');
+    return (parserPre >>
+                      (arenaRepeat(parseAny(), parserDelim) >>= Make{})
+                      << parserPost).toCommonType();
+}
+
+}
+
+
+namespace implMap {
+
+template <typename Container>
+class MapJson {
+public:
+    using ptr = std::shared_ptr<MapJson>;
+    using Object = typename Container::template Type<std::string_view, ptr>;
+
+    template <typename T>
+    explicit MapJson(T&& t) noexcept
+        : m_value(std::forward<T>(t)) {
+
+    }
+private:
+    std::variant<double, std::string_view, bool, Json::Null, std::vector<ptr>, Object> m_value;
+};
+
+template <typename Container>
+struct Impl {
+    using J = MapJson<Container>;
+    using PJ = Parser<typename J::ptr>;
+    using Make = details::MakeShared<J>;
+
+    struct ObjectTag;
+    struct ArrayTag;
+
+    static auto parseAny() noexcept {
+        return lazyCached<ObjectTag>(parseObject)
+               | lazyCached<ArrayTag>(parseArray)
+               | (between('"') >>= Make{})
+               | (number() >>= Make{})
+               | ((spaces() >> literal("null") >> spaces() >> pure(Json::Null{})) >>= Make{})
+               | ((spaces() >> (literal("false") >> pure(false)) | (literal("true") >> pure(true))) >>= Make{});
+    }
+
+    static PJ parseObject() noexcept {
+        auto parserPre = charFromSpaces('{');
+        auto parserKey = spaces() >> between('"') << charFromSpaces(':');
+        auto parserDelim = charFromSpaces(',');
+        auto parserPost = charFromSpaces('}');
+        return (parserPre >>
+                          (toMap<true, MAX_ITERATION, Container>(parserKey, parseAny(), parserDelim) >>= Make{})
+                          << parserPost).toCommonType();
+    }
+
+    static PJ parseArray() noexcept {
+        auto parserPre = charFromSpaces('[');
+        auto parserDelim = charFromSpaces(',');
+        auto parserPost = charFromSpaces(']');
+        return (parserPre >>
+                          (parseAny().template repeat<10>(parserDelim) >>= Make{})
+                          << parserPost).toCommonType();
+    }
+};
+
+}
@@ -80,6 +80,25 @@ auto bracesCtxConstexpr() noexcept {
         .cond(checkBraces).repeat<REPEAT_PRE_ALLOC>() >> success()).toCommonType();
 }
 
+static constexpr size_t ERASED_BRACES_SIZE = 128;
+using ErasedBraces = ErasedParser<Unit, VoidContext, ERASED_BRACES_SIZE>;
+struct ErasedTag {};
+
+ErasedBraces bracesLazyErased() noexcept {
+    return (concat(charFrom('(', '{', '['), lazy(bracesLazyErased) >> charFrom(')', '}', ']'))
+        .cond(checkBraces).repeat<REPEAT_PRE_ALLOC>() >> success()).toErased<ERASED_BRACES_SIZE>();
+}
+
+ErasedBraces bracesErased() noexcept {
+    return (concat(charFrom('(', '{', '['), lazyCached<ErasedTag>(bracesErased) >> charFrom(')', '}', ']'))
+        .cond(checkBraces).repeat<REPEAT_PRE_ALLOC>() >> success()).toErased<ERASED_BRACES_SIZE>();
+}
+
+auto bracesCtxErased() noexcept {
+    return (concat(charFrom('(', '{', '['), lazyCtxBinding<Unit>() >> charFrom(')', '}', ']'))
+        .cond(checkBraces).repeat<REPEAT_PRE_ALLOC>() >> success()).toErased<ERASED_BRACES_SIZE>();
+}
+
 static constexpr std::string_view braces = "{}(()()[{({}([{()()}[]]){{}[]()})()}[{}{{}[]()}([{()()}[]]){{}[{{}[]()}]()}]]){{}[{}([{()()}[]]){{}[]()}](){}([{()()}[{{}[]()}]]){{}[]()}}";
 static constexpr std::string_view bracesFailed = "{}(()()[{({}([{()()}[]]){{}[]()})()}[{}{{}[]()}([{()()}[]]){{}[{{}[]()}]()}]]){{}[{}([{()()}[]]){{}[]()}](){}([{()()}[{{}[]()}]])){{}[]()}}";
 
@@ -144,9 +163,48 @@ void BM_bracesFailureCtx(benchmark::State& state, P baseParser) {
     state.SetBytesProcessed(130 * state.iterations()); // First error in braces order
 }
 
+/**
+ * Erased parsers are move-only, build them inside
+ */
+template <typename Fn>
+void BM_bracesSuccessCtxErased(benchmark::State& state, Fn makeParser) {
+    auto const baseParser = makeParser();
+    auto lazyBindingStorage = makeBindingCtx(baseParser);
+    auto parser = baseParser.ref().endOfStream();
+    auto ctx = parser.makeCtx(lazyBindingStorage);
+    for (auto _ : state) {
+        Stream s{braces};
+        auto result = parser(s, ctx);
+        if (result.isError()) {
+            state.SkipWithError("Cannot parse braces");
+        }
+    }
+
+    state.SetBytesProcessed(braces.size() * state.iterations());
+}
+
+template <typename Fn>
+void BM_bracesFailureCtxErased(benchmark::State& state, Fn makeParser) {
+    auto const baseParser = makeParser();
+    auto lazyBindingStorage = makeBindingCtx(baseParser);
+    auto parser = baseParser.ref().endOfStream();
+    auto ctx = parser.makeCtx(lazyBindingStorage);
+    for (auto _ : state) {
+        Stream s{bracesFailed};
+        auto result = parser(s, ctx);
+        if (!result.isError()) {
+            state.SkipWithError("Error parse braces");
+        }
+    }
+
+    state.SetBytesProcessed(130 * state.iterations()); // First error in braces order
+}
+
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesLazy, bracesLazy().endOfStream());
+BENCHMARK_CAPTURE(BM_bracesSuccess, bracesLazyErased, lazy(bracesLazyErased).endOfStream());
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesSelfLazy, bracesSelfLazy().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesCached, bracesCache().endOfStream());
+BENCHMARK_CAPTURE(BM_bracesSuccess, bracesCachedErased, lazyCached<ErasedTag>(bracesErased).endOfStream());
 #ifdef ENABLE_HARD_BENCHMARK
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesCachedDrop, bracesCacheDrop().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesCacheDropConstexpr, bracesCacheDropConstexpr().endOfStream());
@@ -154,6 +212,7 @@ BENCHMARK_CAPTURE(BM_bracesSuccess, bracesCacheConstexpr, bracesCacheConstexpr()
 #endif
 BENCHMARK_CAPTURE(BM_bracesSuccess, bracesForget, bracesForget().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesSuccessCtx, bracesCtx, bracesCtx());
+BENCHMARK_CAPTURE(BM_bracesSuccessCtxErased, bracesCtxErased, bracesCtxErased);
 #ifdef ENABLE_HARD_BENCHMARK
 BENCHMARK_CAPTURE(BM_bracesSuccessCtx, bracesCtxDrop, bracesCtxDrop());
 BENCHMARK_CAPTURE(BM_bracesSuccessCtx, bracesCtxDropConstexpr, bracesCtxDropConstexpr());
@@ -161,8 +220,10 @@ BENCHMARK_CAPTURE(BM_bracesSuccessCtx, bracesCtxConstexpr, bracesCtxConstexpr())
 #endif
 
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesLazy, bracesLazy().endOfStream());
+BENCHMARK_CAPTURE(BM_bracesFailure, bracesLazyErased, lazy(bracesLazyErased).endOfStream());
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesSelfLazy, bracesSelfLazy().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesCached, bracesCache().endOfStream());
+BENCHMARK_CAPTURE(BM_bracesFailure, bracesCachedErased, lazyCached<ErasedTag>(bracesErased).endOfStream());
 #ifdef ENABLE_HARD_BENCHMARK
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesCachedDrop, bracesCacheDrop().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesCacheDropConstexpr, bracesCacheDropConstexpr().endOfStream());
@@ -170,6 +231,7 @@ BENCHMARK_CAPTURE(BM_bracesFailure, bracesCacheConstexpr, bracesCacheConstexpr()
 #endif
 BENCHMARK_CAPTURE(BM_bracesFailure, bracesForget, bracesForget().endOfStream());
 BENCHMARK_CAPTURE(BM_bracesFailureCtx, bracesCtx, bracesCtx());
+BENCHMARK_CAPTURE(BM_bracesFailureCtxErased, bracesCtxErased, bracesCtxErased);
 #ifdef ENABLE_HARD_BENCHMARK
 BENCHMARK_CAPTURE(BM_bracesFailureCtx, bracesCtxDrop, bracesCtxDrop());
 BENCHMARK_CAPTURE(BM_bracesFailureCtx, bracesCtxDropConstexpr, bracesCtxDropConstexpr());
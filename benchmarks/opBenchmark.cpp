@@ -172,4 +172,122 @@ static void BM_ETALON_TypeErasing(benchmark::State& state) {
     state.SetBytesProcessed(TYPE_ERASING_OP_TEST.size() * state.iterations());
 }
 
-BENCHMARK(BM_ETALON_TypeErasing);
\ No newline at end of file
+BENCHMARK(BM_ETALON_TypeErasing);
+
+static std::string generateLongWords(size_t words, size_t wordSize) {
+    std::string out;
+    for (size_t i = 0; i != words; ++i) {
+        for (size_t j = 0; j != wordSize; ++j) {
+            out += static_cast<char>('a' + (i * 7 + j) % 26);
+        }
+        out += (i % 4 == 3) ? '\n' : ' ';
+    }
+    return out;
+}
+
+static inline std::string const LONG_WORDS_TEST = generateLongWords(1000, 120);
+
+// byte by byte loop, the same as `letters` before bulk scanning
+inline auto lettersScalar() noexcept {
+    return make_parser([](Stream& str) {
+        auto start = str.pos();
+        while (str.checkFirst(details::lettersSet<false>.table()));
+
+        auto end = str.pos();
+        if (start == end) {
+            return Parser<std::string_view>::makeError("Empty word", str.pos());
+        } else {
+            return Parser<std::string_view>::data(str.get_sv(start, end));
+        }
+    });
+}
+
+inline auto untilNewLineScalar() noexcept {
+    return make_parser([](Stream& str) {
+        auto start = str.pos();
+        while (str.checkFirst([](char c) {
+            return c != '\n';
+        }));
+
+        return Parser<std::string_view>::data(str.get_sv(start, str.pos()));
+    });
+}
+
+template <ParserType P>
+static void BM_CharClassScan(benchmark::State& state, P parser) {
+    for (auto _ : state) {
+        Stream s(LONG_WORDS_TEST);
+        auto data = parser(s);
+        if (data.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse");
+        }
+    }
+
+    state.SetBytesProcessed(LONG_WORDS_TEST.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_CharClassScan, Letters, (letters() >> spaces()).drop().repeat());
+BENCHMARK_CAPTURE(BM_CharClassScan, LettersScalar, (lettersScalar() >> spaces()).drop().repeat());
+BENCHMARK_CAPTURE(BM_CharClassScan, Until, (until<'\n'>() >> charFrom<'\n'>()).drop().repeat());
+BENCHMARK_CAPTURE(BM_CharClassScan, UntilScalar, (untilNewLineScalar() >> charFrom<'\n'>()).drop().repeat());
+
+
+static inline std::string const QUOTED_STRINGS_TEST = [] {
+    std::string out;
+    for (size_t i = 0; i != 1000; ++i) {
+        out += "\"" + std::string(8 + i % 24, static_cast<char>('a' + i % 26)) + "\",";
+    }
+    return out;
+}();
+
+template <ParserType P>
+static void BM_EscapedString(benchmark::State& state, P parser) {
+    for (auto _ : state) {
+        Stream s(QUOTED_STRINGS_TEST);
+        auto data = parser(s);
+        if (data.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse");
+        }
+    }
+
+    state.SetBytesProcessed(QUOTED_STRINGS_TEST.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_EscapedString, Owned, (charFrom<'"'>() >> escapedString<'"'>() << charFrom<','>()).repeat<1000>());
+BENCHMARK_CAPTURE(BM_EscapedString, View, (charFrom<'"'>() >> escapedStringView<'"'>() << charFrom<','>()).repeat<1000>());
+
+
+static inline std::string const TAGS_TEST = [] {
+    std::string out;
+    for (size_t i = 0; i != 1000; ++i) {
+        out += (i % 2 == 0) ? "<tag/>" : "<tag!>";
+    }
+    return out;
+}();
+
+// the same primitive, but hidden from the fusion of `>>` and `<<`
+template <ParserType P>
+auto noFusion(P parser) noexcept {
+    return make_parser([parser](Stream& s) {
+        return parser(s);
+    });
+}
+
+template <ParserType P>
+static void BM_FusedPrimitives(benchmark::State& state, P parser) {
+    for (auto _ : state) {
+        Stream s(TAGS_TEST);
+        auto data = parser(s);
+        if (data.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse");
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(TAGS_TEST.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_FusedPrimitives, Fused,
+        (charFrom('<') >> literal<"tag"_prs>() >> charFrom('/', '!') << charFrom('>')).drop().repeat());
+BENCHMARK_CAPTURE(BM_FusedPrimitives, NotFused,
+        (noFusion(charFrom('<')) >> noFusion(literal<"tag"_prs>()) >> noFusion(charFrom('/', '!')) << noFusion(charFrom('>'))).drop().repeat());
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <parsecpp/all.hpp>
+
+#include <string>
+
+using namespace prs;
+
+/*
+ * S = (S)a | (S)b | x
+ * Without memoization every level parses (S) twice, so "((x)b)b" of depth n takes 2^n steps
+ */
+Parser<char> nestedBacktracking() noexcept {
+    auto inner = charFrom('(') >> lazyCached(nestedBacktracking, AutoTagV) << charFrom(')');
+    return ((inner >> charFrom('a')) | (inner >> charFrom('b')) | charFrom('x')).toCommonType();
+}
+
+Parser<char, PackratCtx> nestedPackrat() noexcept {
+    auto inner = packrat(charFrom('(') >> lazyCached(nestedPackrat, AutoTagV) << charFrom(')'));
+    return ((inner >> charFrom('a')) | (inner >> charFrom('b')) | charFrom('x')).toCommonType();
+}
+
+static std::string nestedText(size_t depth) {
+    std::string out(depth, '(');
+    out += 'x';
+    for (size_t i = 0; i != depth; ++i) {
+        out += ")b";
+    }
+    return out;
+}
+
+static void BM_NestedBacktracking(benchmark::State& state) {
+    auto const parser = nestedBacktracking();
+    auto const text = nestedText(state.range(0));
+    for (auto _ : state) {
+        Stream s{text};
+        auto result = parser(s);
+        if (result.isError()) {
+            state.SkipWithError("Cannot parse");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_NestedPackrat(benchmark::State& state) {
+    auto const parser = nestedPackrat();
+    auto const text = nestedText(state.range(0));
+    PackratTable table;
+    for (auto _ : state) {
+        table.reset();
+        PackratCtx ctx{table};
+        Stream s{text};
+        auto result = parser(s, ctx);
+        if (result.isError()) {
+            state.SkipWithError("Cannot parse");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_NestedBacktracking)->DenseRange(4, 20, 4)->Complexity();
+BENCHMARK(BM_NestedPackrat)->DenseRange(4, 20, 4)->Arg(256)->Complexity();
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <parsecpp/full.hpp>
+
+#include <string>
+
+
+using namespace prs;
+
+
+struct Trade {
+    unsigned long ts;
+    std::string_view symbol;
+    double price;
+    int qty;
+};
+
+static std::string const& tradesLog() {
+    static std::string const log = [] {
+        std::string text;
+        for (unsigned i = 0; text.size() < (32u << 20); ++i) {
+            text += "ts=" + std::to_string(1700000000000ul + i) + " sym=" + (i % 3 == 0 ? "BTCUSDT" : "ETHUSDT")
+                    + " px=" + std::to_string(i % 1000) + "." + std::to_string(i % 97)
+                    + " qty=" + std::to_string(i % 50 + 1) + (i % 101 == 0 ? " corrupted\n" : "\n");
+        }
+        return text;
+    }();
+    return log;
+}
+
+static auto tradeItem() {
+    auto record = liftM(details::MakeClass<Trade>{},
+            literal("ts=") >> number<unsigned long>(),
+            literal(" sym=") >> letters(),
+            literal(" px=") >> number<double>(),
+            literal(" qty=") >> number<int>() << charFrom('\n'));
+    return skipToNext(record, searchText("\n"));
+}
+
+
+static void BM_RecordsSequential(benchmark::State& state) {
+    auto const& log = tradesLog();
+    auto parser = tradeItem().repeat();
+    for (auto _ : state) {
+        Stream s{log};
+        auto result = parser(s);
+        if (result.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(log.size() * state.iterations());
+}
+
+static void BM_RecordsParallel(benchmark::State& state) {
+    auto const& log = tradesLog();
+    auto item = tradeItem();
+    auto resync = searchText("\n");
+    for (auto _ : state) {
+        Stream s{log};
+        auto result = parallelRepeat(s, item, resync, state.range(0));
+        if (result.isError() || !s.eos()) {
+            state.SkipWithError("Cannot parse");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(log.size() * state.iterations());
+}
+
+BENCHMARK(BM_RecordsSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordsParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -111,3 +111,53 @@ void BM_RegexHexColor(benchmark::State& state) {
 
 BENCHMARK(BM_RegexHexColor);
 
+
+
+static std::string generateSearchText(std::string const& needle) {
+    std::string out;
+    for (size_t i = 0; out.size() < 64 * 1024; ++i) {
+        out += static_cast<char>('a' + (i * i * 13 + 7 * i + 3) % 23);
+        if (i % 61 == 0) {
+            out += needle.substr(0, needle.size() - 1); // almost match
+        }
+    }
+    return out + needle;
+}
+
+static inline std::string const SHORT_NEEDLE = "\"id\":";
+static inline std::string const LONG_NEEDLE = "\"isBuyerMaker\":true,\"isBestMatch\":";
+
+template <ParserType P>
+void BM_SearchText(benchmark::State& state, P parser, std::string const& needle) {
+    std::string test = generateSearchText(needle);
+    for (auto _ : state) {
+        Stream s{test};
+        auto result = parser(s);
+        if (result.isError() || !s.eos()) {
+            state.SkipWithError("Cannot find");
+        }
+    }
+
+    state.SetBytesProcessed(test.size() * state.iterations());
+}
+
+void BM_SearchTextStdFind(benchmark::State& state, std::string const& needle) {
+    std::string test = generateSearchText(needle);
+    for (auto _ : state) {
+        std::string_view s{test};
+        auto pos = s.find(needle);
+        if (pos + needle.size() != test.size()) {
+            state.SkipWithError("Cannot find");
+        }
+        benchmark::DoNotOptimize(pos);
+    }
+
+    state.SetBytesProcessed(test.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_SearchText, Short, searchText(SHORT_NEEDLE), SHORT_NEEDLE);
+BENCHMARK_CAPTURE(BM_SearchText, ShortConstexpr, searchText<"\"id\":"_prs>(), SHORT_NEEDLE);
+BENCHMARK_CAPTURE(BM_SearchTextStdFind, Short, SHORT_NEEDLE);
+BENCHMARK_CAPTURE(BM_SearchText, Long, searchText(LONG_NEEDLE), LONG_NEEDLE);
+BENCHMARK_CAPTURE(BM_SearchText, LongConstexpr, searchText<"\"isBuyerMaker\":true,\"isBestMatch\":"_prs>(), LONG_NEEDLE);
+BENCHMARK_CAPTURE(BM_SearchTextStdFind, Long, LONG_NEEDLE);
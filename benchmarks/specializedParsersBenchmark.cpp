@@ -85,6 +85,93 @@ auto binanceParserConstexpr() {
 }
 
 
+struct BinanceTradeFixed {
+    size_t id;
+    int64_t price; // 10^-8
+    int64_t qty;   // 10^-8
+    size_t time;
+    bool isBuyerMaker;
+};
+
+template <ConstexprString fieldName>
+auto jsonValueFixedConstexpr() noexcept {
+    return searchText<fieldName.between('"').add(':')>() >> charFrom<'"'>() >> fixedPoint<8>() << charFrom<'"'>();
+}
+
+auto binanceParserFixed() {
+    return charFrom<'['>() >> (charFrom<'{'>() >> liftM(details::MakeClass<BinanceTradeFixed>{},
+            jsonValueUnsignedConstexpr<"id"_prs>(),
+            jsonValueFixedConstexpr<"price"_prs>(),
+            jsonValueFixedConstexpr<"qty"_prs>(),
+            jsonValueUnsignedConstexpr<"time"_prs>(),
+            searchText<"isBuyerMaker"_prs.between('"').add(':')>() >> (letters() >>= boolFromString)
+    ) << searchText<"}"_prs>() << charFrom<','>().maybe()).repeat<1000>() << charFrom<']'>();
+}
+
 BENCHMARK_CAPTURE(BM_jsonSpecializedBinance, Common, binanceParser());
 BENCHMARK_CAPTURE(BM_jsonSpecializedBinance, TypeErasing, binanceParser().toCommonType());
 BENCHMARK_CAPTURE(BM_jsonSpecializedBinance, Constexpr, binanceParserConstexpr());
+BENCHMARK_CAPTURE(BM_jsonSpecializedBinance, FixedPoint, binanceParserFixed());
+
+
+auto fromCharsDouble() noexcept {
+    return Parser<double>::make([](Stream& s) {
+        auto sv = s.sv();
+        double n = 0;
+        if (auto res = std::from_chars(sv.data(), sv.data() + sv.size(), n); res.ec == std::errc{}) {
+            s.moveUnsafe(res.ptr - sv.data());
+            return Parser<double>::data(n);
+        }
+        return Parser<double>::makeError("Cannot parse number", s.pos());
+    });
+}
+
+/**
+ * Coordinates like in canada.json
+ */
+template <typename Parser>
+static void BM_numbers(benchmark::State& state, Parser number) {
+    std::string text;
+    for (size_t i = 0; i != 10000; ++i) {
+        text += std::to_string(-65.6 + static_cast<double>(i * 7919 % 10007) / 1234.567) + "12345678,";
+    }
+    auto parser = (number << charFrom(',')).repeat();
+    for (auto _ : state) {
+        Stream s(text);
+        auto data = parser(s);
+        if (data.isError() || data.data().size() != 10000) {
+            state.SkipWithError("Cannot parse numbers");
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(text.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_numbers, FromChars, fromCharsDouble());
+BENCHMARK_CAPTURE(BM_numbers, General, number<double>());
+BENCHMARK_CAPTURE(BM_numbers, Json, number<double, NumberFormat::Json>());
+
+/**
+ * All [x, y] pairs of canada.json
+ */
+template <typename Point>
+static void BM_canadaPoints(benchmark::State& state, Point point) {
+    std::string const text = readFile("./canada.json");
+    auto ring = charFrom('[') >> point.repeat(charFrom(',')) << charFrom(']');
+    auto parser = searchText("\"coordinates\":[") >> ring.repeat(charFrom(',')) << charFrom(']');
+    for (auto _ : state) {
+        Stream s(text);
+        auto data = parser(s);
+        if (data.isError() || data.data().size() != 480) {
+            state.SkipWithError("Cannot parse canada.json");
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(text.size() * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_canadaPoints, Vector, charFrom('[') >> number<double>().repeat(charFrom(',')) << charFrom(']'));
+BENCHMARK_CAPTURE(BM_canadaPoints, Reserve, charFrom('[') >> number<double>().repeat<2>(charFrom(',')) << charFrom(']'));
+BENCHMARK_CAPTURE(BM_canadaPoints, Small, charFrom('[') >> number<double>().repeatSmall<2>(charFrom(',')) << charFrom(']'));
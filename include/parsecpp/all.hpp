@@ -9,7 +9,12 @@
 #include <parsecpp/core/modifier.h>
 
 #include <parsecpp/common/base.h>
+#include <parsecpp/common/choice.h>
+#include <parsecpp/common/keyword.h>
 #include <parsecpp/common/map.h>
+#include <parsecpp/common/arena.h>
+#include <parsecpp/common/packrat.h>
 #include <parsecpp/common/number.h>
 #include <parsecpp/common/string.h>
 #include <parsecpp/common/process.h>
+#include <parsecpp/common/bytecode.h>
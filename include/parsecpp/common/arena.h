@@ -0,0 +1,204 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+#include <parsecpp/common/map.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace prs {
+
+/**
+ * Parse-scoped monotonic arena for the results of arenaRepeat, arenaToMap and Repeat with ArenaCtx.
+ * All memory is released at once by reset(), results allocated from the arena must be destroyed before it.
+ * reset() grows the first block to the used size, so next documents of the same size don't use the heap at all.
+ */
+class ParseArena {
+public:
+    static constexpr size_t DEFAULT_SIZE = 64 * 1024;
+
+    explicit ParseArena(size_t initialSize = DEFAULT_SIZE)
+        : m_size(std::max<size_t>(initialSize, 1))
+        , m_buffer(new std::byte[m_size]) {
+        m_resource.emplace(m_buffer.get(), m_size, &m_upstream);
+    }
+
+    ParseArena(ParseArena const&) = delete;
+    ParseArena& operator=(ParseArena const&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept {
+        return &*m_resource;
+    }
+
+    /**
+     * Release all results of the previous parsing
+     */
+    void reset() {
+        auto const overflow = m_upstream.allocated;
+        m_resource.reset();
+        if (overflow != 0) {
+            m_size += overflow;
+            m_buffer.reset(new std::byte[m_size]);
+        }
+        m_upstream.allocated = 0;
+        m_upstream.count = 0;
+        m_resource.emplace(m_buffer.get(), m_size, &m_upstream);
+    }
+
+    /**
+     * Heap allocations since the last reset
+     */
+    size_t heapAllocations() const noexcept {
+        return m_upstream.count;
+    }
+
+    size_t capacity() const noexcept {
+        return m_size;
+    }
+private:
+    struct CountingResource final : public std::pmr::memory_resource {
+        size_t allocated = 0;
+        size_t count = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) final {
+            allocated += bytes;
+            ++count;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) final {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept final {
+            return this == &other;
+        }
+    };
+
+    size_t m_size;
+    std::unique_ptr<std::byte[]> m_buffer;
+    CountingResource m_upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+};
+
+using ArenaCtx = ContextWrapper<ParseArena&>;
+
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+template <typename Key, typename Value>
+using ArenaMap = std::pmr::map<Key, Value>;
+
+namespace details {
+
+template <ContextType Ctx>
+std::pmr::memory_resource* arenaResource(Ctx& ctx) noexcept {
+    return get<ParseArena>(ctx).resource();
+}
+
+}
+
+
+/**
+ * repeat with the result in the arena from the context
+ * @def arenaRepeat :: Parser<A, Ctx> -> Parser<ArenaVector<A>, Ctx & ArenaCtx>
+ */
+template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Value>
+    requires(!std::is_same_v<GetParserResult<Value>, Drop>)
+auto arenaRepeat(Value value) noexcept {
+    using Out = ArenaVector<GetParserResult<Value>>;
+    using P = Parser<Out, UnionCtx<GetParserCtx<Value>, ArenaCtx>>;
+    return P::make([value = std::move(value)](Stream& stream, auto& ctx) {
+        Out out{details::arenaResource(ctx)};
+        out.reserve(reserve);
+
+        size_t iteration = 0;
+        do {
+            auto backup = stream.pos();
+            auto result = value.apply(stream, ctx);
+            if (!result.isError()) {
+                out.emplace_back(std::move(result).data());
+            } else {
+                stream.restorePos(backup);
+                return P::data(std::move(out));
+            }
+        } while (++iteration != maxIteration);
+
+        return P::makeError("Max iteration", stream.pos());
+    });
+}
+
+
+/**
+ * @def arenaRepeat :: Parser<A, Ctx> -> Parser<Delim, CtxD> -> Parser<ArenaVector<A>, Ctx & CtxD & ArenaCtx>
+ */
+template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Value, ParserType Delimiter>
+    requires(!std::is_same_v<GetParserResult<Value>, Drop>)
+auto arenaRepeat(Value value, Delimiter delimiter) noexcept {
+    using Out = ArenaVector<GetParserResult<Value>>;
+    using P = Parser<Out, UnionCtx<GetParserCtx<Value>, GetParserCtx<Delimiter>, ArenaCtx>>;
+    return P::make([value = std::move(value), delimiter = std::move(delimiter)](Stream& stream, auto& ctx) {
+        Out out{details::arenaResource(ctx)};
+        out.reserve(reserve);
+
+        size_t iteration = 0;
+        auto backup = stream.pos();
+        do {
+            auto result = value.apply(stream, ctx);
+            if (!result.isError()) {
+                out.emplace_back(std::move(result).data());
+            } else {
+                return P::data(std::move(out));
+            }
+
+            backup = stream.pos();
+        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+
+        if (iteration == maxIteration) {
+            return P::makeError("Max iteration", stream.pos());
+        } else {
+            stream.restorePos(backup);
+            return P::data(std::move(out));
+        }
+    });
+}
+
+
+/**
+ * toMap with the result in the arena from the context
+ * @return Parser<ArenaMap<Key, Value>, CtxKey & CtxValue & ArenaCtx>
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , ParserType ParserKey
+        , ParserType ParserValue>
+auto arenaToMap(ParserKey key, ParserValue value) noexcept {
+    using Map = ArenaMap<GetParserResult<ParserKey>, GetParserResult<ParserValue>>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, ArenaCtx>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, StdMapContainer, Map, UCtx>(std::move(key), std::move(value), [](auto& ctx) {
+        return Map{details::arenaResource(ctx)};
+    });
+}
+
+
+/**
+ * @return Parser<ArenaMap<Key, Value>, CtxKey & CtxValue & CtxDelim & ArenaCtx>
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , ParserType ParserKey
+        , ParserType ParserValue
+        , ParserType ParserDelimiter>
+auto arenaToMap(ParserKey key, ParserValue value, ParserDelimiter delimiter) noexcept {
+    using Map = ArenaMap<GetParserResult<ParserKey>, GetParserResult<ParserValue>>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>, ArenaCtx>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, StdMapContainer, Map, UCtx>(std::move(key), std::move(value), std::move(delimiter), [](auto& ctx) {
+        return Map{details::arenaResource(ctx)};
+    });
+}
+
+}
\ No newline at end of file
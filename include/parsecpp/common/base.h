@@ -40,7 +40,7 @@ inline auto fail() noexcept {
  * @return Parser<Unit>
  */
 inline auto fail(std::string const& text) noexcept {
-    return Parser<Unit>::make([text](Stream& s) {
+    return Parser<Unit>::make([text = details::keepErrorText(text)](Stream& s) {
         return Parser<Unit>::makeError(text, s.pos());
     });
 }
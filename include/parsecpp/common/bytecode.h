@@ -0,0 +1,672 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace prs::vm {
+
+/**
+ * Instructions of the parsing machine, `aux` is a byte or an index of a set, `arg` is an address or an index
+ */
+enum class Op : uint8_t {
+    Char,          // match the byte aux
+    Set,           // match a byte of sets[aux]
+    Span,          // skip bytes of sets[aux]
+    Literal,       // match literals[arg]
+    Any,           // match any byte
+    TestSet,       // jump to arg without backtracking if the byte isn't in sets[aux]
+    Choice,        // push a backtrack entry to arg
+    Commit,        // pop the backtrack entry, jump to arg
+    PartialCommit, // update the backtrack entry to the current position, jump to arg
+    Jump,
+    Call,
+    Return,
+    Fail,
+    Open,          // start of a capture
+    Close,         // end of a capture with the action arg
+    End
+};
+
+struct Instruction {
+    Op op;
+    uint16_t aux = 0;
+    uint32_t arg = 0;
+};
+
+template <typename State>
+using Action = void (*)(std::string_view, State&);
+
+
+struct Node;
+
+/**
+ * Expression of a grammar, it's a value: subexpressions are shared
+ */
+class Expr {
+public:
+    explicit Expr(std::shared_ptr<Node const> node) noexcept
+        : m_node(std::move(node)) {
+
+    }
+
+    Node const& node() const noexcept {
+        return *m_node;
+    }
+private:
+    std::shared_ptr<Node const> m_node;
+};
+
+struct Node {
+    enum class Kind {Char, Set, Literal, Any, Seq, Alt, Many, Opt, Rule, Capture};
+
+    Kind kind;
+    char c = 0;
+    CharSet set{};
+    std::string literal{};
+    size_t index = 0; // rule or action
+    std::vector<Expr> children{};
+};
+
+namespace impl {
+
+inline Expr makeNode(Node node) {
+    return Expr{std::make_shared<Node const>(std::move(node))};
+}
+
+inline Expr makeList(Node::Kind kind, Expr const& lhs, Expr const& rhs) {
+    Node out{kind};
+    for (auto const* e : {&lhs, &rhs}) {
+        if (e->node().kind == kind) {
+            out.children.insert(out.children.end(), e->node().children.begin(), e->node().children.end());
+        } else {
+            out.children.push_back(*e);
+        }
+    }
+    return makeNode(std::move(out));
+}
+
+}
+
+inline Expr ch(char c) {
+    return impl::makeNode(Node{Node::Kind::Char, c});
+}
+
+inline Expr chars(CharSet const& set) {
+    return impl::makeNode(Node{Node::Kind::Set, 0, set});
+}
+
+inline Expr range(char from, char to) {
+    return chars(CharSet::fromPredicate([from, to](char c) {
+        return from <= c && c <= to;
+    }));
+}
+
+inline Expr lit(std::string_view str) {
+    return impl::makeNode(Node{Node::Kind::Literal, 0, {}, std::string(str)});
+}
+
+inline Expr any() {
+    return impl::makeNode(Node{Node::Kind::Any});
+}
+
+inline Expr operator>>(Expr const& lhs, Expr const& rhs) {
+    return impl::makeList(Node::Kind::Seq, lhs, rhs);
+}
+
+/**
+ * Ordered choice: rhs is tried only if lhs fails
+ */
+inline Expr operator|(Expr const& lhs, Expr const& rhs) {
+    return impl::makeList(Node::Kind::Alt, lhs, rhs);
+}
+
+/**
+ * Greedy repetition, an iteration that doesn't consume input stops the loop
+ */
+inline Expr many(Expr const& e) {
+    return impl::makeNode(Node{Node::Kind::Many, 0, {}, {}, 0, {e}});
+}
+
+inline Expr many1(Expr const& e) {
+    return e >> many(e);
+}
+
+inline Expr opt(Expr const& e) {
+    return impl::makeNode(Node{Node::Kind::Opt, 0, {}, {}, 0, {e}});
+}
+
+/**
+ * On success of the whole match actions[action] is called with the text matched by e.
+ * Actions are called in postfix order: nested captures before the enclosing one.
+ */
+inline Expr capture(Expr const& e, size_t action) {
+    return impl::makeNode(Node{Node::Kind::Capture, 0, {}, {}, action, {e}});
+}
+
+
+namespace impl {
+
+class Compiler;
+
+}
+
+
+/**
+ * Compiled grammar: flat array of instructions, a backtracking stack machine in the spirit of LPeg.
+ */
+class Program {
+public:
+    static constexpr size_t MAX_STACK = size_t{1} << 16;
+
+    std::span<Instruction const> code() const noexcept {
+        return m_code;
+    }
+
+    /**
+     * First bytes of the start rule, if they are known
+     */
+    std::optional<CharSet> const& firstSet() const noexcept {
+        return m_first;
+    }
+
+    /**
+     * Match from the current position, on success the stream is moved to the end of the match
+     * and actions of the captures are called.
+     * @return the furthest failed position on error
+     */
+    template <typename State>
+    details::ResultType<Unit> run(Stream& stream, State& state, std::span<Action<State> const> actions) const {
+        ScratchLease scratch;
+        auto result = exec(stream, *scratch);
+        if (result.isError()) {
+            return result;
+        }
+
+        auto& opens = scratch->opens;
+        auto const str = stream.full();
+        for (auto const& capture : scratch->captures) {
+            if (capture.action == OPEN) {
+                opens.push_back(capture.pos);
+            } else {
+                assert(capture.action < actions.size());
+                actions[capture.action](str.substr(opens.back(), capture.pos - opens.back()), state);
+                opens.pop_back();
+            }
+        }
+        return result;
+    }
+
+    details::ResultType<Unit> run(Stream& stream) const {
+        ScratchLease scratch;
+        return exec(stream, *scratch);
+    }
+private:
+    friend class impl::Compiler;
+
+    static constexpr uint32_t OPEN = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t CALL_FRAME = std::numeric_limits<size_t>::max();
+    static constexpr size_t INITIAL_STACK = 64;
+
+    struct Capture {
+        uint32_t action;
+        size_t pos;
+    };
+
+    struct Frame {
+        uint32_t pc;
+        uint32_t captures;
+        size_t pos; // CALL_FRAME for return addresses
+    };
+
+    /**
+     * Buffers of a run, they are kept by the thread between runs
+     */
+    struct Scratch {
+        std::vector<Frame> stack;
+        std::vector<Capture> captures;
+        std::vector<size_t> opens;
+    };
+
+    /**
+     * Takes the buffers of the thread and gives them back cleared.
+     * An action can run a program, the nested run finds no buffers and allocates its own.
+     */
+    class ScratchLease {
+    public:
+        ScratchLease() noexcept
+            : m_scratch(std::exchange(cached(), Scratch{})) {
+
+        }
+
+        ScratchLease(ScratchLease const&) = delete;
+        ScratchLease& operator=(ScratchLease const&) = delete;
+
+        ~ScratchLease() {
+            m_scratch.stack.clear();
+            m_scratch.captures.clear();
+            m_scratch.opens.clear();
+            cached() = std::move(m_scratch);
+        }
+
+        Scratch& operator*() noexcept {
+            return m_scratch;
+        }
+
+        Scratch* operator->() noexcept {
+            return &m_scratch;
+        }
+    private:
+        static Scratch& cached() noexcept {
+            thread_local Scratch scratch;
+            return scratch;
+        }
+
+        Scratch m_scratch;
+    };
+
+    details::ResultType<Unit> exec(Stream& stream, Scratch& scratch) const {
+        auto const str = stream.full();
+        auto const* code = m_code.data();
+        size_t pos = stream.pos();
+        size_t furthest = pos;
+        uint32_t pc = 0;
+        auto& stack = scratch.stack;
+        auto& captures = scratch.captures;
+        stack.reserve(INITIAL_STACK);
+
+        while (true) {
+            auto const& ins = code[pc];
+            switch (ins.op) {
+                case Op::Char:
+                    if (pos != str.size() && str[pos] == static_cast<char>(ins.aux)) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Set:
+                    if (pos != str.size() && m_sets[ins.aux].contains(str[pos])) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Span:
+                    pos += m_sets[ins.aux].prefixLength(str.substr(pos));
+                    ++pc;
+                    continue;
+                case Op::Literal:
+                    if (str.substr(pos).starts_with(m_literals[ins.arg])) {
+                        pos += m_literals[ins.arg].size();
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Any:
+                    if (pos != str.size()) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::TestSet:
+                    if (pos != str.size() && m_sets[ins.aux].contains(str[pos])) {
+                        ++pc;
+                    } else {
+                        furthest = std::max(furthest, pos);
+                        pc = ins.arg;
+                    }
+                    continue;
+                case Op::Choice:
+                    if (stack.size() == MAX_STACK) {
+                        return Parser<Unit>::makeError("Stack overflow", pos);
+                    }
+                    stack.push_back(Frame{ins.arg, static_cast<uint32_t>(captures.size()), pos});
+                    ++pc;
+                    continue;
+                case Op::Commit:
+                    stack.pop_back();
+                    pc = ins.arg;
+                    continue;
+                case Op::PartialCommit:
+                    if (auto& top = stack.back(); top.pos != pos) {
+                        top.pos = pos;
+                        top.captures = static_cast<uint32_t>(captures.size());
+                        pc = ins.arg;
+                    } else {
+                        pc = top.pc;
+                        stack.pop_back();
+                    }
+                    continue;
+                case Op::Jump:
+                    pc = ins.arg;
+                    continue;
+                case Op::Call:
+                    if (stack.size() == MAX_STACK) {
+                        return Parser<Unit>::makeError("Stack overflow", pos);
+                    }
+                    stack.push_back(Frame{pc + 1, 0, CALL_FRAME});
+                    pc = ins.arg;
+                    continue;
+                case Op::Return:
+                    pc = stack.back().pc;
+                    stack.pop_back();
+                    continue;
+                case Op::Fail:
+                    break;
+                case Op::Open:
+                    captures.push_back(Capture{OPEN, pos});
+                    ++pc;
+                    continue;
+                case Op::Close:
+                    captures.push_back(Capture{ins.arg, pos});
+                    ++pc;
+                    continue;
+                case Op::End:
+                    stream.restorePos(pos);
+                    return Parser<Unit>::data(Unit{});
+            }
+
+            furthest = std::max(furthest, pos);
+            while (!stack.empty() && stack.back().pos == CALL_FRAME) {
+                stack.pop_back();
+            }
+            if (stack.empty()) {
+                return Parser<Unit>::makeError("Grammar doesn't match", furthest);
+            }
+            pc = stack.back().pc;
+            pos = stack.back().pos;
+            captures.resize(stack.back().captures);
+            stack.pop_back();
+        }
+    }
+
+    std::vector<Instruction> m_code;
+    std::vector<CharSet> m_sets;
+    std::vector<std::string> m_literals;
+    std::optional<CharSet> m_first;
+};
+
+
+/**
+ * Set of rules, rules can be referenced before the definition, so grammars can be recursive.
+ * Left recursion isn't supported, it fails with "Stack overflow".
+ */
+class Grammar {
+public:
+    Expr rule() {
+        m_rules.emplace_back();
+        return impl::makeNode(Node{Node::Kind::Rule, 0, {}, {}, m_rules.size() - 1});
+    }
+
+    void define(Expr const& rule, Expr body) {
+        assert(rule.node().kind == Node::Kind::Rule);
+        m_rules[rule.node().index] = std::move(body);
+    }
+
+    Program compile(Expr const& start) const;
+private:
+    std::vector<std::optional<Expr>> m_rules;
+};
+
+
+namespace impl {
+
+class Compiler {
+public:
+    explicit Compiler(std::vector<std::optional<Expr>> const& rules)
+        : m_rules(rules)
+        , m_addresses(rules.size(), UNKNOWN) {
+
+    }
+
+    Program compile(Expr const& start) {
+        emitRoot(start);
+        emit(Op::End);
+        for (size_t i = 0; i != m_rules.size(); ++i) {
+            m_addresses[i] = here();
+            if (m_rules[i]) {
+                emitRoot(*m_rules[i]);
+            } else {
+                assert(false && "Rule is not defined");
+                emit(Op::Fail);
+            }
+            emit(Op::Return);
+        }
+        for (auto [at, rule] : m_calls) {
+            m_program.m_code[at].arg = m_addresses[rule];
+        }
+        m_program.m_first = firstOf(start.node(), 0);
+        return std::move(m_program);
+    }
+private:
+    static constexpr uint32_t UNKNOWN = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MAX_FIRST_DEPTH = 16;
+
+    uint32_t here() const noexcept {
+        return static_cast<uint32_t>(m_program.m_code.size());
+    }
+
+    size_t emit(Op op, uint16_t aux = 0, uint32_t arg = 0) {
+        m_program.m_code.push_back(Instruction{op, aux, arg});
+        return m_program.m_code.size() - 1;
+    }
+
+    void patch(size_t at) noexcept {
+        m_program.m_code[at].arg = here();
+    }
+
+    uint16_t addSet(CharSet const& set) {
+        assert(m_program.m_sets.size() < std::numeric_limits<uint16_t>::max());
+        m_program.m_sets.push_back(set);
+        return static_cast<uint16_t>(m_program.m_sets.size() - 1);
+    }
+
+    void emitRoot(Expr const& e) {
+        emitNode(e.node());
+    }
+
+    /**
+     * The set of first bytes if the expression cannot match the empty string
+     */
+    std::optional<CharSet> firstOf(Node const& node, size_t depth) const {
+        switch (node.kind) {
+            case Node::Kind::Char:
+                return CharSet::anyOf(node.c);
+            case Node::Kind::Set:
+                return node.set;
+            case Node::Kind::Literal:
+                return node.literal.empty() ? std::nullopt : std::optional{CharSet::anyOf(node.literal.front())};
+            case Node::Kind::Seq:
+                return firstOf(node.children.front().node(), depth);
+            case Node::Kind::Alt: {
+                std::vector<CharSet> sets;
+                for (auto const& child : node.children) {
+                    auto first = firstOf(child.node(), depth);
+                    if (!first) {
+                        return std::nullopt;
+                    }
+                    sets.push_back(*first);
+                }
+                return CharSet::fromPredicate([&sets](char c) {
+                    return std::any_of(sets.begin(), sets.end(), [c](CharSet const& set) {
+                        return set.contains(c);
+                    });
+                });
+            }
+            case Node::Kind::Rule:
+                if (depth == MAX_FIRST_DEPTH || !m_rules[node.index]) {
+                    return std::nullopt;
+                }
+                return firstOf(m_rules[node.index]->node(), depth + 1);
+            case Node::Kind::Capture:
+                return firstOf(node.children.front().node(), depth);
+            case Node::Kind::Any:
+            case Node::Kind::Many:
+            case Node::Kind::Opt:
+                return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Skip the backtrack entry if the first byte cannot start the expression
+     */
+    std::optional<size_t> emitTest(Node const& node) {
+        if (auto first = firstOf(node, 0); first) {
+            return emit(Op::TestSet, addSet(*first));
+        }
+        return std::nullopt;
+    }
+
+    void emitNode(Node const& node) {
+        switch (node.kind) {
+            case Node::Kind::Char:
+                emit(Op::Char, static_cast<unsigned char>(node.c));
+                break;
+            case Node::Kind::Set:
+                emit(Op::Set, addSet(node.set));
+                break;
+            case Node::Kind::Literal:
+                if (node.literal.size() == 1) {
+                    emit(Op::Char, static_cast<unsigned char>(node.literal.front()));
+                } else if (!node.literal.empty()) {
+                    m_program.m_literals.push_back(node.literal);
+                    emit(Op::Literal, 0, static_cast<uint32_t>(m_program.m_literals.size() - 1));
+                }
+                break;
+            case Node::Kind::Any:
+                emit(Op::Any);
+                break;
+            case Node::Kind::Seq:
+                for (auto const& child : node.children) {
+                    emitNode(child.node());
+                }
+                break;
+            case Node::Kind::Alt: {
+                // TestSet next; Choice next; alt; Commit end; next: ...
+                std::vector<size_t> commits;
+                for (size_t i = 0; i + 1 != node.children.size(); ++i) {
+                    auto const test = emitTest(node.children[i].node());
+                    auto const choice = emit(Op::Choice);
+                    emitNode(node.children[i].node());
+                    commits.push_back(emit(Op::Commit));
+                    patch(choice);
+                    if (test) {
+                        patch(*test);
+                    }
+                }
+                emitNode(node.children.back().node());
+                for (auto commit : commits) {
+                    patch(commit);
+                }
+                break;
+            }
+            case Node::Kind::Many: {
+                auto const& body = node.children.front().node();
+                if (body.kind == Node::Kind::Set || body.kind == Node::Kind::Char) {
+                    emit(Op::Span, addSet(body.kind == Node::Kind::Set ? body.set : CharSet::anyOf(body.c)));
+                    break;
+                }
+                // TestSet end; Choice end; loop: body; PartialCommit loop; end:
+                auto const test = emitTest(body);
+                auto const choice = emit(Op::Choice);
+                emitNode(body);
+                emit(Op::PartialCommit, 0, static_cast<uint32_t>(choice + 1));
+                patch(choice);
+                if (test) {
+                    patch(*test);
+                }
+                break;
+            }
+            case Node::Kind::Opt: {
+                auto const& body = node.children.front().node();
+                auto const test = emitTest(body);
+                auto const choice = emit(Op::Choice);
+                emitNode(body);
+                auto const commit = emit(Op::Commit);
+                patch(choice);
+                patch(commit);
+                if (test) {
+                    patch(*test);
+                }
+                break;
+            }
+            case Node::Kind::Rule:
+                m_calls.emplace_back(emit(Op::Call), node.index);
+                break;
+            case Node::Kind::Capture:
+                emit(Op::Open);
+                emitNode(node.children.front().node());
+                emit(Op::Close, 0, static_cast<uint32_t>(node.index));
+                break;
+        }
+    }
+
+    std::vector<std::optional<Expr>> const& m_rules;
+    std::vector<uint32_t> m_addresses;
+    std::vector<std::pair<size_t, size_t>> m_calls;
+    Program m_program;
+};
+
+}
+
+
+inline Program Grammar::compile(Expr const& start) const {
+    return impl::Compiler{m_rules}.compile(start);
+}
+
+
+namespace impl {
+
+template <typename R, typename Fn>
+auto withProgramFirstSet(Program const& program, Fn fn) {
+    auto parser = Parser<R>::make(std::move(fn));
+    if (auto const& first = program.firstSet(); first) {
+        return parser.withFirstSet(FirstSet::of(*first));
+    }
+    return parser.withFirstSet(FirstSet::any());
+}
+
+}
+
+
+/**
+ * Parser that runs the program, the captures are ignored
+ * @return Parser<Unit>
+ */
+inline auto toParser(std::shared_ptr<Program const> program) {
+    auto const& ref = *program;
+    return impl::withProgramFirstSet<Unit>(ref, [program = std::move(program)](Stream& stream) {
+        return program->run(stream);
+    });
+}
+
+/**
+ * Parser that runs the program with a new State, calls the actions of captures and returns result(state)
+ * @return Parser<std::invoke_result_t<Fn, State&>>
+ */
+template <typename State, typename Fn>
+auto toParser(std::shared_ptr<Program const> program, std::vector<Action<State>> actions, Fn result) {
+    using R = std::decay_t<std::invoke_result_t<Fn, State&>>;
+    auto const& ref = *program;
+    return impl::withProgramFirstSet<R>(ref, [program = std::move(program), actions = std::move(actions), result = std::move(result)](Stream& stream) {
+        State state{};
+        return program->run<State>(stream, state, actions).map([&](Unit) {
+            return result(state);
+        });
+    });
+}
+
+}
\ No newline at end of file
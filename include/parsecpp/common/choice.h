@@ -0,0 +1,94 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+namespace prs {
+
+namespace details {
+
+template <size_t n>
+using ChoiceMask = std::conditional_t<n <= 8, uint8_t,
+                   std::conditional_t<n <= 16, uint16_t,
+                   std::conditional_t<n <= 32, uint32_t, uint64_t>>>;
+
+/**
+ * Apply viable alternatives (set bits of mask) in order, the same as `|` of them
+ */
+template <size_t I = 0, typename Mask, typename TupleParser, typename Ctx>
+auto applyChoice(Mask mask, TupleParser const& parsers, Stream& stream, Ctx& ctx) {
+    using Result = typename std::tuple_element_t<0, TupleParser>::Result;
+    if constexpr (I == std::tuple_size_v<TupleParser>) {
+        return Result{ParsingError{stream.pos()}};
+    } else {
+        if ((mask & (Mask{1} << I)) == 0) {
+            return applyChoice<I + 1>(mask, parsers, stream, ctx);
+        }
+
+        mask &= static_cast<Mask>(mask - 1);
+        if (mask == 0) {
+            return std::get<I>(parsers).apply(stream, ctx);
+        }
+
+        auto backup = stream.pos();
+        return std::get<I>(parsers).apply(stream, ctx).flatMapError([&](ParsingError const& firstError) {
+            stream.restorePos(backup);
+            return applyChoice<I + 1>(mask, parsers, stream, ctx).flatMapError([&](ParsingError const& secondError) {
+                return Result{ParsingError::orError(firstError, secondError)};
+            });
+        });
+    }
+}
+
+}
+
+
+/**
+ * N-ary `|` with LL(1) dispatch: alternatives whose first set doesn't contain the next byte are not applied.
+ * The viable alternatives are found by a 256-entry table, the rest of them are applied with backtracking as in `|`.
+ * Alternatives without the first set (e.g. `lazy`, `satisfy`) are always viable, use withFirstSet to declare it.
+ * @def choice :: Parser<A, Ctx1> -> ... -> Parser<A, CtxN> -> Parser<A, Ctx1 & ... & CtxN>
+ */
+template <ParserType First, ParserType ...Rest>
+    requires((std::is_same_v<GetParserResult<First>, GetParserResult<Rest>> && ...) && sizeof...(Rest) < 64)
+constexpr auto choice(First first, Rest ...rest) noexcept {
+    using T = GetParserResult<First>;
+    using UCtx = UnionCtx<GetParserCtx<First>, GetParserCtx<Rest>...>;
+    using Mask = details::ChoiceMask<sizeof...(Rest) + 1>;
+    constexpr size_t EOS = CharSet::CHAR_MAPPING_SIZE;
+
+    std::array<FirstSet, sizeof...(Rest) + 1> const sets{first.firstSet(), rest.firstSet()...};
+    std::array<Mask, EOS + 1> table{};
+    FirstSet all{};
+    for (size_t i = 0; i != sets.size(); ++i) {
+        auto const bit = static_cast<Mask>(Mask{1} << i);
+        for (size_t c = 0; c != EOS; ++c) {
+            if (sets[i].viable(static_cast<char>(c))) {
+                table[c] |= bit;
+            }
+        }
+        if (sets[i].nullable()) {
+            table[EOS] |= bit;
+        }
+        all = all | sets[i];
+    }
+
+    auto parser = Parser<T, UCtx>::make([parsers = std::make_tuple(std::move(first), std::move(rest)...), table](Stream& stream, auto& ctx) {
+        Mask const mask = stream.eos() ? table[EOS] : table[static_cast<unsigned char>(stream.front())];
+        if (mask == 0) {
+            return Parser<T>::makeError("No viable alternative", stream.pos());
+        }
+        return details::applyChoice(mask, parsers, stream, ctx);
+    });
+
+    if constexpr (std::decay_t<First>::hasFirstSet && (std::decay_t<Rest>::hasFirstSet && ...)) {
+        return parser.withFirstSet(all);
+    } else {
+        return parser;
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+#include <parsecpp/utils/constexprString.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace prs {
+
+namespace details {
+
+struct KeywordMatch {
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    size_t index = NONE;
+    size_t length = 0;
+};
+
+/**
+ * Compile-time trie of keywords.
+ * Bytes are mapped to the alphabet of keywords, so transitions are a dense [node][class] table
+ * and the lookup is one table access per byte regardless of the number of keywords.
+ */
+template <ConstexprString ...words>
+class KeywordTrie {
+public:
+    static constexpr std::array<std::string_view, sizeof...(words)> WORDS{words.sv()...};
+
+    static constexpr size_t countNodes() noexcept {
+        auto sorted = WORDS;
+        std::sort(sorted.begin(), sorted.end());
+        size_t nodes = 1;
+        for (size_t i = 0; i != sorted.size(); ++i) {
+            size_t common = 0;
+            if (i != 0) {
+                while (common != sorted[i].size() && common != sorted[i - 1].size() && sorted[i][common] == sorted[i - 1][common]) {
+                    ++common;
+                }
+            }
+            nodes += sorted[i].size() - common;
+        }
+        return nodes;
+    }
+
+    static constexpr size_t countClasses() noexcept {
+        std::array<bool, CharSet::CHAR_MAPPING_SIZE> used{};
+        size_t classes = 1;
+        for (auto word : WORDS) {
+            for (char c : word) {
+                auto& u = used[static_cast<unsigned char>(c)];
+                classes += u ? 0 : 1;
+                u = true;
+            }
+        }
+        return classes;
+    }
+
+    static constexpr size_t NODES = countNodes();
+    static constexpr size_t CLASSES = countClasses();
+    static_assert(NODES < std::numeric_limits<uint16_t>::max(), "Too many keywords");
+
+    constexpr KeywordTrie() noexcept {
+        uint8_t classes = 1;
+        for (auto word : WORDS) {
+            for (char c : word) {
+                auto& cls = m_classOf[static_cast<unsigned char>(c)];
+                if (cls == 0) {
+                    cls = classes++;
+                }
+            }
+        }
+
+        uint16_t nodes = 1;
+        for (size_t i = 0; i != WORDS.size(); ++i) {
+            size_t node = 0;
+            for (char c : WORDS[i]) {
+                auto& next = m_next[node * CLASSES + m_classOf[static_cast<unsigned char>(c)]];
+                if (next == 0) {
+                    next = nodes++;
+                }
+                node = next;
+            }
+            if (m_terminal[node] == 0) {
+                m_terminal[node] = static_cast<uint16_t>(i + 1);
+            }
+        }
+    }
+
+    /**
+     * @return the longest keyword that is a prefix of str
+     */
+    constexpr KeywordMatch match(std::string_view str) const noexcept {
+        KeywordMatch out{};
+        size_t node = 0;
+        size_t i = 0;
+        while (true) {
+            if (m_terminal[node] != 0) {
+                out = KeywordMatch{m_terminal[node] - size_t{1}, i};
+            }
+            if (i == str.size()) {
+                return out;
+            }
+
+            auto const cls = m_classOf[static_cast<unsigned char>(str[i])];
+            if (cls == 0 || (node = m_next[node * CLASSES + cls]) == 0) {
+                return out;
+            }
+            ++i;
+        }
+    }
+
+    constexpr FirstSet firstSet() const noexcept {
+        auto first = FirstSet::fromPredicate([](char c) {
+            return std::any_of(WORDS.begin(), WORDS.end(), [c](std::string_view word) {
+                return !word.empty() && word.front() == c;
+            });
+        });
+        return m_terminal[0] != 0 ? first.maybe() : first;
+    }
+private:
+    std::array<uint8_t, CharSet::CHAR_MAPPING_SIZE> m_classOf{};
+    std::array<uint16_t, NODES * CLASSES> m_next{};
+    std::array<uint16_t, NODES> m_terminal{};
+};
+
+template <ConstexprString ...words>
+inline constexpr KeywordTrie<words...> keywordTrie{};
+
+}
+
+
+/**
+ * One of the fixed words with the longest match semantics, O(length of the match) for any number of words.
+ * If the same word is listed twice, the first index is returned.
+ * @return Parser<size_t> - index of the matched word
+ */
+template <ConstexprString ...words>
+    requires(sizeof...(words) > 0)
+auto keyword() noexcept {
+    return Parser<size_t>::make([](Stream& stream) {
+        auto const match = details::keywordTrie<words...>.match(stream.sv());
+        if (match.index == details::KeywordMatch::NONE) {
+            return Parser<size_t>::makeError("Unknown keyword", stream.pos());
+        }
+        stream.moveUnsafe(match.length);
+        return Parser<size_t>::data(match.index);
+    }).withFirstSet(details::keywordTrie<words...>.firstSet());
+}
+
+
+/**
+ * @param values - mapped value for each word
+ * @return Parser<std::common_type_t<Values...>>
+ */
+template <ConstexprString ...words, typename ...Values>
+    requires(sizeof...(words) > 0 && sizeof...(words) == sizeof...(Values))
+auto keyword(Values ...values) noexcept {
+    using T = std::common_type_t<Values...>;
+    return keyword<words...>() >>= [values = std::array<T, sizeof...(Values)>{static_cast<T>(values)...}](size_t index) {
+        return values[index];
+    };
+}
+
+}
\ No newline at end of file
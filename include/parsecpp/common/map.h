@@ -2,30 +2,99 @@
 
 #include <parsecpp/core/parser.h>
 #include <parsecpp/core/lift.h>
+#include <parsecpp/utils/flatMap.h>
 
 #include <map>
+#include <utility>
+#include <vector>
 
 
 namespace prs {
 
 /**
- * @tparam errorInTheMiddle - fail parser if key can be parsed and value cannot
- * Key := ParserKey::Type
- * Value := ParserValue::Type
- * @return Parser<std::map<Key, Value>>
+ * Result containers of toMap.
+ * Container::Type<Key, Value> is the result type, insert is called for each pair and finish once before return.
  */
-template <bool errorInTheMiddle = true
-        , size_t maxIteration = MAX_ITERATION
-        , ParserType ParserKey
-        , ParserType ParserValue>
-auto toMap(ParserKey key, ParserValue value) noexcept {
-    using Key = GetParserResult<ParserKey>;
-    using Value = GetParserResult<ParserValue>;
-    using Map = std::map<Key, Value>;
-    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>>;
-    using P = Parser<Map, UCtx>;
-    return P::make([key, value](Stream& stream, auto& ctx) {
-        Map out{};
+struct StdMapContainer {
+    template <typename Key, typename Value>
+    using Type = std::map<Key, Value>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.insert_or_assign(std::forward<Key>(key), std::forward<Value>(value));
+    }
+
+    template <typename Map>
+    static void finish(Map&) noexcept {}
+};
+
+/**
+ * Sorted vector, sorted once at the end
+ */
+struct FlatMapContainer {
+    template <typename Key, typename Value>
+    using Type = FlatMap<Key, Value>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.append(std::forward<Key>(key), std::forward<Value>(value));
+    }
+
+    template <typename Map>
+    static void finish(Map& map) {
+        map.sort();
+    }
+};
+
+/**
+ * Open addressing hash map, keeps the insertion order
+ */
+struct HashMapContainer : public StdMapContainer {
+    template <typename Key, typename Value>
+    using Type = HashMap<Key, Value>;
+};
+
+/**
+ * Plain vector of pairs in the input order, duplicates are kept
+ */
+struct PairVectorContainer {
+    template <typename Key, typename Value>
+    using Type = std::vector<std::pair<Key, Value>>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.emplace_back(std::forward<Key>(key), std::forward<Value>(value));
+    }
+
+    template <typename Map>
+    static void finish(Map&) noexcept {}
+};
+
+
+namespace details {
+
+/**
+ * Common loop of toMap, makeMap :: Ctx& -> Map creates an empty container, into clears the caller's one
+ */
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map,
+        ParserType ParserKey, ParserType ParserValue, typename MakeMap>
+struct ToMapFn {
+    template <typename Ctx>
+    ResultType<Map> operator()(Stream& stream, Ctx& ctx) const {
+        Map out = makeMap(ctx);
+        return fill(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Map& out) const {
+        out.clear();
+        return fill(stream, ctx, out);
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> fill(Stream& stream, Ctx& ctx, Map& out) const {
         size_t iteration = 0;
 
         [[maybe_unused]]
@@ -35,47 +104,53 @@ auto toMap(ParserKey key, ParserValue value) noexcept {
             if (!keyRes.isError()) {
                 auto valueRes = value.apply(stream, ctx);
                 if (!valueRes.isError()) {
-                    out.insert_or_assign(std::move(keyRes).data(), std::move(valueRes).data());
+                    Container::insert(out, std::move(keyRes).data(), std::move(valueRes).data());
                 } else {
                     if constexpr (errorInTheMiddle) {
-                        return P::makeError("Parse key but cannot parse value", stream.pos());
+                        return ResultType<Drop>{ParsingError{"Parse key but cannot parse value", stream.pos()}};
                     } else {
                         stream.restorePos(backup);
-                        return P::data(std::move(out));
+                        Container::finish(out);
+                        return ResultType<Drop>{Drop{}};
                     }
                 }
             } else {
                 stream.restorePos(backup);
-                return P::data(std::move(out));
+                Container::finish(out);
+                return ResultType<Drop>{Drop{}};
             }
 
             backup = stream.pos();
         } while (++iteration != maxIteration);
 
-        return P::makeError("Max iteration", stream.pos());
-    });
-}
+        return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+    }
 
+    ParserKey key;
+    ParserValue value;
+    MakeMap makeMap;
+};
 
-/**
- * @tparam errorInTheMiddle - fail parser if key or delim can be parsed and value(key) cannot
- * Key := ParserKey::Type
- * Value := ParserValue::Type
- * @return Parser<std::map<Key, Value>>
- */
-template <bool errorInTheMiddle = true
-        , size_t maxIteration = MAX_ITERATION
-        , ParserType ParserKey
-        , ParserType ParserValue
-        , ParserType ParserDelimiter>
-auto toMap(ParserKey tKey, ParserValue tValue, ParserDelimiter tDelimiter) noexcept {
-    using Key = GetParserResult<ParserKey>;
-    using Value = GetParserResult<ParserValue>;
-    using Map = std::map<Key, Value>;
-    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>>;
-    using P = Parser<Map, UCtx>;
-    return P::make([key = std::move(tKey), value = std::move(tValue), delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) {
-        Map out{};
+
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map,
+        ParserType ParserKey, ParserType ParserValue, ParserType ParserDelimiter, typename MakeMap>
+struct ToMapDelimiterFn {
+    template <typename Ctx>
+    ResultType<Map> operator()(Stream& stream, Ctx& ctx) const {
+        Map out = makeMap(ctx);
+        return fill(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Map& out) const {
+        out.clear();
+        return fill(stream, ctx, out);
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> fill(Stream& stream, Ctx& ctx, Map& out) const {
         size_t iteration = 0;
 
         auto backup = stream.pos();
@@ -84,29 +159,101 @@ auto toMap(ParserKey tKey, ParserValue tValue, ParserDelimiter tDelimiter) noexc
             if (!keyRes.isError()) {
                 auto valueRes = value.apply(stream, ctx);
                 if (!valueRes.isError()) {
-                    out.insert_or_assign(std::move(keyRes).data(), std::move(valueRes).data());
+                    Container::insert(out, std::move(keyRes).data(), std::move(valueRes).data());
                 } else {
                     if constexpr (errorInTheMiddle) {
-                        return P::makeError("Parse key but cannot parse value", stream.pos());
+                        return ResultType<Drop>{ParsingError{"Parse key but cannot parse value", stream.pos()}};
                     } else {
                         stream.restorePos(backup);
-                        return P::data(std::move(out));
+                        Container::finish(out);
+                        return ResultType<Drop>{Drop{}};
                     }
                 }
             } else {
                 stream.restorePos(backup);
-                return P::data(std::move(out));
+                Container::finish(out);
+                return ResultType<Drop>{Drop{}};
             }
 
             backup = stream.pos();
         } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
 
         if (iteration == maxIteration) {
-            return P::makeError("Max iteration", stream.pos());
+            return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
         } else {
             stream.restorePos(backup);
-            return P::data(std::move(out));
+            Container::finish(out);
+            return ResultType<Drop>{Drop{}};
         }
+    }
+
+    ParserKey key;
+    ParserValue value;
+    ParserDelimiter delimiter;
+    MakeMap makeMap;
+};
+
+
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map, typename UCtx,
+        ParserType ParserKey, ParserType ParserValue, typename MakeMap>
+auto toMapImpl(ParserKey key, ParserValue value, MakeMap makeMap) noexcept {
+    using Fn = ToMapFn<errorInTheMiddle, maxIteration, Container, Map, ParserKey, ParserValue, MakeMap>;
+    return Parser<Map, UCtx>::make(Fn{std::move(key), std::move(value), std::move(makeMap)});
+}
+
+
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map, typename UCtx,
+        ParserType ParserKey, ParserType ParserValue, ParserType ParserDelimiter, typename MakeMap>
+auto toMapImpl(ParserKey key, ParserValue value, ParserDelimiter delimiter, MakeMap makeMap) noexcept {
+    using Fn = ToMapDelimiterFn<errorInTheMiddle, maxIteration, Container, Map, ParserKey, ParserValue, ParserDelimiter, MakeMap>;
+    return Parser<Map, UCtx>::make(Fn{std::move(key), std::move(value), std::move(delimiter), std::move(makeMap)});
+}
+
+}
+
+/**
+ * @tparam errorInTheMiddle - fail parser if key can be parsed and value cannot
+ * @tparam Container - StdMapContainer, FlatMapContainer, HashMapContainer, PairVectorContainer or custom one
+ * Key := ParserKey::Type
+ * Value := ParserValue::Type
+ * @return Parser<Container::Type<Key, Value>>, std::map<Key, Value> by default
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , typename Container = StdMapContainer
+        , ParserType ParserKey
+        , ParserType ParserValue>
+auto toMap(ParserKey key, ParserValue value) noexcept {
+    using Key = GetParserResult<ParserKey>;
+    using Value = GetParserResult<ParserValue>;
+    using Map = typename Container::template Type<Key, Value>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, Container, Map, UCtx>(std::move(key), std::move(value), [](auto&) {
+        return Map{};
+    });
+}
+
+
+/**
+ * @tparam errorInTheMiddle - fail parser if key or delim can be parsed and value(key) cannot
+ * @tparam Container - StdMapContainer, FlatMapContainer, HashMapContainer, PairVectorContainer or custom one
+ * Key := ParserKey::Type
+ * Value := ParserValue::Type
+ * @return Parser<Container::Type<Key, Value>>, std::map<Key, Value> by default
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , typename Container = StdMapContainer
+        , ParserType ParserKey
+        , ParserType ParserValue
+        , ParserType ParserDelimiter>
+auto toMap(ParserKey tKey, ParserValue tValue, ParserDelimiter tDelimiter) noexcept {
+    using Key = GetParserResult<ParserKey>;
+    using Value = GetParserResult<ParserValue>;
+    using Map = typename Container::template Type<Key, Value>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, Container, Map, UCtx>(std::move(tKey), std::move(tValue), std::move(tDelimiter), [](auto&) {
+        return Map{};
     });
 }
 
@@ -2,32 +2,68 @@
 
 #include <parsecpp/core/parser.h>
 #include <parsecpp/common/string.h>
+#include <parsecpp/utils/numberParsing.h>
 
+#include <cerrno>
 #include <charconv>
 
 
 namespace prs {
 
-namespace {
+namespace details {
 
-template <typename Number, typename = std::void_t<>>
-constexpr bool hasFromCharsMethod = false;
+/**
+ * Superset of the first symbols accepted by from_chars (or strtod)
+ */
+template <typename Number, NumberFormat format = NumberFormat::General>
+constexpr FirstSet numberFirstSet() noexcept {
+    return FirstSet::fromPredicate([](char c) {
+        bool const isDigit = '0' <= c && c <= '9';
+        if constexpr (std::is_integral_v<Number>) {
+            return isDigit || (std::is_signed_v<Number> && c == '-');
+        } else if constexpr (format == NumberFormat::Json) {
+            return isDigit || c == '-';
+        } else if constexpr (hasFromChars<Number> || std::is_same_v<Number, float> || std::is_same_v<Number, double>) {
+            return isDigit || c == '-' || c == '.' || c == 'i' || c == 'I' || c == 'n' || c == 'N';
+        } else {
+            return isDigit || c == '-' || c == '+' || c == '.' || c == 'i' || c == 'I' || c == 'n' || c == 'N'
+                || c == ' ' || ('\t' <= c && c <= '\r');
+        }
+    });
+}
 
 template <typename Number>
-constexpr bool hasFromCharsMethod<Number, std::void_t<decltype(std::from_chars(nullptr, nullptr, std::declval<Number&>()))>> = true;
+constexpr bool hasBuiltinParsing = std::is_same_v<Number, float> || std::is_same_v<Number, double>
+    || (std::is_integral_v<Number> && !std::is_same_v<Number, bool>);
 
 }
 
 /**
+ * Integers, float and double are parsed by the built-in parser (the same result on every platform),
+ * other types by from_chars or strtod
+ * @tparam format - NumberFormat::Json accepts only JSON numbers
  * @return Parser<Number>
  */
-template <typename Number = double>
+template <typename Number = double, NumberFormat format = NumberFormat::General>
     requires (std::is_arithmetic_v<Number>)
 constexpr auto number() noexcept {
+    static_assert(format == NumberFormat::General || details::hasBuiltinParsing<Number>, "Json format requires the built-in parsing");
     return Parser<Number>::make([](Stream& s) {
         auto sv = s.sv();
         Number n{};
-        if constexpr (hasFromCharsMethod<Number>) {
+        if constexpr (details::hasBuiltinParsing<Number>) {
+            std::from_chars_result res;
+            if constexpr (std::is_floating_point_v<Number>) {
+                res = details::parseFloat<format>(sv.data(), sv.data() + sv.size(), n);
+            } else {
+                res = details::parseInteger<format>(sv.data(), sv.data() + sv.size(), n);
+            }
+            if (res.ec == std::errc{}) {
+                s.moveUnsafe(res.ptr - sv.data());
+                return Parser<Number>::data(n);
+            }
+            return Parser<Number>::makeError("Cannot parse number", s.pos());
+        } else if constexpr (details::hasFromChars<Number>) {
             if (auto res = std::from_chars(sv.data(), sv.data() + sv.size(), n);
                     res.ec == std::errc{}) {
                 s.moveUnsafe(res.ptr - sv.data());
@@ -37,21 +73,10 @@ constexpr auto number() noexcept {
                 return Parser<Number>::makeError("Cannot parse number", s.pos());
             }
         } else { // some system doesn't have from_chars for floating point numbers
-            if constexpr (std::is_same_v<Number, double>) {
-                char *end = const_cast<char*>(sv.end());
-                n = std::strtod(sv.data(), &end);
-                size_t endIndex = end - sv.data();
-                if (endIndex == 0) {
-                    return Parser<Number>::makeError("Cannot parse number", s.pos());
-                }
-                if (errno == ERANGE) {
-                    return Parser<Number>::makeError("Cannot parse number ERANGE", s.pos());
-                }
-                s.moveUnsafe(endIndex);
-                return Parser<Number>::data(n);
-            } else if (std::is_same_v<Number, float>) {
+            if constexpr (std::is_same_v<Number, long double>) {
                 char *end = const_cast<char*>(sv.end());
-                n = std::strtof(sv.data(), &end);
+                errno = 0;
+                n = std::strtold(sv.data(), &end);
                 size_t endIndex = end - sv.data();
                 if (endIndex == 0) {
                     return Parser<Number>::makeError("Cannot parse number", s.pos());
@@ -66,9 +91,69 @@ constexpr auto number() noexcept {
                 return Parser<Number>::makeError("Not supported", s.pos());
             }
         }
+    }).withFirstSet(details::numberFirstSet<Number, format>());
+}
+
+
+namespace details {
+
+template <std::integral Mantissa>
+constexpr FirstSet decimalFirstSet() noexcept {
+    return FirstSet::fromPredicate([](char c) {
+        return ('0' <= c && c <= '9') || (std::is_signed_v<Mantissa> && c == '-');
     });
 }
 
+}
+
+/**
+ * Exact decimal "-?digits(.digits)?" in one pass, without double
+ * @tparam maxScale - max number of fractional digits
+ * @return Parser<Decimal<Mantissa>>
+ */
+template <std::integral Mantissa = int64_t, size_t maxScale = 18>
+    requires (!std::is_same_v<Mantissa, bool>)
+constexpr auto decimal() noexcept {
+    using Result = Decimal<Mantissa>;
+    return Parser<Result>::make([](Stream& s) {
+        auto sv = s.sv();
+        Result n;
+        auto const res = details::parseDecimal(sv.data(), sv.data() + sv.size(), maxScale, n.mantissa, n.scale);
+        if (res.ec == std::errc{}) {
+            s.moveUnsafe(res.ptr - sv.data());
+            return Parser<Result>::data(n);
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            return Parser<Result>::makeError("Decimal overflow", s.pos());
+        }
+        return Parser<Result>::makeError("Cannot parse decimal", s.pos());
+    }).withFirstSet(details::decimalFirstSet<Mantissa>());
+}
+
+/**
+ * Fixed point decimal, "1.5" -> 150 for scale = 2
+ * @tparam scale - max number of fractional digits, the result is multiplied by 10^scale
+ * @return Parser<Mantissa>
+ */
+template <size_t scale, std::integral Mantissa = int64_t>
+    requires (!std::is_same_v<Mantissa, bool>)
+constexpr auto fixedPoint() noexcept {
+    return Parser<Mantissa>::make([](Stream& s) {
+        auto sv = s.sv();
+        Mantissa n{};
+        size_t parsedScale = 0;
+        auto const res = details::parseDecimal(sv.data(), sv.data() + sv.size(), scale, n, parsedScale);
+        if (res.ec == std::errc{} && details::scaleUp(n, scale - parsedScale)) {
+            s.moveUnsafe(res.ptr - sv.data());
+            return Parser<Mantissa>::data(n);
+        }
+        if (res.ec == std::errc::invalid_argument) {
+            return Parser<Mantissa>::makeError("Cannot parse decimal", s.pos());
+        }
+        return Parser<Mantissa>::makeError("Decimal overflow", s.pos());
+    }).withFirstSet(details::decimalFirstSet<Mantissa>());
+}
+
 
 /**
  *
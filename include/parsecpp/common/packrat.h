@@ -0,0 +1,208 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+#include <parsecpp/utils/flatMap.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace prs {
+
+namespace details {
+
+class PackratCacheBase {
+public:
+    virtual ~PackratCacheBase() = default;
+};
+
+/**
+ * Direct-mapped window of results of one packrat parser, the entry of a position evicts the entry of position ± window
+ */
+template <typename T>
+class PackratCache final : public PackratCacheBase {
+public:
+    struct Entry {
+        size_t pos = std::string_view::npos;
+        uint64_t generation = 0;
+        size_t end = 0;
+        std::optional<ResultType<T>> result;
+    };
+
+    explicit PackratCache(size_t window)
+        : m_entries(window) {
+
+    }
+
+    Entry& slot(size_t pos) noexcept {
+        return m_entries[pos & (m_entries.size() - 1)];
+    }
+private:
+    std::vector<Entry> m_entries;
+};
+
+
+inline size_t nextPackratId() noexcept {
+    static std::atomic<size_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Tag>
+size_t packratTagId() noexcept {
+    static size_t const id = nextPackratId();
+    return id;
+}
+
+}
+
+
+/**
+ * Cache of packrat parsers: (parser id, position) -> (result, end position).
+ * Every packrat parser keeps the last `window` positions (rounded up to a power of two),
+ * so memory is bounded by window * number of packrat parsers used with the table.
+ * The table is cleared in O(1) by reset() or when it's used with another input.
+ */
+class PackratTable {
+public:
+    static constexpr size_t DEFAULT_WINDOW = 1024;
+
+    explicit PackratTable(size_t window = DEFAULT_WINDOW)
+        : m_window(std::bit_ceil(std::max<size_t>(window, 1))) {
+
+    }
+
+    PackratTable(PackratTable const&) = delete;
+    PackratTable& operator=(PackratTable const&) = delete;
+
+    /**
+     * Forget all results, call it before parsing a new text in the same buffer
+     */
+    void reset() noexcept {
+        ++m_generation;
+        m_input = {};
+    }
+
+    size_t window() const noexcept {
+        return m_window;
+    }
+
+    size_t hits() const noexcept {
+        return m_hits;
+    }
+
+    size_t misses() const noexcept {
+        return m_misses;
+    }
+
+    /**
+     * Number of packrat parsers that have a cache in the table
+     */
+    size_t caches() const noexcept {
+        return m_caches.size();
+    }
+
+    template <typename T>
+    typename details::PackratCache<T>::Entry& entry(size_t id, Stream const& stream) {
+        if (auto const full = stream.full(); full.data() != m_input.data() || full.size() != m_input.size()) {
+            reset();
+            m_input = full;
+        }
+
+        // ids are global, the caches are keyed by them only for the parsers that used the table
+        auto it = m_caches.find(id);
+        if (it == m_caches.end()) {
+            m_caches.insert_or_assign(size_t{id}, std::make_unique<details::PackratCache<T>>(m_window));
+            it = m_caches.find(id);
+        }
+        return static_cast<details::PackratCache<T>&>(*it->second).slot(stream.pos());
+    }
+
+    template <typename Entry>
+    bool lookup(Entry const& entry, size_t pos) noexcept {
+        bool const hit = entry.pos == pos && entry.generation == m_generation;
+        ++(hit ? m_hits : m_misses);
+        return hit;
+    }
+
+    template <typename Entry, typename Result>
+    void store(Entry& entry, size_t pos, size_t end, Result const& result) {
+        entry.result.emplace(result);
+        entry.pos = pos;
+        entry.end = end;
+        entry.generation = m_generation;
+    }
+private:
+    size_t m_window;
+    uint64_t m_generation = 1;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    std::string_view m_input;
+    HashMap<size_t, std::unique_ptr<details::PackratCacheBase>> m_caches;
+};
+
+using PackratCtx = ContextWrapper<PackratTable&>;
+
+
+namespace details {
+
+template <ParserType P>
+auto packratImpl(P parser, size_t id) noexcept {
+    using T = GetParserResult<P>;
+    using R = Parser<T, UnionCtx<GetParserCtx<P>, PackratCtx>>;
+    auto const first = parser.firstSet();
+    auto out = R::make([parser = std::move(parser), id](Stream& stream, auto& ctx) {
+        auto& table = get<PackratTable>(ctx);
+        auto const pos = stream.pos();
+        auto& entry = table.template entry<T>(id, stream);
+        if (table.lookup(entry, pos)) {
+            stream.restorePos(entry.end);
+            return *entry.result;
+        }
+
+        auto result = parser.apply(stream, ctx);
+        // entry is stable, nested calls of the parser could only evict it
+        table.store(entry, pos, stream.pos(), result);
+        return result;
+    });
+
+    if constexpr (P::hasFirstSet) {
+        return out.withFirstSet(first);
+    } else {
+        return out;
+    }
+}
+
+}
+
+
+/**
+ * Memoize results of the parser by position in the PackratTable from the context,
+ * it makes backtracking of alternatives with common prefixes linear.
+ * The id of the parser is unique for every call, build the parser once (lazyCached).
+ * Side effects of the parser on the context aren't repeated for cached results.
+ * @def packrat :: Parser<A, Ctx> -> Parser<A, Ctx & PackratCtx>
+ */
+template <ParserType P>
+    requires(std::copy_constructible<GetParserResult<P>>)
+auto packrat(P parser) noexcept {
+    auto const id = details::nextPackratId();
+    return details::packratImpl(std::move(parser), id);
+}
+
+
+/**
+ * The id is unique for Tag, use it for the parsers that are rebuilt while parsing (lazy).
+ * Different parsers must have different tags.
+ */
+template <typename Tag, ParserType P>
+    requires(std::copy_constructible<GetParserResult<P>>)
+auto packrat(P parser) noexcept {
+    return details::packratImpl(std::move(parser), details::packratTagId<Tag>());
+}
+
+}
\ No newline at end of file
@@ -78,34 +78,45 @@ auto search(P tParser) noexcept {
 }
 
 
-template <typename Derived, typename Container, ContextType Ctx>
+/**
+ * CRTP base for repeat modifiers that accumulate results in place.
+ * Derived defines add(Container&, Value[, Ctx&]) and can override init([Ctx&]) to create the container, e.g. from ArenaCtx.
+ */
+template <typename Derived, typename ContainerT, ContextType CtxT>
 class Repeat {
 public:
+    using Container = ContainerT;
+    using Ctx = CtxT;
+
     Repeat() noexcept = default;
 
-    auto operator()(auto& parser, Stream& stream, Ctx& ctx) const {
-        using P = Parser<typename std::decay_t<decltype(parser)>::Type, Ctx>;
+    auto operator()(auto& parser, Stream& stream, auto& ctx) const {
+        using P = Parser<Container, Ctx>;
 
-        get().init();
+        decltype(auto) container = get().init(ctx);
         size_t iteration = 0;
-        auto backup = stream.pos();
         do {
-            backup = stream.pos();
+            auto backup = stream.pos();
             auto result = parser();
             if (!result.isError()) {
-                get().add(std::move(result).data(), ctx);
+                get().add(container, std::move(result).data(), ctx);
             } else {
                 stream.restorePos(backup);
-                return P::data(get().value());
+                return P::data(std::move(container));
             }
         } while (++iteration != MAX_ITERATION);
 
         return P::makeError("Max iteration", stream.pos());
     }
 
+protected:
+    Container init(auto& ctx) const noexcept {
+        return {};
+    }
+
 private:
-    Derived& get() noexcept {
-        return static_cast<Derived&>(*this);
+    Derived const& get() const noexcept {
+        return static_cast<Derived const&>(*this);
     }
 };
 
@@ -189,7 +200,7 @@ public:
             Stream localStream{t};
             return m_parser(localStream).flatMapError([&](details::ParsingError const& error) {
                 auto posOfError = stream.pos() - (localStream.full().size() - error.pos);
-                return P::PRS_MAKE_ERROR("Internal parser fail: " + error.description, posOfError);
+                return P::makeError(details::ParsingError::internalError(error, posOfError));
             });
         });
     }
@@ -201,7 +212,7 @@ public:
             Stream localStream{t};
             return m_parser(localStream, ctx).flatMapError([&](details::ParsingError const& error) {
                 auto posOfError = stream.pos() - (localStream.full().size() - error.pos);
-                return Parser<ParserResult>::PRS_MAKE_ERROR("Internal parser fail: " + error.description, posOfError);
+                return Parser<ParserResult>::makeError(details::ParsingError::internalError(error, posOfError));
             });
         });
     }
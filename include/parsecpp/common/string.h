@@ -2,9 +2,14 @@
 
 #include <parsecpp/core/parser.h>
 #include <parsecpp/core/lift.h>
+#include <parsecpp/core/textSearch.h>
 
 #include <parsecpp/utils/constexprString.hpp>
 
+#include <cstring>
+#include <string>
+#include <string_view>
+
 namespace prs {
 
 /**
@@ -26,18 +31,52 @@ inline auto anyChar() noexcept {
 }
 
 
+class FromRange {
+public:
+    constexpr FromRange(char begin, char end) noexcept
+        : m_begin(begin)
+        , m_end(end) {
+
+    }
+
+    friend constexpr bool operator==(FromRange const& range, char c) noexcept {
+        return range.m_begin <= c && c <= range.m_end;
+    }
+
+// no private to be structural and avoid next error:
+// 'prs::FromRange' is not a valid type for a template non-type parameter because it is not structural
+//private:
+    char m_begin;
+    char m_end;
+};
+
+
+struct AnySpace {
+    constexpr AnySpace() = default;
+
+    // std::isspace for the "C" locale, but constexpr
+    friend constexpr bool operator==(AnySpace const& range, char c) noexcept {
+        return c == ' ' || ('\t' <= c && c <= '\r');
+    }
+};
+
+
+template <typename T, typename U>
+concept LeftCmpWith = requires(const std::remove_reference_t<T>& t,
+        const std::remove_reference_t<U>& u) {
+    {t == u} -> std::convertible_to<bool>; // boolean-testable
+};
+
+
 /**
  *
  * @return Parser<Unit>
  */
 inline auto spaces() noexcept {
     return make_parser([](Stream& str) {
-        while (str.checkFirst([](char c) {
-            return std::isspace(c);
-        }));
-
+        str.takeWhile(details::charSetOf<AnySpace{}>);
         return prs::Parser<Unit>::data({});
-    });
+    }).withFirstSet(FirstSet::of(details::charSetOf<AnySpace{}>, true));
 }
 
 
@@ -47,10 +86,7 @@ inline auto spaces() noexcept {
  */
 inline auto spacesFast() noexcept {
     return make_parser([](Stream& str) {
-        while (str.checkFirst([](char c) {
-            return c == ' ';
-        }));
-
+        str.takeWhile(details::charSetOf<' '>);
         return prs::Parser<Unit>::data({});
     });
 }
@@ -71,7 +107,11 @@ constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArrayGen() {
 }
 
 template <bool allowDigit>
-static constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArray = lettersArrayGen<allowDigit>();
+inline constexpr CharSet lettersSet = CharSet{lettersArrayGen<allowDigit>()};
+
+constexpr FirstSet literalFirstSet(std::string_view str) noexcept {
+    return str.empty() ? FirstSet{}.maybe() : FirstSet::anyOf(str.front());
+}
 
 }
 
@@ -82,67 +122,21 @@ static constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArray = lett
 template <bool allowDigit = false, typename StringType = std::string_view>
 auto letters() noexcept {
     return make_parser([](Stream& str) {
-        auto start = str.pos();
-
-        while (str.checkFirst(details::lettersArray<allowDigit>));
-
-        auto end = str.pos();
-        if (start == end) {
+        auto word = str.takeWhile(details::lettersSet<allowDigit>);
+        if (word.empty()) {
             return Parser<StringType>::makeError("Empty word", str.pos());
         } else {
-            return Parser<StringType>::data(StringType{str.get_sv(start, end)});
+            return Parser<StringType>::data(StringType{word});
         }
-    });
+    }).withFirstSet(FirstSet::of(details::lettersSet<allowDigit>));
 }
 
 
-class FromRange {
-public:
-    constexpr FromRange(char begin, char end) noexcept
-        : m_begin(begin)
-        , m_end(end) {
-
-    }
-
-    friend constexpr bool operator==(FromRange const& range, char c) noexcept {
-        return range.m_begin <= c && c <= range.m_end;
-    }
-
-// no private to be structural and avoid next error:
-// 'prs::FromRange' is not a valid type for a template non-type parameter because it is not structural
-//private:
-    char m_begin;
-    char m_end;
-};
-
-
-struct AnySpace {
-    constexpr AnySpace() = default;
-
-    friend constexpr bool operator==(AnySpace const& range, char c) noexcept {
-        return std::isspace(c);
-    }
-};
-
-
-template <typename T, typename U>
-concept LeftCmpWith = requires(const std::remove_reference_t<T>& t,
-        const std::remove_reference_t<U>& u) {
-    {t == u} -> std::convertible_to<bool>; // boolean-testable
-};
-
-
 template <typename StringType = std::string_view, LeftCmpWith<char> ...Args>
 auto lettersFrom(Args ...args) noexcept {
     static_assert(sizeof...(args) > 0);
-    return make_parser([args...](Stream& str) {
-        auto start = str.pos();
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
-
-        auto end = str.pos();
-        return Parser<StringType>::data(StringType{str.get_sv(start, end)});
+    return make_parser([set = CharSet::anyOf(args...)](Stream& str) {
+        return Parser<StringType>::data(StringType{str.takeWhile(set)});
     });
 }
 
@@ -152,13 +146,7 @@ constexpr auto lettersFrom() noexcept {
     static_assert(sizeof...(args) > 0);
     using T = std::string_view;
     return make_parser([](Stream& str) {
-        auto start = str.pos();
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
-
-        auto end = str.pos();
-        return Parser<T>::data(str.get_sv(start, end));
+        return Parser<T>::data(str.takeWhile(details::charSetOf<args...>));
     });
 }
 
@@ -166,11 +154,8 @@ constexpr auto lettersFrom() noexcept {
 template <LeftCmpWith<char> ...Args>
 auto skipChars(Args ...args) noexcept {
     static_assert(sizeof...(args) > 0);
-    return make_parser([args...](Stream& str) {
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
-
+    return make_parser([set = CharSet::anyOf(args...)](Stream& str) {
+        str.takeWhile(set);
         return Parser<Drop>::data({});
     });
 }
@@ -180,10 +165,7 @@ template <auto ...args>
 auto skipChars() noexcept {
     static_assert(sizeof...(args) > 0);
     return make_parser([](Stream& str) {
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
-
+        str.takeWhile(details::charSetOf<args...>);
         return Parser<Drop>::data({});
     });
 }
@@ -191,18 +173,20 @@ auto skipChars() noexcept {
 
 template <bool forwardSearch = false>
 auto searchText(std::string const& searchPattern) noexcept {
-    return Parser<Unit>::make([searchPattern](Stream& stream) {
+    // errors can outlive the parser, so they get their own text of the pattern
+    return Parser<Unit>::make([pattern = searchPattern, text = details::keepErrorText(searchPattern)](Stream& stream) {
+        std::string_view const patternView = pattern;
         auto &str = stream.sv();
-        if (auto pos = str.find(searchPattern); pos != std::string_view::npos) {
+        if (auto pos = details::findText(str, patternView); pos != std::string_view::npos) {
             if constexpr (forwardSearch) {
                 stream.move(pos);
                 return Parser<Unit>::data({});
             } else {
-                str = str.substr(pos + searchPattern.size());
+                str = str.substr(pos + patternView.size());
                 return Parser<Unit>::data({});
             }
         } else {
-            return Parser<Unit>::PRS_MAKE_ERROR("Cannot find '" + std::string(searchPattern) + "'", stream.pos());
+            return Parser<Unit>::makeError(details::ParsingError::quoted("Cannot find", text, stream.pos()));
         }
     });
 }
@@ -212,7 +196,7 @@ template <ConstexprString searchPattern, bool forwardSearch = false>
 auto searchText() noexcept {
     return Parser<Unit>::make([](Stream& stream) {
         auto &str = stream.sv();
-        if (auto pos = str.find(searchPattern.sv()); pos != std::string_view::npos) {
+        if (auto pos = details::findText<searchPattern.size()>(str, searchPattern.sv()); pos != std::string_view::npos) {
             if constexpr (forwardSearch) {
                 stream.move(pos);
                 return Parser<Unit>::data({});
@@ -221,7 +205,7 @@ auto searchText() noexcept {
                 return Parser<Unit>::data({});
             }
         } else {
-            return Parser<Unit>::PRS_MAKE_ERROR("Cannot find '" + searchPattern.toString() + "'", stream.pos());
+            return Parser<Unit>::makeError(details::ParsingError::quoted("Cannot find", details::StaticText::fromStatic(searchPattern.c_str()), stream.pos()));
         }
     });
 }
@@ -229,17 +213,19 @@ auto searchText() noexcept {
 
 template <LeftCmpWith<char> ...Args>
 constexpr auto charFrom(Args ...chars) noexcept {
-    return satisfy([=](char c) {
+    auto test = [=](char c) {
         return details::cmpAnyOf(c, chars...);
-    });
+    };
+    return satisfy(test).withFirstSet(FirstSet::fromPredicate(test));
 }
 
 
 template <auto ...chars>
 constexpr auto charFrom() noexcept {
-    return satisfy([](char c) {
+    auto test = [](char c) {
         return details::cmpAnyOf(c, chars...);
-    });
+    };
+    return satisfy(test).withFirstSet(FirstSet::fromPredicate(test));
 }
 
 
@@ -252,23 +238,18 @@ auto charFromSpaces(Args ...chars) noexcept {
 template <typename StringType = std::string_view>
 auto between(char borderLeft, char borderRight) noexcept {
     using P = Parser<StringType>;
-    return P::make([borderLeft, borderRight](Stream& stream) {
+    return P::make([borderLeft, borderRight, set = CharSet::anyOf(borderRight).inverse()](Stream& stream) {
         if (stream.checkFirst(borderLeft) == 0) {
             return P::makeError("No leftBorder", stream.pos());
         }
 
-        auto start = stream.pos();
-        while (stream.checkFirst([borderRight](char c) {
-            return c != borderRight;
-        }));
-
-        auto ans = stream.full().substr(start, stream.pos() - start);
+        auto ans = stream.takeWhile(set);
         if (stream.checkFirst(borderRight) == 0) {
             return P::makeError("No rightBorder", stream.pos());
         }
 
         return P::data(StringType{ans});
-    });
+    }).withFirstSet(FirstSet::anyOf(borderLeft));
 }
 
 
@@ -314,14 +295,8 @@ auto until(Fn fn) noexcept {
 
 template <typename StringType = std::string_view, typename ...Args>
 auto until(Args ...args) noexcept {
-    return Parser<StringType>::make([args...](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !((args == c) || ...);
-        }));
-
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
+    return Parser<StringType>::make([set = CharSet::anyOf(args...).inverse()](Stream& stream) {
+        return Parser<StringType>::data(StringType{stream.takeWhile(set)});
     });
 }
 
@@ -330,13 +305,7 @@ template <auto ...args>
 auto until() noexcept {
     using StringType = std::string_view;
     return Parser<StringType>::make([](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !((args == c) || ...);
-        }));
-
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
+        return Parser<StringType>::data(StringType{stream.takeWhile(details::charSetNotOf<args...>)});
     });
 }
 
@@ -375,89 +344,251 @@ auto between(char border, Parser parser) noexcept {
 }
 
 
-template <typename StringType = std::string_view>
-auto literal(std::string str) noexcept {
-    return Parser<StringType>::make([str](Stream& s) {
+namespace details {
+
+/**
+ * Literal known at runtime, adjacent literals and chars are fused by `>>` and `<<`
+ */
+template <typename StringType>
+struct LiteralFn {
+    std::string str;
+
+    ResultType<StringType> operator()(Stream& s) const {
         if (s.sv().starts_with(str)) {
             s.moveUnsafe(str.size());
             return Parser<StringType>::data(StringType{str});
         } else {
             return Parser<StringType>::makeError("Cannot find literal", s.pos());
         }
-    });
-}
+    }
+
+    size_t width() const noexcept {
+        return str.size();
+    }
+
+    bool matchAt(char const* p) const noexcept {
+        return str.empty() || std::memcmp(p, str.data(), str.size()) == 0;
+    }
+
+    StringType valueAt(char const*) const {
+        return StringType{str};
+    }
+};
 
 template <ConstexprString str>
-auto literal() noexcept {
-    using StringType = std::string_view;
-    return Parser<StringType>::make([](Stream& s) {
+struct ConstLiteralFn {
+    ResultType<std::string_view> operator()(Stream& s) const {
         if (s.sv().starts_with(str.sv())) {
             s.moveUnsafe(str.size());
-            return Parser<StringType>::data(str.sv());
+            return Parser<std::string_view>::data(str.sv());
         } else {
-            return Parser<StringType>::makeError("Cannot find literal", s.pos());
+            return Parser<std::string_view>::makeError("Cannot find literal", s.pos());
         }
-    });
+    }
+
+    static constexpr size_t width() noexcept {
+        return str.size();
+    }
+
+    // the size is a constant, so the comparison is inlined to word compares
+    static bool matchAt(char const* p) noexcept {
+        return str.size() == 0 || std::memcmp(p, str.c_str(), str.size()) == 0;
+    }
+
+    static constexpr std::string_view valueAt(char const*) noexcept {
+        return str.sv();
+    }
+};
+
 }
 
 
-template <char endSymbol, char escapingSymbol = '\\'>
-auto escapedString() noexcept {
-    if constexpr (endSymbol != escapingSymbol) {
-        return Parser<std::string>::make([](Stream& s) {
-            bool isEscaped = false;
-            const auto sv = s.sv();
-            std::string out;
-            for (size_t i = 0; i != sv.size(); ++i) {
-                switch (sv[i]) {
-                    case escapingSymbol: {
-                        if (std::exchange(isEscaped, !isEscaped)) {
-                            out.push_back(escapingSymbol);
-                        }
-                        break;
-                    }
-                    case endSymbol: {
-                        if (isEscaped) {
-                            isEscaped = false;
-                            out.push_back(endSymbol);
-                        } else {
-                            s.moveUnsafe(i + 1);
-                            return Parser<std::string>::data(std::move(out));
-                        }
-                        break;
-                    }
-                    default: out.push_back(sv[i]);
-                }
-            }
+template <typename StringType = std::string_view>
+auto literal(std::string str) noexcept {
+    auto const first = details::literalFirstSet(str);
+    return Parser<StringType>::make(details::LiteralFn<StringType>{std::move(str)}).withFirstSet(first);
+}
 
-            return Parser<std::string>::makeError("Cannot find end symbol", s.pos());
-        });
-    } else {
-        return Parser<std::string>::make([](Stream& s) {
-            bool isEscaped = false;
-            const auto sv = s.sv();
-            std::string out;
-            for (size_t i = 0; i != sv.size(); ++i) {
-                if (sv[i] == endSymbol) {
-                    if (isEscaped) {
-                        isEscaped = false;
-                        out.push_back(endSymbol);
-                    } else {
-                        if (i + 1 != sv.size() && sv[i + 1] == endSymbol) {
-                            isEscaped = true;
-                        } else {
-                            s.moveUnsafe(i + 1);
-                            return Parser<std::string>::data(std::move(out));
-                        }
-                    }
-                } else {
-                    out.push_back(sv[i]);
+template <ConstexprString str>
+auto literal() noexcept {
+    return Parser<std::string_view>::make(details::ConstLiteralFn<str>{}).withFirstSet(details::literalFirstSet(str.sv()));
+}
+
+
+namespace details {
+
+/**
+ * Unescape string from the position `from`, there is no escaped symbol before `from`
+ * @return position of endSymbol or npos
+ */
+template <char endSymbol, char escapingSymbol>
+size_t unescapeString(std::string_view sv, size_t from, std::string& out) {
+    static constexpr auto specialSymbols = CharSet::anyOf(endSymbol, escapingSymbol).inverse();
+
+    bool isEscaped = false;
+    size_t i = from;
+    while (true) {
+        auto const plain = specialSymbols.prefixLength(sv.substr(i));
+        out.append(sv.data() + i, plain);
+        i += plain;
+        if (i == sv.size()) {
+            return std::string_view::npos;
+        }
+
+        if constexpr (endSymbol != escapingSymbol) {
+            if (sv[i] == escapingSymbol) {
+                if (std::exchange(isEscaped, !isEscaped)) {
+                    out.push_back(escapingSymbol);
                 }
+            } else if (isEscaped) {
+                isEscaped = false;
+                out.push_back(endSymbol);
+            } else {
+                return i;
+            }
+        } else {
+            if (isEscaped) {
+                isEscaped = false;
+                out.push_back(endSymbol);
+            } else if (i + 1 != sv.size() && sv[i + 1] == endSymbol) {
+                isEscaped = true;
+            } else {
+                return i;
             }
+        }
+        ++i;
+    }
+}
+
+}
 
-            return Parser<std::string>::makeError("Cannot find end symbol", s.pos());
+
+namespace details {
+
+template <char endSymbol, char escapingSymbol>
+struct EscapedStringFn {
+    ResultType<std::string> operator()(Stream& s) const {
+        std::string out;
+        return unescape(s, out).map([&out](Drop) {
+            return std::move(out);
         });
     }
+
+    /**
+     * Reuses the capacity of the caller's string
+     */
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& s, Ctx&, std::string& out) const {
+        out.clear();
+        return unescape(s, out);
+    }
+
+    static ResultType<Drop> unescape(Stream& s, std::string& out) {
+        if (auto end = unescapeString<endSymbol, escapingSymbol>(s.sv(), 0, out);
+                end != std::string_view::npos) {
+            s.moveUnsafe(end + 1);
+            return ResultType<Drop>{Drop{}};
+        } else {
+            return ResultType<Drop>{ParsingError{"Cannot find end symbol", s.pos()}};
+        }
+    }
+};
+
+}
+
+
+template <char endSymbol, char escapingSymbol = '\\'>
+auto escapedString() noexcept {
+    return Parser<std::string>::make(details::EscapedStringFn<endSymbol, escapingSymbol>{});
+}
+
+
+/**
+ * String that refers to the source if it's possible and owns memory otherwise
+ */
+class MaybeOwnedString {
+public:
+    MaybeOwnedString() noexcept = default;
+
+    explicit MaybeOwnedString(std::string_view view) noexcept
+        : m_view(view) {
+
+    }
+
+    explicit MaybeOwnedString(char const* view) noexcept
+        : m_view(view) {
+
+    }
+
+    explicit MaybeOwnedString(std::string owned) noexcept
+        : m_owned(std::move(owned))
+        , m_isOwned(true) {
+
+    }
+
+    std::string_view sv() const noexcept {
+        return m_isOwned ? std::string_view{m_owned} : m_view;
+    }
+
+    operator std::string_view() const noexcept {
+        return sv();
+    }
+
+    bool isOwned() const noexcept {
+        return m_isOwned;
+    }
+
+    std::string toString() const {
+        return std::string{sv()};
+    }
+
+    friend bool operator==(MaybeOwnedString const& lhs, MaybeOwnedString const& rhs) noexcept {
+        return lhs.sv() == rhs.sv();
+    }
+
+    friend bool operator==(MaybeOwnedString const& lhs, std::string_view rhs) noexcept {
+        return lhs.sv() == rhs;
+    }
+private:
+    std::string_view m_view;
+    std::string m_owned;
+    bool m_isOwned = false;
+};
+
+
+/**
+ * The same as escapedString, but doesn't allocate memory if the string doesn't contain escaped symbols
+ * @return Parser<MaybeOwnedString>
+ */
+template <char endSymbol, char escapingSymbol = '\\'>
+auto escapedStringView() noexcept {
+    using P = Parser<MaybeOwnedString>;
+    return P::make([](Stream& s) {
+        static constexpr auto specialSymbols = CharSet::anyOf(endSymbol, escapingSymbol).inverse();
+
+        auto const sv = s.sv();
+        auto const plain = specialSymbols.prefixLength(sv);
+        if (plain == sv.size()) {
+            return P::makeError("Cannot find end symbol", s.pos());
+        }
+
+        bool const isEnd = endSymbol != escapingSymbol
+                ? sv[plain] == endSymbol
+                : plain + 1 == sv.size() || sv[plain + 1] != endSymbol;
+        if (isEnd) {
+            s.moveUnsafe(plain + 1);
+            return P::data(MaybeOwnedString{sv.substr(0, plain)});
+        }
+
+        std::string out{sv.substr(0, plain)};
+        if (auto end = details::unescapeString<endSymbol, escapingSymbol>(sv, plain, out);
+                end != std::string_view::npos) {
+            s.moveUnsafe(end + 1);
+            return P::data(MaybeOwnedString{std::move(out)});
+        } else {
+            return P::makeError("Cannot find end symbol", s.pos());
+        }
+    });
 }
 
 }
\ No newline at end of file
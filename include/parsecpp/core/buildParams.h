@@ -12,6 +12,24 @@ static constexpr bool DISABLE_ERROR_LOG = true;
 #define PRS_MAKE_ERROR(strError, pos) makeError(pos);
 #endif
 
+#ifndef PRS_LAZY_ERROR_LOG
+static constexpr bool LAZY_ERROR_LOG = false;
+#else
+static constexpr bool LAZY_ERROR_LOG = true;
+#endif
+
+#ifndef PRS_COMPACT_ERROR
+static constexpr bool COMPACT_ERROR = false;
+#else
+static constexpr bool COMPACT_ERROR = true;
+#endif
+
+#ifndef PRS_DISABLE_SIMD
+static constexpr bool DISABLE_SIMD = false;
+#else
+static constexpr bool DISABLE_SIMD = true;
+#endif
+
 static constexpr size_t MAX_ITERATION = 1'000'000;
 
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <parsecpp/core/buildParams.h>
+#include <parsecpp/core/simd.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+/**
+ * Set of bytes known before parsing.
+ * Stores 256-entry table for the scalar path and a short list of byte ranges for the vectorized one.
+ * If the set cannot be described by MAX_SIMD_RANGES ranges, only the scalar path is used.
+ */
+class CharSet {
+public:
+    static constexpr size_t CHAR_MAPPING_SIZE = 256;
+    static constexpr size_t MAX_SIMD_RANGES = 8;
+
+    struct Range {
+        unsigned char begin = 0;
+        unsigned char end = 0;
+    };
+
+    using Table = std::array<bool, CHAR_MAPPING_SIZE>;
+
+    constexpr CharSet() noexcept = default;
+
+    constexpr explicit CharSet(Table const& table) noexcept
+        : m_table(table) {
+        buildRanges();
+    }
+
+    /**
+     * @param test :: char -> bool, will be called for all 256 symbols once
+     */
+    template <typename Fn>
+    static constexpr CharSet fromPredicate(Fn const& test) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
+        Table table{};
+        for (size_t i = 0; i != CHAR_MAPPING_SIZE; ++i) {
+            table[i] = test(static_cast<char>(i));
+        }
+        return CharSet{table};
+    }
+
+    template <typename ...Args>
+    static constexpr CharSet anyOf(Args const& ...args) noexcept {
+        return fromPredicate([&](char c) {
+            return ((args == c) || ...);
+        });
+    }
+
+    constexpr CharSet inverse() const noexcept {
+        Table table{};
+        for (size_t i = 0; i != CHAR_MAPPING_SIZE; ++i) {
+            table[i] = !m_table[i];
+        }
+        return CharSet{table};
+    }
+
+    constexpr bool contains(char c) const noexcept {
+        return m_table[static_cast<unsigned char>(c)];
+    }
+
+    constexpr bool hasSimdRanges() const noexcept {
+        return m_rangesCount != NO_SIMD;
+    }
+
+    /**
+     * @return number of the first symbols of str that are in the set
+     */
+    size_t prefixLength(std::string_view str) const noexcept {
+        char const* begin = str.data();
+        char const* end = begin + str.size();
+        size_t i = 0;
+        if constexpr (!DISABLE_SIMD) {
+            if (hasSimdRanges()) {
+                i = prefixLengthSimd(begin, end);
+            }
+        }
+        return i + prefixLengthScalar(begin + i, end);
+    }
+
+    size_t prefixLengthScalar(char const* begin, char const* end) const noexcept {
+        char const* it = begin;
+        while (it != end && contains(*it)) {
+            ++it;
+        }
+        return it - begin;
+    }
+
+    /**
+     * @return length of processed full blocks, the tail should be checked by the scalar path
+     */
+    size_t prefixLengthSimd(char const* begin, char const* end) const noexcept {
+        size_t i = 0;
+        [[maybe_unused]] size_t const size = end - begin;
+#ifdef PRS_SIMD_AVX2
+        for (; i + 32 <= size; i += 32) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(begin + i));
+            __m256i inSet = _mm256_setzero_si256();
+            for (size_t r = 0; r != m_rangesCount; ++r) {
+                __m256i const shifted = _mm256_sub_epi8(block, _mm256_set1_epi8(static_cast<char>(m_ranges[r].begin)));
+                __m256i const width = _mm256_set1_epi8(static_cast<char>(m_ranges[r].end - m_ranges[r].begin));
+                inSet = _mm256_or_si256(inSet, _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, width), shifted));
+            }
+            auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(inSet));
+            if (mask != 0xFFFFFFFFu) {
+                return i + std::countr_one(mask);
+            }
+        }
+#endif
+#ifdef PRS_SIMD_SSE2
+        for (; i + 16 <= size; i += 16) {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin + i));
+            __m128i inSet = _mm_setzero_si128();
+            for (size_t r = 0; r != m_rangesCount; ++r) {
+                __m128i const shifted = _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(m_ranges[r].begin)));
+                __m128i const width = _mm_set1_epi8(static_cast<char>(m_ranges[r].end - m_ranges[r].begin));
+                inSet = _mm_or_si128(inSet, _mm_cmpeq_epi8(_mm_min_epu8(shifted, width), shifted));
+            }
+            auto const mask = static_cast<uint32_t>(_mm_movemask_epi8(inSet));
+            if (mask != 0xFFFFu) {
+                return i + std::countr_one(mask);
+            }
+        }
+#endif
+        return i;
+    }
+
+    constexpr Table const& table() const noexcept {
+        return m_table;
+    }
+private:
+    static constexpr size_t NO_SIMD = MAX_SIMD_RANGES + 1;
+
+    constexpr void buildRanges() noexcept {
+        m_rangesCount = 0;
+        size_t i = 0;
+        while (i != CHAR_MAPPING_SIZE) {
+            if (!m_table[i]) {
+                ++i;
+                continue;
+            }
+
+            size_t j = i;
+            while (j + 1 != CHAR_MAPPING_SIZE && m_table[j + 1]) {
+                ++j;
+            }
+
+            if (m_rangesCount == MAX_SIMD_RANGES) {
+                m_rangesCount = NO_SIMD;
+                return;
+            }
+            m_ranges[m_rangesCount++] = Range{static_cast<unsigned char>(i), static_cast<unsigned char>(j)};
+            i = j + 1;
+        }
+    }
+
+    Table m_table{};
+    std::array<Range, MAX_SIMD_RANGES> m_ranges{};
+    size_t m_rangesCount = 0;
+};
+
+
+namespace details {
+
+template <auto ...args>
+inline const CharSet charSetOf = CharSet::anyOf(args...);
+
+template <auto ...args>
+inline const CharSet charSetNotOf = CharSet::anyOf(args...).inverse();
+
+}
+
+}
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace prs {
@@ -304,7 +305,8 @@ decltype(auto) get(Ctx& ctx) noexcept {
         return ctx.get();
     } else {
         using TypeWrapper = details::GetTypeWrapper<Ctx, T>;
-        return static_cast<ContextWrapper<TypeWrapper>>(ctx).get();
+        using Base = std::conditional_t<std::is_const_v<Ctx>, ContextWrapper<TypeWrapper> const&, ContextWrapper<TypeWrapper>&>;
+        return static_cast<Base>(ctx).get();
     }
 }
 
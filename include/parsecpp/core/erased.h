@@ -0,0 +1,121 @@
+#pragma once
+
+#include <parsecpp/core/baseTypes.h>
+#include <parsecpp/core/context.h>
+#include <parsecpp/core/stream.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+static constexpr size_t ERASED_PARSER_SIZE = 256;
+
+namespace details {
+
+/**
+ * Move-only type erased parser with inline storage, never allocates memory.
+ * The stored parser is called by a plain function pointer.
+ */
+template <typename T, ContextType Ctx, size_t inlineSize = ERASED_PARSER_SIZE>
+class ErasedFn {
+public:
+    using Invoke = ResultType<T> (*)(void const*, Stream&, Ctx&);
+
+    template <typename P>
+        requires(!std::is_same_v<std::decay_t<P>, ErasedFn>)
+    explicit ErasedFn(P&& parser) noexcept(std::is_nothrow_constructible_v<std::decay_t<P>, P>) {
+        using Stored = std::decay_t<P>;
+        static_assert(sizeof(Stored) <= inlineSize, "Parser doesn't fit the inline storage, increase the size of ErasedParser");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t));
+        static_assert(std::is_nothrow_move_constructible_v<Stored>);
+
+        new (&m_storage) Stored(std::forward<P>(parser));
+        m_invoke = [](void const* p, Stream& stream, Ctx& ctx) -> ResultType<T> {
+            return static_cast<Stored const*>(p)->apply(stream, ctx);
+        };
+        m_manage = [](void* to, void* from) noexcept {
+            if (from != nullptr) {
+                new (to) Stored(std::move(*static_cast<Stored*>(from)));
+            } else {
+                std::destroy_at(static_cast<Stored*>(to));
+            }
+        };
+    }
+
+    ErasedFn(ErasedFn&& other) noexcept
+        : m_invoke(other.m_invoke)
+        , m_manage(other.m_manage) {
+        m_manage(&m_storage, &other.m_storage);
+    }
+
+    ErasedFn(ErasedFn const&) = delete;
+    ErasedFn& operator=(ErasedFn const&) = delete;
+    ErasedFn& operator=(ErasedFn&&) = delete;
+
+    ~ErasedFn() {
+        m_manage(&m_storage, nullptr);
+    }
+
+    ResultType<T> operator()(Stream& stream) const requires(IsVoidCtx<Ctx>) {
+        return m_invoke(&m_storage, stream, VOID_CONTEXT);
+    }
+
+    ResultType<T> operator()(Stream& stream, Ctx& ctx) const {
+        return m_invoke(&m_storage, stream, ctx);
+    }
+private:
+    alignas(std::max_align_t) std::byte m_storage[inlineSize];
+    Invoke m_invoke;
+    void (*m_manage)(void*, void*) noexcept;
+};
+
+
+/**
+ * Non-owning type erased parser: a pointer to the parser and a function pointer.
+ */
+template <typename T, ContextType Ctx>
+class ParserRefFn {
+public:
+    using Invoke = ResultType<T> (*)(void const*, Stream&, Ctx&);
+
+    template <typename P>
+        requires(!std::is_same_v<std::decay_t<P>, ParserRefFn>)
+    explicit ParserRefFn(P const& parser) noexcept
+        : m_parser(std::addressof(parser))
+        , m_invoke([](void const* p, Stream& stream, Ctx& ctx) -> ResultType<T> {
+            return static_cast<P const*>(p)->apply(stream, ctx);
+        }) {
+
+    }
+
+    ResultType<T> operator()(Stream& stream) const requires(IsVoidCtx<Ctx>) {
+        return m_invoke(m_parser, stream, VOID_CONTEXT);
+    }
+
+    ResultType<T> operator()(Stream& stream, Ctx& ctx) const {
+        return m_invoke(m_parser, stream, ctx);
+    }
+private:
+    void const* m_parser;
+    Invoke m_invoke;
+};
+
+}
+
+/**
+ * Move-only parser for recursive grammars without std::function, see Parser::toErased
+ */
+template <typename T, ContextType Ctx = VoidContext, size_t inlineSize = ERASED_PARSER_SIZE>
+using ErasedParser = Parser<T, Ctx, details::ErasedFn<T, Ctx, inlineSize>>;
+
+/**
+ * Copyable reference to a parser, see Parser::ref
+ */
+template <typename T, ContextType Ctx = VoidContext>
+using ParserRef = Parser<T, Ctx, details::ParserRefFn<T, Ctx>>;
+
+}
\ No newline at end of file
@@ -2,50 +2,44 @@
 
 #include <parsecpp/utils/funcHelper.h>
 
+#include <concepts>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <cassert>
 
 
 namespace prs {
 
-template <typename T, typename Error>
-    requires(!std::same_as<std::decay_t<T>, std::decay_t<Error>>)
-class Expected {
-public:
-    using Body = T;
-
-    template<typename OnSuccess, typename OnError = details::Id>
-    static constexpr bool map_nothrow = std::is_nothrow_invocable_v<OnSuccess, T const&>
-                    && std::is_nothrow_invocable_v<OnError, Error const&>;
-
-    template<typename OnSuccess, typename OnError = details::Id>
-    static constexpr bool map_move_nothrow = std::is_nothrow_invocable_v<OnSuccess, T>
-                    && std::is_nothrow_invocable_v<OnError, Error>;
-
-    constexpr explicit Expected(T &&t) noexcept(std::is_nothrow_move_constructible_v<T>)
-        : m_isError(false)
-        , m_data(std::move(t)) {
-
-    }
+namespace details {
 
+/**
+ * Error type with a state that is never a real error, Expected<Empty, Error> stores only the error
+ */
+template <typename Error>
+concept NicheError = requires(Error const& error) {
+    { Error::niche() } -> std::same_as<Error>;
+    { error.isNiche() } -> std::convertible_to<bool>;
+};
 
-    constexpr explicit Expected(T const& t) noexcept(std::is_nothrow_copy_constructible_v<T>)
+template <typename T, typename Error>
+class ExpectedStorage {
+public:
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<0>, U&& t) noexcept(std::is_nothrow_constructible_v<T, U&&>)
         : m_isError(false)
-        , m_data(t) {
+        , m_data(std::forward<U>(t)) {
 
     }
 
-    constexpr explicit Expected(Error &&error) noexcept(std::is_nothrow_move_constructible_v<Error>)
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<1>, U&& error) noexcept(std::is_nothrow_constructible_v<Error, U&&>)
         : m_isError(true)
-        , m_error(std::move(error)) {
-    }
+        , m_error(std::forward<U>(error)) {
 
-    constexpr explicit Expected(Error const& error) noexcept(std::is_nothrow_copy_constructible_v<Error>)
-        : m_isError(true)
-        , m_error(error) {
     }
 
-    constexpr Expected(Expected<T, Error> const& e) noexcept
+    constexpr ExpectedStorage(ExpectedStorage const& e) noexcept
         : m_isError(e.m_isError) {
 
         if (isError()) {
@@ -55,7 +49,17 @@ public:
         }
     }
 
-    ~Expected() noexcept {
+    constexpr ExpectedStorage(ExpectedStorage&& e) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<Error>)
+        : m_isError(e.m_isError) {
+
+        if (isError()) {
+            new (&m_error)Error(std::move(e.m_error));
+        } else {
+            new (&m_data)T(std::move(e.m_data));
+        }
+    }
+
+    ~ExpectedStorage() noexcept {
         if (isError()) {
             std::destroy_at(&m_error);
         } else {
@@ -67,24 +71,130 @@ public:
         return m_isError;
     }
 
+    constexpr T& storedData() noexcept {
+        return m_data;
+    }
+
+    constexpr T const& storedData() const noexcept {
+        return m_data;
+    }
+
+    constexpr Error& storedError() noexcept {
+        return m_error;
+    }
+
+    constexpr Error const& storedError() const noexcept {
+        return m_error;
+    }
+private:
+    bool m_isError;
+
+    union {
+        T m_data;
+        Error m_error;
+    };
+};
+
+/**
+ * Empty T: the niche of the error is the success
+ */
+template <typename T, NicheError Error>
+    requires(std::is_empty_v<T>)
+class ExpectedStorage<T, Error> {
+public:
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<0>, U&& t) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+        : m_data(std::forward<U>(t))
+        , m_error(Error::niche()) {
+
+    }
+
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<1>, U&& error) noexcept(std::is_nothrow_constructible_v<Error, U&&>)
+        : m_error(std::forward<U>(error)) {
+
+    }
+
+    constexpr bool isError() const noexcept {
+        return !m_error.isNiche();
+    }
+
+    constexpr T& storedData() noexcept {
+        return m_data;
+    }
+
+    constexpr T const& storedData() const noexcept {
+        return m_data;
+    }
+
+    constexpr Error& storedError() noexcept {
+        return m_error;
+    }
+
+    constexpr Error const& storedError() const noexcept {
+        return m_error;
+    }
+private:
+    [[no_unique_address]] T m_data;
+    Error m_error;
+};
+
+}
+
+template <typename T, typename Error>
+    requires(!std::same_as<std::decay_t<T>, std::decay_t<Error>>)
+class Expected : private details::ExpectedStorage<T, Error> {
+    using Storage = details::ExpectedStorage<T, Error>;
+public:
+    using Storage::isError;
+
+    using Body = T;
+
+    template<typename OnSuccess, typename OnError = details::Id>
+    static constexpr bool map_nothrow = std::is_nothrow_invocable_v<OnSuccess, T const&>
+                    && std::is_nothrow_invocable_v<OnError, Error const&>;
+
+    template<typename OnSuccess, typename OnError = details::Id>
+    static constexpr bool map_move_nothrow = std::is_nothrow_invocable_v<OnSuccess, T>
+                    && std::is_nothrow_invocable_v<OnError, Error>;
+
+    constexpr explicit Expected(T &&t) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : Storage(std::in_place_index<0>, std::move(t)) {
+
+    }
+
+
+    constexpr explicit Expected(T const& t) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : Storage(std::in_place_index<0>, t) {
+
+    }
+
+    constexpr explicit Expected(Error &&error) noexcept(std::is_nothrow_move_constructible_v<Error>)
+        : Storage(std::in_place_index<1>, std::move(error)) {
+    }
+
+    constexpr explicit Expected(Error const& error) noexcept(std::is_nothrow_copy_constructible_v<Error>)
+        : Storage(std::in_place_index<1>, error) {
+    }
+
     T const& data() const& noexcept {
         assert(!isError());
-        return m_data;
+        return storedData();
     }
 
     T data() && noexcept {
         assert(!isError());
-        return std::move(m_data);
+        return std::move(storedData());
     }
 
     Error const& error() const& noexcept {
         assert(isError());
-        return m_error;
+        return storedError();
     }
 
     Error error() && noexcept {
         assert(isError());
-        return std::move(m_error);
+        return std::move(storedError());
     }
 
 
@@ -95,18 +205,18 @@ public:
 //        using Result = std::common_type_t<std::invoke_result_t<OnSuccess, const T&>,
 //                    std::invoke_result_t<OnError, const Error&>>;
 
-        return isError() ? onError(m_error) : onSuccess(m_data);
+        return isError() ? onError(storedError()) : onSuccess(storedData());
     }
 
 
     template<std::invocable<T> OnSuccess, std::invocable<Error> OnError>
     auto join(OnSuccess onSuccess, OnError onError) &&
-                    noexcept(map_nothrow<OnSuccess, OnError>) {
+                    noexcept(map_move_nothrow<OnSuccess, OnError>) {
 
 //        using Result = std::common_type_t<std::invoke_result_t<OnSuccess, const T&>,
 //                    std::invoke_result_t<OnError, const Error&>>;
 
-        return isError() ? onError(std::move(m_error)) : onSuccess(std::move(m_data));
+        return isError() ? onError(std::move(storedError())) : onSuccess(std::move(storedData()));
     }
 
     template<std::invocable<const T&> OnSuccess>
@@ -114,7 +224,7 @@ public:
                     noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::decay_t<std::invoke_result_t<OnSuccess, const T&>>;
-        return isError() ? Expected<Result, Error>{m_error} : Expected<Result, Error>{onSuccess(m_data)};
+        return isError() ? Expected<Result, Error>{storedError()} : Expected<Result, Error>{onSuccess(storedData())};
     }
 
 
@@ -123,72 +233,68 @@ public:
                     noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::decay_t<std::invoke_result_t<OnSuccess, T&&>>;
-        return isError() ? Expected<Result, Error>{std::move(m_error)}
-                : Expected<Result, Error>{onSuccess(std::move(m_data))};
+        return isError() ? Expected<Result, Error>{std::move(storedError())}
+                : Expected<Result, Error>{onSuccess(std::move(storedData()))};
     }
 
     template<std::invocable<const T&> OnSuccess, std::invocable<Error const&> OnError>
     auto map(OnSuccess onSuccess, OnError onError) const& noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T const&>;
-        return isError() ? Expected<Result, Error>{onError(m_error)}
-                : Expected<Result, Error>{onSuccess(m_data)};
+        return isError() ? Expected<Result, Error>{onError(storedError())}
+                : Expected<Result, Error>{onSuccess(storedData())};
     }
 
     template<std::invocable<T> OnSuccess, std::invocable<Error> OnError>
     auto map(OnSuccess onSuccess, OnError onError) && noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T>;
-        return isError() ? Expected<Result, Error>{onError(std::move(m_error))}
-                : Expected<Result, Error>{onSuccess(std::move(m_data))};
+        return isError() ? Expected<Result, Error>{onError(std::move(storedError()))}
+                : Expected<Result, Error>{onSuccess(std::move(storedData()))};
     }
 
     template<std::invocable<T const&> OnSuccess>
     auto flatMap(OnSuccess onSuccess) const& noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T const&>;
-        return isError() ? Result{m_error} : onSuccess(m_data);
+        return isError() ? Result{storedError()} : onSuccess(storedData());
     }
 
     template<std::invocable<T&&> OnSuccess>
-    auto flatMap(OnSuccess onSuccess) && noexcept(map_nothrow<OnSuccess>) {
+    auto flatMap(OnSuccess onSuccess) && noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T>;
-        return isError() ? Result{std::move(m_error)} : onSuccess(std::move(m_data));
+        return isError() ? Result{std::move(storedError())} : onSuccess(std::move(storedData()));
     }
 
 
     template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
     auto flatMap(OnSuccess onSuccess, OnError onError) const& noexcept(map_nothrow<OnSuccess, OnError>) {
 
-        return isError() ? onError(m_error) : onSuccess(m_data);
+        return isError() ? onError(storedError()) : onSuccess(storedData());
     }
 
 
-    template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
-    auto flatMap(OnSuccess onSuccess, OnError onError) && noexcept(map_nothrow<OnSuccess, OnError>) {
+    template<std::invocable<T&&> OnSuccess, std::invocable<Error&&> OnError>
+    auto flatMap(OnSuccess onSuccess, OnError onError) && noexcept(map_move_nothrow<OnSuccess, OnError>) {
 
-        return isError() ? onError(std::move(m_error)) : onSuccess(std::move(m_data));
+        return isError() ? onError(std::move(storedError())) : onSuccess(std::move(storedData()));
     }
 
     template<std::invocable<Error const&> OnError>
     auto flatMapError(OnError onError) const& noexcept(map_nothrow<details::Id, OnError>) {
         using Result = std::invoke_result_t<OnError, Error const&>;
-        return isError() ? onError(m_error) : Result{m_data};
+        return isError() ? onError(storedError()) : Result{storedData()};
     }
 
     template<std::invocable<Error> OnError>
-    auto flatMapError(OnError onError) && noexcept(map_nothrow<details::Id, OnError>) {
+    auto flatMapError(OnError onError) && noexcept(map_move_nothrow<details::Id, OnError>) {
         using Result = std::invoke_result_t<OnError, Error>;
-        return isError() ? onError(std::move(m_error)) : Result{std::move(m_data)};
+        return isError() ? onError(std::move(storedError())) : Result{std::move(storedData())};
     }
 private:
-    bool m_isError;
-
-    union {
-        T m_data;
-        Error m_error;
-    };
+    using Storage::storedData;
+    using Storage::storedError;
 };
 
 
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <parsecpp/core/charSet.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+/**
+ * Bytes that can start a successful parse (LL(1) first set).
+ * nullable - the parser can succeed without consuming, so it is viable for any next byte and for the end of stream.
+ * The default set is empty, any() is used for parsers without the analysis.
+ */
+class FirstSet {
+public:
+    constexpr FirstSet() noexcept = default;
+
+    static constexpr FirstSet any() noexcept {
+        FirstSet out;
+        out.m_bits.fill(~uint64_t{0});
+        out.m_nullable = true;
+        return out;
+    }
+
+    /**
+     * @param test :: char -> bool, will be called for all 256 symbols once
+     */
+    template <typename Fn>
+    static constexpr FirstSet fromPredicate(Fn const& test, bool nullable = false) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
+        FirstSet out;
+        for (size_t i = 0; i != CharSet::CHAR_MAPPING_SIZE; ++i) {
+            if (test(static_cast<char>(i))) {
+                out.m_bits[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+        out.m_nullable = nullable;
+        return out;
+    }
+
+    static constexpr FirstSet of(CharSet const& set, bool nullable = false) noexcept {
+        return fromPredicate([&set](char c) {
+            return set.contains(c);
+        }, nullable);
+    }
+
+    template <typename ...Args>
+    static constexpr FirstSet anyOf(Args const& ...args) noexcept {
+        return fromPredicate([&](char c) {
+            return ((args == c) || ...);
+        });
+    }
+
+    constexpr bool contains(char c) const noexcept {
+        auto const i = static_cast<unsigned char>(c);
+        return (m_bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    constexpr bool nullable() const noexcept {
+        return m_nullable;
+    }
+
+    /**
+     * Can the parser succeed if the next byte is c
+     */
+    constexpr bool viable(char c) const noexcept {
+        return m_nullable || contains(c);
+    }
+
+    /**
+     * @def `|` of parsers
+     */
+    constexpr FirstSet operator|(FirstSet const& rhs) const noexcept {
+        FirstSet out;
+        for (size_t i = 0; i != m_bits.size(); ++i) {
+            out.m_bits[i] = m_bits[i] | rhs.m_bits[i];
+        }
+        out.m_nullable = m_nullable || rhs.m_nullable;
+        return out;
+    }
+
+    /**
+     * @def `>>` of parsers
+     */
+    constexpr FirstSet then(FirstSet const& next) const noexcept {
+        if (!m_nullable) {
+            return *this;
+        }
+        FirstSet out = *this | next;
+        out.m_nullable = next.m_nullable;
+        return out;
+    }
+
+    constexpr FirstSet maybe() const noexcept {
+        FirstSet out = *this;
+        out.m_nullable = true;
+        return out;
+    }
+
+    constexpr bool operator==(FirstSet const&) const noexcept = default;
+private:
+    std::array<uint64_t, CharSet::CHAR_MAPPING_SIZE / 64> m_bits{};
+    bool m_nullable = false;
+};
+
+
+namespace details {
+
+/**
+ * Parser function with the known first set
+ */
+template <typename Fn>
+struct WithFirstSet {
+    Fn fn;
+    FirstSet first;
+
+    template <typename ...Args>
+        requires(std::is_invocable_v<Fn const&, Args...>)
+    constexpr decltype(auto) operator()(Args&& ...args) const noexcept(std::is_nothrow_invocable_v<Fn const&, Args...>) {
+        return std::invoke(fn, std::forward<Args>(args)...);
+    }
+};
+
+template <typename Fn>
+constexpr inline bool IsWithFirstSet = false;
+
+template <typename Fn>
+constexpr inline bool IsWithFirstSet<WithFirstSet<Fn>> = true;
+
+}
+
+}
\ No newline at end of file
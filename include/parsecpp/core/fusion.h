@@ -0,0 +1,182 @@
+#pragma once
+
+#include <parsecpp/core/expected.h>
+#include <parsecpp/core/firstSet.h>
+#include <parsecpp/core/parsingError.h>
+#include <parsecpp/core/stream.h>
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace prs::details {
+
+/**
+ * Parser function that matches a fixed number of bytes without side effects,
+ * so a sequence of them can be checked with one bounds check.
+ * matchAt and valueAt are called only if width() bytes are available.
+ */
+template <typename F>
+concept FusablePrimitive = requires(F const& f, Stream& stream, char const* p) {
+    { f.width() } -> std::convertible_to<size_t>;
+    { f.matchAt(p) } -> std::convertible_to<bool>;
+    f.valueAt(p);
+    { f(stream) } -> std::same_as<ResultType<std::decay_t<decltype(f.valueAt(p))>>>;
+};
+
+
+/**
+ * Sequence of primitives that is matched at once, the result is the value of the part resultIndex.
+ * The parts are run one by one only to reproduce the error of the sequence.
+ */
+template <size_t resultIndex, FusablePrimitive ...Parts>
+class FusedFn {
+    using Parts_ = std::tuple<Parts...>;
+public:
+    static constexpr size_t RESULT_INDEX = resultIndex;
+    using Result = std::decay_t<decltype(std::declval<std::tuple_element_t<resultIndex, Parts_> const&>().valueAt(nullptr))>;
+
+    constexpr explicit FusedFn(Parts_ parts) noexcept(std::is_nothrow_move_constructible_v<Parts_>)
+        : m_parts(std::move(parts)) {
+
+    }
+
+    constexpr Parts_ const& parts() const noexcept {
+        return m_parts;
+    }
+
+    constexpr size_t width() const noexcept {
+        return std::apply([](auto const& ...parts) {
+            return (size_t{0} + ... + parts.width());
+        }, m_parts);
+    }
+
+    constexpr bool matchAt(char const* p) const noexcept(noexcept(matchFrom<0>(p))) {
+        return matchFrom<0>(p);
+    }
+
+    constexpr Result valueAt(char const* p) const {
+        return std::get<resultIndex>(m_parts).valueAt(p + offsetOf<resultIndex>());
+    }
+
+    ResultType<Result> operator()(Stream& stream) const noexcept((std::is_nothrow_invocable_v<Parts const&, Stream&> && ...)) {
+        auto const sv = stream.sv();
+        if (auto const n = width(); sv.size() >= n && matchAt(sv.data())) {
+            auto out = valueAt(sv.data());
+            stream.moveUnsafe(n);
+            return ResultType<Result>{std::move(out)};
+        }
+        return sequential(stream);
+    }
+private:
+    template <size_t I>
+    constexpr bool matchFrom(char const* p) const {
+        if constexpr (I == sizeof...(Parts)) {
+            return true;
+        } else {
+            auto const& part = std::get<I>(m_parts);
+            return part.matchAt(p) && matchFrom<I + 1>(p + part.width());
+        }
+    }
+
+    template <size_t I>
+    constexpr size_t offsetOf() const noexcept {
+        if constexpr (I == 0) {
+            return 0;
+        } else {
+            return offsetOf<I - 1>() + std::get<I - 1>(m_parts).width();
+        }
+    }
+
+    ResultType<Result> sequential(Stream& stream) const {
+        auto const start = stream.pos();
+        std::optional<ParsingError> error;
+        auto step = [&](auto const& part) {
+            auto result = part(stream);
+            if (result.isError()) {
+                error.emplace(std::move(result).error());
+                return false;
+            }
+            return true;
+        };
+        std::apply([&](auto const& ...parts) {
+            (step(parts) && ...);
+        }, m_parts);
+
+        if (error) {
+            return ResultType<Result>{std::move(*error)};
+        }
+        return ResultType<Result>{valueAt(stream.full().data() + start)};
+    }
+
+    Parts_ m_parts;
+};
+
+
+template <typename F>
+constexpr inline bool IsFused = false;
+
+template <size_t resultIndex, typename ...Parts>
+constexpr inline bool IsFused<FusedFn<resultIndex, Parts...>> = true;
+
+
+template <typename Fn>
+constexpr Fn const& unwrapFirstSet(Fn const& fn) noexcept {
+    return fn;
+}
+
+template <typename Fn>
+constexpr Fn const& unwrapFirstSet(WithFirstSet<Fn> const& fn) noexcept {
+    return fn.fn;
+}
+
+template <typename Fn>
+using UnwrapFirstSet = std::decay_t<decltype(unwrapFirstSet(std::declval<Fn const&>()))>;
+
+template <typename LhsFn, typename RhsFn>
+concept Fusable = FusablePrimitive<UnwrapFirstSet<LhsFn>> && FusablePrimitive<UnwrapFirstSet<RhsFn>>;
+
+
+template <FusablePrimitive F>
+constexpr auto fusionParts(F const& f) {
+    if constexpr (IsFused<F>) {
+        return f.parts();
+    } else {
+        return std::tuple<F>{f};
+    }
+}
+
+template <FusablePrimitive F>
+constexpr size_t fusionResultIndex() noexcept {
+    if constexpr (IsFused<F>) {
+        return F::RESULT_INDEX;
+    } else {
+        return 0;
+    }
+}
+
+template <size_t resultIndex, typename ...Parts>
+constexpr auto makeFused(std::tuple<Parts...> parts) {
+    return FusedFn<resultIndex, Parts...>{std::move(parts)};
+}
+
+/**
+ * Flat sequence of the primitives of lhs and rhs
+ * @param keepLeft - the result of lhs (`<<`) or rhs (`>>`)
+ */
+template <bool keepLeft, typename LhsFn, typename RhsFn>
+    requires(Fusable<LhsFn, RhsFn>)
+constexpr auto fuse(LhsFn const& lhsFn, RhsFn const& rhsFn) {
+    using L = UnwrapFirstSet<LhsFn>;
+    using R = UnwrapFirstSet<RhsFn>;
+    auto lhs = fusionParts(unwrapFirstSet(lhsFn));
+    constexpr size_t index = keepLeft
+            ? fusionResultIndex<L>()
+            : std::tuple_size_v<decltype(lhs)> + fusionResultIndex<R>();
+    return makeFused<index>(std::tuple_cat(std::move(lhs), fusionParts(unwrapFirstSet(rhsFn))));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <parsecpp/core/baseTypes.h>
+#include <parsecpp/core/stream.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace prs::details {
+
+/**
+ * Parser function that can refill the caller's object instead of creating a new one
+ */
+template <typename Fn, typename Out, typename Ctx>
+concept HasInto = requires(Fn const& fn, Stream& stream, Ctx& ctx, Out& out) {
+    { fn.into(stream, ctx, out) } -> std::same_as<ResultType<Drop>>;
+};
+
+
+/**
+ * Drop the items after `size` keeping the capacity and the kept items
+ */
+template <typename Out>
+void truncate(Out& out, size_t size) noexcept {
+    while (out.size() > size) {
+        out.pop_back();
+    }
+}
+
+
+/**
+ * Trivial items aren't reused, they are parsed by value and appended
+ */
+template <typename Out>
+void clearTrivial(Out& out) noexcept {
+    if constexpr (std::is_trivially_copyable_v<typename Out::value_type>) {
+        out.clear();
+    }
+}
+
+
+/**
+ * `>>` and `<<` of not fusable parsers, the kept side is parsed into the caller's object by into
+ */
+template <bool keepLeft, typename Lhs, typename Rhs>
+struct SequenceFn {
+    static constexpr bool nothrow = Lhs::nothrow && Rhs::nothrow;
+
+    template <typename Ctx>
+    auto operator()(Stream& stream, Ctx& ctx) const noexcept(nothrow) {
+        if constexpr (keepLeft) {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx](auto&& body) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx).map([&body](auto const& _) {
+                    return std::move(body);
+                });
+            });
+        } else {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx](auto const& body) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx);
+            });
+        }
+    }
+
+    template <typename Ctx, typename Out>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(nothrow) {
+        if constexpr (keepLeft) {
+            return lhs.parseInto(stream, ctx, out).flatMap([this, &stream, &ctx](Drop) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx).map([](auto const& _) {
+                    return Drop{};
+                });
+            });
+        } else {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx, &out](auto const& body) noexcept(Rhs::nothrow) {
+                return rhs.parseInto(stream, ctx, out);
+            });
+        }
+    }
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+
+/**
+ * Loop of repeat, the items of the caller's container are reused by into
+ * @tparam Capacity - FixedCapacity or AdaptiveCapacity
+ */
+template <typename Out, size_t maxIteration, typename Capacity, typename Value>
+struct RepeatFn {
+    template <typename Ctx>
+    ResultType<Out> operator()(Stream& stream, Ctx& ctx) const noexcept(Value::nothrow) {
+        Out out{};
+        return into(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(Value::nothrow) {
+        clearTrivial(out);
+        out.reserve(capacity.hint());
+
+        size_t iteration = 0;
+
+        auto backup = stream.pos();
+        do {
+            backup = stream.pos();
+            if (!parseItem(value, stream, ctx, out, iteration)) {
+                stream.restorePos(backup);
+                truncate(out, iteration);
+                capacity.record(iteration);
+                return ResultType<Drop>{Drop{}};
+            }
+        } while (++iteration != maxIteration);
+
+        return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+    }
+
+    /**
+     * Parse the item `i` into the old one if it exists and owns memory
+     */
+    template <typename Parser, typename Ctx>
+    static bool parseItem(Parser const& parser, Stream& stream, Ctx& ctx, Out& out, size_t i) {
+        using Item = decltype(out[i]);
+        if constexpr (std::is_lvalue_reference_v<Item> && !std::is_trivially_copyable_v<std::remove_reference_t<Item>>) {
+            if (i < out.size()) {
+                return !parser.parseInto(stream, ctx, out[i]).isError();
+            }
+        }
+
+        auto result = parser.apply(stream, ctx);
+        if (result.isError()) {
+            return false;
+        }
+        out.emplace_back(std::move(result).data());
+        return true;
+    }
+
+    Value value;
+    [[no_unique_address]] Capacity capacity;
+};
+
+
+template <typename Out, size_t maxIteration, typename Capacity, typename Value, typename Delimiter>
+struct RepeatDelimiterFn {
+    static constexpr bool nothrow = Value::nothrow && Delimiter::nothrow;
+
+    template <typename Ctx>
+    ResultType<Out> operator()(Stream& stream, Ctx& ctx) const noexcept(nothrow) {
+        Out out{};
+        return into(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(nothrow) {
+        clearTrivial(out);
+        out.reserve(capacity.hint());
+
+        size_t iteration = 0;
+
+        auto backup = stream.pos();
+        do {
+            if (!RepeatFn<Out, maxIteration, Capacity, Value>::parseItem(value, stream, ctx, out, iteration)) {
+                truncate(out, iteration);
+                capacity.record(iteration);
+                return ResultType<Drop>{Drop{}};
+            }
+
+            backup = stream.pos();
+        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+
+        if (iteration == maxIteration) {
+            return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+        } else {
+            stream.restorePos(backup);
+            truncate(out, iteration + 1);
+            capacity.record(iteration + 1);
+            return ResultType<Drop>{Drop{}};
+        }
+    }
+
+    Value value;
+    Delimiter delimiter;
+    [[no_unique_address]] Capacity capacity;
+};
+
+}
\ No newline at end of file
@@ -55,7 +55,7 @@ public:
         }
     }
 
-    auto operator()(Stream& stream) const {
+    auto operator()(Stream& stream) const requires(nocontext) {
         return (*cachedParser)(stream);
     }
 
@@ -79,12 +79,12 @@ struct AutoTag {
 
 template <typename Tag, std::invocable Fn>
 auto lazyCached(Fn const& genParser) noexcept(std::is_nothrow_invocable_v<Fn>) {
-    return make_parser(LazyCached<Tag, Fn>{genParser});
+    return make_parser<GetParserCtx<std::invoke_result_t<Fn>>>(LazyCached<Tag, Fn>{genParser});
 }
 
 template <typename Tag, std::invocable Fn>
 auto lazyCached(Fn const& genParser, Tag tag) noexcept(std::is_nothrow_invocable_v<Fn>) {
-    return make_parser(LazyCached<Tag, Fn>{genParser});
+    return make_parser<GetParserCtx<std::invoke_result_t<Fn>>>(LazyCached<Tag, Fn>{genParser});
 }
 
 
@@ -172,17 +172,26 @@ public:
     using P = Parser<T, Ctx>;
     using ParserResult = T;
 
+    /**
+     * Pointer to the bound parser of any type (common, erased) and its invoker
+     */
     struct LazyContext {
-        explicit LazyContext(void const*const p) : parser(p) {};
+        template <typename Fn>
+        explicit LazyContext(Parser<T, Ctx, Fn> const* p) noexcept
+            : parser(p)
+            , invoke([](void const* bound, Stream& stream, Ctx& ctx) -> details::ResultType<T> {
+                return static_cast<Parser<T, Ctx, Fn> const*>(bound)->apply(stream, ctx);
+            }) {}
         void const*const parser;
+        details::ResultType<T> (*const invoke)(void const*, Stream&, Ctx&);
     };
 
     explicit LazyCtxBinding() noexcept = default;
 
     template <ContextType Context>
     details::ResultType<ParserResult> operator()(Stream& stream, Context& ctx) const {
-        auto const*const parser = reinterpret_cast<P const*const>(get<LazyContext>(ctx).parser);
-        return parser->apply(stream, ctx);
+        auto const& binding = get<LazyContext>(ctx);
+        return binding.invoke(binding.parser, stream, ctx);
     }
 };
 
@@ -225,9 +234,9 @@ auto lazyCtxBindingCtx(Tag = Tag{}) noexcept {
     return lazyCtxBindingCtx<T, Ctx, Tag>();
 }
 
-template <typename T, ContextType Ctx, typename Tag = LazyBindingTag>
+template <typename T, ContextType Ctx, typename Tag = LazyBindingTag, typename Fn>
 requires (sizeCtx<Ctx> == 1)
-auto makeBindingCtx(Parser<T, Ctx> const& parser) noexcept {
+auto makeBindingCtx(Parser<T, Ctx, Fn> const& parser) noexcept {
     using LazyCtx = typename LazyCtxBinding<T, VoidContext, Tag>::LazyContext;
     return LazyCtx{std::addressof(parser)};
 }
@@ -22,11 +22,11 @@ auto liftRec(Fn const& fn, Stream& stream, TupleParser const& parsers, Values &&
     constexpr size_t Ind = sizeof...(values);
     if constexpr (std::tuple_size_v<TupleParser> == Ind) {
         using ReturnType = std::invoke_result_t<Fn, Values...>;
-        return Parser<ReturnType>::data(std::invoke(fn, values...));
+        return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)...));
     } else {
         return std::get<Ind>(parsers).apply(stream).flatMap([&](auto &&a) {
             return liftRec(
-                    fn, stream, parsers, std::forward<Values>(values)..., a);
+                    fn, stream, parsers, std::forward<Values>(values)..., std::forward<decltype(a)>(a));
         });
     }
 }
@@ -38,14 +38,14 @@ auto liftRecCtx(Fn const& fn, Stream& stream, Ctx& ctx, TupleParser const& parse
     if constexpr (std::tuple_size_v<TupleParser> == Ind) {
         using ReturnType = std::invoke_result_t<Fn, Values...>;
         if constexpr (std::is_invocable_v<Fn, Values...>) {
-            return Parser<ReturnType>::data(std::invoke(fn, values...));
+            return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)...));
         } else {
-            return Parser<ReturnType>::data(std::invoke(fn, values..., ctx));
+            return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)..., ctx));
         }
     } else {
         return std::get<Ind>(parsers).apply(stream, ctx).flatMap([&](auto &&a) {
             return liftRecCtx(
-                    fn, stream, ctx, parsers, std::forward<Values>(values)..., a);
+                    fn, stream, ctx, parsers, std::forward<Values>(values)..., std::forward<decltype(a)>(a));
         });
     }
 }
@@ -79,12 +79,16 @@ auto concat(Args &&...args) noexcept {
     return liftM(details::MakeTuple{}, std::forward<Args>(args)...);
 }
 
-/*
- * satisfy :: (char -> bool) -> Parser<char>
+namespace details {
+
+/**
+ * One byte that satisfies the test, adjacent ones are fused by `>>` and `<<`
  */
 template <typename Fn>
-constexpr auto satisfy(Fn&& tTest) noexcept {
-    return Parser<char>::make([test = std::forward<Fn>(tTest)](Stream& stream) {
+struct SatisfyFn {
+    Fn test;
+
+    ResultType<char> operator()(Stream& stream) const {
         if (stream.eos()) {
             return Parser<char>::PRS_MAKE_ERROR("satisfy eos", stream.pos());
         }
@@ -95,7 +99,29 @@ constexpr auto satisfy(Fn&& tTest) noexcept {
         } else {
             return Parser<char>::PRS_MAKE_ERROR("satisfy eq", stream.pos());
         }
-    });
+    }
+
+    static constexpr size_t width() noexcept {
+        return 1;
+    }
+
+    constexpr bool matchAt(char const* p) const {
+        return test(*p);
+    }
+
+    static constexpr char valueAt(char const* p) noexcept {
+        return *p;
+    }
+};
+
+}
+
+/*
+ * satisfy :: (char -> bool) -> Parser<char>
+ */
+template <typename Fn>
+constexpr auto satisfy(Fn&& tTest) noexcept {
+    return Parser<char>::make(details::SatisfyFn<std::decay_t<Fn>>{std::forward<Fn>(tTest)});
 }
 
 }
\ No newline at end of file
@@ -83,7 +83,7 @@ auto operator*(ParserA parserA, Modify modifier) noexcept {
 template <ParserType ParserA, typename Modify>
     requires(!ParserA::nocontext)
 auto operator*(ParserA parserA, Modify modifier) noexcept {
-    using Ctx = GetParserCtx<ParserA>;
+    using Ctx = UnionCtx<GetParserCtx<ParserA>, GetContextTrait<Modify>>;
     return make_parser<Ctx>(
             [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
         ModifyCallerCtx p{parser, stream, ctx};
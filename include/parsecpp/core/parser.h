@@ -3,12 +3,19 @@
 #include <parsecpp/core/expected.h>
 #include <parsecpp/utils/funcHelper.h>
 #include <parsecpp/utils/sourceLocation.h>
+#include <parsecpp/utils/smallVector.h>
+#include <parsecpp/utils/capacityHint.h>
 #include <parsecpp/core/parsingError.h>
 #include <parsecpp/core/baseTypes.h>
 #include <parsecpp/core/concept.h>
 #include <parsecpp/core/context.h>
+#include <parsecpp/core/erased.h>
+#include <parsecpp/core/firstSet.h>
+#include <parsecpp/core/fusion.h>
+#include <parsecpp/core/into.h>
 #include <parsecpp/core/stream.h>
 
+#include <algorithm>
 #include <concepts>
 #include <string_view>
 #include <functional>
@@ -28,6 +35,7 @@ public:
                     std::is_nothrow_invocable<Func, Stream&, CtxType&>>::value;
 
     using StoredFn = std::decay_t<Func>;
+    static constexpr bool hasFirstSet = details::IsWithFirstSet<StoredFn>;
 
     using Type = T;
     using Ctx = CtxType;
@@ -76,23 +84,76 @@ public:
     }
 
 
+    /**
+     * Parse into the caller's object, repeat, toMap and escapedString clear and refill it keeping the capacity.
+     * Other parsers assign the result.
+     */
+    details::ResultType<Drop> parseInto(Stream& stream, T& out) const noexcept(nothrow) requires(nocontext) {
+        return parseInto(stream, VOID_CONTEXT, out);
+    }
+
+    template <typename Context>
+    details::ResultType<Drop> parseInto(Stream& stream, Context& ctx, T& out) const noexcept(nothrow) {
+        if constexpr (details::HasInto<details::UnwrapFirstSet<StoredFn>, T, Context>) {
+            return details::unwrapFirstSet(m_fn).into(stream, ctx, out);
+        } else {
+            return apply(stream, ctx).map([&out](T&& t) {
+                out = std::move(t);
+                return Drop{};
+            });
+        }
+    }
+
+
     template <typename ...Args>
         requires(std::is_constructible_v<Ctx, Args...>)
     static Ctx makeCtx(Args&& ...args) noexcept(std::is_nothrow_constructible_v<Ctx, Args...>) {
         return Ctx{std::forward<Args>(args)...};
     }
 
+    /**
+     * @return bytes that can start a successful parse, FirstSet::any() if they are unknown
+     */
+    constexpr FirstSet firstSet() const noexcept {
+        if constexpr (hasFirstSet) {
+            return m_fn.first;
+        } else {
+            return FirstSet::any();
+        }
+    }
+
+    /**
+     * The stored parser function, adjacent primitive parsers are fused by it
+     */
+    constexpr StoredFn const& fn() const noexcept {
+        return m_fn;
+    }
+
+    /**
+     * The same parser with the declared first set, e.g. for `lazy` parsers in `choice`
+     */
+    constexpr auto withFirstSet(FirstSet first) const noexcept {
+        if constexpr (hasFirstSet) {
+            return Parser<T, Ctx, StoredFn>(StoredFn{m_fn.fn, first});
+        } else {
+            using Fn = details::WithFirstSet<StoredFn>;
+            return Parser<T, Ctx, Fn>(Fn{m_fn, first});
+        }
+    }
+
     /**
      * @def `>>` :: Parser<A> -> Parser<B> -> Parser<B>
      */
     template <typename B, typename CtxB, typename Rhs>
         requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        return Parser<B, VoidContext>::make([lhs = *this, rhs](Stream& stream) noexcept(nothrow && Parser<B, CtxB, Rhs>::nothrow) {
-            return lhs.apply(stream).flatMap([&rhs, &stream](T const& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream);
-            });
-        });
+        auto const first = firstSet().then(rhs.firstSet());
+        if constexpr (details::Fusable<StoredFn, typename Parser<B, CtxB, Rhs>::StoredFn>) {
+            return keepFirstSet<hasFirstSet>(Parser<B>::make(details::fuse<false>(m_fn, rhs.fn())), first);
+        } else {
+            using Fn = details::SequenceFn<false, Parser, Parser<B, CtxB, Rhs>>;
+            return keepFirstSet<hasFirstSet>(Parser<B>::make(Fn{*this, rhs}), first);
+        }
     }
 
 
@@ -102,11 +163,9 @@ public:
     template <typename B, typename CtxB, typename Rhs>
         requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        return Parser<B, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) noexcept(nothrow && Parser<B, CtxB, Rhs>::nothrow) {
-            return lhs.apply(stream, ctx).flatMap([&rhs, &stream, &ctx](T const& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream, ctx);
-            });
-        });
+        auto const first = firstSet().then(rhs.firstSet());
+        using Fn = details::SequenceFn<false, Parser, Parser<B, CtxB, Rhs>>;
+        return keepFirstSet<hasFirstSet>(Parser<B, UnionCtx<Ctx, CtxB>>::make(Fn{*this, rhs}), first);
     }
 
 
@@ -116,14 +175,13 @@ public:
     template <typename B, typename CtxB, typename Rhs>
         requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        constexpr bool firstCallNoexcept = nothrow && Parser<B, CtxB, Rhs>::nothrow;
-        return Parser<T>::make([lhs = *this, rhs](Stream& stream) noexcept(firstCallNoexcept) {
-            return lhs.apply(stream).flatMap([&rhs, &stream](T&& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream).map([mvBody = std::move(body)](auto const& _) {
-                    return mvBody;
-                });
-            });
-        });
+        auto const first = firstSet().then(rhs.firstSet());
+        if constexpr (details::Fusable<StoredFn, typename Parser<B, CtxB, Rhs>::StoredFn>) {
+            return keepFirstSet<hasFirstSet>(Parser<T>::make(details::fuse<true>(m_fn, rhs.fn())), first);
+        } else {
+            using Fn = details::SequenceFn<true, Parser, Parser<B, CtxB, Rhs>>;
+            return keepFirstSet<hasFirstSet>(Parser<T>::make(Fn{*this, rhs}), first);
+        }
     }
 
 
@@ -133,28 +191,25 @@ public:
     template <typename B, typename CtxB, typename Rhs>
         requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        constexpr bool firstCallNoexcept = nothrow && Parser<B, CtxB, Rhs>::nothrow;
-        return Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) noexcept(firstCallNoexcept) {
-            return lhs.apply(stream, ctx).flatMap([&rhs, &stream, &ctx](T body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream, ctx).map([mvBody = std::move(body)](auto const& _) {
-                    return mvBody;
-                });
-            });
-        });
+        auto const first = firstSet().then(rhs.firstSet());
+        using Fn = details::SequenceFn<true, Parser, Parser<B, CtxB, Rhs>>;
+        return keepFirstSet<hasFirstSet>(Parser<T, UnionCtx<Ctx, CtxB>>::make(Fn{*this, rhs}), first);
     }
 
 
     /*
      * <$>, fmap operator
      * @def `>>=` :: Parser<A> -> (A -> B) -> Parser<B>
+     * Lhs is checked first: ADL finds these friends of the parsers stored in SequenceFn and RepeatFn too
      */
-    template <typename ListFn>
-        requires(nocontext)
-    constexpr friend auto operator>>=(Parser lhs, ListFn fn) noexcept {
+    template <typename Lhs, typename ListFn>
+        requires(std::is_same_v<Lhs, Parser> && nocontext)
+    constexpr friend auto operator>>=(Lhs lhs, ListFn fn) noexcept {
         using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
-        return Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream) {
+        auto const first = lhs.firstSet();
+        return keepFirstSet<hasFirstSet>(Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream) {
            return lhs.apply(stream).map(fn);
-        });
+        }), first);
     }
 
 
@@ -162,13 +217,14 @@ public:
      * <$>, fmap operator
      * @def `>>=` :: Parser<A, Ctx> -> (A -> B) -> Parser<B, Ctx>
      */
-    template <std::invocable<T> ListFn>
-        requires(!nocontext)
-    constexpr friend auto operator>>=(Parser lhs, ListFn fn) noexcept {
+    template <typename Lhs, typename ListFn>
+        requires(std::is_same_v<Lhs, Parser> && !nocontext && std::invocable<ListFn, T>)
+    constexpr friend auto operator>>=(Lhs lhs, ListFn fn) noexcept {
         using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
-        return Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream, auto& ctx) {
+        auto const first = lhs.firstSet();
+        return keepFirstSet<hasFirstSet>(Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream, auto& ctx) {
             return lhs.apply(stream, ctx).map(fn);
-        });
+        }), first);
     }
 
     template <std::invocable<T> ListFn>
@@ -186,7 +242,7 @@ public:
         using ResultT = GetParserResult<std::invoke_result_t<ListFn, T>>;
         return Parser<ResultT, Ctx>::make([lhs = *this, fn](Stream& stream) {
            return lhs.apply(stream).flatMap([&](T &&t) {
-               return fn(t).apply(stream);
+               return fn(std::move(t)).apply(stream);
            });
         });
     }
@@ -204,7 +260,7 @@ public:
 
         return Parser<ResultT, UCtx>::make([lhs = *this, fn](Stream& stream, UCtx& ctx) {
            return lhs.apply(stream, ctx).flatMap([&](T &&t) {
-               return fn(t).apply(stream, ctx);
+               return fn(std::move(t)).apply(stream, ctx);
            });
         });
     }
@@ -216,17 +272,16 @@ public:
     template <typename CtxB, typename Rhs>
         requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
-        return Parser<T>::make([lhs = *this, rhs](Stream& stream) {
+        auto const first = firstSet() | rhs.firstSet();
+        return keepFirstSet<hasFirstSet && Parser<T, CtxB, Rhs>::hasFirstSet>(Parser<T>::make([lhs = *this, rhs](Stream& stream) {
             auto backup = stream.pos();
             return lhs.apply(stream).flatMapError([&](details::ParsingError const& firstError) noexcept(Parser<T, CtxB, Rhs>::nothrow) {
                 stream.restorePos(backup);
                 return rhs.apply(stream).flatMapError([&](details::ParsingError const& secondError) {
-                    return PRS_MAKE_ERROR(
-                            "Or error: " + firstError.description + ", " + secondError.description
-                                 , std::max(firstError.pos, secondError.pos));
+                    return makeError(details::ParsingError::orError(firstError, secondError));
                 });
             });
-        });
+        }), first);
     }
 
     /**
@@ -235,17 +290,16 @@ public:
     template <typename CtxB, typename Rhs>
         requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
     constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
-        return Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) {
+        auto const first = firstSet() | rhs.firstSet();
+        return keepFirstSet<hasFirstSet && Parser<T, CtxB, Rhs>::hasFirstSet>(Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) {
             auto backup = stream.pos();
             return lhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& firstError) {
                 stream.restorePos(backup);
                 return rhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& secondError) {
-                    return PRS_MAKE_ERROR(
-                            "Or error: " + firstError.description + ", " + secondError.description
-                                 , std::max(firstError.pos, secondError.pos));
+                    return makeError(details::ParsingError::orError(firstError, secondError));
                 });
             });
-        });
+        }), first);
     }
 
 
@@ -258,9 +312,9 @@ public:
      */
     constexpr auto maybe() const noexcept {
         if constexpr (nocontext) {
-            return Parser<MaybeValue<T>>::make([parser = *this](Stream& stream) {
+            return keepFirstSet<hasFirstSet>(Parser<MaybeValue<T>>::make([parser = *this](Stream& stream) {
                 auto backup = stream.pos();
-                return parser.apply(stream).map([](T t) {
+                return parser.apply(stream).map([](T&& t) {
                     if constexpr (std::is_same_v<T, Drop>) {
                         return Drop{};
                     } else {
@@ -270,11 +324,11 @@ public:
                     stream.restorePos(backup);
                     return MaybeValue<T>{};
                 });
-            });
+            }), firstSet().maybe());
         } else {
-            return Parser<MaybeValue<T>, Ctx>::make([parser = *this](Stream& stream, auto& ctx) {
+            return keepFirstSet<hasFirstSet>(Parser<MaybeValue<T>, Ctx>::make([parser = *this](Stream& stream, auto& ctx) {
                 auto backup = stream.pos();
-                return parser.apply(stream, ctx).map([](T t) {
+                return parser.apply(stream, ctx).map([](T&& t) {
                     if constexpr (std::is_same_v<T, Drop>) {
                         return Drop{};
                     } else {
@@ -284,7 +338,7 @@ public:
                     stream.restorePos(backup);
                     return MaybeValue<T>{};
                 });
-            });
+            }), firstSet().maybe());
         }
     }
 
@@ -319,28 +373,27 @@ public:
     template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION>
             requires(!std::is_same_v<T, Drop>)
     constexpr auto repeat() const noexcept {
-        using Value = T;
-        using P = Parser<std::vector<Value>, Ctx>;
-        return P::make([value = *this](Stream& stream, auto& ctx) noexcept(nothrow) {
-            std::vector<Value> out{};
-            out.reserve(reserve);
-
-            size_t iteration = 0;
+        return repeatTo<std::vector<T>, maxIteration>(details::FixedCapacity<reserve>{});
+    }
 
-            auto backup = stream.pos();
-            do {
-                backup = stream.pos();
-                auto result = value.apply(stream, ctx);
-                if (!result.isError()) {
-                    out.emplace_back(std::move(result).data());
-                } else {
-                    stream.restorePos(backup);
-                    return P::data(std::move(out));
-                }
-            } while (++iteration != maxIteration);
+    /**
+     * repeat with the first `inlineCapacity` items stored without a heap allocation
+     * @def repeatSmall :: Parser<A> -> Parser<SmallVector<A, inlineCapacity>>
+     */
+    template <size_t inlineCapacity, size_t maxIteration = MAX_ITERATION>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeatSmall() const noexcept {
+        return repeatTo<SmallVector<T, inlineCapacity>, maxIteration>(details::FixedCapacity<0>{});
+    }
 
-            return P::makeError("Max iteration", stream.pos());
-        });
+    /**
+     * repeat reserving the running p90 of the previous result sizes of this parser and its copies
+     * @def repeatAdaptive :: Parser<A> -> Parser<std::vector<A>>
+     */
+    template <size_t maxIteration = MAX_ITERATION>
+            requires(!std::is_same_v<T, Drop>)
+    auto repeatAdaptive() const {
+        return repeatTo<std::vector<T>, maxIteration>(details::AdaptiveCapacity{});
     }
 
     /**
@@ -374,37 +427,26 @@ public:
     template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
             requires(!std::is_same_v<T, Drop>)
     constexpr auto repeat(Delimiter tDelimiter) const noexcept {
-        using Value = T;
-        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
-        using P = Parser<std::vector<Value>, UCtx>;
-        constexpr bool noexceptP = nothrow && Delimiter::nothrow;
-        return P::make([value = *this, delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) noexcept(noexceptP) {
-            std::vector<Value> out{};
-            out.reserve(reserve);
-
-            size_t iteration = 0;
-
-            auto backup = stream.pos();
-            do {
-                auto result = value.apply(stream, ctx);
-                if (!result.isError()) {
-                    out.emplace_back(std::move(result).data());
-                } else {
-                    return P::data(std::move(out));
-                }
-
-                backup = stream.pos();
-            } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+        return repeatTo<std::vector<T>, maxIteration>(details::FixedCapacity<reserve>{}, std::move(tDelimiter));
+    }
 
-            if (iteration == maxIteration) {
-                return P::makeError("Max iteration", stream.pos());
-            } else {
-                stream.restorePos(backup);
-                return P::data(std::move(out));
-            }
-        });
+    /**
+     * @def repeatSmall :: Parser<A> -> Parser<Delim> -> Parser<SmallVector<A, inlineCapacity>>
+     */
+    template <size_t inlineCapacity, size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeatSmall(Delimiter tDelimiter) const noexcept {
+        return repeatTo<SmallVector<T, inlineCapacity>, maxIteration>(details::FixedCapacity<0>{}, std::move(tDelimiter));
     }
 
+    /**
+     * @def repeatAdaptive :: Parser<A> -> Parser<Delim> -> Parser<std::vector<A>>
+     */
+    template <size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(!std::is_same_v<T, Drop>)
+    auto repeatAdaptive(Delimiter tDelimiter) const {
+        return repeatTo<std::vector<T>, maxIteration>(details::AdaptiveCapacity{}, std::move(tDelimiter));
+    }
 
     /**
      * @def repeat :: Parser<Drop> -> Parser<Delim> -> Parser<Drop>
@@ -444,7 +486,7 @@ public:
             requires (!std::predicate<T const&, Stream&> && nocontext)
     constexpr auto cond(Fn test) const noexcept {
         return Parser<T>::make([parser = *this, test](Stream& stream) {
-           return parser.apply(stream).flatMap([&test, &stream](T t) {
+           return parser.apply(stream).flatMap([&test, &stream](T&& t) {
                if (test(t)) {
                    return Parser<T>::data(std::move(t));
                } else {
@@ -461,7 +503,7 @@ public:
             requires (!std::predicate<T const&, Stream&> && !nocontext)
     constexpr auto cond(Fn test) const noexcept {
         return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&test, &stream](T t) {
+           return parser.apply(stream, ctx).flatMap([&test, &stream](T&& t) {
                if (test(t)) {
                    return Parser<T>::data(std::move(t));
                } else {
@@ -478,7 +520,7 @@ public:
         requires(nocontext)
     constexpr auto cond(Fn test) const noexcept {
         return Parser<T>::make([parser = *this, test](Stream& stream) {
-           return parser.apply(stream).flatMap([&test, &stream](T t) {
+           return parser.apply(stream).flatMap([&test, &stream](T&& t) {
                if (test(t, stream)) {
                    return Parser<T>::data(std::move(t));
                } else {
@@ -495,7 +537,7 @@ public:
         requires(!nocontext)
     constexpr auto cond(Fn test) const noexcept {
         return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&test, &stream](T t) {
+           return parser.apply(stream, ctx).flatMap([&test, &stream](T&& t) {
                if (test(t, stream)) {
                    return Parser<T>::data(std::move(t));
                } else {
@@ -513,7 +555,7 @@ public:
     constexpr auto condC(Fn test) const noexcept {
         using UCtx = UnionCtx<Ctx, CondContext>;
         return Parser<T, UCtx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&](T t) {
+           return parser.apply(stream, ctx).flatMap([&](T&& t) {
                if (test(t, ctx)) {
                    return Parser<T>::data(std::move(t));
                } else {
@@ -528,17 +570,17 @@ public:
      */
     constexpr auto drop() const noexcept {
         if constexpr (nocontext) {
-            return Parser<Drop>::make([p = *this](Stream& s) {
+            return keepFirstSet<hasFirstSet>(Parser<Drop>::make([p = *this](Stream& s) {
                 return p.apply(s).map([](auto &&) {
                     return Drop{};
                 });
-            });
+            }), firstSet());
         } else {
-            return Parser<Drop, Ctx>::make([p = *this](Stream& s, auto& ctx) {
+            return keepFirstSet<hasFirstSet>(Parser<Drop, Ctx>::make([p = *this](Stream& s, auto& ctx) {
                 return p.apply(s, ctx).map([](auto &&) {
                     return Drop{};
                 });
-            });
+            }), firstSet());
         }
     }
 
@@ -557,9 +599,9 @@ public:
     constexpr auto mustConsume() const noexcept {
         return make([p = *this](Stream& s, auto& ctx) {
             auto pos = s.pos();
-            return p.apply(s, ctx).flatMap([pos, &s](auto &&t) {
+            return p.apply(s, ctx).flatMap([pos, &s](T&& t) {
                if (s.pos() > pos) {
-                   return data(t);
+                   return data(std::move(t));
                } else {
                    return makeError("Didn't consume stream", s.pos());
                }
@@ -572,8 +614,8 @@ public:
         requires(nocontext)
     constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
         return make_parser([parser = *this, fn](Stream& stream) {
-            return parser.apply(stream).flatMap([fn, &stream](T const& t) {
-                return fn(t).apply(stream);
+            return parser.apply(stream).flatMap([&fn, &stream](T&& t) {
+                return fn(std::move(t)).apply(stream);
             });
         });
     }
@@ -583,8 +625,8 @@ public:
         requires(!nocontext)
     constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
         return make_parser<Ctx>([parser = *this, fn](Stream& stream, auto& ctx) {
-            return parser.apply(stream, ctx).flatMap([fn, &stream](T const& t) {
-                return fn(t).apply(stream);
+            return parser.apply(stream, ctx).flatMap([&fn, &stream](T&& t) {
+                return fn(std::move(t)).apply(stream);
             });
         });
     }
@@ -608,6 +650,28 @@ public:
         }
     }
 
+    /**
+     * Type erasing without memory allocation, the parser must fit inlineSize
+     * @def toErased :: Parser<A, Ctx, Fn> -> ErasedParser<A, Ctx, inlineSize>
+     */
+    template <size_t inlineSize = ERASED_PARSER_SIZE>
+    constexpr auto toErased() const& noexcept {
+        return ErasedParser<T, Ctx, inlineSize>(details::ErasedFn<T, Ctx, inlineSize>(*this));
+    }
+
+    template <size_t inlineSize = ERASED_PARSER_SIZE>
+    constexpr auto toErased() && noexcept {
+        return ErasedParser<T, Ctx, inlineSize>(details::ErasedFn<T, Ctx, inlineSize>(std::move(*this)));
+    }
+
+    /**
+     * The parser must outlive the reference
+     * @def ref :: Parser<A, Ctx, Fn> -> ParserRef<A, Ctx>
+     */
+    constexpr auto ref() const noexcept {
+        return ParserRef<T, Ctx>(details::ParserRefFn<T, Ctx>(*this));
+    }
+
     static Result makeError(details::ParsingError error) noexcept {
         return Result{error};
     }
@@ -616,16 +680,68 @@ public:
         return Result{details::ParsingError{pos}};
     }
 
-    static constexpr Result makeError(std::string_view desc, size_t pos) noexcept {
+    static constexpr Result makeError(details::StaticText desc, size_t pos) noexcept {
         return Result{details::ParsingError{desc, pos}};
     }
 
+    /**
+     * The runtime description is copied to the heap, copies of the error share it.
+     * Arrays aren't accepted here: a literal is a StaticText and a mutable array is the next overload.
+     */
+    template <typename Text>
+        requires(std::convertible_to<Text const&, std::string_view> && !std::is_array_v<Text> && !details::STATIC_ERROR_TEXT)
+    static Result makeError(Text const& desc, size_t pos) {
+        if constexpr (DISABLE_ERROR_LOG) {
+            return makeError(pos);
+        } else {
+            return makeError(std::make_shared<std::string const>(std::string_view{desc}), pos);
+        }
+    }
+
+    /**
+     * A buffer with a formatted message, the text before the first null is copied
+     */
+    template <size_t N>
+    static Result makeError(char (&desc)[N], size_t pos) requires(!details::STATIC_ERROR_TEXT) {
+        return makeError(std::string_view{desc, static_cast<size_t>(std::find(desc, desc + N, '\0') - desc)}, pos);
+    }
+
+    static Result makeError(details::SharedText desc, size_t pos) noexcept requires(!details::STATIC_ERROR_TEXT) {
+        if constexpr (DISABLE_ERROR_LOG) {
+            return makeError(pos);
+        } else {
+            return Result{details::ParsingError{std::move(desc), pos}};
+        }
+    }
+
     template <typename U = T>
         requires(std::convertible_to<U, T>)
     static constexpr Result data(U&& t) noexcept(std::is_nothrow_convertible_v<U, T>) {
         return Result{std::forward<U>(t)};
     }
 private:
+    template <typename Out, size_t maxIteration, typename Capacity>
+    constexpr auto repeatTo(Capacity capacity) const noexcept {
+        using Fn = details::RepeatFn<Out, maxIteration, Capacity, Parser>;
+        return Parser<Out, Ctx>::make(Fn{*this, std::move(capacity)});
+    }
+
+    template <typename Out, size_t maxIteration, typename Capacity, ParserType Delimiter>
+    constexpr auto repeatTo(Capacity capacity, Delimiter tDelimiter) const noexcept {
+        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
+        using Fn = details::RepeatDelimiterFn<Out, maxIteration, Capacity, Parser, Delimiter>;
+        return Parser<Out, UCtx>::make(Fn{*this, std::move(tDelimiter), std::move(capacity)});
+    }
+
+    template <bool known, ParserType P>
+    static constexpr auto keepFirstSet(P parser, FirstSet first) noexcept {
+        if constexpr (known) {
+            return parser.withFirstSet(first);
+        } else {
+            return parser;
+        }
+    }
+
     StoredFn m_fn;
 };
 
@@ -2,48 +2,452 @@
 
 #include <parsecpp/core/buildParams.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace prs::details {
 
+/**
+ * Pointer to a null-terminated text that lives until the end of the program: a string literal or an interned string.
+ * The lazy errors keep only such texts.
+ */
+class StaticText {
+public:
+    constexpr StaticText() noexcept = default;
+
+    /**
+     * A string literal or a constant array, an array filled at runtime isn't a constant expression and doesn't compile
+     */
+    template <size_t N>
+    consteval StaticText(char const(&s)[N])
+        : m_text(s) {
+        if (s[N - 1] != '\0') {
+            throw "StaticText requires a null-terminated array";
+        }
+    }
+
+    /**
+     * The text must have the static storage duration (a constant or a template parameter object)
+     */
+    static constexpr StaticText fromStatic(char const* s) noexcept {
+        return StaticText{std::in_place, s};
+    }
+
+    /**
+     * Copy of the text that is never freed, equal texts share the copy
+     */
+    static StaticText intern(std::string_view s) {
+        static std::mutex mutex;
+        static std::set<std::string, std::less<>> texts;
+
+        std::lock_guard lock{mutex};
+        auto it = texts.find(s);
+        if (it == texts.end()) {
+            it = texts.emplace(s).first;
+        }
+        return StaticText{std::in_place, it->c_str()};
+    }
+
+    constexpr char const* c_str() const noexcept {
+        return m_text;
+    }
+
+    constexpr std::string_view sv() const noexcept {
+        return m_text;
+    }
+
+    constexpr operator std::string_view() const noexcept {
+        return m_text;
+    }
+private:
+    constexpr StaticText(std::in_place_t, char const* s) noexcept
+        : m_text(s) {}
+
+    char const* m_text = "";
+};
+
+/**
+ * Runtime text of the default errors, copies of an error share it
+ */
+using SharedText = std::shared_ptr<std::string const>;
+
 template <bool disableDescription>
 struct ParsingErrorT;
 
 template <>
-struct ParsingErrorT<false> {
+struct ParsingErrorT<true> {
     ParsingErrorT() = default;
 
-    explicit ParsingErrorT(std::string_view s, size_t p) noexcept
-        : description(s), pos(p) {};
+    explicit ParsingErrorT(StaticText, size_t p) noexcept
+        : pos(p) {};
 
     explicit ParsingErrorT(size_t p) noexcept
         : pos(p) {};
 
     std::string_view getDescription() const noexcept {
-        return description;
+        return "";
+    }
+
+    static ParsingErrorT orError(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        return ParsingErrorT{std::max(first.pos, second.pos)};
+    }
+
+    static ParsingErrorT internalError(ParsingErrorT const&, size_t p) noexcept {
+        return ParsingErrorT{p};
+    }
+
+    static ParsingErrorT quoted(StaticText, StaticText, size_t p) noexcept {
+        return ParsingErrorT{p};
+    }
+
+    size_t pos{};
+};
+
+/**
+ * Error of the lazy mode, without allocations: keeps pointers to static descriptions and formats them only in getDescription().
+ * Descriptions and quotes are StaticText, a runtime text must be interned.
+ * `|` keeps only the furthest failure with the set of expected descriptions (Parsec style),
+ * the set is limited by MAX_EXPECTED. The quote of a single description takes the second slot of the set.
+ */
+struct LazyParsingError {
+    static constexpr size_t MAX_EXPECTED = 4;
+
+    constexpr LazyParsingError() = default;
+
+    constexpr explicit LazyParsingError(StaticText s, size_t p) noexcept
+        : pos(p), expected{s.c_str()}, count(1) {};
+
+    constexpr explicit LazyParsingError(size_t p) noexcept
+        : pos(p) {};
+
+    std::string getDescription() const {
+        std::string out = internal ? "Internal parser fail: " : "";
+        if (count > 1 || truncated) {
+            out += "Expected one of: ";
+            for (size_t i = 0; i != count; ++i) {
+                out.append(i == 0 ? "" : ", ").append(expected[i]);
+            }
+            if (truncated) {
+                out += ", ...";
+            }
+        } else if (count == 1) {
+            out += expected[0];
+        }
+
+        if (hasQuote) {
+            out.append(" '").append(expected[1]).append("'");
+        }
+        return out;
+    }
+
+    constexpr bool contains(char const* description) const noexcept {
+        for (size_t i = 0; i != count; ++i) {
+            if (expected[i] == description || std::string_view{expected[i]} == description) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr LazyParsingError orError(LazyParsingError const& first, LazyParsingError const& second) noexcept {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+
+        LazyParsingError out{first.pos};
+        out.truncated = first.truncated || second.truncated;
+        for (auto const* error : {&first, &second}) {
+            for (size_t i = 0; i != error->count; ++i) {
+                if (out.contains(error->expected[i])) {
+                    continue;
+                } else if (out.count == MAX_EXPECTED) {
+                    out.truncated = true;
+                } else {
+                    out.expected[out.count++] = error->expected[i];
+                }
+            }
+        }
+        return out;
+    }
+
+    static constexpr LazyParsingError internalError(LazyParsingError const& error, size_t p) noexcept {
+        LazyParsingError out = error;
+        out.pos = p;
+        out.internal = true;
+        return out;
+    }
+
+    static constexpr LazyParsingError quoted(StaticText s, StaticText q, size_t p) noexcept {
+        LazyParsingError out{s, p};
+        out.expected[1] = q.c_str();
+        out.hasQuote = true;
+        return out;
     }
 
-    std::string description;
     size_t pos{};
+    std::array<char const*, MAX_EXPECTED> expected{};
+    uint8_t count = 0;
+    bool truncated = false;
+    bool internal = false;
+    bool hasQuote = false;
 };
 
+/**
+ * Error of the default mode: LazyParsingError that can also keep one runtime text, a description of the set or the quote.
+ * `|` of two errors with different runtime texts keeps the text of the first one.
+ * A move copies the text handle, so a moved-from error still has a valid description.
+ */
 template <>
-struct ParsingErrorT<true> {
+struct ParsingErrorT<false> : LazyParsingError {
     ParsingErrorT() = default;
 
-    explicit ParsingErrorT(std::string_view s, size_t p) noexcept
-        : pos(p) {};
+    ParsingErrorT(ParsingErrorT const&) = default;
+    ParsingErrorT& operator=(ParsingErrorT const&) = default;
+
+    explicit ParsingErrorT(StaticText s, size_t p) noexcept
+        : LazyParsingError(s, p) {};
+
+    explicit ParsingErrorT(SharedText s, size_t p) noexcept
+        : LazyParsingError(StaticText{}, p), text(std::move(s)) {
+        expected[0] = text->c_str();
+    }
 
     explicit ParsingErrorT(size_t p) noexcept
-        : pos(p) {};
+        : LazyParsingError(p) {};
 
-    std::string_view getDescription() const noexcept {
-        return "";
+    static ParsingErrorT orError(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        if (!first.text && !second.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), nullptr};
+        }
+        return orErrorOfTexts(first, second);
+    }
+
+    static ParsingErrorT internalError(ParsingErrorT const& error, size_t p) noexcept {
+        return ParsingErrorT{LazyParsingError::internalError(error, p), error.text};
+    }
+
+    static ParsingErrorT quoted(StaticText s, StaticText q, size_t p) noexcept {
+        return ParsingErrorT{LazyParsingError::quoted(s, q, p), nullptr};
+    }
+
+    static ParsingErrorT quoted(StaticText s, SharedText q, size_t p) noexcept {
+        ParsingErrorT out{LazyParsingError::quoted(s, StaticText{}, p), std::move(q)};
+        out.expected[1] = out.text->c_str();
+        return out;
+    }
+
+    SharedText text;
+private:
+    ParsingErrorT(LazyParsingError const& error, SharedText t) noexcept
+        : LazyParsingError(error), text(std::move(t)) {};
+
+    // out of the fast path of `|`
+    static ParsingErrorT orErrorOfTexts(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+        if (!second.text || second.text == first.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), first.text};
+        }
+        if (!first.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), second.text};
+        }
+
+        LazyParsingError rest = second;
+        rest.count = 0;
+        for (size_t i = 0; i != second.count; ++i) {
+            if (second.expected[i] != second.text->c_str()) {
+                rest.expected[rest.count++] = second.expected[i];
+            } else if (!first.contains(second.expected[i])) {
+                rest.truncated = true;
+            }
+        }
+        return ParsingErrorT{LazyParsingError::orError(first, rest), first.text};
+    }
+};
+
+/**
+ * Error of the compact mode: the position and a handle of LazyParsingError that lives out of line,
+ * in a per-thread free list of reference counted nodes. A result is T + 16 bytes instead of T + sizeof(LazyParsingError),
+ * a result of an empty T is only the handle (the null handle is the success).
+ * Copies share the node with an atomic counter, the last copy returns it to the free list of its thread.
+ */
+class CompactParsingError {
+    struct Node {
+        LazyParsingError error;
+        std::atomic<uint32_t> refs = 1;
+        Node* next = nullptr;
+    };
+
+    enum PoolState : uint8_t {
+        NO_POOL,
+        POOL_ALIVE,
+        POOL_DESTROYED
+    };
+
+    // trivially initialized, so the fast path has no thread_local guard
+    static inline thread_local Node* t_free = nullptr;
+    static inline thread_local PoolState t_pool = NO_POOL;
+
+    struct PoolOwner {
+        PoolOwner() noexcept {
+            t_pool = POOL_ALIVE;
+        }
+
+        ~PoolOwner() {
+            t_pool = POOL_DESTROYED;
+            while (t_free) {
+                delete std::exchange(t_free, t_free->next);
+            }
+        }
+    };
+
+    static Node* allocate(LazyParsingError const& error) {
+        if (Node* node = t_free) {
+            t_free = node->next;
+            node->error = error;
+            node->refs.store(1, std::memory_order_relaxed);
+            return node;
+        }
+        return new Node{error};
+    }
+
+    // nodes enter a free list only here, so the pool owner of the thread is created here
+    static void release(Node* node) noexcept {
+        if (t_pool != POOL_ALIVE && !createPool()) {
+            delete node; // the thread is exiting
+            return;
+        }
+        node->next = t_free;
+        t_free = node;
+    }
+
+    static bool createPool() noexcept {
+        if (t_pool == NO_POOL) {
+            thread_local PoolOwner owner; // frees the nodes of the thread
+            (void)owner;
+        }
+        return t_pool == POOL_ALIVE;
+    }
+
+    // errors without a description don't allocate
+    static Node* emptyNode() noexcept {
+        static Node empty{};
+        return &empty;
+    }
+
+    CompactParsingError(size_t p, Node* node) noexcept
+        : pos(p), m_node(node) {};
+public:
+    CompactParsingError() noexcept
+        : m_node(emptyNode()) {};
+
+    explicit CompactParsingError(StaticText s, size_t p)
+        : pos(p), m_node(allocate(LazyParsingError{s, p})) {};
+
+    explicit CompactParsingError(size_t p) noexcept
+        : pos(p), m_node(emptyNode()) {};
+
+    CompactParsingError(CompactParsingError const& other) noexcept
+        : pos(other.pos), m_node(other.m_node) {
+        if (m_node && m_node != emptyNode()) {
+            m_node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // a moved-from error stays an error (or the niche)
+    CompactParsingError(CompactParsingError&& other) noexcept
+        : pos(other.pos), m_node(std::exchange(other.m_node, other.m_node ? emptyNode() : nullptr)) {};
+
+    CompactParsingError& operator=(CompactParsingError other) noexcept {
+        pos = other.pos;
+        std::swap(m_node, other.m_node);
+        return *this;
+    }
+
+    ~CompactParsingError() noexcept {
+        if (m_node && m_node != emptyNode() && m_node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            release(m_node);
+        }
+    }
+
+    static CompactParsingError niche() noexcept {
+        return CompactParsingError{0, nullptr};
+    }
+
+    bool isNiche() const noexcept {
+        return m_node == nullptr;
+    }
+
+    std::string getDescription() const {
+        return m_node ? m_node->error.getDescription() : std::string{};
+    }
+
+    static CompactParsingError orError(CompactParsingError const& first, CompactParsingError const& second) {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+        return make(LazyParsingError::orError(first.lazy(), second.lazy()));
+    }
+
+    static CompactParsingError internalError(CompactParsingError const& error, size_t p) {
+        return make(LazyParsingError::internalError(error.lazy(), p));
+    }
+
+    static CompactParsingError quoted(StaticText s, StaticText q, size_t p) {
+        return make(LazyParsingError::quoted(s, q, p));
     }
 
     size_t pos{};
+private:
+    LazyParsingError lazy() const noexcept {
+        LazyParsingError out = m_node ? m_node->error : LazyParsingError{};
+        out.pos = pos;
+        return out;
+    }
+
+    static CompactParsingError make(LazyParsingError const& error) {
+        return CompactParsingError{error.pos, allocate(error)};
+    }
+
+    Node* m_node;
 };
 
-using ParsingError = ParsingErrorT<DISABLE_ERROR_LOG>;
+using ParsingError = std::conditional_t<DISABLE_ERROR_LOG
+        , ParsingErrorT<true>
+        , std::conditional_t<COMPACT_ERROR, CompactParsingError
+        , std::conditional_t<LAZY_ERROR_LOG, LazyParsingError, ParsingErrorT<false>>>>;
+
+/**
+ * The lazy and compact modes accept only static descriptions, the default mode also keeps runtime ones
+ */
+static constexpr bool STATIC_ERROR_TEXT = !DISABLE_ERROR_LOG && (LAZY_ERROR_LOG || COMPACT_ERROR);
+
+/**
+ * Runtime text that a parser keeps for its errors
+ */
+using ErrorText = std::conditional_t<DISABLE_ERROR_LOG || STATIC_ERROR_TEXT, StaticText, SharedText>;
+
+/**
+ * Interned only in the modes with static descriptions, dropped without the error log
+ */
+template <typename Text = ErrorText>
+Text keepErrorText(std::string_view text) {
+    if constexpr (DISABLE_ERROR_LOG) {
+        return {};
+    } else if constexpr (STATIC_ERROR_TEXT) {
+        return StaticText::intern(text);
+    } else {
+        return std::make_shared<std::string const>(text);
+    }
+}
 
 }
\ No newline at end of file
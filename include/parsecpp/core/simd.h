@@ -0,0 +1,14 @@
+#pragma once
+
+#include <parsecpp/core/buildParams.h>
+
+#if !defined(PRS_DISABLE_SIMD)
+    #if defined(__AVX2__)
+        #define PRS_SIMD_AVX2
+        #define PRS_SIMD_SSE2
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PRS_SIMD_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
\ No newline at end of file
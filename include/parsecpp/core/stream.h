@@ -2,6 +2,7 @@
 
 #include <parsecpp/core/parsingError.h>
 #include <parsecpp/core/buildParams.h>
+#include <parsecpp/core/charSet.h>
 
 #include <string_view>
 #include <string>
@@ -108,7 +109,7 @@ public:
             return 0;
         } else {
             char c = m_currentStr[0];
-            if (test[c]) {
+            if (test[static_cast<unsigned char>(c)]) {
                 m_currentStr.remove_prefix(1);
                 return c;
             } else {
@@ -117,6 +118,17 @@ public:
         }
     }
 
+    /**
+     * Consume the longest prefix of symbols from the set
+     * @return consumed part of the stream
+     */
+    std::string_view takeWhile(CharSet const& set) noexcept {
+        auto const n = set.prefixLength(m_currentStr);
+        auto const out = m_currentStr.substr(0, n);
+        m_currentStr.remove_prefix(n);
+        return out;
+    }
+
     void restorePos(size_t pos) noexcept {
         assert(pos <= m_fullStr.size());
         m_currentStr = m_fullStr.substr(pos);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <parsecpp/core/buildParams.h>
+#include <parsecpp/core/simd.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace prs::details {
+
+/**
+ * Substring search with SIMD first/last byte candidate filter.
+ * Blocks of text are compared with the first and the last symbols of the pattern,
+ * only positions where both of them match are checked with memcmp.
+ * @tparam extent - size of the pattern if it's known at compile time
+ * @return position of the first entrance of pattern or npos
+ */
+template <size_t extent = std::dynamic_extent>
+size_t findText(std::string_view str, std::string_view pattern) noexcept {
+    size_t const k = extent == std::dynamic_extent ? pattern.size() : extent;
+    if (k == 0) {
+        return 0;
+    }
+    if (k > str.size()) {
+        return std::string_view::npos;
+    }
+    if (k == 1) {
+        auto const* p = static_cast<char const*>(std::memchr(str.data(), pattern[0], str.size()));
+        return p == nullptr ? std::string_view::npos : p - str.data();
+    }
+
+    [[maybe_unused]] char const* const s = str.data();
+    [[maybe_unused]] char const* const needle = pattern.data();
+    [[maybe_unused]] size_t const lastStart = str.size() - k; // the last position where pattern can start
+    size_t i = 0;
+
+    if constexpr (!DISABLE_SIMD) {
+#ifdef PRS_SIMD_AVX2
+        __m256i const first32 = _mm256_set1_epi8(needle[0]);
+        __m256i const last32 = _mm256_set1_epi8(needle[k - 1]);
+        for (; i + 32 <= lastStart + 1; i += 32) {
+            __m256i const blockFirst = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i));
+            __m256i const blockLast = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i + k - 1));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+                    _mm256_cmpeq_epi8(blockFirst, first32), _mm256_cmpeq_epi8(blockLast, last32))));
+            while (mask != 0) {
+                auto const bit = std::countr_zero(mask);
+                if (std::memcmp(s + i + bit + 1, needle + 1, k - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+#endif
+#ifdef PRS_SIMD_SSE2
+        __m128i const first16 = _mm_set1_epi8(needle[0]);
+        __m128i const last16 = _mm_set1_epi8(needle[k - 1]);
+        for (; i + 16 <= lastStart + 1; i += 16) {
+            __m128i const blockFirst = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i));
+            __m128i const blockLast = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i + k - 1));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16))));
+            while (mask != 0) {
+                auto const bit = std::countr_zero(mask);
+                if (std::memcmp(s + i + bit + 1, needle + 1, k - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
+        }
+#endif
+    }
+
+    return str.find(pattern.substr(0, k), i);
+}
+
+}
\ No newline at end of file
@@ -7,5 +7,8 @@
 #include <parsecpp/utils/hitCounter.h>
 #include <parsecpp/utils/finally.h>
 #include <parsecpp/utils/memoizer.hpp>
+#include <parsecpp/utils/mappedFile.h>
+#include <parsecpp/utils/chunkedStream.h>
+#include <parsecpp/utils/parallelRepeat.h>
 
 #include <parsecpp/common/debug.h>
\ No newline at end of file
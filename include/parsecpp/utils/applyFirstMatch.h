@@ -1,7 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
 #include <functional>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace prs::details {
 
@@ -22,6 +29,43 @@ struct strip_reference_wrapper<std::reference_wrapper<T>> {
 template <typename T>
 using strip_reference_wrapper_t = typename impl::strip_reference_wrapper<T>::type;
 
+
+enum class FirstMatchStrategy {
+    Linear,
+    Integral, // dense table or binary search for sparse keys
+    String // binary search by (length, string)
+};
+
+namespace impl {
+
+template <typename Equal, typename ...Keys>
+constexpr FirstMatchStrategy selectFirstMatchStrategy() noexcept {
+    constexpr size_t LINEAR_MAX_SIZE = 8;
+    using Key = std::decay_t<std::tuple_element_t<0, std::tuple<Keys...>>>;
+    if constexpr (sizeof...(Keys) <= LINEAR_MAX_SIZE
+                  || !std::is_same_v<Equal, std::equal_to<>>
+                  || !(std::is_same_v<std::decay_t<Keys>, Key> && ...)) {
+        return FirstMatchStrategy::Linear;
+    } else if constexpr ((std::is_integral_v<Key> && !std::is_same_v<Key, bool>) || std::is_enum_v<Key>) {
+        return FirstMatchStrategy::Integral;
+    } else if constexpr (std::is_same_v<Key, std::string_view>) {
+        return FirstMatchStrategy::String;
+    } else {
+        return FirstMatchStrategy::Linear;
+    }
+}
+
+template <typename Key>
+constexpr auto toIntegral(Key key) noexcept {
+    if constexpr (std::is_enum_v<Key>) {
+        return static_cast<std::underlying_type_t<Key>>(key);
+    } else {
+        return key;
+    }
+}
+
+}
+
 template <typename UnhandledAction, typename Equal, typename ...TupleArgs>
 class ApplyFirstMatch {
 public:
@@ -36,10 +80,27 @@ public:
         : m_tuple(std::make_tuple(std::forward<TupleArgs>(args)...))
         , m_unhandled(std::move(unhandled))
         , m_cmp(std::move(eq)) {
+        if constexpr (strategy != FirstMatchStrategy::Linear) {
+            buildIndex(std::make_index_sequence<sizeof...(TupleArgs)>{});
+        }
     }
 
+    /**
+     * Lookup is selected by the keys: linear scan for small N or custom Equal,
+     * dense table (or binary search for sparse keys) for integral and enum keys,
+     * binary search by (length, string) for string_view keys.
+     * The first item wins for equal keys with any strategy.
+     */
+    static constexpr FirstMatchStrategy strategy = impl::selectFirstMatchStrategy<Equal, std::tuple_element_t<0, TupleArgs>...>();
+
     template <typename KeyLike, typename ...Args>
     constexpr decltype(auto) apply(KeyLike const& key, Args &&...args) const {
+        if constexpr (strategy != FirstMatchStrategy::Linear) {
+            if (auto const index = findIndex(key); index != NOT_INDEXED) {
+                return invokeAt(index, std::forward<Args>(args)...);
+            }
+        }
+
         auto f = [&](auto const& el) -> bool {
             return std::invoke(m_cmp, el, key);
         };
@@ -80,9 +141,118 @@ private:
         }
     }
 
+    using Key = std::decay_t<std::tuple_element_t<0, std::tuple_element_t<0, std::tuple<TupleArgs...>>>>;
+    static constexpr size_t N = sizeof...(TupleArgs);
+    static constexpr size_t DENSE_FACTOR = 4;
+    static constexpr size_t UNHANDLED = N;
+    static constexpr size_t NOT_INDEXED = N + 1; // the key type cannot be indexed, use the linear scan
+    using Index = std::conditional_t<N < 255, uint8_t, std::conditional_t<N < 65535, uint16_t, uint32_t>>;
+
+    struct IndexedKey {
+        Key key;
+        Index index;
+    };
+
+    static constexpr bool lessKey(Key const& lhs, Key const& rhs) noexcept {
+        if constexpr (strategy == FirstMatchStrategy::String) {
+            return lhs.size() != rhs.size() ? lhs.size() < rhs.size() : lhs < rhs;
+        } else {
+            return impl::toIntegral(lhs) < impl::toIntegral(rhs);
+        }
+    }
+
+    template <size_t ...Is>
+    constexpr void buildIndex(std::index_sequence<Is...>) noexcept {
+        m_sorted = {IndexedKey{Key(std::get<0>(std::get<Is>(m_tuple))), static_cast<Index>(Is)}...};
+        std::sort(m_sorted.begin(), m_sorted.end(), [](IndexedKey const& lhs, IndexedKey const& rhs) {
+            return lessKey(lhs.key, rhs.key) || (!lessKey(rhs.key, lhs.key) && lhs.index < rhs.index);
+        });
+
+        if constexpr (strategy == FirstMatchStrategy::Integral) {
+            if (offset(m_sorted.back().key) < m_dense.size()) {
+                m_dense.fill(static_cast<Index>(UNHANDLED));
+                for (size_t i = N; i-- != 0;) {
+                    m_dense[offset(m_sorted[i].key)] = m_sorted[i].index;
+                }
+                m_isDense = true;
+            }
+        }
+    }
+
+    /**
+     * Distance from the minimal key, keys less than the minimal one are mapped to big numbers
+     */
+    constexpr size_t offset(Key const& key) const noexcept requires(std::is_integral_v<Key> || std::is_enum_v<Key>) {
+        using Unsigned = std::make_unsigned_t<decltype(impl::toIntegral(key))>;
+        return static_cast<Unsigned>(static_cast<Unsigned>(impl::toIntegral(key)) - static_cast<Unsigned>(impl::toIntegral(m_sorted.front().key)));
+    }
+
+    template <typename KeyLike>
+    constexpr size_t findIndex(KeyLike const& keyLike) const noexcept {
+        Key key{};
+        if constexpr (strategy == FirstMatchStrategy::String) {
+            if constexpr (!std::is_convertible_v<KeyLike const&, std::string_view>) {
+                return NOT_INDEXED;
+            } else {
+                key = keyLike;
+            }
+        } else if constexpr (std::is_same_v<KeyLike, Key>) {
+            key = keyLike;
+        } else if constexpr (std::is_integral_v<Key> && std::is_integral_v<KeyLike> && !std::is_same_v<KeyLike, bool>) {
+            if (!std::in_range<Key>(keyLike)) {
+                return NOT_INDEXED;
+            }
+            key = static_cast<Key>(keyLike);
+        } else {
+            return NOT_INDEXED;
+        }
+
+        if constexpr (strategy == FirstMatchStrategy::Integral) {
+            if (m_isDense) {
+                auto const i = offset(key);
+                return i < m_dense.size() ? m_dense[i] : UNHANDLED;
+            }
+        }
+
+        auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), key, [](IndexedKey const& lhs, Key const& rhs) {
+            return lessKey(lhs.key, rhs);
+        });
+        return it != m_sorted.end() && !lessKey(key, it->key) ? it->index : UNHANDLED;
+    }
+
+    template <size_t I, typename ...Args>
+    static constexpr decltype(auto) invokeItem(ApplyFirstMatch const& self, Args &&...args) {
+        if constexpr (I == N) {
+            return self.invoke(self.m_unhandled, std::forward<Args>(args)...);
+        } else {
+            return self.invoke(std::get<1>(std::get<I>(self.m_tuple)), std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename ...Args>
+    constexpr decltype(auto) invokeAt(size_t index, Args &&...args) const {
+        return INVOKE_TABLE<Args...>[index](*this, std::forward<Args>(args)...);
+    }
+
+    template <typename ...Args>
+    using InvokeFn = decltype(invokeItem<0>(std::declval<ApplyFirstMatch const&>(), std::declval<Args>()...)) (*)(ApplyFirstMatch const&, Args&&...);
+
+    template <typename ...Args, size_t ...Is>
+    static constexpr std::array<InvokeFn<Args...>, N + 1> makeInvokeTable(std::index_sequence<Is...>) noexcept {
+        return {&invokeItem<Is, Args...>...};
+    }
+
+    template <typename ...Args>
+    static constexpr auto INVOKE_TABLE = makeInvokeTable<Args...>(std::make_index_sequence<N + 1>{});
+
     std::tuple<TupleArgs...> const m_tuple;
     strip_reference_wrapper_t<UnhandledAction> const m_unhandled;
     Equal const m_cmp;
+
+    static constexpr bool indexed = strategy != FirstMatchStrategy::Linear;
+    std::array<IndexedKey, indexed ? N : 0> m_sorted{};
+    std::array<Index, strategy == FirstMatchStrategy::Integral ? DENSE_FACTOR * N : 0> m_dense{};
+    bool m_isDense = false;
 };
 
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace prs::details {
+
+/**
+ * Reserve policy of repeat with the capacity fixed at compile time
+ */
+template <size_t reserve>
+struct FixedCapacity {
+    static constexpr size_t hint() noexcept {
+        return reserve;
+    }
+
+    static constexpr void record(size_t) noexcept {}
+};
+
+
+/**
+ * Running p90 of the result sizes of one repeat parser, shared by its copies and threads.
+ * Sizes are counted in power of two buckets, every `WINDOW` samples the hint is recomputed and the old counts are halved.
+ */
+class CapacityStats {
+public:
+    size_t hint() const noexcept {
+        return m_hint.load(std::memory_order_relaxed);
+    }
+
+    void record(size_t size) noexcept {
+        m_buckets[bucket(size)].fetch_add(1, std::memory_order_relaxed);
+        if (m_samples.fetch_add(1, std::memory_order_relaxed) % WINDOW == WINDOW - 1) {
+            update();
+        }
+    }
+private:
+    static constexpr size_t BUCKETS = 25;
+    static constexpr uint32_t WINDOW = 32;
+
+    static size_t bucket(size_t size) noexcept {
+        return std::min<size_t>(std::bit_width(size), BUCKETS - 1);
+    }
+
+    void update() noexcept {
+        if (m_updating.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::array<uint32_t, BUCKETS> counts{};
+        uint64_t total = 0;
+        for (size_t i = 0; i != BUCKETS; ++i) {
+            counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        uint64_t const target = (total * 9 + 9) / 10;
+        uint64_t cumulative = 0;
+        size_t p90 = 0;
+        while (p90 + 1 != BUCKETS && (cumulative += counts[p90]) < target) {
+            ++p90;
+        }
+        // the largest size of the bucket
+        m_hint.store((size_t{1} << p90) - 1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i != BUCKETS; ++i) {
+            m_buckets[i].fetch_sub(counts[i] / 2, std::memory_order_relaxed);
+        }
+        m_updating.clear(std::memory_order_release);
+    }
+
+    std::array<std::atomic<uint32_t>, BUCKETS> m_buckets{};
+    std::atomic<uint32_t> m_samples = 0;
+    std::atomic<size_t> m_hint = 0;
+    std::atomic_flag m_updating;
+};
+
+
+/**
+ * Reserve policy of repeat learned from the previous results
+ */
+struct AdaptiveCapacity {
+    size_t hint() const noexcept {
+        return stats->hint();
+    }
+
+    void record(size_t size) const noexcept {
+        stats->record(size);
+    }
+
+    std::shared_ptr<CapacityStats> stats = std::make_shared<CapacityStats>();
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace prs {
+
+enum class ChunkStatus {
+    Data,
+    NeedMoreInput,
+    Error,
+    EndOfInput,
+};
+
+
+template <typename T>
+struct ChunkResult {
+    ChunkStatus status;
+    std::optional<T> data;
+    details::ParsingError error; // pos is global offset from the start of input
+
+    bool isData() const noexcept {
+        return status == ChunkStatus::Data;
+    }
+};
+
+
+/**
+ * Incremental input for sources that cannot be kept in memory: pipes, sockets, rotating logs.
+ * Input is split by records, `next` parses only complete records (ended by recordEnd) or the whole tail after `finish`.
+ * Parsers can backtrack only inside the not committed part, everything before the committed watermark is released.
+ * Results that point to the input (std::string_view) are valid until the next `feed`.
+ */
+class ChunkedStream {
+public:
+    explicit ChunkedStream(char recordEnd = '\n') noexcept
+        : m_recordEnd(recordEnd) {
+
+    }
+
+    void feed(std::string_view chunk) {
+        if (m_begin != 0 && m_begin * 2 >= m_buffer.size()) {
+            m_buffer.erase(0, m_begin);
+            m_released += m_begin;
+            m_complete -= m_begin;
+            m_begin = 0;
+        }
+
+        if (auto last = chunk.rfind(m_recordEnd); last != std::string_view::npos) {
+            m_complete = m_buffer.size() + last + 1;
+        }
+        m_buffer.append(chunk);
+    }
+
+    /**
+     * No more input, the last record may be not finished by recordEnd
+     */
+    void finish() noexcept {
+        m_finished = true;
+    }
+
+    bool finished() const noexcept {
+        return m_finished;
+    }
+
+    /**
+     * Global offset of the first not committed symbol
+     */
+    size_t committed() const noexcept {
+        return m_released + m_begin;
+    }
+
+    /**
+     * Size of the kept in memory input
+     */
+    size_t buffered() const noexcept {
+        return m_buffer.size() - m_begin;
+    }
+
+    /**
+     * Skip input until the next recordEnd, use it to recover after ChunkStatus::Error
+     * @return false if the record isn't complete yet
+     */
+    bool skipRecord() noexcept {
+        auto end = std::string_view(m_buffer).substr(0, window()).find(m_recordEnd, m_begin);
+        if (end != std::string_view::npos) {
+            m_begin = end + 1;
+            return true;
+        } else if (m_finished) {
+            m_begin = m_buffer.size();
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    template <ParserType P>
+        requires(IsVoidCtx<GetParserCtx<P>>)
+    ChunkResult<GetParserResult<P>> next(P const& parser) {
+        return next(parser, VOID_CONTEXT);
+    }
+
+    /**
+     * Parse one value from the complete records, commit the consumed input if success
+     */
+    template <ParserType P, ContextType Ctx>
+    ChunkResult<GetParserResult<P>> next(P const& parser, Ctx& ctx) {
+        using Result = ChunkResult<GetParserResult<P>>;
+        auto const end = window();
+        if (m_begin == end) {
+            if (m_finished && m_begin == m_buffer.size()) {
+                return Result{ChunkStatus::EndOfInput, std::nullopt, details::ParsingError{committed()}};
+            } else {
+                return Result{ChunkStatus::NeedMoreInput, std::nullopt, details::ParsingError{committed()}};
+            }
+        }
+
+        Stream stream{std::string_view(m_buffer).substr(m_begin, end - m_begin)};
+        auto result = parser(stream, ctx);
+        if (result.isError()) {
+            auto error = std::move(result).error();
+            error.pos += committed();
+            return Result{ChunkStatus::Error, std::nullopt, std::move(error)};
+        } else if (stream.pos() == 0) {
+            return Result{ChunkStatus::Error, std::nullopt, details::ParsingError{"Didn't consume stream", committed()}};
+        } else {
+            m_begin += stream.pos();
+            return Result{ChunkStatus::Data, std::move(result).data(), details::ParsingError{committed()}};
+        }
+    }
+private:
+    size_t window() const noexcept {
+        return m_finished ? m_buffer.size() : m_complete;
+    }
+
+    std::string m_buffer;
+    size_t m_begin = 0; // watermark inside m_buffer
+    size_t m_complete = 0; // end of the last complete record inside m_buffer
+    size_t m_released = 0; // size of input removed from m_buffer
+    char m_recordEnd;
+    bool m_finished = false;
+};
+
+}
\ No newline at end of file
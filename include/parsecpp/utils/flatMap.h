@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace prs {
+
+/**
+ * Map stored as a vector of pairs sorted by key.
+ * Pairs are appended unsorted while parsing and sorted once by `sort()`, the last value wins for equal keys.
+ */
+template <typename Key, typename Value, typename Compare = std::less<>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using Storage = std::vector<value_type>;
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+
+    FlatMap() noexcept = default;
+
+    FlatMap(std::initializer_list<value_type> init)
+        : m_data(init) {
+        sort();
+    }
+
+    void append(Key&& key, Value&& value) {
+        m_data.emplace_back(std::move(key), std::move(value));
+    }
+
+    /**
+     * Stable sort, keeps only the last pair for equal keys
+     */
+    void sort() {
+        constexpr size_t INSERTION_SORT_SIZE = 16;
+        auto const less = [](value_type const& lhs, value_type const& rhs) {
+            return Compare{}(lhs.first, rhs.first);
+        };
+        if (m_data.size() <= INSERTION_SORT_SIZE) {
+            for (size_t i = 1; i < m_data.size(); ++i) {
+                for (size_t j = i; j != 0 && less(m_data[j], m_data[j - 1]); --j) {
+                    std::swap(m_data[j], m_data[j - 1]);
+                }
+            }
+        } else {
+            std::stable_sort(m_data.begin(), m_data.end(), less);
+        }
+
+        size_t out = 0;
+        for (size_t i = 0; i != m_data.size(); ++i) {
+            if (out != 0 && !less(m_data[out - 1], m_data[i])) {
+                m_data[out - 1] = std::move(m_data[i]);
+            } else {
+                if (out != i) {
+                    m_data[out] = std::move(m_data[i]);
+                }
+                ++out;
+            }
+        }
+        m_data.erase(m_data.begin() + static_cast<std::ptrdiff_t>(out), m_data.end());
+    }
+
+    template <typename K>
+    const_iterator find(K const& key) const {
+        auto it = std::lower_bound(m_data.begin(), m_data.end(), key, [](value_type const& lhs, K const& rhs) {
+            return Compare{}(lhs.first, rhs);
+        });
+        return it != m_data.end() && !Compare{}(key, it->first) ? it : m_data.end();
+    }
+
+    template <typename K>
+    bool contains(K const& key) const {
+        return find(key) != end();
+    }
+
+    template <typename K>
+    Value const& at(K const& key) const noexcept(false) {
+        if (auto it = find(key); it != end()) {
+            return it->second;
+        }
+        throw std::out_of_range("FlatMap::at");
+    }
+
+    const_iterator begin() const noexcept {
+        return m_data.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return m_data.end();
+    }
+
+    size_t size() const noexcept {
+        return m_data.size();
+    }
+
+    bool empty() const noexcept {
+        return m_data.empty();
+    }
+
+    /**
+     * Keeps the capacity
+     */
+    void clear() noexcept {
+        m_data.clear();
+    }
+
+    bool operator==(FlatMap const& rhs) const = default;
+private:
+    Storage m_data;
+};
+
+
+/**
+ * Open addressing (linear probing) hash map, pairs are stored densely in the insertion order.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<>>
+class HashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using Storage = std::vector<value_type>;
+    using const_iterator = typename Storage::const_iterator;
+
+    HashMap() noexcept = default;
+
+    HashMap(std::initializer_list<value_type> init) {
+        for (auto const& [key, value] : init) {
+            insert_or_assign(Key{key}, Value{value});
+        }
+    }
+
+    void insert_or_assign(Key&& key, Value&& value) {
+        if ((m_data.size() + 1) * 2 > m_slots.size()) {
+            rehash(std::max<size_t>(MIN_SLOTS, m_slots.size() * 2));
+        }
+
+        size_t const mask = m_slots.size() - 1;
+        for (size_t i = Hash{}(key) & mask;; i = (i + 1) & mask) {
+            if (m_slots[i] == EMPTY) {
+                m_data.emplace_back(std::move(key), std::move(value));
+                m_slots[i] = static_cast<uint32_t>(m_data.size());
+                return;
+            } else if (auto& item = m_data[m_slots[i] - 1]; Equal{}(item.first, key)) {
+                item.second = std::move(value);
+                return;
+            }
+        }
+    }
+
+    const_iterator find(Key const& key) const {
+        if (m_slots.empty()) {
+            return end();
+        }
+
+        size_t const mask = m_slots.size() - 1;
+        for (size_t i = Hash{}(key) & mask; m_slots[i] != EMPTY; i = (i + 1) & mask) {
+            if (Equal{}(m_data[m_slots[i] - 1].first, key)) {
+                return m_data.begin() + (m_slots[i] - 1);
+            }
+        }
+        return end();
+    }
+
+    bool contains(Key const& key) const {
+        return find(key) != end();
+    }
+
+    Value const& at(Key const& key) const noexcept(false) {
+        if (auto it = find(key); it != end()) {
+            return it->second;
+        }
+        throw std::out_of_range("HashMap::at");
+    }
+
+    const_iterator begin() const noexcept {
+        return m_data.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return m_data.end();
+    }
+
+    size_t size() const noexcept {
+        return m_data.size();
+    }
+
+    bool empty() const noexcept {
+        return m_data.empty();
+    }
+
+    /**
+     * Keeps the capacity and the slots
+     */
+    void clear() noexcept {
+        m_data.clear();
+        std::fill(m_slots.begin(), m_slots.end(), EMPTY);
+    }
+
+    bool operator==(HashMap const& rhs) const {
+        return size() == rhs.size() && std::all_of(begin(), end(), [&rhs](value_type const& item) {
+            auto it = rhs.find(item.first);
+            return it != rhs.end() && it->second == item.second;
+        });
+    }
+private:
+    static constexpr uint32_t EMPTY = 0; // slots store index + 1
+    static constexpr size_t MIN_SLOTS = 16;
+
+    void rehash(size_t slots) {
+        m_slots.assign(slots, EMPTY);
+        size_t const mask = slots - 1;
+        for (size_t index = 0; index != m_data.size(); ++index) {
+            size_t i = Hash{}(m_data[index].first) & mask;
+            while (m_slots[i] != EMPTY) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = static_cast<uint32_t>(index + 1);
+        }
+    }
+
+    Storage m_data;
+    std::vector<uint32_t> m_slots;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <parsecpp/core/stream.h>
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace prs {
+
+/**
+ * Hints for the kernel how the mapping will be read, can be combined with `|`
+ */
+enum class MapAdvice : unsigned {
+    Normal = 0,
+    Sequential = 1,
+    Random = 2,
+    WillNeed = 4,
+};
+
+constexpr MapAdvice operator|(MapAdvice lhs, MapAdvice rhs) noexcept {
+    return static_cast<MapAdvice>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+}
+
+constexpr bool hasAdvice(MapAdvice advice, MapAdvice flag) noexcept {
+    return (static_cast<unsigned>(advice) & static_cast<unsigned>(flag)) != 0;
+}
+
+
+/**
+ * Read-only memory mapped file. Owns the mapping, use `stream()` or `sv()` to parse it without copy.
+ * Views and streams must not outlive the MappedFile.
+ * Throws std::system_error if the file cannot be opened or mapped.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(std::string const& path, MapAdvice advice = MapAdvice::Sequential | MapAdvice::WillNeed) noexcept(false) {
+#if defined(_WIN32)
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, hasAdvice(advice, MapAdvice::Sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            throwError(lastError(), "Cannot open file " + path);
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_file, &size)) {
+            auto const error = lastError();
+            close();
+            throwError(error, "Cannot get file size " + path);
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size != 0) {
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping == nullptr) {
+                auto const error = lastError();
+                close();
+                throwError(error, "Cannot map file " + path);
+            }
+            m_data = static_cast<char const*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (m_data == nullptr) {
+                auto const error = lastError();
+                close();
+                throwError(error, "Cannot map file " + path);
+            }
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throwError(lastError(), "Cannot open file " + path);
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) == -1) {
+            auto const error = lastError();
+            ::close(fd);
+            throwError(error, "Cannot get file size " + path);
+        }
+
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size != 0) {
+            void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                auto const error = lastError();
+                ::close(fd);
+                throwError(error, "Cannot map file " + path);
+            }
+            m_data = static_cast<char const*>(p);
+            advise(advice);
+        }
+        // mapping stays valid after close
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& rhs) noexcept
+        : m_data(std::exchange(rhs.m_data, nullptr))
+        , m_size(std::exchange(rhs.m_size, 0))
+#if defined(_WIN32)
+        , m_file(std::exchange(rhs.m_file, INVALID_HANDLE_VALUE))
+        , m_mapping(std::exchange(rhs.m_mapping, nullptr))
+#endif
+    {
+
+    }
+
+    MappedFile& operator=(MappedFile&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            m_data = std::exchange(rhs.m_data, nullptr);
+            m_size = std::exchange(rhs.m_size, 0);
+#if defined(_WIN32)
+            m_file = std::exchange(rhs.m_file, INVALID_HANDLE_VALUE);
+            m_mapping = std::exchange(rhs.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    std::string_view sv() const noexcept {
+        return m_size == 0 ? std::string_view{} : std::string_view{m_data, m_size};
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    Stream stream() const noexcept {
+        return Stream{sv()};
+    }
+
+    /**
+     * Change hints for the whole mapping, for example, Random before restorePos heavy parsing
+     */
+    void advise(MapAdvice advice) const noexcept {
+#if !defined(_WIN32) && defined(MADV_SEQUENTIAL)
+        if (m_data == nullptr) {
+            return;
+        }
+        void* p = const_cast<char*>(m_data);
+        if (hasAdvice(advice, MapAdvice::Sequential)) {
+            ::madvise(p, m_size, MADV_SEQUENTIAL);
+        }
+        if (hasAdvice(advice, MapAdvice::Random)) {
+            ::madvise(p, m_size, MADV_RANDOM);
+        }
+        if (hasAdvice(advice, MapAdvice::WillNeed)) {
+            ::madvise(p, m_size, MADV_WILLNEED);
+        }
+#endif
+    }
+private:
+    static int lastError() noexcept {
+#if defined(_WIN32)
+        return static_cast<int>(GetLastError());
+#else
+        return errno;
+#endif
+    }
+
+    [[noreturn]] static void throwError(int error, std::string const& what) noexcept(false) {
+        throw std::system_error(error, std::system_category(), what);
+    }
+
+    void close() noexcept {
+#if defined(_WIN32)
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    char const* m_data = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+}
\ No newline at end of file
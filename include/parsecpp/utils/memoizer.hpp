@@ -1,9 +1,47 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace prs {
 
 namespace details {
 
+/**
+ * Hash for heterogeneous lookup, string-like probes are hashed as std::string_view
+ */
+template <typename K>
+struct TransparentHash {
+    using is_transparent = void;
+
+    template <typename KeyLike>
+    size_t operator()(KeyLike const& key) const noexcept {
+        if constexpr (std::is_convertible_v<KeyLike const&, std::string_view> && std::is_convertible_v<K const&, std::string_view>) {
+            return std::hash<std::string_view>{}(key);
+        } else {
+            return std::hash<K>{}(key);
+        }
+    }
+};
+
+template <typename K>
+using TransparentHashMap = std::unordered_map<K, size_t, TransparentHash<K>, std::equal_to<>>;
+
 
 template <typename K, typename V>
 class MapStorage {
@@ -11,7 +49,9 @@ public:
     MapStorage() = default;
 
     using Pointer = V const*;
-    Pointer find(K const& key) const noexcept {
+
+    template <typename KeyLike>
+    Pointer find(KeyLike const& key) const noexcept {
         if (auto it = m_storage.find(key); it != m_storage.end()) {
             return std::addressof(it->second);
         } else {
@@ -22,8 +62,16 @@ public:
     V const& emplace(K const& k, V &&v) {
         return m_storage.emplace(k, v).first->second;
     }
+
+    template <typename KeyLike, typename Make>
+    V const& getOrCreate(KeyLike const& key, Make const& make) {
+        if (auto it = find(key); it) {
+            return *it;
+        }
+        return emplace(K(key), make());
+    }
 private:
-    std::map<K, V> m_storage;
+    std::map<K, V, std::less<>> m_storage;
 };
 
 template <typename K, typename V>
@@ -32,7 +80,9 @@ public:
     HashMapStorage() = default;
 
     using Pointer = V*;
-    Pointer find(K const& key) noexcept {
+
+    template <typename KeyLike>
+    Pointer find(KeyLike const& key) noexcept {
         if (auto it = m_storage.find(key); it != m_storage.end()) {
             return std::addressof(it->second);
         } else {
@@ -43,8 +93,16 @@ public:
     V const& emplace(K const& k, V &&v) {
         return m_storage.emplace(k, v).first->second;
     }
+
+    template <typename KeyLike, typename Make>
+    V const& getOrCreate(KeyLike const& key, Make const& make) {
+        if (auto it = find(key); it) {
+            return *it;
+        }
+        return emplace(K(key), make());
+    }
 private:
-    std::unordered_map<K, V> m_storage;
+    std::unordered_map<K, V, TransparentHash<K>, std::equal_to<>> m_storage;
 };
 
 
@@ -58,7 +116,9 @@ public:
     }
 
     using Pointer = V const*;
-    Pointer find(K const& key) const noexcept {
+
+    template <typename KeyLike>
+    Pointer find(KeyLike const& key) const noexcept {
         for (auto const& st : m_storage) {
             if (st.first == key) {
                 return std::addressof(st.second);
@@ -72,11 +132,196 @@ public:
 
         return m_storage.emplace_back(std::pair<K, V>(k, v)).second;
     }
+
+    /**
+     * The reference is valid until the next insertion
+     */
+    template <typename KeyLike, typename Make>
+    V const& getOrCreate(KeyLike const& key, Make const& make) {
+        if (auto it = find(key); it) {
+            return *it;
+        }
+        return emplace(K(key), make());
+    }
 private:
     std::vector<std::pair<K, V>> m_storage;
 };
 
 
+/**
+ * Thread-safe storage, keys are split to shards with own shared_mutex.
+ * Values are never removed, so references stay valid. Copies of the storage share the values.
+ * The value can be created twice by concurrent calls, the first inserted one wins.
+ */
+template <typename K, typename V, size_t shards = 16>
+class ShardedStorage {
+    static_assert(shards != 0 && (shards & (shards - 1)) == 0, "Number of shards must be a power of two");
+public:
+    ShardedStorage()
+        : m_shards(std::make_shared<std::array<Shard, shards>>()) {
+
+    }
+
+    template <typename KeyLike, typename Make>
+    V const& getOrCreate(KeyLike const& key, Make const& make) {
+        constexpr int bits = std::numeric_limits<size_t>::digits;
+        size_t const hash = TransparentHash<K>{}(key);
+        auto& shard = (*m_shards)[(hash ^ (hash >> bits / 4) ^ (hash >> bits / 2)) & (shards - 1)];
+        {
+            std::shared_lock lock(shard.mutex);
+            if (auto it = shard.values.find(key); it != shard.values.end()) {
+                return it->second;
+            }
+        }
+
+        V value = make();
+        std::unique_lock lock(shard.mutex);
+        return shard.values.try_emplace(K(key), std::move(value)).first->second;
+    }
+private:
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<K, V, TransparentHash<K>, std::equal_to<>> values;
+    };
+
+    std::shared_ptr<std::array<Shard, shards>> m_shards;
+};
+
+
+inline size_t nextStorageId() noexcept {
+    static std::atomic<size_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Every thread uses own Inner storage without locks. Copies of the storage share the values.
+ * Storages of a thread are released at the thread exit or with the last copy of the storage.
+ */
+template <typename K, typename V, template <typename, typename> typename Inner = HashMapStorage>
+class PerThreadStorage {
+public:
+    template <typename KeyLike, typename Make>
+    decltype(auto) getOrCreate(KeyLike const& key, Make const& make) {
+        return local().getOrCreate(key, make);
+    }
+private:
+    // the storages of all threads, shared by the copies
+    struct Shared {
+        void release(std::thread::id thread) {
+            std::lock_guard lock(mutex);
+            storages.erase(thread);
+        }
+
+        size_t const id = nextStorageId();
+        std::mutex mutex;
+        std::unordered_map<std::thread::id, std::unique_ptr<Inner<K, V>>> storages;
+    };
+
+    // releases the storages of the thread that are still alive
+    struct ThreadExit {
+        ~ThreadExit() {
+            for (auto const& weak : used) {
+                if (auto shared = weak.lock()) {
+                    shared->release(std::this_thread::get_id());
+                }
+            }
+        }
+
+        std::vector<std::weak_ptr<Shared>> used;
+    };
+
+    Inner<K, V>& local() {
+        // ids aren't reused, so the pointer of a destroyed storage is never matched
+        thread_local size_t lastId = std::numeric_limits<size_t>::max();
+        thread_local Inner<K, V>* last = nullptr;
+        if (lastId != m_shared->id) {
+            last = std::addressof(registerThread());
+            lastId = m_shared->id;
+        }
+        return *last;
+    }
+
+    Inner<K, V>& registerThread() {
+        thread_local ThreadExit exit;
+        std::lock_guard lock(m_shared->mutex);
+        auto& storage = m_shared->storages[std::this_thread::get_id()];
+        if (!storage) {
+            storage = std::make_unique<Inner<K, V>>();
+            std::erase_if(exit.used, [](std::weak_ptr<Shared> const& weak) {
+                return weak.expired();
+            });
+            exit.used.push_back(m_shared);
+        }
+        return *storage;
+    }
+
+    std::shared_ptr<Shared> m_shared = std::make_shared<Shared>();
+};
+
+
+/**
+ * Fixed-capacity storage with CLOCK (second chance) eviction.
+ * Values are returned by copy because they can be evicted by the next call. Not thread-safe, use PerThreadStorage.
+ */
+template <typename K, typename V, size_t capacity = 64>
+class ClockStorage {
+    static_assert(capacity != 0);
+public:
+    ClockStorage() {
+        m_index.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    template <typename KeyLike, typename Make>
+    V getOrCreate(KeyLike const& key, Make const& make) {
+        if (auto it = m_index.find(key); it != m_index.end()) {
+            auto& slot = m_slots[it->second];
+            slot.referenced = true;
+            return *slot.value;
+        }
+
+        // make can throw, the storage is changed only after it
+        V value = make();
+        if (m_slots.size() != capacity) {
+            m_index.emplace(K(key), m_slots.size());
+            return *m_slots.emplace_back(K(key), std::move(value)).value;
+        }
+
+        while (m_slots[m_hand].referenced) {
+            m_slots[m_hand].referenced = false;
+            m_hand = (m_hand + 1) % capacity;
+        }
+
+        auto& slot = m_slots[m_hand];
+        m_index.erase(slot.key);
+        slot.key = K(key);
+        slot.value.emplace(std::move(value));
+        m_index.emplace(slot.key, m_hand);
+        m_hand = (m_hand + 1) % capacity;
+        return *slot.value;
+    }
+
+    size_t size() const noexcept {
+        return m_slots.size();
+    }
+private:
+    struct Slot {
+        Slot(K k, V v)
+            : key(std::move(k))
+            , value(std::move(v)) {
+
+        }
+
+        K key;
+        std::optional<V> value;
+        bool referenced = false;
+    };
+
+    TransparentHashMap<K> m_index;
+    std::vector<Slot> m_slots;
+    size_t m_hand = 0;
+};
+
 }
 
 template <typename Out, typename Key, typename Fn, typename StorageT>
@@ -89,22 +334,21 @@ public:
 
     template <typename ...Args>
         requires(sizeof...(Args) > 1)
-    Out const& operator()(Args const& ...args) const {
-        auto key = std::make_tuple(args...);
-        if (auto it = m_storage.find(key); it) {
-            return *it;
-        } else {
-            return m_storage.emplace(key, m_fn(args...));
-        }
+    decltype(auto) operator()(Args const& ...args) const {
+        return m_storage.getOrCreate(std::make_tuple(args...), [&] {
+            return m_fn(args...);
+        });
     }
 
-
-    Out const& operator()(Key const& key) const {
-        if (auto it = m_storage.find(key); it) {
-            return *it;
-        } else {
-            return m_storage.emplace(key, m_fn(key));
-        }
+    /**
+     * Heterogeneous lookup, the key is constructed only for a new value
+     */
+    template <typename KeyLike>
+        requires(std::is_constructible_v<Key, KeyLike const&>)
+    decltype(auto) operator()(KeyLike const& key) const {
+        return m_storage.getOrCreate(key, [&] {
+            return m_fn(Key(key));
+        });
     }
 private:
     mutable StorageT m_storage;
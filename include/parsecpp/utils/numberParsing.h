@@ -0,0 +1,700 @@
+#pragma once
+
+#include <parsecpp/utils/powersOfFive.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace prs {
+
+enum class NumberFormat {
+    General, // the grammar of std::from_chars: leading zeros, ".5", "5.", inf, nan
+    Json     // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, the longest matching prefix is taken
+};
+
+/**
+ * Exact decimal number mantissa * 10^-scale, 1.50 and 1.5 are different representations
+ */
+template <std::integral Mantissa = int64_t>
+struct Decimal {
+    Mantissa mantissa = 0;
+    size_t scale = 0;
+
+    bool operator==(Decimal const&) const noexcept = default;
+
+    template <std::floating_point T = double>
+    T to() const noexcept {
+        T power = 1;
+        for (size_t i = 0; i != scale; ++i) {
+            power *= 10;
+        }
+        return static_cast<T>(mantissa) / power;
+    }
+};
+
+namespace details {
+
+template <typename Number, typename = std::void_t<>>
+constexpr bool hasFromChars = false;
+
+template <typename Number>
+constexpr bool hasFromChars<Number, std::void_t<decltype(std::from_chars(nullptr, nullptr, std::declval<Number&>()))>> = true;
+
+
+constexpr bool isDigit(char c) noexcept {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/**
+ * 8 bytes as a little-endian word
+ */
+inline uint64_t loadEightBytes(char const* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if constexpr (std::endian::native == std::endian::big) {
+        uint64_t out = 0;
+        for (size_t i = 0; i != sizeof(v); ++i) {
+            out = (out << 8) | ((v >> (8 * i)) & 0xFF);
+        }
+        v = out;
+    }
+    return v;
+}
+
+constexpr bool isEightDigits(uint64_t v) noexcept {
+    return (((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333);
+}
+
+/**
+ * SWAR conversion of 8 ASCII digits: pairs, then quads, then the whole word, 3 multiplications
+ */
+constexpr uint32_t parseEightDigits(uint64_t v) noexcept {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    constexpr uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(v);
+}
+
+/**
+ * Consume all digits, w accumulates them modulo 2^64
+ */
+inline char const* accumulateDigits(char const* p, char const* last, uint64_t& w) noexcept {
+    while (last - p >= 8) {
+        auto const v = loadEightBytes(p);
+        if (!isEightDigits(v)) {
+            break;
+        }
+        w = w * 100000000 + parseEightDigits(v);
+        p += 8;
+    }
+    while (p != last && isDigit(*p)) {
+        w = w * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+
+
+/**
+ * value = +-acc if it fits T
+ */
+template <std::integral T>
+constexpr bool narrowTo(uint64_t acc, bool negative, T& value) noexcept {
+    using U = std::make_unsigned_t<T>;
+    uint64_t const maxValue = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    if (acc > maxValue) {
+        return false;
+    }
+    value = static_cast<T>(negative ? static_cast<U>(0 - acc) : static_cast<U>(acc));
+    return true;
+}
+
+/**
+ * Integer with the semantic of std::from_chars (base 10), for all platforms
+ */
+template <NumberFormat format = NumberFormat::General, std::integral T>
+    requires(!std::is_same_v<T, bool>)
+std::from_chars_result parseInteger(char const* first, char const* last, T& value) noexcept {
+    char const* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+
+    char const* const digitsStart = p;
+    char const* end = p;
+    if (format == NumberFormat::Json && end != last && *end == '0') {
+        ++end;
+    } else {
+        while (last - end >= 8 && isEightDigits(loadEightBytes(end))) {
+            end += 8;
+        }
+        while (end != last && isDigit(*end)) {
+            ++end;
+        }
+    }
+    if (end == digitsStart) {
+        return {first, std::errc::invalid_argument};
+    }
+
+    while (p != end && *p == '0') {
+        ++p;
+    }
+
+    constexpr size_t MAX_SAFE_DIGITS = 19;
+    size_t const n = static_cast<size_t>(end - p);
+    if (n > MAX_SAFE_DIGITS + 1) {
+        return {end, std::errc::result_out_of_range};
+    }
+
+    uint64_t acc = 0;
+    char const* const safeEnd = p + std::min(n, MAX_SAFE_DIGITS);
+    for (; safeEnd - p >= 8; p += 8) {
+        acc = acc * 100000000 + parseEightDigits(loadEightBytes(p));
+    }
+    for (; p != safeEnd; ++p) {
+        acc = acc * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if (n == MAX_SAFE_DIGITS + 1) {
+        auto const lastDigit = static_cast<uint64_t>(*p - '0');
+        if (acc > (std::numeric_limits<uint64_t>::max() - lastDigit) / 10) {
+            return {end, std::errc::result_out_of_range};
+        }
+        acc = acc * 10 + lastDigit;
+    }
+
+    return {end, narrowTo(acc, negative, value) ? std::errc{} : std::errc::result_out_of_range};
+}
+
+
+/**
+ * Exact decimal "-?digits(.digits)?": mantissa and the number of fractional digits.
+ * '.' without digits after it isn't consumed, more than maxScale fractional digits or
+ * a mantissa out of range of Mantissa are result_out_of_range.
+ */
+template <std::integral Mantissa>
+std::from_chars_result parseDecimal(char const* first, char const* last, size_t maxScale,
+                                    Mantissa& mantissa, size_t& scale) noexcept {
+    char const* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<Mantissa>) {
+        if (p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+
+    uint64_t acc = 0;
+    char const* const intStart = p;
+    char const* const intEnd = accumulateDigits(intStart, last, acc);
+    if (intEnd == intStart) {
+        return {first, std::errc::invalid_argument};
+    }
+    char const* fracStart = intEnd;
+    char const* fracEnd = intEnd;
+    if (intEnd != last && *intEnd == '.' && intEnd + 1 != last && isDigit(intEnd[1])) {
+        fracStart = intEnd + 1;
+        fracEnd = accumulateDigits(fracStart, last, acc);
+    }
+    scale = static_cast<size_t>(fracEnd - fracStart);
+    if (scale > maxScale) {
+        return {fracEnd, std::errc::result_out_of_range};
+    }
+
+    constexpr size_t MAX_SAFE_DIGITS = 19;
+    if (static_cast<size_t>(fracEnd - intStart) > MAX_SAFE_DIGITS) {
+        // acc may have wrapped, the slow exact path
+        auto exact = [&acc](char const* d, char const* end) {
+            for (; d != end; ++d) {
+                auto const digit = static_cast<uint64_t>(*d - '0');
+                if (acc > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+                    return false;
+                }
+                acc = acc * 10 + digit;
+            }
+            return true;
+        };
+        acc = 0;
+        if (!exact(intStart, intEnd) || !exact(fracStart, fracEnd)) {
+            return {fracEnd, std::errc::result_out_of_range};
+        }
+    }
+    return {fracEnd, narrowTo(acc, negative, mantissa) ? std::errc{} : std::errc::result_out_of_range};
+}
+
+/**
+ * value * 10^power if it fits T
+ */
+template <std::integral T>
+constexpr bool scaleUp(T& value, size_t power) noexcept {
+    for (; power != 0; --power) {
+        if (value > std::numeric_limits<T>::max() / 10 || value < std::numeric_limits<T>::min() / 10) {
+            return false;
+        }
+        value *= 10;
+    }
+    return true;
+}
+
+template <typename T>
+struct BinaryFormat;
+
+template <>
+struct BinaryFormat<double> {
+    using Bits = uint64_t;
+    static constexpr int MANTISSA_BITS = 52;
+    static constexpr int MIN_EXPONENT = -1023;
+    static constexpr int INFINITE_POWER = 0x7FF;
+    static constexpr int MIN_ROUND_TO_EVEN = -4;
+    static constexpr int MAX_ROUND_TO_EVEN = 23;
+    static constexpr int SMALLEST_POWER_OF_TEN = -342;
+    static constexpr int LARGEST_POWER_OF_TEN = 308;
+    static constexpr int MAX_EXPONENT_FAST_PATH = 22;
+    static constexpr uint64_t MAX_MANTISSA_FAST_PATH = uint64_t{2} << MANTISSA_BITS;
+    static constexpr double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template <>
+struct BinaryFormat<float> {
+    using Bits = uint32_t;
+    static constexpr int MANTISSA_BITS = 23;
+    static constexpr int MIN_EXPONENT = -127;
+    static constexpr int INFINITE_POWER = 0xFF;
+    static constexpr int MIN_ROUND_TO_EVEN = -17;
+    static constexpr int MAX_ROUND_TO_EVEN = 10;
+    static constexpr int SMALLEST_POWER_OF_TEN = -64;
+    static constexpr int LARGEST_POWER_OF_TEN = 38;
+    static constexpr int MAX_EXPONENT_FAST_PATH = 10;
+    static constexpr uint64_t MAX_MANTISSA_FAST_PATH = uint64_t{2} << MANTISSA_BITS;
+    static constexpr float POWERS_OF_TEN[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+// Clinger's fast path is exact only without extended precision of intermediate results (x87)
+static constexpr bool EXACT_FLOAT_EVAL = FLT_EVAL_METHOD == 0;
+
+
+struct Value128 {
+    uint64_t low;
+    uint64_t high;
+};
+
+inline Value128 fullMultiplication(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using UInt128 = unsigned __int128;
+    auto const r = static_cast<UInt128>(a) * b;
+    return {static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64)};
+#else
+    uint64_t const aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    uint64_t const bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    uint64_t const ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    uint64_t const mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return {(mid << 32) | (ll & 0xFFFFFFFF), hh + (lh >> 32) + (hl >> 32) + (mid >> 32)};
+#endif
+}
+
+struct AdjustedMantissa {
+    uint64_t mantissa = 0;
+    int32_t power2 = 0;
+
+    bool operator==(AdjustedMantissa const&) const noexcept = default;
+};
+
+/**
+ * Eisel-Lemire: w * 10^q rounded to the nearest T, the 128-bit product is always sufficient
+ * (Mushtak, Lemire, "Fast number parsing without fallback")
+ */
+template <typename T>
+AdjustedMantissa computeFloat(int64_t q, uint64_t w) noexcept {
+    using F = BinaryFormat<T>;
+    AdjustedMantissa answer;
+    if (w == 0 || q < F::SMALLEST_POWER_OF_TEN) {
+        return answer;
+    }
+    if (q > F::LARGEST_POWER_OF_TEN) {
+        answer.power2 = F::INFINITE_POWER;
+        return answer;
+    }
+
+    int const lz = std::countl_zero(w);
+    w <<= lz;
+
+    auto const index = 2 * static_cast<size_t>(q - SMALLEST_POWER_OF_FIVE);
+    Value128 product = fullMultiplication(w, POWER_OF_FIVE_128[index]);
+    constexpr uint64_t precisionMask = std::numeric_limits<uint64_t>::max() >> (F::MANTISSA_BITS + 3);
+    if ((product.high & precisionMask) == precisionMask) {
+        Value128 const second = fullMultiplication(w, POWER_OF_FIVE_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            ++product.high;
+        }
+    }
+
+    int const upperBit = static_cast<int>(product.high >> 63);
+    int const shift = upperBit + 64 - F::MANTISSA_BITS - 3;
+    answer.mantissa = product.high >> shift;
+    int32_t const power = static_cast<int32_t>((((152170 + 65536) * q) >> 16) + 63); // floor(q * log2(10)) + 63
+    answer.power2 = power + upperBit - lz - F::MIN_EXPONENT;
+
+    if (answer.power2 <= 0) { // subnormal
+        if (-answer.power2 + 1 >= 64) {
+            return AdjustedMantissa{};
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (uint64_t{1} << F::MANTISSA_BITS) ? 0 : 1;
+        return answer;
+    }
+
+    // exactly between two floats: round to even
+    if (product.low <= 1 && q >= F::MIN_ROUND_TO_EVEN && q <= F::MAX_ROUND_TO_EVEN
+            && (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == product.high) {
+        answer.mantissa &= ~uint64_t{1};
+    }
+
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (uint64_t{2} << F::MANTISSA_BITS)) {
+        answer.mantissa = uint64_t{1} << F::MANTISSA_BITS;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(uint64_t{1} << F::MANTISSA_BITS);
+    if (answer.power2 >= F::INFINITE_POWER) {
+        answer.power2 = F::INFINITE_POWER;
+        answer.mantissa = 0;
+    }
+    return answer;
+}
+
+
+inline bool startsWithNoCase(char const* p, char const* last, std::string_view word) noexcept {
+    if (static_cast<size_t>(last - p) < word.size()) {
+        return false;
+    }
+    for (size_t i = 0; i != word.size(); ++i) {
+        if ((p[i] | 0x20) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::floating_point T>
+std::from_chars_result parseInfNan(char const* first, char const* p, char const* last, bool negative, T& value) noexcept {
+    if (startsWithNoCase(p, last, "inf")) {
+        p += 3;
+        if (startsWithNoCase(p, last, "inity")) {
+            p += 5;
+        }
+        value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return {p, std::errc{}};
+    }
+    if (startsWithNoCase(p, last, "nan")) {
+        p += 3;
+        if (p != last && *p == '(') {
+            char const* q = p + 1;
+            while (q != last && (isDigit(*q) || *q == '_' || ('a' <= (*q | 0x20) && (*q | 0x20) <= 'z'))) {
+                ++q;
+            }
+            if (q != last && *q == ')') {
+                p = q + 1;
+            }
+        }
+        value = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+        return {p, std::errc{}};
+    }
+    return {first, std::errc::invalid_argument};
+}
+
+/**
+ * Unsigned integer of fixed capacity for the exact comparisons of the fallback
+ */
+class BigInteger {
+public:
+    // 768 digits times a power of five of the float range with the margin
+    static constexpr size_t LIMBS = 128;
+
+    BigInteger() noexcept = default;
+
+    explicit BigInteger(uint64_t value) noexcept {
+        for (; value != 0; value >>= 32) {
+            m_limbs[m_size++] = static_cast<uint32_t>(value);
+        }
+    }
+
+    void mulAdd(uint32_t mul, uint32_t add) noexcept {
+        uint64_t carry = add;
+        for (size_t i = 0; i != m_size; ++i) {
+            uint64_t const r = static_cast<uint64_t>(m_limbs[i]) * mul + carry;
+            m_limbs[i] = static_cast<uint32_t>(r);
+            carry = r >> 32;
+        }
+        if (carry != 0) {
+            assert(m_size != LIMBS);
+            m_limbs[m_size++] = static_cast<uint32_t>(carry);
+        }
+    }
+
+    void mulPow5(uint64_t power) noexcept {
+        constexpr uint32_t POW5_13 = 1220703125;
+        for (; power >= 13; power -= 13) {
+            mulAdd(POW5_13, 0);
+        }
+        uint32_t rest = 1;
+        for (; power != 0; --power) {
+            rest *= 5;
+        }
+        mulAdd(rest, 0);
+    }
+
+    void shiftLeft(uint64_t bits) noexcept {
+        if (m_size == 0) {
+            return;
+        }
+        auto const limbs = static_cast<size_t>(bits / 32);
+        auto const shift = static_cast<unsigned>(bits % 32);
+        assert(m_size + limbs + 1 <= LIMBS);
+
+        m_limbs[m_size + limbs] = 0;
+        for (size_t i = m_size; i-- != 0;) {
+            uint64_t const moved = static_cast<uint64_t>(m_limbs[i]) << shift;
+            m_limbs[i + limbs + 1] |= static_cast<uint32_t>(moved >> 32);
+            m_limbs[i + limbs] = static_cast<uint32_t>(moved);
+        }
+        std::fill_n(m_limbs.begin(), limbs, 0);
+        m_size += limbs + 1;
+        while (m_size != 0 && m_limbs[m_size - 1] == 0) {
+            --m_size;
+        }
+    }
+
+    friend int compare(BigInteger const& lhs, BigInteger const& rhs) noexcept {
+        if (lhs.m_size != rhs.m_size) {
+            return lhs.m_size < rhs.m_size ? -1 : 1;
+        }
+        for (size_t i = lhs.m_size; i-- != 0;) {
+            if (lhs.m_limbs[i] != rhs.m_limbs[i]) {
+                return lhs.m_limbs[i] < rhs.m_limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+private:
+    std::array<uint32_t, LIMBS> m_limbs{};
+    size_t m_size = 0;
+};
+
+/**
+ * Correctly rounded digits * 10^exponent, used when the first 19 digits don't define the result.
+ * `lower` is the result of the truncated digits, the answer is it or the next float:
+ * the digits are compared exactly with the halfway point between them (fast_float's digit_comp).
+ */
+template <std::floating_point T>
+std::errc fallbackFloat(bool negative, std::string_view intDigits, std::string_view fracDigits, int64_t exponent,
+                        AdjustedMantissa lower, T& value) noexcept {
+    using F = BinaryFormat<T>;
+    // a halfway point has fewer significant digits, the rest only tells that the number is above it
+    constexpr size_t MAX_DIGITS = 768;
+
+    BigInteger digits;
+    size_t count = 0;
+    uint32_t chunk = 0;
+    uint32_t chunkPower = 1;
+    bool truncated = false;
+    for (std::string_view part : {intDigits, fracDigits}) {
+        for (char c : part) {
+            if (count == MAX_DIGITS) {
+                truncated |= c != '0';
+                ++exponent;
+                continue;
+            }
+            if (count == 0 && c == '0') {
+                continue;
+            }
+            ++count;
+            chunk = chunk * 10 + static_cast<uint32_t>(c - '0');
+            chunkPower *= 10;
+            if (chunkPower == 1000000000) {
+                digits.mulAdd(chunkPower, chunk);
+                chunk = 0;
+                chunkPower = 1;
+            }
+        }
+    }
+    digits.mulAdd(chunkPower, chunk + (truncated ? 1 : 0));
+
+    // lower = m * 2^e, the halfway point is (2m + 1) * 2^(e - 1)
+    auto bits = static_cast<uint64_t>(lower.mantissa | (static_cast<uint64_t>(lower.power2) << F::MANTISSA_BITS));
+    uint64_t const power2 = bits >> F::MANTISSA_BITS;
+    uint64_t const mantissa = (bits & ((uint64_t{1} << F::MANTISSA_BITS) - 1)) | (power2 != 0 ? uint64_t{1} << F::MANTISSA_BITS : 0);
+    int64_t const halfwayPower2 = static_cast<int64_t>(std::max<uint64_t>(power2, 1)) + F::MIN_EXPONENT - F::MANTISSA_BITS - 1;
+
+    BigInteger halfway{2 * mantissa + 1};
+
+    // digits * 5^exponent * 2^exponent <=> halfway * 2^halfwayPower2
+    if (exponent >= 0) {
+        digits.mulPow5(static_cast<uint64_t>(exponent));
+    } else {
+        halfway.mulPow5(static_cast<uint64_t>(-exponent));
+    }
+    if (exponent >= halfwayPower2) {
+        digits.shiftLeft(static_cast<uint64_t>(exponent - halfwayPower2));
+    } else {
+        halfway.shiftLeft(static_cast<uint64_t>(halfwayPower2 - exponent));
+    }
+
+    int const order = compare(digits, halfway);
+    bits += order > 0 || (order == 0 && (bits & 1) != 0) ? 1 : 0;
+    if (bits == 0 || (bits >> F::MANTISSA_BITS) >= static_cast<uint64_t>(F::INFINITE_POWER)) {
+        return std::errc::result_out_of_range;
+    }
+
+    if (negative) {
+        bits |= uint64_t{1} << (sizeof(typename F::Bits) * 8 - 1);
+    }
+    value = std::bit_cast<T>(static_cast<typename F::Bits>(bits));
+    return std::errc{};
+}
+
+
+/**
+ * Floating point number with the semantic of std::from_chars (general format) or the JSON grammar:
+ * SWAR digits, Clinger's fast path, Eisel-Lemire, correctly rounded fallback for more than 19 significant digits.
+ * Results that are out of range of T (overflow or underflow to zero) are result_out_of_range.
+ */
+template <NumberFormat format = NumberFormat::General, std::floating_point T>
+    requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+std::from_chars_result parseFloat(char const* first, char const* last, T& value) {
+    using F = BinaryFormat<T>;
+    char const* p = first;
+    bool const negative = p != last && *p == '-';
+    p += negative ? 1 : 0;
+
+    if constexpr (format == NumberFormat::General) {
+        if (p != last && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+            return parseInfNan(first, p, last, negative, value);
+        }
+    }
+
+    uint64_t w = 0;
+    char const* const intStart = p;
+    if (format == NumberFormat::Json && p != last && *p == '0') {
+        ++p;
+    } else {
+        p = accumulateDigits(p, last, w);
+    }
+    char const* const intEnd = p;
+
+    char const* fracStart = p;
+    char const* fracEnd = p;
+    if (p != last && *p == '.') {
+        fracStart = p + 1;
+        fracEnd = accumulateDigits(fracStart, last, w);
+        if (format == NumberFormat::General || fracEnd != fracStart) {
+            p = fracEnd;
+        } else {
+            fracStart = fracEnd = intEnd;
+        }
+    }
+
+    size_t digits = static_cast<size_t>((intEnd - intStart) + (fracEnd - fracStart));
+    if (digits == 0 || (format == NumberFormat::Json && intEnd == intStart)) {
+        return {first, std::errc::invalid_argument};
+    }
+
+    int64_t explicitExponent = 0;
+    if (p != last && (*p | 0x20) == 'e') {
+        char const* q = p + 1;
+        bool expNegative = false;
+        if (q != last && (*q == '+' || *q == '-')) {
+            expNegative = *q == '-';
+            ++q;
+        }
+        if (q != last && isDigit(*q)) {
+            constexpr int64_t EXPONENT_LIMIT = 0x10000000;
+            for (; q != last && isDigit(*q); ++q) {
+                if (explicitExponent < EXPONENT_LIMIT) {
+                    explicitExponent = explicitExponent * 10 + (*q - '0');
+                }
+            }
+            explicitExponent = expNegative ? -explicitExponent : explicitExponent;
+            p = q;
+        }
+    }
+    int64_t exponent = explicitExponent - (fracEnd - fracStart);
+
+    constexpr size_t MAX_DIGITS = 19;
+    bool tooManyDigits = false;
+    if (digits > MAX_DIGITS) {
+        for (char const* s = intStart; s != fracEnd && (*s == '0' || *s == '.'); ++s) {
+            digits -= *s == '0' ? 1 : 0;
+        }
+        if (digits > MAX_DIGITS) {
+            // keep the first 19 significant digits, the exponent is corrected to the truncated value
+            tooManyDigits = true;
+            constexpr uint64_t MIN_NINETEEN_DIGITS = 1000000000000000000;
+            w = 0;
+            char const* s = intStart;
+            for (; w < MIN_NINETEEN_DIGITS && s != intEnd; ++s) {
+                w = w * 10 + static_cast<uint64_t>(*s - '0');
+            }
+            if (w >= MIN_NINETEEN_DIGITS) {
+                exponent = (intEnd - s) + explicitExponent;
+            } else {
+                s = fracStart;
+                for (; w < MIN_NINETEEN_DIGITS && s != fracEnd; ++s) {
+                    w = w * 10 + static_cast<uint64_t>(*s - '0');
+                }
+                exponent = (fracStart - s) + explicitExponent;
+            }
+        }
+    }
+
+    if (EXACT_FLOAT_EVAL && !tooManyDigits && -F::MAX_EXPONENT_FAST_PATH <= exponent && exponent <= F::MAX_EXPONENT_FAST_PATH
+            && w <= F::MAX_MANTISSA_FAST_PATH) {
+        auto out = static_cast<T>(w);
+        out = exponent < 0 ? out / F::POWERS_OF_TEN[-exponent] : out * F::POWERS_OF_TEN[exponent];
+        value = negative ? -out : out;
+        return {p, std::errc{}};
+    }
+
+    auto am = computeFloat<T>(exponent, w);
+    if (tooManyDigits && am != computeFloat<T>(exponent, w + 1)) {
+        return {p, fallbackFloat(negative, std::string_view(intStart, intEnd), std::string_view(fracStart, fracEnd),
+                                 explicitExponent - (fracEnd - fracStart), am, value)};
+    }
+
+    if (am.power2 == F::INFINITE_POWER || (am.power2 == 0 && am.mantissa == 0 && w != 0)) {
+        return {p, std::errc::result_out_of_range};
+    }
+
+    auto bits = static_cast<typename F::Bits>(am.mantissa | (static_cast<uint64_t>(am.power2) << F::MANTISSA_BITS));
+    if (negative) {
+        bits |= typename F::Bits{1} << (sizeof(bits) * 8 - 1);
+    }
+    value = std::bit_cast<T>(bits);
+    return {p, std::errc{}};
+}
+
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <parsecpp/core/parser.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace prs {
+
+namespace details {
+
+struct ChunkBounds {
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * Split [begin, end) of the full stream by points found by resync from the uniform offsets
+ */
+template <ParserType Resync>
+std::vector<ChunkBounds> splitByRecords(std::string_view full, size_t begin, size_t chunks, Resync const& resync) {
+    std::vector<ChunkBounds> bounds;
+    bounds.reserve(chunks);
+
+    size_t const end = full.size();
+    size_t const size = end - begin;
+    size_t last = begin;
+    for (size_t i = 1; i < chunks; ++i) {
+        size_t const target = begin + size / chunks * i;
+        if (target <= last) {
+            continue;
+        }
+
+        Stream stream{full};
+        stream.restorePos(target);
+        if (resync(stream).isError()) {
+            break;
+        }
+
+        if (size_t const point = stream.pos(); point > last && point < end) {
+            bounds.push_back(ChunkBounds{last, point});
+            last = point;
+        }
+    }
+    bounds.push_back(ChunkBounds{last, end});
+    return bounds;
+}
+
+}
+
+
+/**
+ * Parallel version of `item.repeat()` for top-level parsers of big inputs, e.g. `skipToNext(record, searchText("\n"))`.
+ * The remaining stream is split at points found by resync (searched from uniform offsets),
+ * the chunks are parsed by the pool of threads and the results are concatenated in order.
+ * As in `repeat`, parsing stops after the first failed item, the stream is moved to that position.
+ * If an item fails at the end of a chunk, it is retried on the full stream and parsing continues sequentially
+ * until it meets the beginning of the next chunk.
+ * Each chunk is a prefix of the original stream, so all positions (errors, get_sv) are global.
+ * Item must not read behind the resync point and must be safe to call from several threads.
+ * @param threads 0 - std::thread::hardware_concurrency()
+ * @param minChunkSize smaller inputs are not split
+ * @return Parser<std::vector<A>>::Result, the same as item.repeat()
+ */
+template <size_t maxIteration = MAX_ITERATION, ParserType Item, ParserType Resync>
+    requires(IsVoidCtx<GetParserCtx<Item>> && IsVoidCtx<GetParserCtx<Resync>> && !std::is_same_v<GetParserResult<Item>, Drop>)
+auto parallelRepeat(Stream& stream, Item const& item, Resync const& resync, size_t threads = 0, size_t minChunkSize = 1 << 16)
+        noexcept(false) -> details::ResultType<std::vector<GetParserResult<Item>>> {
+    using Value = GetParserResult<Item>;
+    using P = Parser<std::vector<Value>>;
+    using ChunkResult = details::ResultType<std::vector<Value>>;
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto const full = stream.full();
+    size_t const begin = stream.pos();
+    size_t const chunks = threads == 1 ? 1 : std::min(threads * CHUNKS_PER_THREAD, std::max<size_t>(1, (full.size() - begin) / std::max<size_t>(1, minChunkSize)));
+    auto const bounds = details::splitByRecords(full, begin, chunks, resync);
+
+    auto const repeat = item.template repeat<0, maxIteration>();
+    std::vector<std::optional<ChunkResult>> results(bounds.size());
+    std::vector<size_t> stops(bounds.size());
+    std::vector<std::exception_ptr> exceptions(bounds.size());
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < bounds.size(); i = next++) {
+            Stream chunk{full.substr(0, bounds[i].end)};
+            chunk.restorePos(bounds[i].begin);
+            try {
+                results[i].emplace(repeat(chunk));
+            } catch (...) {
+                exceptions[i] = std::current_exception();
+            }
+            stops[i] = chunk.pos();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(std::min(threads, bounds.size()) - 1);
+    for (size_t i = 1; i < std::min(threads, bounds.size()); ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // The item can fail at the end of a chunk only because it needs the next one (skipToNext),
+    // so parse sequentially from the stop point until it reaches the beginning of a parsed chunk
+    std::vector<Value> out{};
+    size_t total = 0;
+    for (auto const& result : results) {
+        if (result && !result->isError()) {
+            total += result->data().size();
+        }
+    }
+
+    Stream tail{full};
+    size_t pos = begin;
+    size_t i = 0;
+    while (true) {
+        while (i != bounds.size() && bounds[i].begin < pos) {
+            ++i;
+        }
+
+        if (i != bounds.size() && bounds[i].begin == pos) {
+            if (exceptions[i]) {
+                std::rethrow_exception(exceptions[i]);
+            }
+
+            // maxIteration counts the whole result, the chunk reaching it is parsed sequentially
+            auto& result = *results[i];
+            if (result.isError() || out.size() + result.data().size() >= maxIteration) {
+                i = bounds.size();
+                continue;
+            }
+
+            pos = stops[i];
+            auto data = std::move(result).data();
+            if (out.empty()) {
+                out = std::move(data);
+                out.reserve(total);
+            } else {
+                out.insert(out.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+            }
+            ++i;
+        } else {
+            tail.restorePos(pos);
+            auto result = item(tail);
+            if (result.isError()) {
+                break;
+            }
+            out.emplace_back(std::move(result).data());
+            pos = tail.pos();
+            if (out.size() == maxIteration) {
+                stream.restorePos(pos);
+                return P::makeError("Max iteration", pos);
+            }
+        }
+    }
+
+    stream.restorePos(pos);
+    return P::data(std::move(out));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+/**
+ * Vector with the first `inlineCapacity` items stored inside the object, the heap is used only past it.
+ * Moving an inline vector moves its items one by one.
+ */
+template <typename T, size_t inlineCapacity>
+class SmallVector {
+    static_assert(inlineCapacity > 0, "Use std::vector for the zero inline capacity");
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> init) {
+        reserve(init.size());
+        for (auto const& item : init) {
+            emplace_back(item);
+        }
+    }
+
+    SmallVector(SmallVector const& other) {
+        reserve(other.size());
+        for (auto const& item : other) {
+            emplace_back(item);
+        }
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        steal(other);
+    }
+
+    SmallVector& operator=(SmallVector const& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            for (auto const& item : other) {
+                emplace_back(item);
+            }
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            freeHeap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        freeHeap();
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        T* item = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+        ++m_size;
+        return *item;
+    }
+
+    void push_back(T const& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        std::destroy_at(m_data + --m_size);
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > m_capacity) {
+            grow(capacity);
+        }
+    }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        m_size = 0;
+    }
+
+    /**
+     * true while the items are stored in the object itself
+     */
+    bool isInline() const noexcept {
+        return m_data == inlineData();
+    }
+
+    T& operator[](size_t i) noexcept {
+        return m_data[i];
+    }
+
+    T const& operator[](size_t i) const noexcept {
+        return m_data[i];
+    }
+
+    T& front() noexcept {
+        return m_data[0];
+    }
+
+    T const& front() const noexcept {
+        return m_data[0];
+    }
+
+    T& back() noexcept {
+        return m_data[m_size - 1];
+    }
+
+    T const& back() const noexcept {
+        return m_data[m_size - 1];
+    }
+
+    T* data() noexcept {
+        return m_data;
+    }
+
+    T const* data() const noexcept {
+        return m_data;
+    }
+
+    iterator begin() noexcept {
+        return m_data;
+    }
+
+    iterator end() noexcept {
+        return m_data + m_size;
+    }
+
+    const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    friend bool operator==(SmallVector const& lhs, SmallVector const& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+private:
+    T* inlineData() noexcept {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    T const* inlineData() const noexcept {
+        return reinterpret_cast<T const*>(m_inline);
+    }
+
+    void grow(size_t capacity) {
+        T* heap = std::allocator<T>{}.allocate(capacity);
+        try {
+            relocate(heap);
+        } catch (...) {
+            std::allocator<T>{}.deallocate(heap, capacity);
+            throw;
+        }
+        adopt(heap, capacity);
+    }
+
+    /**
+     * The arguments can refer to the old items, so the new item is constructed before they are moved
+     */
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        size_t const capacity = m_capacity * 2;
+        T* heap = std::allocator<T>{}.allocate(capacity);
+        T* item = nullptr;
+        try {
+            item = std::construct_at(heap + m_size, std::forward<Args>(args)...);
+            relocate(heap);
+        } catch (...) {
+            if (item) {
+                std::destroy_at(item);
+            }
+            std::allocator<T>{}.deallocate(heap, capacity);
+            throw;
+        }
+        adopt(heap, capacity);
+        ++m_size;
+        return *item;
+    }
+
+    /**
+     * Move the items to `heap`, on an exception the moved ones are destroyed and the old ones are kept
+     */
+    void relocate(T* heap) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(begin(), end(), heap);
+        } else {
+            std::uninitialized_copy(begin(), end(), heap);
+        }
+    }
+
+    void adopt(T* heap, size_t capacity) noexcept {
+        std::destroy(begin(), end());
+        freeHeap();
+        m_data = heap;
+        m_capacity = capacity;
+    }
+
+    void freeHeap() noexcept {
+        if (!isInline()) {
+            std::allocator<T>{}.deallocate(m_data, m_capacity);
+            m_data = inlineData();
+            m_capacity = inlineCapacity;
+        }
+    }
+
+    /**
+     * this must be empty and inline
+     */
+    void steal(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), m_data);
+            m_size = other.m_size;
+            other.clear();
+        } else {
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, inlineCapacity);
+        }
+    }
+
+    alignas(T) std::byte m_inline[sizeof(T) * inlineCapacity];
+    T* m_data = inlineData();
+    size_t m_size = 0;
+    size_t m_capacity = inlineCapacity;
+};
+
+}
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace prs {
@@ -314,7 +315,8 @@ decltype(auto) get(Ctx& ctx) noexcept {
         return ctx.get();
     } else {
         using TypeWrapper = details::GetTypeWrapper<Ctx, T>;
-        return static_cast<ContextWrapper<TypeWrapper>>(ctx).get();
+        using Base = std::conditional_t<std::is_const_v<Ctx>, ContextWrapper<TypeWrapper> const&, ContextWrapper<TypeWrapper>&>;
+        return static_cast<Base>(ctx).get();
     }
 }
 
@@ -341,53 +343,475 @@ static constexpr bool DISABLE_ERROR_LOG = true;
 #define PRS_MAKE_ERROR(strError, pos) makeError(pos);
 #endif
 
+#ifndef PRS_LAZY_ERROR_LOG
+static constexpr bool LAZY_ERROR_LOG = false;
+#else
+static constexpr bool LAZY_ERROR_LOG = true;
+#endif
+
+#ifndef PRS_COMPACT_ERROR
+static constexpr bool COMPACT_ERROR = false;
+#else
+static constexpr bool COMPACT_ERROR = true;
+#endif
+
+#ifndef PRS_DISABLE_SIMD
+static constexpr bool DISABLE_SIMD = false;
+#else
+static constexpr bool DISABLE_SIMD = true;
+#endif
+
 static constexpr size_t MAX_ITERATION = 1'000'000;
 
 }
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace prs::details {
 
+/**
+ * Pointer to a null-terminated text that lives until the end of the program: a string literal or an interned string.
+ * The lazy errors keep only such texts.
+ */
+class StaticText {
+public:
+    constexpr StaticText() noexcept = default;
+
+    /**
+     * A string literal or a constant array, an array filled at runtime isn't a constant expression and doesn't compile
+     */
+    template <size_t N>
+    consteval StaticText(char const(&s)[N])
+        : m_text(s) {
+        if (s[N - 1] != '\0') {
+            throw "StaticText requires a null-terminated array";
+        }
+    }
+
+    /**
+     * The text must have the static storage duration (a constant or a template parameter object)
+     */
+    static constexpr StaticText fromStatic(char const* s) noexcept {
+        return StaticText{std::in_place, s};
+    }
+
+    /**
+     * Copy of the text that is never freed, equal texts share the copy
+     */
+    static StaticText intern(std::string_view s) {
+        static std::mutex mutex;
+        static std::set<std::string, std::less<>> texts;
+
+        std::lock_guard lock{mutex};
+        auto it = texts.find(s);
+        if (it == texts.end()) {
+            it = texts.emplace(s).first;
+        }
+        return StaticText{std::in_place, it->c_str()};
+    }
+
+    constexpr char const* c_str() const noexcept {
+        return m_text;
+    }
+
+    constexpr std::string_view sv() const noexcept {
+        return m_text;
+    }
+
+    constexpr operator std::string_view() const noexcept {
+        return m_text;
+    }
+private:
+    constexpr StaticText(std::in_place_t, char const* s) noexcept
+        : m_text(s) {}
+
+    char const* m_text = "";
+};
+
+/**
+ * Runtime text of the default errors, copies of an error share it
+ */
+using SharedText = std::shared_ptr<std::string const>;
+
 template <bool disableDescription>
 struct ParsingErrorT;
 
 template <>
-struct ParsingErrorT<false> {
+struct ParsingErrorT<true> {
     ParsingErrorT() = default;
 
-    explicit ParsingErrorT(std::string_view s, size_t p) noexcept
-        : description(s), pos(p) {};
+    explicit ParsingErrorT(StaticText, size_t p) noexcept
+        : pos(p) {};
 
     explicit ParsingErrorT(size_t p) noexcept
         : pos(p) {};
 
     std::string_view getDescription() const noexcept {
-        return description;
+        return "";
+    }
+
+    static ParsingErrorT orError(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        return ParsingErrorT{std::max(first.pos, second.pos)};
+    }
+
+    static ParsingErrorT internalError(ParsingErrorT const&, size_t p) noexcept {
+        return ParsingErrorT{p};
+    }
+
+    static ParsingErrorT quoted(StaticText, StaticText, size_t p) noexcept {
+        return ParsingErrorT{p};
+    }
+
+    size_t pos{};
+};
+
+/**
+ * Error of the lazy mode, without allocations: keeps pointers to static descriptions and formats them only in getDescription().
+ * Descriptions and quotes are StaticText, a runtime text must be interned.
+ * `|` keeps only the furthest failure with the set of expected descriptions (Parsec style),
+ * the set is limited by MAX_EXPECTED. The quote of a single description takes the second slot of the set.
+ */
+struct LazyParsingError {
+    static constexpr size_t MAX_EXPECTED = 4;
+
+    constexpr LazyParsingError() = default;
+
+    constexpr explicit LazyParsingError(StaticText s, size_t p) noexcept
+        : pos(p), expected{s.c_str()}, count(1) {};
+
+    constexpr explicit LazyParsingError(size_t p) noexcept
+        : pos(p) {};
+
+    std::string getDescription() const {
+        std::string out = internal ? "Internal parser fail: " : "";
+        if (count > 1 || truncated) {
+            out += "Expected one of: ";
+            for (size_t i = 0; i != count; ++i) {
+                out.append(i == 0 ? "" : ", ").append(expected[i]);
+            }
+            if (truncated) {
+                out += ", ...";
+            }
+        } else if (count == 1) {
+            out += expected[0];
+        }
+
+        if (hasQuote) {
+            out.append(" '").append(expected[1]).append("'");
+        }
+        return out;
+    }
+
+    constexpr bool contains(char const* description) const noexcept {
+        for (size_t i = 0; i != count; ++i) {
+            if (expected[i] == description || std::string_view{expected[i]} == description) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr LazyParsingError orError(LazyParsingError const& first, LazyParsingError const& second) noexcept {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+
+        LazyParsingError out{first.pos};
+        out.truncated = first.truncated || second.truncated;
+        for (auto const* error : {&first, &second}) {
+            for (size_t i = 0; i != error->count; ++i) {
+                if (out.contains(error->expected[i])) {
+                    continue;
+                } else if (out.count == MAX_EXPECTED) {
+                    out.truncated = true;
+                } else {
+                    out.expected[out.count++] = error->expected[i];
+                }
+            }
+        }
+        return out;
+    }
+
+    static constexpr LazyParsingError internalError(LazyParsingError const& error, size_t p) noexcept {
+        LazyParsingError out = error;
+        out.pos = p;
+        out.internal = true;
+        return out;
+    }
+
+    static constexpr LazyParsingError quoted(StaticText s, StaticText q, size_t p) noexcept {
+        LazyParsingError out{s, p};
+        out.expected[1] = q.c_str();
+        out.hasQuote = true;
+        return out;
     }
 
-    std::string description;
     size_t pos{};
+    std::array<char const*, MAX_EXPECTED> expected{};
+    uint8_t count = 0;
+    bool truncated = false;
+    bool internal = false;
+    bool hasQuote = false;
 };
 
+/**
+ * Error of the default mode: LazyParsingError that can also keep one runtime text, a description of the set or the quote.
+ * `|` of two errors with different runtime texts keeps the text of the first one.
+ * A move copies the text handle, so a moved-from error still has a valid description.
+ */
 template <>
-struct ParsingErrorT<true> {
+struct ParsingErrorT<false> : LazyParsingError {
     ParsingErrorT() = default;
 
-    explicit ParsingErrorT(std::string_view s, size_t p) noexcept
-        : pos(p) {};
+    ParsingErrorT(ParsingErrorT const&) = default;
+    ParsingErrorT& operator=(ParsingErrorT const&) = default;
+
+    explicit ParsingErrorT(StaticText s, size_t p) noexcept
+        : LazyParsingError(s, p) {};
+
+    explicit ParsingErrorT(SharedText s, size_t p) noexcept
+        : LazyParsingError(StaticText{}, p), text(std::move(s)) {
+        expected[0] = text->c_str();
+    }
 
     explicit ParsingErrorT(size_t p) noexcept
-        : pos(p) {};
+        : LazyParsingError(p) {};
 
-    std::string_view getDescription() const noexcept {
-        return "";
+    static ParsingErrorT orError(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        if (!first.text && !second.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), nullptr};
+        }
+        return orErrorOfTexts(first, second);
+    }
+
+    static ParsingErrorT internalError(ParsingErrorT const& error, size_t p) noexcept {
+        return ParsingErrorT{LazyParsingError::internalError(error, p), error.text};
+    }
+
+    static ParsingErrorT quoted(StaticText s, StaticText q, size_t p) noexcept {
+        return ParsingErrorT{LazyParsingError::quoted(s, q, p), nullptr};
+    }
+
+    static ParsingErrorT quoted(StaticText s, SharedText q, size_t p) noexcept {
+        ParsingErrorT out{LazyParsingError::quoted(s, StaticText{}, p), std::move(q)};
+        out.expected[1] = out.text->c_str();
+        return out;
+    }
+
+    SharedText text;
+private:
+    ParsingErrorT(LazyParsingError const& error, SharedText t) noexcept
+        : LazyParsingError(error), text(std::move(t)) {};
+
+    // out of the fast path of `|`
+    static ParsingErrorT orErrorOfTexts(ParsingErrorT const& first, ParsingErrorT const& second) noexcept {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+        if (!second.text || second.text == first.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), first.text};
+        }
+        if (!first.text) {
+            return ParsingErrorT{LazyParsingError::orError(first, second), second.text};
+        }
+
+        LazyParsingError rest = second;
+        rest.count = 0;
+        for (size_t i = 0; i != second.count; ++i) {
+            if (second.expected[i] != second.text->c_str()) {
+                rest.expected[rest.count++] = second.expected[i];
+            } else if (!first.contains(second.expected[i])) {
+                rest.truncated = true;
+            }
+        }
+        return ParsingErrorT{LazyParsingError::orError(first, rest), first.text};
+    }
+};
+
+/**
+ * Error of the compact mode: the position and a handle of LazyParsingError that lives out of line,
+ * in a per-thread free list of reference counted nodes. A result is T + 16 bytes instead of T + sizeof(LazyParsingError),
+ * a result of an empty T is only the handle (the null handle is the success).
+ * Copies share the node with an atomic counter, the last copy returns it to the free list of its thread.
+ */
+class CompactParsingError {
+    struct Node {
+        LazyParsingError error;
+        std::atomic<uint32_t> refs = 1;
+        Node* next = nullptr;
+    };
+
+    enum PoolState : uint8_t {
+        NO_POOL,
+        POOL_ALIVE,
+        POOL_DESTROYED
+    };
+
+    // trivially initialized, so the fast path has no thread_local guard
+    static inline thread_local Node* t_free = nullptr;
+    static inline thread_local PoolState t_pool = NO_POOL;
+
+    struct PoolOwner {
+        PoolOwner() noexcept {
+            t_pool = POOL_ALIVE;
+        }
+
+        ~PoolOwner() {
+            t_pool = POOL_DESTROYED;
+            while (t_free) {
+                delete std::exchange(t_free, t_free->next);
+            }
+        }
+    };
+
+    static Node* allocate(LazyParsingError const& error) {
+        if (Node* node = t_free) {
+            t_free = node->next;
+            node->error = error;
+            node->refs.store(1, std::memory_order_relaxed);
+            return node;
+        }
+        return new Node{error};
+    }
+
+    // nodes enter a free list only here, so the pool owner of the thread is created here
+    static void release(Node* node) noexcept {
+        if (t_pool != POOL_ALIVE && !createPool()) {
+            delete node; // the thread is exiting
+            return;
+        }
+        node->next = t_free;
+        t_free = node;
+    }
+
+    static bool createPool() noexcept {
+        if (t_pool == NO_POOL) {
+            thread_local PoolOwner owner; // frees the nodes of the thread
+            (void)owner;
+        }
+        return t_pool == POOL_ALIVE;
+    }
+
+    // errors without a description don't allocate
+    static Node* emptyNode() noexcept {
+        static Node empty{};
+        return &empty;
+    }
+
+    CompactParsingError(size_t p, Node* node) noexcept
+        : pos(p), m_node(node) {};
+public:
+    CompactParsingError() noexcept
+        : m_node(emptyNode()) {};
+
+    explicit CompactParsingError(StaticText s, size_t p)
+        : pos(p), m_node(allocate(LazyParsingError{s, p})) {};
+
+    explicit CompactParsingError(size_t p) noexcept
+        : pos(p), m_node(emptyNode()) {};
+
+    CompactParsingError(CompactParsingError const& other) noexcept
+        : pos(other.pos), m_node(other.m_node) {
+        if (m_node && m_node != emptyNode()) {
+            m_node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // a moved-from error stays an error (or the niche)
+    CompactParsingError(CompactParsingError&& other) noexcept
+        : pos(other.pos), m_node(std::exchange(other.m_node, other.m_node ? emptyNode() : nullptr)) {};
+
+    CompactParsingError& operator=(CompactParsingError other) noexcept {
+        pos = other.pos;
+        std::swap(m_node, other.m_node);
+        return *this;
+    }
+
+    ~CompactParsingError() noexcept {
+        if (m_node && m_node != emptyNode() && m_node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            release(m_node);
+        }
+    }
+
+    static CompactParsingError niche() noexcept {
+        return CompactParsingError{0, nullptr};
+    }
+
+    bool isNiche() const noexcept {
+        return m_node == nullptr;
+    }
+
+    std::string getDescription() const {
+        return m_node ? m_node->error.getDescription() : std::string{};
+    }
+
+    static CompactParsingError orError(CompactParsingError const& first, CompactParsingError const& second) {
+        if (first.pos != second.pos) {
+            return first.pos > second.pos ? first : second;
+        }
+        return make(LazyParsingError::orError(first.lazy(), second.lazy()));
+    }
+
+    static CompactParsingError internalError(CompactParsingError const& error, size_t p) {
+        return make(LazyParsingError::internalError(error.lazy(), p));
+    }
+
+    static CompactParsingError quoted(StaticText s, StaticText q, size_t p) {
+        return make(LazyParsingError::quoted(s, q, p));
     }
 
     size_t pos{};
+private:
+    LazyParsingError lazy() const noexcept {
+        LazyParsingError out = m_node ? m_node->error : LazyParsingError{};
+        out.pos = pos;
+        return out;
+    }
+
+    static CompactParsingError make(LazyParsingError const& error) {
+        return CompactParsingError{error.pos, allocate(error)};
+    }
+
+    Node* m_node;
 };
 
-using ParsingError = ParsingErrorT<DISABLE_ERROR_LOG>;
+using ParsingError = std::conditional_t<DISABLE_ERROR_LOG
+        , ParsingErrorT<true>
+        , std::conditional_t<COMPACT_ERROR, CompactParsingError
+        , std::conditional_t<LAZY_ERROR_LOG, LazyParsingError, ParsingErrorT<false>>>>;
+
+/**
+ * The lazy and compact modes accept only static descriptions, the default mode also keeps runtime ones
+ */
+static constexpr bool STATIC_ERROR_TEXT = !DISABLE_ERROR_LOG && (LAZY_ERROR_LOG || COMPACT_ERROR);
+
+/**
+ * Runtime text that a parser keeps for its errors
+ */
+using ErrorText = std::conditional_t<DISABLE_ERROR_LOG || STATIC_ERROR_TEXT, StaticText, SharedText>;
+
+/**
+ * Interned only in the modes with static descriptions, dropped without the error log
+ */
+template <typename Text = ErrorText>
+Text keepErrorText(std::string_view text) {
+    if constexpr (DISABLE_ERROR_LOG) {
+        return {};
+    } else if constexpr (STATIC_ERROR_TEXT) {
+        return StaticText::intern(text);
+    } else {
+        return std::make_shared<std::string const>(text);
+    }
+}
 
 }
 
@@ -599,50 +1023,44 @@ constexpr decltype(auto) repeatF(T t, Fn op) noexcept(std::is_nothrow_invocable_
 }
 
 
+#include <concepts>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <cassert>
 
 
 namespace prs {
 
-template <typename T, typename Error>
-    requires(!std::same_as<std::decay_t<T>, std::decay_t<Error>>)
-class Expected {
-public:
-    using Body = T;
-
-    template<typename OnSuccess, typename OnError = details::Id>
-    static constexpr bool map_nothrow = std::is_nothrow_invocable_v<OnSuccess, T const&>
-                    && std::is_nothrow_invocable_v<OnError, Error const&>;
-
-    template<typename OnSuccess, typename OnError = details::Id>
-    static constexpr bool map_move_nothrow = std::is_nothrow_invocable_v<OnSuccess, T>
-                    && std::is_nothrow_invocable_v<OnError, Error>;
-
-    constexpr explicit Expected(T &&t) noexcept(std::is_nothrow_move_constructible_v<T>)
-        : m_isError(false)
-        , m_data(std::move(t)) {
-
-    }
+namespace details {
 
+/**
+ * Error type with a state that is never a real error, Expected<Empty, Error> stores only the error
+ */
+template <typename Error>
+concept NicheError = requires(Error const& error) {
+    { Error::niche() } -> std::same_as<Error>;
+    { error.isNiche() } -> std::convertible_to<bool>;
+};
 
-    constexpr explicit Expected(T const& t) noexcept(std::is_nothrow_copy_constructible_v<T>)
+template <typename T, typename Error>
+class ExpectedStorage {
+public:
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<0>, U&& t) noexcept(std::is_nothrow_constructible_v<T, U&&>)
         : m_isError(false)
-        , m_data(t) {
+        , m_data(std::forward<U>(t)) {
 
     }
 
-    constexpr explicit Expected(Error &&error) noexcept(std::is_nothrow_move_constructible_v<Error>)
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<1>, U&& error) noexcept(std::is_nothrow_constructible_v<Error, U&&>)
         : m_isError(true)
-        , m_error(std::move(error)) {
-    }
+        , m_error(std::forward<U>(error)) {
 
-    constexpr explicit Expected(Error const& error) noexcept(std::is_nothrow_copy_constructible_v<Error>)
-        : m_isError(true)
-        , m_error(error) {
     }
 
-    constexpr Expected(Expected<T, Error> const& e) noexcept
+    constexpr ExpectedStorage(ExpectedStorage const& e) noexcept
         : m_isError(e.m_isError) {
 
         if (isError()) {
@@ -652,7 +1070,17 @@ public:
         }
     }
 
-    ~Expected() noexcept {
+    constexpr ExpectedStorage(ExpectedStorage&& e) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<Error>)
+        : m_isError(e.m_isError) {
+
+        if (isError()) {
+            new (&m_error)Error(std::move(e.m_error));
+        } else {
+            new (&m_data)T(std::move(e.m_data));
+        }
+    }
+
+    ~ExpectedStorage() noexcept {
         if (isError()) {
             std::destroy_at(&m_error);
         } else {
@@ -664,46 +1092,152 @@ public:
         return m_isError;
     }
 
-    T const& data() const& noexcept {
-        assert(!isError());
+    constexpr T& storedData() noexcept {
         return m_data;
     }
 
-    T data() && noexcept {
-        assert(!isError());
-        return std::move(m_data);
+    constexpr T const& storedData() const noexcept {
+        return m_data;
     }
 
-    Error const& error() const& noexcept {
-        assert(isError());
+    constexpr Error& storedError() noexcept {
         return m_error;
     }
 
-    Error error() && noexcept {
-        assert(isError());
-        return std::move(m_error);
+    constexpr Error const& storedError() const noexcept {
+        return m_error;
     }
+private:
+    bool m_isError;
 
+    union {
+        T m_data;
+        Error m_error;
+    };
+};
 
-    template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
-    auto join(OnSuccess onSuccess, OnError onError) const&
-                    noexcept(map_nothrow<OnSuccess, OnError>) {
-
-//        using Result = std::common_type_t<std::invoke_result_t<OnSuccess, const T&>,
-//                    std::invoke_result_t<OnError, const Error&>>;
+/**
+ * Empty T: the niche of the error is the success
+ */
+template <typename T, NicheError Error>
+    requires(std::is_empty_v<T>)
+class ExpectedStorage<T, Error> {
+public:
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<0>, U&& t) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+        : m_data(std::forward<U>(t))
+        , m_error(Error::niche()) {
 
-        return isError() ? onError(m_error) : onSuccess(m_data);
     }
 
+    template <typename U>
+    constexpr explicit ExpectedStorage(std::in_place_index_t<1>, U&& error) noexcept(std::is_nothrow_constructible_v<Error, U&&>)
+        : m_error(std::forward<U>(error)) {
 
-    template<std::invocable<T> OnSuccess, std::invocable<Error> OnError>
-    auto join(OnSuccess onSuccess, OnError onError) &&
+    }
+
+    constexpr bool isError() const noexcept {
+        return !m_error.isNiche();
+    }
+
+    constexpr T& storedData() noexcept {
+        return m_data;
+    }
+
+    constexpr T const& storedData() const noexcept {
+        return m_data;
+    }
+
+    constexpr Error& storedError() noexcept {
+        return m_error;
+    }
+
+    constexpr Error const& storedError() const noexcept {
+        return m_error;
+    }
+private:
+    [[no_unique_address]] T m_data;
+    Error m_error;
+};
+
+}
+
+template <typename T, typename Error>
+    requires(!std::same_as<std::decay_t<T>, std::decay_t<Error>>)
+class Expected : private details::ExpectedStorage<T, Error> {
+    using Storage = details::ExpectedStorage<T, Error>;
+public:
+    using Storage::isError;
+
+    using Body = T;
+
+    template<typename OnSuccess, typename OnError = details::Id>
+    static constexpr bool map_nothrow = std::is_nothrow_invocable_v<OnSuccess, T const&>
+                    && std::is_nothrow_invocable_v<OnError, Error const&>;
+
+    template<typename OnSuccess, typename OnError = details::Id>
+    static constexpr bool map_move_nothrow = std::is_nothrow_invocable_v<OnSuccess, T>
+                    && std::is_nothrow_invocable_v<OnError, Error>;
+
+    constexpr explicit Expected(T &&t) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : Storage(std::in_place_index<0>, std::move(t)) {
+
+    }
+
+
+    constexpr explicit Expected(T const& t) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : Storage(std::in_place_index<0>, t) {
+
+    }
+
+    constexpr explicit Expected(Error &&error) noexcept(std::is_nothrow_move_constructible_v<Error>)
+        : Storage(std::in_place_index<1>, std::move(error)) {
+    }
+
+    constexpr explicit Expected(Error const& error) noexcept(std::is_nothrow_copy_constructible_v<Error>)
+        : Storage(std::in_place_index<1>, error) {
+    }
+
+    T const& data() const& noexcept {
+        assert(!isError());
+        return storedData();
+    }
+
+    T data() && noexcept {
+        assert(!isError());
+        return std::move(storedData());
+    }
+
+    Error const& error() const& noexcept {
+        assert(isError());
+        return storedError();
+    }
+
+    Error error() && noexcept {
+        assert(isError());
+        return std::move(storedError());
+    }
+
+
+    template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
+    auto join(OnSuccess onSuccess, OnError onError) const&
                     noexcept(map_nothrow<OnSuccess, OnError>) {
 
 //        using Result = std::common_type_t<std::invoke_result_t<OnSuccess, const T&>,
 //                    std::invoke_result_t<OnError, const Error&>>;
 
-        return isError() ? onError(std::move(m_error)) : onSuccess(std::move(m_data));
+        return isError() ? onError(storedError()) : onSuccess(storedData());
+    }
+
+
+    template<std::invocable<T> OnSuccess, std::invocable<Error> OnError>
+    auto join(OnSuccess onSuccess, OnError onError) &&
+                    noexcept(map_move_nothrow<OnSuccess, OnError>) {
+
+//        using Result = std::common_type_t<std::invoke_result_t<OnSuccess, const T&>,
+//                    std::invoke_result_t<OnError, const Error&>>;
+
+        return isError() ? onError(std::move(storedError())) : onSuccess(std::move(storedData()));
     }
 
     template<std::invocable<const T&> OnSuccess>
@@ -711,7 +1245,7 @@ public:
                     noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::decay_t<std::invoke_result_t<OnSuccess, const T&>>;
-        return isError() ? Expected<Result, Error>{m_error} : Expected<Result, Error>{onSuccess(m_data)};
+        return isError() ? Expected<Result, Error>{storedError()} : Expected<Result, Error>{onSuccess(storedData())};
     }
 
 
@@ -720,72 +1254,68 @@ public:
                     noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::decay_t<std::invoke_result_t<OnSuccess, T&&>>;
-        return isError() ? Expected<Result, Error>{std::move(m_error)}
-                : Expected<Result, Error>{onSuccess(std::move(m_data))};
+        return isError() ? Expected<Result, Error>{std::move(storedError())}
+                : Expected<Result, Error>{onSuccess(std::move(storedData()))};
     }
 
     template<std::invocable<const T&> OnSuccess, std::invocable<Error const&> OnError>
     auto map(OnSuccess onSuccess, OnError onError) const& noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T const&>;
-        return isError() ? Expected<Result, Error>{onError(m_error)}
-                : Expected<Result, Error>{onSuccess(m_data)};
+        return isError() ? Expected<Result, Error>{onError(storedError())}
+                : Expected<Result, Error>{onSuccess(storedData())};
     }
 
     template<std::invocable<T> OnSuccess, std::invocable<Error> OnError>
     auto map(OnSuccess onSuccess, OnError onError) && noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T>;
-        return isError() ? Expected<Result, Error>{onError(std::move(m_error))}
-                : Expected<Result, Error>{onSuccess(std::move(m_data))};
+        return isError() ? Expected<Result, Error>{onError(std::move(storedError()))}
+                : Expected<Result, Error>{onSuccess(std::move(storedData()))};
     }
 
     template<std::invocable<T const&> OnSuccess>
     auto flatMap(OnSuccess onSuccess) const& noexcept(map_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T const&>;
-        return isError() ? Result{m_error} : onSuccess(m_data);
+        return isError() ? Result{storedError()} : onSuccess(storedData());
     }
 
     template<std::invocable<T&&> OnSuccess>
-    auto flatMap(OnSuccess onSuccess) && noexcept(map_nothrow<OnSuccess>) {
+    auto flatMap(OnSuccess onSuccess) && noexcept(map_move_nothrow<OnSuccess>) {
 
         using Result = std::invoke_result_t<OnSuccess, T>;
-        return isError() ? Result{std::move(m_error)} : onSuccess(std::move(m_data));
+        return isError() ? Result{std::move(storedError())} : onSuccess(std::move(storedData()));
     }
 
 
     template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
     auto flatMap(OnSuccess onSuccess, OnError onError) const& noexcept(map_nothrow<OnSuccess, OnError>) {
 
-        return isError() ? onError(m_error) : onSuccess(m_data);
+        return isError() ? onError(storedError()) : onSuccess(storedData());
     }
 
 
-    template<std::invocable<T const&> OnSuccess, std::invocable<Error const&> OnError>
-    auto flatMap(OnSuccess onSuccess, OnError onError) && noexcept(map_nothrow<OnSuccess, OnError>) {
+    template<std::invocable<T&&> OnSuccess, std::invocable<Error&&> OnError>
+    auto flatMap(OnSuccess onSuccess, OnError onError) && noexcept(map_move_nothrow<OnSuccess, OnError>) {
 
-        return isError() ? onError(std::move(m_error)) : onSuccess(std::move(m_data));
+        return isError() ? onError(std::move(storedError())) : onSuccess(std::move(storedData()));
     }
 
     template<std::invocable<Error const&> OnError>
     auto flatMapError(OnError onError) const& noexcept(map_nothrow<details::Id, OnError>) {
         using Result = std::invoke_result_t<OnError, Error const&>;
-        return isError() ? onError(m_error) : Result{m_data};
+        return isError() ? onError(storedError()) : Result{storedData()};
     }
 
     template<std::invocable<Error> OnError>
-    auto flatMapError(OnError onError) && noexcept(map_nothrow<details::Id, OnError>) {
+    auto flatMapError(OnError onError) && noexcept(map_move_nothrow<details::Id, OnError>) {
         using Result = std::invoke_result_t<OnError, Error>;
-        return isError() ? onError(std::move(m_error)) : Result{std::move(m_data)};
+        return isError() ? onError(std::move(storedError())) : Result{std::move(storedData())};
     }
 private:
-    bool m_isError;
-
-    union {
-        T m_data;
-        Error m_error;
-    };
+    using Storage::storedData;
+    using Storage::storedError;
 };
 
 
@@ -887,2267 +1417,6311 @@ private:
 
 }
 
-// #include <parsecpp/core/parsingError.h>
+// #include <parsecpp/utils/smallVector.h>
 
-// #include <parsecpp/core/baseTypes.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
-// #include <parsecpp/core/stream.h>
+namespace prs {
 
+/**
+ * Vector with the first `inlineCapacity` items stored inside the object, the heap is used only past it.
+ * Moving an inline vector moves its items one by one.
+ */
+template <typename T, size_t inlineCapacity>
+class SmallVector {
+    static_assert(inlineCapacity > 0, "Use std::vector for the zero inline capacity");
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = T const*;
 
-// #include <parsecpp/core/parsingError.h>
+    SmallVector() noexcept = default;
 
-// #include <parsecpp/core/buildParams.h>
+    SmallVector(std::initializer_list<T> init) {
+        reserve(init.size());
+        for (auto const& item : init) {
+            emplace_back(item);
+        }
+    }
 
+    SmallVector(SmallVector const& other) {
+        reserve(other.size());
+        for (auto const& item : other) {
+            emplace_back(item);
+        }
+    }
 
-#include <string_view>
-#include <string>
-#include <utility>
-#include <sstream>
-#include <cassert>
-#include <numeric>
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        steal(other);
+    }
 
+    SmallVector& operator=(SmallVector const& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            for (auto const& item : other) {
+                emplace_back(item);
+            }
+        }
+        return *this;
+    }
 
-namespace prs {
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            freeHeap();
+            steal(other);
+        }
+        return *this;
+    }
 
-class Stream {
-public:
-    static constexpr auto CHAR_MAPPING_SIZE = size_t(1) + std::numeric_limits<unsigned char>::max();
-    static_assert(CHAR_MAPPING_SIZE == 256);
+    ~SmallVector() {
+        clear();
+        freeHeap();
+    }
 
-    explicit Stream(std::string const& str) noexcept
-        : Stream{str, str} {
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        T* item = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+        ++m_size;
+        return *item;
+    }
 
+    void push_back(T const& value) {
+        emplace_back(value);
     }
 
-    explicit Stream(std::string_view str) noexcept
-        : Stream{str, str} {
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
     }
 
-    explicit Stream(char const* str) noexcept
-        : Stream{std::string_view(str)} {
+    void pop_back() noexcept {
+        std::destroy_at(m_data + --m_size);
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > m_capacity) {
+            grow(capacity);
+        }
     }
 
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        m_size = 0;
+    }
 
-    std::string_view& sv() noexcept {
-        return m_currentStr;
+    /**
+     * true while the items are stored in the object itself
+     */
+    bool isInline() const noexcept {
+        return m_data == inlineData();
     }
 
+    T& operator[](size_t i) noexcept {
+        return m_data[i];
+    }
 
-    std::string_view const& sv() const noexcept {
-        return m_currentStr;
+    T const& operator[](size_t i) const noexcept {
+        return m_data[i];
     }
 
-    char front() const noexcept {
-        assert(!eos());
-        return m_currentStr[0];
+    T& front() noexcept {
+        return m_data[0];
     }
 
-    void move(size_t n = 1ull) noexcept {
-        m_currentStr = m_currentStr.substr(std::min(n, m_currentStr.size()));
+    T const& front() const noexcept {
+        return m_data[0];
     }
 
-    void moveUnsafe(size_t n = 1ull) noexcept {
-        m_currentStr.remove_prefix(n);
+    T& back() noexcept {
+        return m_data[m_size - 1];
     }
 
-    std::string_view get_sv(size_t start, size_t end = std::string_view::npos) const noexcept(false) {
-        return m_fullStr.substr(start, end - start);
+    T const& back() const noexcept {
+        return m_data[m_size - 1];
     }
 
-    std::string_view remaining() const noexcept {
-        return m_currentStr;
+    T* data() noexcept {
+        return m_data;
     }
 
-    std::string_view full() const noexcept {
-        return m_fullStr;
+    T const* data() const noexcept {
+        return m_data;
     }
 
-    size_t pos() const noexcept {
-        return m_fullStr.size() - m_currentStr.size();
+    iterator begin() noexcept {
+        return m_data;
     }
 
-    bool eos() const noexcept {
-        return m_currentStr.empty();
+    iterator end() noexcept {
+        return m_data + m_size;
     }
 
-    template<std::predicate<char> Fn>
-    char checkFirst(Fn const& test) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
-        if (eos()) {
-            return 0;
-        } else {
-            char c = m_currentStr[0];
-            if (test(c)) {
-                m_currentStr.remove_prefix(1);
-                return c;
-            } else {
-                return 0;
-            }
+    const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    friend bool operator==(SmallVector const& lhs, SmallVector const& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+private:
+    T* inlineData() noexcept {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    T const* inlineData() const noexcept {
+        return reinterpret_cast<T const*>(m_inline);
+    }
+
+    void grow(size_t capacity) {
+        T* heap = std::allocator<T>{}.allocate(capacity);
+        try {
+            relocate(heap);
+        } catch (...) {
+            std::allocator<T>{}.deallocate(heap, capacity);
+            throw;
         }
+        adopt(heap, capacity);
     }
 
-    char checkFirst(char test) noexcept {
-        if (eos()) {
-            return 0;
-        } else {
-            char c = m_currentStr[0];
-            if (test == c) {
-                m_currentStr.remove_prefix(1);
-                return c;
-            } else {
-                return 0;
+    /**
+     * The arguments can refer to the old items, so the new item is constructed before they are moved
+     */
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        size_t const capacity = m_capacity * 2;
+        T* heap = std::allocator<T>{}.allocate(capacity);
+        T* item = nullptr;
+        try {
+            item = std::construct_at(heap + m_size, std::forward<Args>(args)...);
+            relocate(heap);
+        } catch (...) {
+            if (item) {
+                std::destroy_at(item);
             }
+            std::allocator<T>{}.deallocate(heap, capacity);
+            throw;
         }
+        adopt(heap, capacity);
+        ++m_size;
+        return *item;
     }
 
-    char checkFirst(std::array<bool, CHAR_MAPPING_SIZE> const& test) noexcept {
-        if (eos()) {
-            return 0;
+    /**
+     * Move the items to `heap`, on an exception the moved ones are destroyed and the old ones are kept
+     */
+    void relocate(T* heap) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(begin(), end(), heap);
         } else {
-            char c = m_currentStr[0];
-            if (test[c]) {
-                m_currentStr.remove_prefix(1);
-                return c;
-            } else {
-                return 0;
-            }
+            std::uninitialized_copy(begin(), end(), heap);
         }
     }
 
-    void restorePos(size_t pos) noexcept {
-        assert(pos <= m_fullStr.size());
-        m_currentStr = m_fullStr.substr(pos);
+    void adopt(T* heap, size_t capacity) noexcept {
+        std::destroy(begin(), end());
+        freeHeap();
+        m_data = heap;
+        m_capacity = capacity;
     }
 
-    template <unsigned printBefore = 3, unsigned printAfter = 3>
-    std::string generateErrorText(details::ParsingError const& error) const noexcept {
-        if (error.pos > m_fullStr.size()) {
-            return "Wrong error pos";
-        }
-
-        std::ostringstream stream;
-        stream << "Parse error in pos: " << error.pos;
-        if constexpr (!DISABLE_ERROR_LOG) {
-            stream << ", dsc: " << error.getDescription();
-        }
-        if constexpr (printAfter + printBefore > 0) {
-            auto startPos = error.pos > printBefore ? error.pos - printBefore : 0;
-            auto endPos = error.pos + printAfter > m_fullStr.size() ? m_fullStr.size() : error.pos + printAfter;
-            stream << ", text: |" << m_fullStr.substr(startPos, error.pos - startPos)
-                    << "$" << m_fullStr.substr(error.pos, endPos - error.pos) << "|";
+    void freeHeap() noexcept {
+        if (!isInline()) {
+            std::allocator<T>{}.deallocate(m_data, m_capacity);
+            m_data = inlineData();
+            m_capacity = inlineCapacity;
         }
-        return stream.str();
     }
-private:
-    Stream(std::string_view cur, std::string_view full) noexcept
-        : m_fullStr(cur)
-        , m_currentStr(full) {
 
+    /**
+     * this must be empty and inline
+     */
+    void steal(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), m_data);
+            m_size = other.m_size;
+            other.clear();
+        } else {
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, inlineCapacity);
+        }
     }
 
-    std::string_view const m_fullStr;
-    std::string_view m_currentStr;
+    alignas(T) std::byte m_inline[sizeof(T) * inlineCapacity];
+    T* m_data = inlineData();
+    size_t m_size = 0;
+    size_t m_capacity = inlineCapacity;
 };
 
-
 }
-// #include <parsecpp/core/concept.h>
+// #include <parsecpp/utils/capacityHint.h>
 
 
-// #include <parsecpp/core/forward.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
+namespace prs::details {
 
-namespace prs {
+/**
+ * Reserve policy of repeat with the capacity fixed at compile time
+ */
+template <size_t reserve>
+struct FixedCapacity {
+    static constexpr size_t hint() noexcept {
+        return reserve;
+    }
 
-namespace details {
+    static constexpr void record(size_t) noexcept {}
+};
 
-template <typename T>
-constexpr inline bool IsParserC = false;
 
-template <typename T, typename Ctx, typename Fn>
-constexpr inline bool IsParserC<Parser<T, Ctx, Fn>> = true;
-
-}
-
-template <typename Parser>
-concept ParserType = details::IsParserC<std::decay_t<Parser>>;
+/**
+ * Running p90 of the result sizes of one repeat parser, shared by its copies and threads.
+ * Sizes are counted in power of two buckets, every `WINDOW` samples the hint is recomputed and the old counts are halved.
+ */
+class CapacityStats {
+public:
+    size_t hint() const noexcept {
+        return m_hint.load(std::memory_order_relaxed);
+    }
 
+    void record(size_t size) noexcept {
+        m_buckets[bucket(size)].fetch_add(1, std::memory_order_relaxed);
+        if (m_samples.fetch_add(1, std::memory_order_relaxed) % WINDOW == WINDOW - 1) {
+            update();
+        }
+    }
+private:
+    static constexpr size_t BUCKETS = 25;
+    static constexpr uint32_t WINDOW = 32;
 
-template <ParserType Parser>
-using GetParserResult = typename std::decay_t<Parser>::Type;
+    static size_t bucket(size_t size) noexcept {
+        return std::min<size_t>(std::bit_width(size), BUCKETS - 1);
+    }
 
+    void update() noexcept {
+        if (m_updating.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
 
-template <ParserType Parser>
-using GetParserCtx = typename std::decay_t<Parser>::Ctx;
+        std::array<uint32_t, BUCKETS> counts{};
+        uint64_t total = 0;
+        for (size_t i = 0; i != BUCKETS; ++i) {
+            counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
 
+        uint64_t const target = (total * 9 + 9) / 10;
+        uint64_t cumulative = 0;
+        size_t p90 = 0;
+        while (p90 + 1 != BUCKETS && (cumulative += counts[p90]) < target) {
+            ++p90;
+        }
+        // the largest size of the bucket
+        m_hint.store((size_t{1} << p90) - 1, std::memory_order_relaxed);
 
-template <typename T, typename Parser>
-concept ParserTypeResult = std::is_same_v<GetParserResult<Parser>, T>;
+        for (size_t i = 0; i != BUCKETS; ++i) {
+            m_buckets[i].fetch_sub(counts[i] / 2, std::memory_order_relaxed);
+        }
+        m_updating.clear(std::memory_order_release);
+    }
 
-template <typename T, typename Ctx, typename Parser>
-concept ParserTypeSpec = std::is_same_v<GetParserResult<Parser>, T> && std::is_same_v<GetParserCtx<Parser>, Ctx>;
+    std::array<std::atomic<uint32_t>, BUCKETS> m_buckets{};
+    std::atomic<uint32_t> m_samples = 0;
+    std::atomic<size_t> m_hint = 0;
+    std::atomic_flag m_updating;
+};
 
 
-template<typename, typename = std::void_t<>>
-struct HasTypeCtx : std::false_type { };
+/**
+ * Reserve policy of repeat learned from the previous results
+ */
+struct AdaptiveCapacity {
+    size_t hint() const noexcept {
+        return stats->hint();
+    }
 
-template<typename T>
-struct HasTypeCtx<T, std::void_t<std::enable_if_t<IsCtx<typename T::Ctx>, void>>> : std::true_type {};
+    void record(size_t size) const noexcept {
+        stats->record(size);
+    }
 
-template <typename Modifier>
-struct ContextTrait {
-private:
-    struct Dummy {
-        using Ctx = VoidContext;
-    };
-public:
-    using Ctx = typename std::conditional_t<HasTypeCtx<Modifier>::value,
-            Modifier,
-            Dummy>::Ctx;
+    std::shared_ptr<CapacityStats> stats = std::make_shared<CapacityStats>();
 };
 
-template <typename T>
-using GetContextTrait = typename ContextTrait<T>::Ctx;
-
 }
-// #include <parsecpp/core/context.h>
-
-
-namespace prs {
-
-
-struct Unit {
-    Unit() noexcept = default;
-
-    bool operator==(Unit const&) const noexcept {
-        return true;
-    }
-};
+// #include <parsecpp/core/parsingError.h>
 
+// #include <parsecpp/core/baseTypes.h>
 
-struct Drop {
-    Drop() noexcept = default;
 
-    bool operator==(Drop const&) const noexcept {
-        return true;
-    }
-};
+// #include <parsecpp/core/stream.h>
 
-namespace details {
 
-template <class Body>
-using ResultType = Expected<Body, ParsingError>;
+// #include <parsecpp/core/parsingError.h>
 
-template <typename T, ContextType Ctx = VoidContext>
-using StdFunction = std::conditional_t<IsVoidCtx<Ctx>,
-                std::function<ResultType<T>(Stream&)>, std::function<ResultType<T>(Stream&, Ctx&)>>;
+// #include <parsecpp/core/buildParams.h>
 
-}
+// #include <parsecpp/core/charSet.h>
 
 
+// #include <parsecpp/core/buildParams.h>
 
-};
+// #include <parsecpp/core/simd.h>
 
-// #include <parsecpp/core/concept.h>
 
-// #include <parsecpp/core/context.h>
+// #include <parsecpp/core/buildParams.h>
 
-// #include <parsecpp/core/stream.h>
 
+#if !defined(PRS_DISABLE_SIMD)
+    #if defined(__AVX2__)
+        #define PRS_SIMD_AVX2
+        #define PRS_SIMD_SSE2
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PRS_SIMD_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
 
-#include <concepts>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
-#include <functional>
+#include <type_traits>
 #include <utility>
-#include <optional>
-
 
 namespace prs {
 
-template <typename T, ContextType CtxType = VoidContext, typename Func = details::StdFunction<T, CtxType>>
-        requires (IsParserFn<Func, CtxType>)
-class Parser {
+/**
+ * Set of bytes known before parsing.
+ * Stores 256-entry table for the scalar path and a short list of byte ranges for the vectorized one.
+ * If the set cannot be described by MAX_SIMD_RANGES ranges, only the scalar path is used.
+ */
+class CharSet {
 public:
-    static constexpr bool nocontext = IsVoidCtx<CtxType>;
-    static constexpr bool nothrow = std::conditional_t<nocontext && std::is_invocable_v<Func, Stream&>,
-                    std::is_nothrow_invocable<Func, Stream&>,
-                    std::is_nothrow_invocable<Func, Stream&, CtxType&>>::value;
-
-    using StoredFn = std::decay_t<Func>;
-
-    using Type = T;
-    using Ctx = CtxType;
-    using Result = details::ResultType<T>;
+    static constexpr size_t CHAR_MAPPING_SIZE = 256;
+    static constexpr size_t MAX_SIMD_RANGES = 8;
 
+    struct Range {
+        unsigned char begin = 0;
+        unsigned char end = 0;
+    };
 
-    template <typename Fn>
-        requires (IsParserFn<Fn, Ctx>)
-    constexpr static auto make(Fn &&f) noexcept {
-        return Parser<T, Ctx, Fn>(std::forward<Fn>(f));
-    }
-
+    using Table = std::array<bool, CHAR_MAPPING_SIZE>;
 
-    template <typename U>
-        requires(std::is_same_v<std::decay_t<U>, StoredFn>)
-    constexpr explicit Parser(U&& f) noexcept
-        : m_fn(std::forward<U>(f)) {
+    constexpr CharSet() noexcept = default;
 
+    constexpr explicit CharSet(Table const& table) noexcept
+        : m_table(table) {
+        buildRanges();
     }
 
-    constexpr Result operator()(Stream& stream) const noexcept(nothrow) requires(nocontext) {
-        if constexpr (!std::is_invocable_v<StoredFn, Stream&> && nocontext) {
-            return std::invoke(m_fn, stream, VOID_CONTEXT);
-        } else {
-            return std::invoke(m_fn, stream);
+    /**
+     * @param test :: char -> bool, will be called for all 256 symbols once
+     */
+    template <typename Fn>
+    static constexpr CharSet fromPredicate(Fn const& test) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
+        Table table{};
+        for (size_t i = 0; i != CHAR_MAPPING_SIZE; ++i) {
+            table[i] = test(static_cast<char>(i));
         }
+        return CharSet{table};
     }
 
-    template <ContextType Context>
-    constexpr Result operator()(Stream& stream, Context& ctx) const noexcept(nothrow) {
-        if constexpr (nocontext && std::is_invocable_v<StoredFn, Stream&>) {
-            return std::invoke(m_fn, stream);
-        } else {
-            return std::invoke(m_fn, stream, ctx);
-        }
+    template <typename ...Args>
+    static constexpr CharSet anyOf(Args const& ...args) noexcept {
+        return fromPredicate([&](char c) {
+            return ((args == c) || ...);
+        });
     }
 
-
-    constexpr Result apply(Stream& stream) const noexcept(nothrow) requires(nocontext) {
-        return operator()(stream);
+    constexpr CharSet inverse() const noexcept {
+        Table table{};
+        for (size_t i = 0; i != CHAR_MAPPING_SIZE; ++i) {
+            table[i] = !m_table[i];
+        }
+        return CharSet{table};
     }
 
-    template <typename Context>
-    constexpr Result apply(Stream& stream, Context& ctx) const noexcept(nothrow) {
-        return operator()(stream, ctx);
+    constexpr bool contains(char c) const noexcept {
+        return m_table[static_cast<unsigned char>(c)];
     }
 
-
-    template <typename ...Args>
-        requires(std::is_constructible_v<Ctx, Args...>)
-    static Ctx makeCtx(Args&& ...args) noexcept(std::is_nothrow_constructible_v<Ctx, Args...>) {
-        return Ctx{std::forward<Args>(args)...};
+    constexpr bool hasSimdRanges() const noexcept {
+        return m_rangesCount != NO_SIMD;
     }
 
     /**
-     * @def `>>` :: Parser<A> -> Parser<B> -> Parser<B>
+     * @return number of the first symbols of str that are in the set
      */
-    template <typename B, typename CtxB, typename Rhs>
-        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        return Parser<B, VoidContext>::make([lhs = *this, rhs](Stream& stream) noexcept(nothrow && Parser<B, CtxB, Rhs>::nothrow) {
-            return lhs.apply(stream).flatMap([&rhs, &stream](T const& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream);
-            });
-        });
+    size_t prefixLength(std::string_view str) const noexcept {
+        char const* begin = str.data();
+        char const* end = begin + str.size();
+        size_t i = 0;
+        if constexpr (!DISABLE_SIMD) {
+            if (hasSimdRanges()) {
+                i = prefixLengthSimd(begin, end);
+            }
+        }
+        return i + prefixLengthScalar(begin + i, end);
     }
 
-
-    /**
-     * @def `>>` :: Parser<A, CtxA> -> Parser<B, CtxB> -> Parser<B, CtxA & CtxB>
-     */
-    template <typename B, typename CtxB, typename Rhs>
-        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        return Parser<B, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) noexcept(nothrow && Parser<B, CtxB, Rhs>::nothrow) {
-            return lhs.apply(stream, ctx).flatMap([&rhs, &stream, &ctx](T const& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream, ctx);
-            });
-        });
+    size_t prefixLengthScalar(char const* begin, char const* end) const noexcept {
+        char const* it = begin;
+        while (it != end && contains(*it)) {
+            ++it;
+        }
+        return it - begin;
     }
 
-
     /**
-     * @def `<<` :: Parser<A> -> Parser<B> -> Parser<A>
+     * @return length of processed full blocks, the tail should be checked by the scalar path
      */
-    template <typename B, typename CtxB, typename Rhs>
-        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        constexpr bool firstCallNoexcept = nothrow && Parser<B, CtxB, Rhs>::nothrow;
-        return Parser<T>::make([lhs = *this, rhs](Stream& stream) noexcept(firstCallNoexcept) {
-            return lhs.apply(stream).flatMap([&rhs, &stream](T&& body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream).map([mvBody = std::move(body)](auto const& _) {
-                    return mvBody;
-                });
-            });
-        });
+    size_t prefixLengthSimd(char const* begin, char const* end) const noexcept {
+        size_t i = 0;
+        [[maybe_unused]] size_t const size = end - begin;
+#ifdef PRS_SIMD_AVX2
+        for (; i + 32 <= size; i += 32) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(begin + i));
+            __m256i inSet = _mm256_setzero_si256();
+            for (size_t r = 0; r != m_rangesCount; ++r) {
+                __m256i const shifted = _mm256_sub_epi8(block, _mm256_set1_epi8(static_cast<char>(m_ranges[r].begin)));
+                __m256i const width = _mm256_set1_epi8(static_cast<char>(m_ranges[r].end - m_ranges[r].begin));
+                inSet = _mm256_or_si256(inSet, _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, width), shifted));
+            }
+            auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(inSet));
+            if (mask != 0xFFFFFFFFu) {
+                return i + std::countr_one(mask);
+            }
+        }
+#endif
+#ifdef PRS_SIMD_SSE2
+        for (; i + 16 <= size; i += 16) {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin + i));
+            __m128i inSet = _mm_setzero_si128();
+            for (size_t r = 0; r != m_rangesCount; ++r) {
+                __m128i const shifted = _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(m_ranges[r].begin)));
+                __m128i const width = _mm_set1_epi8(static_cast<char>(m_ranges[r].end - m_ranges[r].begin));
+                inSet = _mm_or_si128(inSet, _mm_cmpeq_epi8(_mm_min_epu8(shifted, width), shifted));
+            }
+            auto const mask = static_cast<uint32_t>(_mm_movemask_epi8(inSet));
+            if (mask != 0xFFFFu) {
+                return i + std::countr_one(mask);
+            }
+        }
+#endif
+        return i;
     }
 
-
-    /**
-     * @def `<<` :: Parser<A, CtxA> -> Parser<B, CtxB> -> Parser<A, CtxA & CtxB>
-     */
-    template <typename B, typename CtxB, typename Rhs>
-        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
-        constexpr bool firstCallNoexcept = nothrow && Parser<B, CtxB, Rhs>::nothrow;
-        return Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) noexcept(firstCallNoexcept) {
-            return lhs.apply(stream, ctx).flatMap([&rhs, &stream, &ctx](T body) noexcept(Parser<B, CtxB, Rhs>::nothrow) {
-                return rhs.apply(stream, ctx).map([mvBody = std::move(body)](auto const& _) {
-                    return mvBody;
-                });
-            });
-        });
+    constexpr Table const& table() const noexcept {
+        return m_table;
     }
+private:
+    static constexpr size_t NO_SIMD = MAX_SIMD_RANGES + 1;
+
+    constexpr void buildRanges() noexcept {
+        m_rangesCount = 0;
+        size_t i = 0;
+        while (i != CHAR_MAPPING_SIZE) {
+            if (!m_table[i]) {
+                ++i;
+                continue;
+            }
 
+            size_t j = i;
+            while (j + 1 != CHAR_MAPPING_SIZE && m_table[j + 1]) {
+                ++j;
+            }
 
-    /*
-     * <$>, fmap operator
-     * @def `>>=` :: Parser<A> -> (A -> B) -> Parser<B>
-     */
-    template <typename ListFn>
-        requires(nocontext)
-    constexpr friend auto operator>>=(Parser lhs, ListFn fn) noexcept {
-        using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
-        return Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream) {
-           return lhs.apply(stream).map(fn);
-        });
+            if (m_rangesCount == MAX_SIMD_RANGES) {
+                m_rangesCount = NO_SIMD;
+                return;
+            }
+            m_ranges[m_rangesCount++] = Range{static_cast<unsigned char>(i), static_cast<unsigned char>(j)};
+            i = j + 1;
+        }
     }
 
+    Table m_table{};
+    std::array<Range, MAX_SIMD_RANGES> m_ranges{};
+    size_t m_rangesCount = 0;
+};
 
-    /*
-     * <$>, fmap operator
-     * @def `>>=` :: Parser<A, Ctx> -> (A -> B) -> Parser<B, Ctx>
-     */
-    template <std::invocable<T> ListFn>
-        requires(!nocontext)
-    constexpr friend auto operator>>=(Parser lhs, ListFn fn) noexcept {
-        using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
-        return Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream, auto& ctx) {
-            return lhs.apply(stream, ctx).map(fn);
-        });
-    }
-
-    template <std::invocable<T> ListFn>
-    constexpr auto fmap(ListFn &&fn) const noexcept {
-        return *this >>= std::forward<ListFn>(fn);
-    }
 
-    /*
-     * bind operator
-     * @def bind :: Parser<A> -> (A -> Parser<B>) -> Parser<B>
-     */
-    template <typename ListFn>
-        requires(nocontext && IsVoidCtx<GetParserCtx<std::invoke_result_t<ListFn, T>>>)
-    constexpr auto bind(ListFn fn) const noexcept {
-        using ResultT = GetParserResult<std::invoke_result_t<ListFn, T>>;
-        return Parser<ResultT, Ctx>::make([lhs = *this, fn](Stream& stream) {
-           return lhs.apply(stream).flatMap([&](T &&t) {
-               return fn(t).apply(stream);
-           });
-        });
-    }
+namespace details {
 
+template <auto ...args>
+inline const CharSet charSetOf = CharSet::anyOf(args...);
 
-    /*
-     * bind operator
-     * @def bind :: Parser<A, CtxA> -> (A -> Parser<B, CtxB>) -> Parser<B, CtxA & CtxB>
-     */
-    template <typename ListFn>
-        requires(!nocontext || !IsVoidCtx<GetParserCtx<std::invoke_result_t<ListFn, T>>>)
-    constexpr auto bind(ListFn fn) const noexcept {
-        using ResultT = GetParserResult<std::invoke_result_t<ListFn, T>>;
-        using UCtx = UnionCtx<Ctx, GetParserCtx<std::invoke_result_t<ListFn, T>>>;
+template <auto ...args>
+inline const CharSet charSetNotOf = CharSet::anyOf(args...).inverse();
 
-        return Parser<ResultT, UCtx>::make([lhs = *this, fn](Stream& stream, UCtx& ctx) {
-           return lhs.apply(stream, ctx).flatMap([&](T &&t) {
-               return fn(t).apply(stream, ctx);
-           });
-        });
-    }
+}
 
+}
 
-    /**
-     * @def `|` :: Parser<A> -> Parser<A> -> Parser<A>
+#include <string_view>
+#include <string>
+#include <utility>
+#include <sstream>
+#include <cassert>
+#include <numeric>
+
+
+namespace prs {
+
+class Stream {
+public:
+    static constexpr auto CHAR_MAPPING_SIZE = size_t(1) + std::numeric_limits<unsigned char>::max();
+    static_assert(CHAR_MAPPING_SIZE == 256);
+
+    explicit Stream(std::string const& str) noexcept
+        : Stream{str, str} {
+
+    }
+
+    explicit Stream(std::string_view str) noexcept
+        : Stream{str, str} {
+    }
+
+    explicit Stream(char const* str) noexcept
+        : Stream{std::string_view(str)} {
+    }
+
+
+    std::string_view& sv() noexcept {
+        return m_currentStr;
+    }
+
+
+    std::string_view const& sv() const noexcept {
+        return m_currentStr;
+    }
+
+    char front() const noexcept {
+        assert(!eos());
+        return m_currentStr[0];
+    }
+
+    void move(size_t n = 1ull) noexcept {
+        m_currentStr = m_currentStr.substr(std::min(n, m_currentStr.size()));
+    }
+
+    void moveUnsafe(size_t n = 1ull) noexcept {
+        m_currentStr.remove_prefix(n);
+    }
+
+    std::string_view get_sv(size_t start, size_t end = std::string_view::npos) const noexcept(false) {
+        return m_fullStr.substr(start, end - start);
+    }
+
+    std::string_view remaining() const noexcept {
+        return m_currentStr;
+    }
+
+    std::string_view full() const noexcept {
+        return m_fullStr;
+    }
+
+    size_t pos() const noexcept {
+        return m_fullStr.size() - m_currentStr.size();
+    }
+
+    bool eos() const noexcept {
+        return m_currentStr.empty();
+    }
+
+    template<std::predicate<char> Fn>
+    char checkFirst(Fn const& test) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
+        if (eos()) {
+            return 0;
+        } else {
+            char c = m_currentStr[0];
+            if (test(c)) {
+                m_currentStr.remove_prefix(1);
+                return c;
+            } else {
+                return 0;
+            }
+        }
+    }
+
+    char checkFirst(char test) noexcept {
+        if (eos()) {
+            return 0;
+        } else {
+            char c = m_currentStr[0];
+            if (test == c) {
+                m_currentStr.remove_prefix(1);
+                return c;
+            } else {
+                return 0;
+            }
+        }
+    }
+
+    char checkFirst(std::array<bool, CHAR_MAPPING_SIZE> const& test) noexcept {
+        if (eos()) {
+            return 0;
+        } else {
+            char c = m_currentStr[0];
+            if (test[static_cast<unsigned char>(c)]) {
+                m_currentStr.remove_prefix(1);
+                return c;
+            } else {
+                return 0;
+            }
+        }
+    }
+
+    /**
+     * Consume the longest prefix of symbols from the set
+     * @return consumed part of the stream
+     */
+    std::string_view takeWhile(CharSet const& set) noexcept {
+        auto const n = set.prefixLength(m_currentStr);
+        auto const out = m_currentStr.substr(0, n);
+        m_currentStr.remove_prefix(n);
+        return out;
+    }
+
+    void restorePos(size_t pos) noexcept {
+        assert(pos <= m_fullStr.size());
+        m_currentStr = m_fullStr.substr(pos);
+    }
+
+    template <unsigned printBefore = 3, unsigned printAfter = 3>
+    std::string generateErrorText(details::ParsingError const& error) const noexcept {
+        if (error.pos > m_fullStr.size()) {
+            return "Wrong error pos";
+        }
+
+        std::ostringstream stream;
+        stream << "Parse error in pos: " << error.pos;
+        if constexpr (!DISABLE_ERROR_LOG) {
+            stream << ", dsc: " << error.getDescription();
+        }
+        if constexpr (printAfter + printBefore > 0) {
+            auto startPos = error.pos > printBefore ? error.pos - printBefore : 0;
+            auto endPos = error.pos + printAfter > m_fullStr.size() ? m_fullStr.size() : error.pos + printAfter;
+            stream << ", text: |" << m_fullStr.substr(startPos, error.pos - startPos)
+                    << "$" << m_fullStr.substr(error.pos, endPos - error.pos) << "|";
+        }
+        return stream.str();
+    }
+private:
+    Stream(std::string_view cur, std::string_view full) noexcept
+        : m_fullStr(cur)
+        , m_currentStr(full) {
+
+    }
+
+    std::string_view const m_fullStr;
+    std::string_view m_currentStr;
+};
+
+
+}
+// #include <parsecpp/core/concept.h>
+
+
+// #include <parsecpp/core/forward.h>
+
+
+namespace prs {
+
+namespace details {
+
+template <typename T>
+constexpr inline bool IsParserC = false;
+
+template <typename T, typename Ctx, typename Fn>
+constexpr inline bool IsParserC<Parser<T, Ctx, Fn>> = true;
+
+}
+
+template <typename Parser>
+concept ParserType = details::IsParserC<std::decay_t<Parser>>;
+
+
+template <ParserType Parser>
+using GetParserResult = typename std::decay_t<Parser>::Type;
+
+
+template <ParserType Parser>
+using GetParserCtx = typename std::decay_t<Parser>::Ctx;
+
+
+template <typename T, typename Parser>
+concept ParserTypeResult = std::is_same_v<GetParserResult<Parser>, T>;
+
+template <typename T, typename Ctx, typename Parser>
+concept ParserTypeSpec = std::is_same_v<GetParserResult<Parser>, T> && std::is_same_v<GetParserCtx<Parser>, Ctx>;
+
+
+template<typename, typename = std::void_t<>>
+struct HasTypeCtx : std::false_type { };
+
+template<typename T>
+struct HasTypeCtx<T, std::void_t<std::enable_if_t<IsCtx<typename T::Ctx>, void>>> : std::true_type {};
+
+template <typename Modifier>
+struct ContextTrait {
+private:
+    struct Dummy {
+        using Ctx = VoidContext;
+    };
+public:
+    using Ctx = typename std::conditional_t<HasTypeCtx<Modifier>::value,
+            Modifier,
+            Dummy>::Ctx;
+};
+
+template <typename T>
+using GetContextTrait = typename ContextTrait<T>::Ctx;
+
+}
+// #include <parsecpp/core/context.h>
+
+
+namespace prs {
+
+
+struct Unit {
+    Unit() noexcept = default;
+
+    bool operator==(Unit const&) const noexcept {
+        return true;
+    }
+};
+
+
+struct Drop {
+    Drop() noexcept = default;
+
+    bool operator==(Drop const&) const noexcept {
+        return true;
+    }
+};
+
+namespace details {
+
+template <class Body>
+using ResultType = Expected<Body, ParsingError>;
+
+template <typename T, ContextType Ctx = VoidContext>
+using StdFunction = std::conditional_t<IsVoidCtx<Ctx>,
+                std::function<ResultType<T>(Stream&)>, std::function<ResultType<T>(Stream&, Ctx&)>>;
+
+}
+
+
+
+};
+
+// #include <parsecpp/core/concept.h>
+
+// #include <parsecpp/core/context.h>
+
+// #include <parsecpp/core/erased.h>
+
+
+// #include <parsecpp/core/baseTypes.h>
+
+// #include <parsecpp/core/context.h>
+
+// #include <parsecpp/core/stream.h>
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+static constexpr size_t ERASED_PARSER_SIZE = 256;
+
+namespace details {
+
+/**
+ * Move-only type erased parser with inline storage, never allocates memory.
+ * The stored parser is called by a plain function pointer.
+ */
+template <typename T, ContextType Ctx, size_t inlineSize = ERASED_PARSER_SIZE>
+class ErasedFn {
+public:
+    using Invoke = ResultType<T> (*)(void const*, Stream&, Ctx&);
+
+    template <typename P>
+        requires(!std::is_same_v<std::decay_t<P>, ErasedFn>)
+    explicit ErasedFn(P&& parser) noexcept(std::is_nothrow_constructible_v<std::decay_t<P>, P>) {
+        using Stored = std::decay_t<P>;
+        static_assert(sizeof(Stored) <= inlineSize, "Parser doesn't fit the inline storage, increase the size of ErasedParser");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t));
+        static_assert(std::is_nothrow_move_constructible_v<Stored>);
+
+        new (&m_storage) Stored(std::forward<P>(parser));
+        m_invoke = [](void const* p, Stream& stream, Ctx& ctx) -> ResultType<T> {
+            return static_cast<Stored const*>(p)->apply(stream, ctx);
+        };
+        m_manage = [](void* to, void* from) noexcept {
+            if (from != nullptr) {
+                new (to) Stored(std::move(*static_cast<Stored*>(from)));
+            } else {
+                std::destroy_at(static_cast<Stored*>(to));
+            }
+        };
+    }
+
+    ErasedFn(ErasedFn&& other) noexcept
+        : m_invoke(other.m_invoke)
+        , m_manage(other.m_manage) {
+        m_manage(&m_storage, &other.m_storage);
+    }
+
+    ErasedFn(ErasedFn const&) = delete;
+    ErasedFn& operator=(ErasedFn const&) = delete;
+    ErasedFn& operator=(ErasedFn&&) = delete;
+
+    ~ErasedFn() {
+        m_manage(&m_storage, nullptr);
+    }
+
+    ResultType<T> operator()(Stream& stream) const requires(IsVoidCtx<Ctx>) {
+        return m_invoke(&m_storage, stream, VOID_CONTEXT);
+    }
+
+    ResultType<T> operator()(Stream& stream, Ctx& ctx) const {
+        return m_invoke(&m_storage, stream, ctx);
+    }
+private:
+    alignas(std::max_align_t) std::byte m_storage[inlineSize];
+    Invoke m_invoke;
+    void (*m_manage)(void*, void*) noexcept;
+};
+
+
+/**
+ * Non-owning type erased parser: a pointer to the parser and a function pointer.
+ */
+template <typename T, ContextType Ctx>
+class ParserRefFn {
+public:
+    using Invoke = ResultType<T> (*)(void const*, Stream&, Ctx&);
+
+    template <typename P>
+        requires(!std::is_same_v<std::decay_t<P>, ParserRefFn>)
+    explicit ParserRefFn(P const& parser) noexcept
+        : m_parser(std::addressof(parser))
+        , m_invoke([](void const* p, Stream& stream, Ctx& ctx) -> ResultType<T> {
+            return static_cast<P const*>(p)->apply(stream, ctx);
+        }) {
+
+    }
+
+    ResultType<T> operator()(Stream& stream) const requires(IsVoidCtx<Ctx>) {
+        return m_invoke(m_parser, stream, VOID_CONTEXT);
+    }
+
+    ResultType<T> operator()(Stream& stream, Ctx& ctx) const {
+        return m_invoke(m_parser, stream, ctx);
+    }
+private:
+    void const* m_parser;
+    Invoke m_invoke;
+};
+
+}
+
+/**
+ * Move-only parser for recursive grammars without std::function, see Parser::toErased
+ */
+template <typename T, ContextType Ctx = VoidContext, size_t inlineSize = ERASED_PARSER_SIZE>
+using ErasedParser = Parser<T, Ctx, details::ErasedFn<T, Ctx, inlineSize>>;
+
+/**
+ * Copyable reference to a parser, see Parser::ref
+ */
+template <typename T, ContextType Ctx = VoidContext>
+using ParserRef = Parser<T, Ctx, details::ParserRefFn<T, Ctx>>;
+
+}
+// #include <parsecpp/core/firstSet.h>
+
+
+// #include <parsecpp/core/charSet.h>
+
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace prs {
+
+/**
+ * Bytes that can start a successful parse (LL(1) first set).
+ * nullable - the parser can succeed without consuming, so it is viable for any next byte and for the end of stream.
+ * The default set is empty, any() is used for parsers without the analysis.
+ */
+class FirstSet {
+public:
+    constexpr FirstSet() noexcept = default;
+
+    static constexpr FirstSet any() noexcept {
+        FirstSet out;
+        out.m_bits.fill(~uint64_t{0});
+        out.m_nullable = true;
+        return out;
+    }
+
+    /**
+     * @param test :: char -> bool, will be called for all 256 symbols once
+     */
+    template <typename Fn>
+    static constexpr FirstSet fromPredicate(Fn const& test, bool nullable = false) noexcept(std::is_nothrow_invocable_v<Fn, char>) {
+        FirstSet out;
+        for (size_t i = 0; i != CharSet::CHAR_MAPPING_SIZE; ++i) {
+            if (test(static_cast<char>(i))) {
+                out.m_bits[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+        out.m_nullable = nullable;
+        return out;
+    }
+
+    static constexpr FirstSet of(CharSet const& set, bool nullable = false) noexcept {
+        return fromPredicate([&set](char c) {
+            return set.contains(c);
+        }, nullable);
+    }
+
+    template <typename ...Args>
+    static constexpr FirstSet anyOf(Args const& ...args) noexcept {
+        return fromPredicate([&](char c) {
+            return ((args == c) || ...);
+        });
+    }
+
+    constexpr bool contains(char c) const noexcept {
+        auto const i = static_cast<unsigned char>(c);
+        return (m_bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    constexpr bool nullable() const noexcept {
+        return m_nullable;
+    }
+
+    /**
+     * Can the parser succeed if the next byte is c
+     */
+    constexpr bool viable(char c) const noexcept {
+        return m_nullable || contains(c);
+    }
+
+    /**
+     * @def `|` of parsers
+     */
+    constexpr FirstSet operator|(FirstSet const& rhs) const noexcept {
+        FirstSet out;
+        for (size_t i = 0; i != m_bits.size(); ++i) {
+            out.m_bits[i] = m_bits[i] | rhs.m_bits[i];
+        }
+        out.m_nullable = m_nullable || rhs.m_nullable;
+        return out;
+    }
+
+    /**
+     * @def `>>` of parsers
+     */
+    constexpr FirstSet then(FirstSet const& next) const noexcept {
+        if (!m_nullable) {
+            return *this;
+        }
+        FirstSet out = *this | next;
+        out.m_nullable = next.m_nullable;
+        return out;
+    }
+
+    constexpr FirstSet maybe() const noexcept {
+        FirstSet out = *this;
+        out.m_nullable = true;
+        return out;
+    }
+
+    constexpr bool operator==(FirstSet const&) const noexcept = default;
+private:
+    std::array<uint64_t, CharSet::CHAR_MAPPING_SIZE / 64> m_bits{};
+    bool m_nullable = false;
+};
+
+
+namespace details {
+
+/**
+ * Parser function with the known first set
+ */
+template <typename Fn>
+struct WithFirstSet {
+    Fn fn;
+    FirstSet first;
+
+    template <typename ...Args>
+        requires(std::is_invocable_v<Fn const&, Args...>)
+    constexpr decltype(auto) operator()(Args&& ...args) const noexcept(std::is_nothrow_invocable_v<Fn const&, Args...>) {
+        return std::invoke(fn, std::forward<Args>(args)...);
+    }
+};
+
+template <typename Fn>
+constexpr inline bool IsWithFirstSet = false;
+
+template <typename Fn>
+constexpr inline bool IsWithFirstSet<WithFirstSet<Fn>> = true;
+
+}
+
+}
+// #include <parsecpp/core/fusion.h>
+
+
+// #include <parsecpp/core/expected.h>
+
+// #include <parsecpp/core/firstSet.h>
+
+// #include <parsecpp/core/parsingError.h>
+
+// #include <parsecpp/core/stream.h>
+
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace prs::details {
+
+/**
+ * Parser function that matches a fixed number of bytes without side effects,
+ * so a sequence of them can be checked with one bounds check.
+ * matchAt and valueAt are called only if width() bytes are available.
+ */
+template <typename F>
+concept FusablePrimitive = requires(F const& f, Stream& stream, char const* p) {
+    { f.width() } -> std::convertible_to<size_t>;
+    { f.matchAt(p) } -> std::convertible_to<bool>;
+    f.valueAt(p);
+    { f(stream) } -> std::same_as<ResultType<std::decay_t<decltype(f.valueAt(p))>>>;
+};
+
+
+/**
+ * Sequence of primitives that is matched at once, the result is the value of the part resultIndex.
+ * The parts are run one by one only to reproduce the error of the sequence.
+ */
+template <size_t resultIndex, FusablePrimitive ...Parts>
+class FusedFn {
+    using Parts_ = std::tuple<Parts...>;
+public:
+    static constexpr size_t RESULT_INDEX = resultIndex;
+    using Result = std::decay_t<decltype(std::declval<std::tuple_element_t<resultIndex, Parts_> const&>().valueAt(nullptr))>;
+
+    constexpr explicit FusedFn(Parts_ parts) noexcept(std::is_nothrow_move_constructible_v<Parts_>)
+        : m_parts(std::move(parts)) {
+
+    }
+
+    constexpr Parts_ const& parts() const noexcept {
+        return m_parts;
+    }
+
+    constexpr size_t width() const noexcept {
+        return std::apply([](auto const& ...parts) {
+            return (size_t{0} + ... + parts.width());
+        }, m_parts);
+    }
+
+    constexpr bool matchAt(char const* p) const noexcept(noexcept(matchFrom<0>(p))) {
+        return matchFrom<0>(p);
+    }
+
+    constexpr Result valueAt(char const* p) const {
+        return std::get<resultIndex>(m_parts).valueAt(p + offsetOf<resultIndex>());
+    }
+
+    ResultType<Result> operator()(Stream& stream) const noexcept((std::is_nothrow_invocable_v<Parts const&, Stream&> && ...)) {
+        auto const sv = stream.sv();
+        if (auto const n = width(); sv.size() >= n && matchAt(sv.data())) {
+            auto out = valueAt(sv.data());
+            stream.moveUnsafe(n);
+            return ResultType<Result>{std::move(out)};
+        }
+        return sequential(stream);
+    }
+private:
+    template <size_t I>
+    constexpr bool matchFrom(char const* p) const {
+        if constexpr (I == sizeof...(Parts)) {
+            return true;
+        } else {
+            auto const& part = std::get<I>(m_parts);
+            return part.matchAt(p) && matchFrom<I + 1>(p + part.width());
+        }
+    }
+
+    template <size_t I>
+    constexpr size_t offsetOf() const noexcept {
+        if constexpr (I == 0) {
+            return 0;
+        } else {
+            return offsetOf<I - 1>() + std::get<I - 1>(m_parts).width();
+        }
+    }
+
+    ResultType<Result> sequential(Stream& stream) const {
+        auto const start = stream.pos();
+        std::optional<ParsingError> error;
+        auto step = [&](auto const& part) {
+            auto result = part(stream);
+            if (result.isError()) {
+                error.emplace(std::move(result).error());
+                return false;
+            }
+            return true;
+        };
+        std::apply([&](auto const& ...parts) {
+            (step(parts) && ...);
+        }, m_parts);
+
+        if (error) {
+            return ResultType<Result>{std::move(*error)};
+        }
+        return ResultType<Result>{valueAt(stream.full().data() + start)};
+    }
+
+    Parts_ m_parts;
+};
+
+
+template <typename F>
+constexpr inline bool IsFused = false;
+
+template <size_t resultIndex, typename ...Parts>
+constexpr inline bool IsFused<FusedFn<resultIndex, Parts...>> = true;
+
+
+template <typename Fn>
+constexpr Fn const& unwrapFirstSet(Fn const& fn) noexcept {
+    return fn;
+}
+
+template <typename Fn>
+constexpr Fn const& unwrapFirstSet(WithFirstSet<Fn> const& fn) noexcept {
+    return fn.fn;
+}
+
+template <typename Fn>
+using UnwrapFirstSet = std::decay_t<decltype(unwrapFirstSet(std::declval<Fn const&>()))>;
+
+template <typename LhsFn, typename RhsFn>
+concept Fusable = FusablePrimitive<UnwrapFirstSet<LhsFn>> && FusablePrimitive<UnwrapFirstSet<RhsFn>>;
+
+
+template <FusablePrimitive F>
+constexpr auto fusionParts(F const& f) {
+    if constexpr (IsFused<F>) {
+        return f.parts();
+    } else {
+        return std::tuple<F>{f};
+    }
+}
+
+template <FusablePrimitive F>
+constexpr size_t fusionResultIndex() noexcept {
+    if constexpr (IsFused<F>) {
+        return F::RESULT_INDEX;
+    } else {
+        return 0;
+    }
+}
+
+template <size_t resultIndex, typename ...Parts>
+constexpr auto makeFused(std::tuple<Parts...> parts) {
+    return FusedFn<resultIndex, Parts...>{std::move(parts)};
+}
+
+/**
+ * Flat sequence of the primitives of lhs and rhs
+ * @param keepLeft - the result of lhs (`<<`) or rhs (`>>`)
+ */
+template <bool keepLeft, typename LhsFn, typename RhsFn>
+    requires(Fusable<LhsFn, RhsFn>)
+constexpr auto fuse(LhsFn const& lhsFn, RhsFn const& rhsFn) {
+    using L = UnwrapFirstSet<LhsFn>;
+    using R = UnwrapFirstSet<RhsFn>;
+    auto lhs = fusionParts(unwrapFirstSet(lhsFn));
+    constexpr size_t index = keepLeft
+            ? fusionResultIndex<L>()
+            : std::tuple_size_v<decltype(lhs)> + fusionResultIndex<R>();
+    return makeFused<index>(std::tuple_cat(std::move(lhs), fusionParts(unwrapFirstSet(rhsFn))));
+}
+
+}
+// #include <parsecpp/core/into.h>
+
+
+// #include <parsecpp/core/baseTypes.h>
+
+// #include <parsecpp/core/stream.h>
+
+
+#include <type_traits>
+#include <utility>
+
+namespace prs::details {
+
+/**
+ * Parser function that can refill the caller's object instead of creating a new one
+ */
+template <typename Fn, typename Out, typename Ctx>
+concept HasInto = requires(Fn const& fn, Stream& stream, Ctx& ctx, Out& out) {
+    { fn.into(stream, ctx, out) } -> std::same_as<ResultType<Drop>>;
+};
+
+
+/**
+ * Drop the items after `size` keeping the capacity and the kept items
+ */
+template <typename Out>
+void truncate(Out& out, size_t size) noexcept {
+    while (out.size() > size) {
+        out.pop_back();
+    }
+}
+
+
+/**
+ * Trivial items aren't reused, they are parsed by value and appended
+ */
+template <typename Out>
+void clearTrivial(Out& out) noexcept {
+    if constexpr (std::is_trivially_copyable_v<typename Out::value_type>) {
+        out.clear();
+    }
+}
+
+
+/**
+ * `>>` and `<<` of not fusable parsers, the kept side is parsed into the caller's object by into
+ */
+template <bool keepLeft, typename Lhs, typename Rhs>
+struct SequenceFn {
+    static constexpr bool nothrow = Lhs::nothrow && Rhs::nothrow;
+
+    template <typename Ctx>
+    auto operator()(Stream& stream, Ctx& ctx) const noexcept(nothrow) {
+        if constexpr (keepLeft) {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx](auto&& body) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx).map([&body](auto const& _) {
+                    return std::move(body);
+                });
+            });
+        } else {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx](auto const& body) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx);
+            });
+        }
+    }
+
+    template <typename Ctx, typename Out>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(nothrow) {
+        if constexpr (keepLeft) {
+            return lhs.parseInto(stream, ctx, out).flatMap([this, &stream, &ctx](Drop) noexcept(Rhs::nothrow) {
+                return rhs.apply(stream, ctx).map([](auto const& _) {
+                    return Drop{};
+                });
+            });
+        } else {
+            return lhs.apply(stream, ctx).flatMap([this, &stream, &ctx, &out](auto const& body) noexcept(Rhs::nothrow) {
+                return rhs.parseInto(stream, ctx, out);
+            });
+        }
+    }
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+
+/**
+ * Loop of repeat, the items of the caller's container are reused by into
+ * @tparam Capacity - FixedCapacity or AdaptiveCapacity
+ */
+template <typename Out, size_t maxIteration, typename Capacity, typename Value>
+struct RepeatFn {
+    template <typename Ctx>
+    ResultType<Out> operator()(Stream& stream, Ctx& ctx) const noexcept(Value::nothrow) {
+        Out out{};
+        return into(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(Value::nothrow) {
+        clearTrivial(out);
+        out.reserve(capacity.hint());
+
+        size_t iteration = 0;
+
+        auto backup = stream.pos();
+        do {
+            backup = stream.pos();
+            if (!parseItem(value, stream, ctx, out, iteration)) {
+                stream.restorePos(backup);
+                truncate(out, iteration);
+                capacity.record(iteration);
+                return ResultType<Drop>{Drop{}};
+            }
+        } while (++iteration != maxIteration);
+
+        return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+    }
+
+    /**
+     * Parse the item `i` into the old one if it exists and owns memory
+     */
+    template <typename Parser, typename Ctx>
+    static bool parseItem(Parser const& parser, Stream& stream, Ctx& ctx, Out& out, size_t i) {
+        using Item = decltype(out[i]);
+        if constexpr (std::is_lvalue_reference_v<Item> && !std::is_trivially_copyable_v<std::remove_reference_t<Item>>) {
+            if (i < out.size()) {
+                return !parser.parseInto(stream, ctx, out[i]).isError();
+            }
+        }
+
+        auto result = parser.apply(stream, ctx);
+        if (result.isError()) {
+            return false;
+        }
+        out.emplace_back(std::move(result).data());
+        return true;
+    }
+
+    Value value;
+    [[no_unique_address]] Capacity capacity;
+};
+
+
+template <typename Out, size_t maxIteration, typename Capacity, typename Value, typename Delimiter>
+struct RepeatDelimiterFn {
+    static constexpr bool nothrow = Value::nothrow && Delimiter::nothrow;
+
+    template <typename Ctx>
+    ResultType<Out> operator()(Stream& stream, Ctx& ctx) const noexcept(nothrow) {
+        Out out{};
+        return into(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Out& out) const noexcept(nothrow) {
+        clearTrivial(out);
+        out.reserve(capacity.hint());
+
+        size_t iteration = 0;
+
+        auto backup = stream.pos();
+        do {
+            if (!RepeatFn<Out, maxIteration, Capacity, Value>::parseItem(value, stream, ctx, out, iteration)) {
+                truncate(out, iteration);
+                capacity.record(iteration);
+                return ResultType<Drop>{Drop{}};
+            }
+
+            backup = stream.pos();
+        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+
+        if (iteration == maxIteration) {
+            return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+        } else {
+            stream.restorePos(backup);
+            truncate(out, iteration + 1);
+            capacity.record(iteration + 1);
+            return ResultType<Drop>{Drop{}};
+        }
+    }
+
+    Value value;
+    Delimiter delimiter;
+    [[no_unique_address]] Capacity capacity;
+};
+
+}
+// #include <parsecpp/core/stream.h>
+
+
+#include <algorithm>
+#include <concepts>
+#include <string_view>
+#include <functional>
+#include <utility>
+#include <optional>
+
+
+namespace prs {
+
+template <typename T, ContextType CtxType = VoidContext, typename Func = details::StdFunction<T, CtxType>>
+        requires (IsParserFn<Func, CtxType>)
+class Parser {
+public:
+    static constexpr bool nocontext = IsVoidCtx<CtxType>;
+    static constexpr bool nothrow = std::conditional_t<nocontext && std::is_invocable_v<Func, Stream&>,
+                    std::is_nothrow_invocable<Func, Stream&>,
+                    std::is_nothrow_invocable<Func, Stream&, CtxType&>>::value;
+
+    using StoredFn = std::decay_t<Func>;
+    static constexpr bool hasFirstSet = details::IsWithFirstSet<StoredFn>;
+
+    using Type = T;
+    using Ctx = CtxType;
+    using Result = details::ResultType<T>;
+
+
+    template <typename Fn>
+        requires (IsParserFn<Fn, Ctx>)
+    constexpr static auto make(Fn &&f) noexcept {
+        return Parser<T, Ctx, Fn>(std::forward<Fn>(f));
+    }
+
+
+    template <typename U>
+        requires(std::is_same_v<std::decay_t<U>, StoredFn>)
+    constexpr explicit Parser(U&& f) noexcept
+        : m_fn(std::forward<U>(f)) {
+
+    }
+
+    constexpr Result operator()(Stream& stream) const noexcept(nothrow) requires(nocontext) {
+        if constexpr (!std::is_invocable_v<StoredFn, Stream&> && nocontext) {
+            return std::invoke(m_fn, stream, VOID_CONTEXT);
+        } else {
+            return std::invoke(m_fn, stream);
+        }
+    }
+
+    template <ContextType Context>
+    constexpr Result operator()(Stream& stream, Context& ctx) const noexcept(nothrow) {
+        if constexpr (nocontext && std::is_invocable_v<StoredFn, Stream&>) {
+            return std::invoke(m_fn, stream);
+        } else {
+            return std::invoke(m_fn, stream, ctx);
+        }
+    }
+
+
+    constexpr Result apply(Stream& stream) const noexcept(nothrow) requires(nocontext) {
+        return operator()(stream);
+    }
+
+    template <typename Context>
+    constexpr Result apply(Stream& stream, Context& ctx) const noexcept(nothrow) {
+        return operator()(stream, ctx);
+    }
+
+
+    /**
+     * Parse into the caller's object, repeat, toMap and escapedString clear and refill it keeping the capacity.
+     * Other parsers assign the result.
+     */
+    details::ResultType<Drop> parseInto(Stream& stream, T& out) const noexcept(nothrow) requires(nocontext) {
+        return parseInto(stream, VOID_CONTEXT, out);
+    }
+
+    template <typename Context>
+    details::ResultType<Drop> parseInto(Stream& stream, Context& ctx, T& out) const noexcept(nothrow) {
+        if constexpr (details::HasInto<details::UnwrapFirstSet<StoredFn>, T, Context>) {
+            return details::unwrapFirstSet(m_fn).into(stream, ctx, out);
+        } else {
+            return apply(stream, ctx).map([&out](T&& t) {
+                out = std::move(t);
+                return Drop{};
+            });
+        }
+    }
+
+
+    template <typename ...Args>
+        requires(std::is_constructible_v<Ctx, Args...>)
+    static Ctx makeCtx(Args&& ...args) noexcept(std::is_nothrow_constructible_v<Ctx, Args...>) {
+        return Ctx{std::forward<Args>(args)...};
+    }
+
+    /**
+     * @return bytes that can start a successful parse, FirstSet::any() if they are unknown
+     */
+    constexpr FirstSet firstSet() const noexcept {
+        if constexpr (hasFirstSet) {
+            return m_fn.first;
+        } else {
+            return FirstSet::any();
+        }
+    }
+
+    /**
+     * The stored parser function, adjacent primitive parsers are fused by it
+     */
+    constexpr StoredFn const& fn() const noexcept {
+        return m_fn;
+    }
+
+    /**
+     * The same parser with the declared first set, e.g. for `lazy` parsers in `choice`
+     */
+    constexpr auto withFirstSet(FirstSet first) const noexcept {
+        if constexpr (hasFirstSet) {
+            return Parser<T, Ctx, StoredFn>(StoredFn{m_fn.fn, first});
+        } else {
+            using Fn = details::WithFirstSet<StoredFn>;
+            return Parser<T, Ctx, Fn>(Fn{m_fn, first});
+        }
+    }
+
+    /**
+     * @def `>>` :: Parser<A> -> Parser<B> -> Parser<B>
+     */
+    template <typename B, typename CtxB, typename Rhs>
+        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet().then(rhs.firstSet());
+        if constexpr (details::Fusable<StoredFn, typename Parser<B, CtxB, Rhs>::StoredFn>) {
+            return keepFirstSet<hasFirstSet>(Parser<B>::make(details::fuse<false>(m_fn, rhs.fn())), first);
+        } else {
+            using Fn = details::SequenceFn<false, Parser, Parser<B, CtxB, Rhs>>;
+            return keepFirstSet<hasFirstSet>(Parser<B>::make(Fn{*this, rhs}), first);
+        }
+    }
+
+
+    /**
+     * @def `>>` :: Parser<A, CtxA> -> Parser<B, CtxB> -> Parser<B, CtxA & CtxB>
+     */
+    template <typename B, typename CtxB, typename Rhs>
+        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator>>(Parser<B, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet().then(rhs.firstSet());
+        using Fn = details::SequenceFn<false, Parser, Parser<B, CtxB, Rhs>>;
+        return keepFirstSet<hasFirstSet>(Parser<B, UnionCtx<Ctx, CtxB>>::make(Fn{*this, rhs}), first);
+    }
+
+
+    /**
+     * @def `<<` :: Parser<A> -> Parser<B> -> Parser<A>
+     */
+    template <typename B, typename CtxB, typename Rhs>
+        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet().then(rhs.firstSet());
+        if constexpr (details::Fusable<StoredFn, typename Parser<B, CtxB, Rhs>::StoredFn>) {
+            return keepFirstSet<hasFirstSet>(Parser<T>::make(details::fuse<true>(m_fn, rhs.fn())), first);
+        } else {
+            using Fn = details::SequenceFn<true, Parser, Parser<B, CtxB, Rhs>>;
+            return keepFirstSet<hasFirstSet>(Parser<T>::make(Fn{*this, rhs}), first);
+        }
+    }
+
+
+    /**
+     * @def `<<` :: Parser<A, CtxA> -> Parser<B, CtxB> -> Parser<A, CtxA & CtxB>
+     */
+    template <typename B, typename CtxB, typename Rhs>
+        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator<<(Parser<B, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet().then(rhs.firstSet());
+        using Fn = details::SequenceFn<true, Parser, Parser<B, CtxB, Rhs>>;
+        return keepFirstSet<hasFirstSet>(Parser<T, UnionCtx<Ctx, CtxB>>::make(Fn{*this, rhs}), first);
+    }
+
+
+    /*
+     * <$>, fmap operator
+     * @def `>>=` :: Parser<A> -> (A -> B) -> Parser<B>
+     * Lhs is checked first: ADL finds these friends of the parsers stored in SequenceFn and RepeatFn too
+     */
+    template <typename Lhs, typename ListFn>
+        requires(std::is_same_v<Lhs, Parser> && nocontext)
+    constexpr friend auto operator>>=(Lhs lhs, ListFn fn) noexcept {
+        using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
+        auto const first = lhs.firstSet();
+        return keepFirstSet<hasFirstSet>(Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream) {
+           return lhs.apply(stream).map(fn);
+        }), first);
+    }
+
+
+    /*
+     * <$>, fmap operator
+     * @def `>>=` :: Parser<A, Ctx> -> (A -> B) -> Parser<B, Ctx>
+     */
+    template <typename Lhs, typename ListFn>
+        requires(std::is_same_v<Lhs, Parser> && !nocontext && std::invocable<ListFn, T>)
+    constexpr friend auto operator>>=(Lhs lhs, ListFn fn) noexcept {
+        using ResultT = std::decay_t<std::invoke_result_t<ListFn, T>>;
+        auto const first = lhs.firstSet();
+        return keepFirstSet<hasFirstSet>(Parser<ResultT, Ctx>::make([lhs, fn](Stream& stream, auto& ctx) {
+            return lhs.apply(stream, ctx).map(fn);
+        }), first);
+    }
+
+    template <std::invocable<T> ListFn>
+    constexpr auto fmap(ListFn &&fn) const noexcept {
+        return *this >>= std::forward<ListFn>(fn);
+    }
+
+    /*
+     * bind operator
+     * @def bind :: Parser<A> -> (A -> Parser<B>) -> Parser<B>
+     */
+    template <typename ListFn>
+        requires(nocontext && IsVoidCtx<GetParserCtx<std::invoke_result_t<ListFn, T>>>)
+    constexpr auto bind(ListFn fn) const noexcept {
+        using ResultT = GetParserResult<std::invoke_result_t<ListFn, T>>;
+        return Parser<ResultT, Ctx>::make([lhs = *this, fn](Stream& stream) {
+           return lhs.apply(stream).flatMap([&](T &&t) {
+               return fn(std::move(t)).apply(stream);
+           });
+        });
+    }
+
+
+    /*
+     * bind operator
+     * @def bind :: Parser<A, CtxA> -> (A -> Parser<B, CtxB>) -> Parser<B, CtxA & CtxB>
+     */
+    template <typename ListFn>
+        requires(!nocontext || !IsVoidCtx<GetParserCtx<std::invoke_result_t<ListFn, T>>>)
+    constexpr auto bind(ListFn fn) const noexcept {
+        using ResultT = GetParserResult<std::invoke_result_t<ListFn, T>>;
+        using UCtx = UnionCtx<Ctx, GetParserCtx<std::invoke_result_t<ListFn, T>>>;
+
+        return Parser<ResultT, UCtx>::make([lhs = *this, fn](Stream& stream, UCtx& ctx) {
+           return lhs.apply(stream, ctx).flatMap([&](T &&t) {
+               return fn(std::move(t)).apply(stream, ctx);
+           });
+        });
+    }
+
+
+    /**
+     * @def `|` :: Parser<A> -> Parser<A> -> Parser<A>
+     */
+    template <typename CtxB, typename Rhs>
+        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet() | rhs.firstSet();
+        return keepFirstSet<hasFirstSet && Parser<T, CtxB, Rhs>::hasFirstSet>(Parser<T>::make([lhs = *this, rhs](Stream& stream) {
+            auto backup = stream.pos();
+            return lhs.apply(stream).flatMapError([&](details::ParsingError const& firstError) noexcept(Parser<T, CtxB, Rhs>::nothrow) {
+                stream.restorePos(backup);
+                return rhs.apply(stream).flatMapError([&](details::ParsingError const& secondError) {
+                    return makeError(details::ParsingError::orError(firstError, secondError));
+                });
+            });
+        }), first);
+    }
+
+    /**
+     * @def `|` :: Parser<A, CtxA> -> Parser<A, CtxB> -> Parser<A, CtxA & CtxB>
+     */
+    template <typename CtxB, typename Rhs>
+        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
+    constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
+        auto const first = firstSet() | rhs.firstSet();
+        return keepFirstSet<hasFirstSet && Parser<T, CtxB, Rhs>::hasFirstSet>(Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) {
+            auto backup = stream.pos();
+            return lhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& firstError) {
+                stream.restorePos(backup);
+                return rhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& secondError) {
+                    return makeError(details::ParsingError::orError(firstError, secondError));
+                });
+            });
+        }), first);
+    }
+
+
+    template <typename A>
+    using MaybeValue = std::conditional_t<std::is_same_v<A, Drop>, Drop, std::optional<A>>;
+
+    /**
+     * @def maybe :: Parser<A> -> Parser<std::optional<B>>
+     * maybe :: Parser<Drop> -> Parser<Drop>
+     */
+    constexpr auto maybe() const noexcept {
+        if constexpr (nocontext) {
+            return keepFirstSet<hasFirstSet>(Parser<MaybeValue<T>>::make([parser = *this](Stream& stream) {
+                auto backup = stream.pos();
+                return parser.apply(stream).map([](T&& t) {
+                    if constexpr (std::is_same_v<T, Drop>) {
+                        return Drop{};
+                    } else {
+                        return MaybeValue<T>{std::move(t)};
+                    }
+                }, [&stream, &backup](details::ParsingError const& error) {
+                    stream.restorePos(backup);
+                    return MaybeValue<T>{};
+                });
+            }), firstSet().maybe());
+        } else {
+            return keepFirstSet<hasFirstSet>(Parser<MaybeValue<T>, Ctx>::make([parser = *this](Stream& stream, auto& ctx) {
+                auto backup = stream.pos();
+                return parser.apply(stream, ctx).map([](T&& t) {
+                    if constexpr (std::is_same_v<T, Drop>) {
+                        return Drop{};
+                    } else {
+                        return MaybeValue<T>{std::move(t)};
+                    }
+                }, [&stream, &backup](details::ParsingError const& error) {
+                    stream.restorePos(backup);
+                    return MaybeValue<T>{};
+                });
+            }), firstSet().maybe());
+        }
+    }
+
+
+    /**
+     * @def maybeOr :: Parser<A> -> Parser<A>
+     */
+    constexpr auto maybeOr(T const& defaultValue) const noexcept {
+        if constexpr (nocontext) {
+            return Parser<T>::make([parser = *this, defaultValue](Stream& stream) {
+                auto backup = stream.pos();
+                return parser.apply(stream).flatMapError([&stream, &backup, &defaultValue](details::ParsingError const& error) {
+                    stream.restorePos(backup);
+                    return data(defaultValue);
+                });
+            });
+        } else {
+            return Parser<T, Ctx>::make([parser = *this, defaultValue](Stream& stream, auto& ctx) {
+                auto backup = stream.pos();
+                return parser.apply(stream, ctx).flatMapError([&stream, &backup, &defaultValue](details::ParsingError const& error) {
+                    stream.restorePos(backup);
+                    return data(defaultValue);
+                });
+            });
+        }
+    }
+
+
+    /**
+     * @def repeat :: Parser<A> -> Parser<std::vector<A>>
+     */
+    template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeat() const noexcept {
+        return repeatTo<std::vector<T>, maxIteration>(details::FixedCapacity<reserve>{});
+    }
+
+    /**
+     * repeat with the first `inlineCapacity` items stored without a heap allocation
+     * @def repeatSmall :: Parser<A> -> Parser<SmallVector<A, inlineCapacity>>
+     */
+    template <size_t inlineCapacity, size_t maxIteration = MAX_ITERATION>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeatSmall() const noexcept {
+        return repeatTo<SmallVector<T, inlineCapacity>, maxIteration>(details::FixedCapacity<0>{});
+    }
+
+    /**
+     * repeat reserving the running p90 of the previous result sizes of this parser and its copies
+     * @def repeatAdaptive :: Parser<A> -> Parser<std::vector<A>>
+     */
+    template <size_t maxIteration = MAX_ITERATION>
+            requires(!std::is_same_v<T, Drop>)
+    auto repeatAdaptive() const {
+        return repeatTo<std::vector<T>, maxIteration>(details::AdaptiveCapacity{});
+    }
+
+    /**
+     * @def repeat :: Parser<Drop> -> Parser<Drop>
+     */
+    template <size_t maxIteration = MAX_ITERATION>
+            requires(std::is_same_v<T, Drop>)
+    constexpr auto repeat() const noexcept {
+        using P = Parser<Drop, Ctx>;
+        return P::make([value = *this](Stream& stream, auto& ctx) noexcept(nothrow) {
+            size_t iteration = 0;
+
+            auto backup = stream.pos();
+            do {
+                backup = stream.pos();
+                auto result = value.apply(stream, ctx);
+                if (result.isError()) {
+                    stream.restorePos(backup);
+                    return P::data({});
+                }
+            } while (++iteration != maxIteration);
+
+            return P::makeError("Max iteration", stream.pos());
+        });
+    }
+
+
+    /**
+     * @def repeat :: Parser<A> -> Parser<Delim> -> Parser<std::vector<A>>
+     */
+    template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeat(Delimiter tDelimiter) const noexcept {
+        return repeatTo<std::vector<T>, maxIteration>(details::FixedCapacity<reserve>{}, std::move(tDelimiter));
+    }
+
+    /**
+     * @def repeatSmall :: Parser<A> -> Parser<Delim> -> Parser<SmallVector<A, inlineCapacity>>
+     */
+    template <size_t inlineCapacity, size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(!std::is_same_v<T, Drop>)
+    constexpr auto repeatSmall(Delimiter tDelimiter) const noexcept {
+        return repeatTo<SmallVector<T, inlineCapacity>, maxIteration>(details::FixedCapacity<0>{}, std::move(tDelimiter));
+    }
+
+    /**
+     * @def repeatAdaptive :: Parser<A> -> Parser<Delim> -> Parser<std::vector<A>>
+     */
+    template <size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(!std::is_same_v<T, Drop>)
+    auto repeatAdaptive(Delimiter tDelimiter) const {
+        return repeatTo<std::vector<T>, maxIteration>(details::AdaptiveCapacity{}, std::move(tDelimiter));
+    }
+
+    /**
+     * @def repeat :: Parser<Drop> -> Parser<Delim> -> Parser<Drop>
+     */
+    template <size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
+            requires(std::is_same_v<T, Drop>)
+    constexpr auto repeat(Delimiter tDelimiter) const noexcept {
+        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
+        using P = Parser<Drop, UCtx>;
+        return P::make([value = *this, delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) {
+            size_t iteration = 0;
+
+            auto backup = stream.pos();
+            do {
+                auto result = value.apply(stream, ctx);
+                if (result.isError()) {
+                    return P::data(Drop{});
+                }
+
+                backup = stream.pos();
+            } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+
+            if (iteration == maxIteration) {
+                return P::makeError("Max iteration", stream.pos());
+            } else {
+                stream.restorePos(backup);
+                return P::data(Drop{});
+            }
+        });
+    }
+
+
+    /**
+     * @def cond :: Parser<A> -> (A -> bool) -> Parser<A>
+     */
+    template <std::predicate<T const&> Fn>
+            requires (!std::predicate<T const&, Stream&> && nocontext)
+    constexpr auto cond(Fn test) const noexcept {
+        return Parser<T>::make([parser = *this, test](Stream& stream) {
+           return parser.apply(stream).flatMap([&test, &stream](T&& t) {
+               if (test(t)) {
+                   return Parser<T>::data(std::move(t));
+               } else {
+                   return Parser<T>::makeError("Cond failed", stream.pos());
+               }
+           });
+        });
+    }
+
+    /**
+     * @def cond :: Parser<A> -> (A -> bool) -> Parser<A>
+     */
+    template <std::predicate<T const&> Fn>
+            requires (!std::predicate<T const&, Stream&> && !nocontext)
+    constexpr auto cond(Fn test) const noexcept {
+        return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
+           return parser.apply(stream, ctx).flatMap([&test, &stream](T&& t) {
+               if (test(t)) {
+                   return Parser<T>::data(std::move(t));
+               } else {
+                   return Parser<T>::makeError("Cond failed", stream.pos());
+               }
+           });
+        });
+    }
+
+    /**
+     * @def cond :: Parser<A> -> (A -> Stream& -> bool) -> Parser<A>
+     */
+    template <std::predicate<T const&, Stream&> Fn>
+        requires(nocontext)
+    constexpr auto cond(Fn test) const noexcept {
+        return Parser<T>::make([parser = *this, test](Stream& stream) {
+           return parser.apply(stream).flatMap([&test, &stream](T&& t) {
+               if (test(t, stream)) {
+                   return Parser<T>::data(std::move(t));
+               } else {
+                   return Parser<T>::makeError("Cond failed", stream.pos());
+               }
+           });
+        });
+    }
+
+    /**
+     * @def cond :: Parser<A> -> (A -> Stream& -> bool) -> Parser<A>
+     */
+    template <std::predicate<T const&, Stream&> Fn>
+        requires(!nocontext)
+    constexpr auto cond(Fn test) const noexcept {
+        return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
+           return parser.apply(stream, ctx).flatMap([&test, &stream](T&& t) {
+               if (test(t, stream)) {
+                   return Parser<T>::data(std::move(t));
+               } else {
+                   return Parser<T>::makeError("Cond failed", stream.pos());
+               }
+           });
+        });
+    }
+
+
+    /**
+     * @def cond :: Parser<A, Ctx> -> (A -> CondCtx& -> bool) -> Parser<A, Ctx & CondCtx>
+     */
+    template <ContextType CondContext, std::predicate<T const&, CondContext&> Fn>
+    constexpr auto condC(Fn test) const noexcept {
+        using UCtx = UnionCtx<Ctx, CondContext>;
+        return Parser<T, UCtx>::make([parser = *this, test](Stream& stream, auto& ctx) {
+           return parser.apply(stream, ctx).flatMap([&](T&& t) {
+               if (test(t, ctx)) {
+                   return Parser<T>::data(std::move(t));
+               } else {
+                   return Parser<T>::makeError("Cond failed", stream.pos());
+               }
+           });
+        });
+    }
+
+    /**
+     * @def Drop :: Parser<A> -> Parser<Drop>
+     */
+    constexpr auto drop() const noexcept {
+        if constexpr (nocontext) {
+            return keepFirstSet<hasFirstSet>(Parser<Drop>::make([p = *this](Stream& s) {
+                return p.apply(s).map([](auto &&) {
+                    return Drop{};
+                });
+            }), firstSet());
+        } else {
+            return keepFirstSet<hasFirstSet>(Parser<Drop, Ctx>::make([p = *this](Stream& s, auto& ctx) {
+                return p.apply(s, ctx).map([](auto &&) {
+                    return Drop{};
+                });
+            }), firstSet());
+        }
+    }
+
+    /**
+     * @def endOfStream :: Parser<A> -> Parser<A>
+     */
+    constexpr auto endOfStream() const noexcept {
+        return cond([](T const& t, Stream& s) {
+            return s.eos();
+        });
+    }
+
+    /**
+     * @def mustConsume :: Parser<A> -> Parser<A>
+     */
+    constexpr auto mustConsume() const noexcept {
+        return make([p = *this](Stream& s, auto& ctx) {
+            auto pos = s.pos();
+            return p.apply(s, ctx).flatMap([pos, &s](T&& t) {
+               if (s.pos() > pos) {
+                   return data(std::move(t));
+               } else {
+                   return makeError("Didn't consume stream", s.pos());
+               }
+            });
+        });
+    }
+
+
+    template <typename Fn>
+        requires(nocontext)
+    constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
+        return make_parser([parser = *this, fn](Stream& stream) {
+            return parser.apply(stream).flatMap([&fn, &stream](T&& t) {
+                return fn(std::move(t)).apply(stream);
+            });
+        });
+    }
+
+
+    template <typename Fn>
+        requires(!nocontext)
+    constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
+        return make_parser<Ctx>([parser = *this, fn](Stream& stream, auto& ctx) {
+            return parser.apply(stream, ctx).flatMap([&fn, &stream](T&& t) {
+                return fn(std::move(t)).apply(stream);
+            });
+        });
+    }
+
+    /**
+     * @def toCommonType :: Parser<A, Ctx, Fn> -> Parser'<A, Ctx>
+     */
+    constexpr auto toCommonType() const noexcept {
+        if constexpr (nocontext) {
+            details::StdFunction<T> f = [fn = *this](Stream& stream) {
+                return std::invoke(fn, stream);
+            };
+
+            return Parser<T>(f);
+        } else {
+            details::StdFunction<T, Ctx> f = [fn = *this](Stream& stream, auto& ctx) {
+                return std::invoke(fn, stream, ctx);
+            };
+
+            return Parser<T, Ctx>(f);
+        }
+    }
+
+    /**
+     * Type erasing without memory allocation, the parser must fit inlineSize
+     * @def toErased :: Parser<A, Ctx, Fn> -> ErasedParser<A, Ctx, inlineSize>
+     */
+    template <size_t inlineSize = ERASED_PARSER_SIZE>
+    constexpr auto toErased() const& noexcept {
+        return ErasedParser<T, Ctx, inlineSize>(details::ErasedFn<T, Ctx, inlineSize>(*this));
+    }
+
+    template <size_t inlineSize = ERASED_PARSER_SIZE>
+    constexpr auto toErased() && noexcept {
+        return ErasedParser<T, Ctx, inlineSize>(details::ErasedFn<T, Ctx, inlineSize>(std::move(*this)));
+    }
+
+    /**
+     * The parser must outlive the reference
+     * @def ref :: Parser<A, Ctx, Fn> -> ParserRef<A, Ctx>
+     */
+    constexpr auto ref() const noexcept {
+        return ParserRef<T, Ctx>(details::ParserRefFn<T, Ctx>(*this));
+    }
+
+    static Result makeError(details::ParsingError error) noexcept {
+        return Result{error};
+    }
+
+    static constexpr Result makeError(size_t pos) noexcept {
+        return Result{details::ParsingError{pos}};
+    }
+
+    static constexpr Result makeError(details::StaticText desc, size_t pos) noexcept {
+        return Result{details::ParsingError{desc, pos}};
+    }
+
+    /**
+     * The runtime description is copied to the heap, copies of the error share it.
+     * Arrays aren't accepted here: a literal is a StaticText and a mutable array is the next overload.
+     */
+    template <typename Text>
+        requires(std::convertible_to<Text const&, std::string_view> && !std::is_array_v<Text> && !details::STATIC_ERROR_TEXT)
+    static Result makeError(Text const& desc, size_t pos) {
+        if constexpr (DISABLE_ERROR_LOG) {
+            return makeError(pos);
+        } else {
+            return makeError(std::make_shared<std::string const>(std::string_view{desc}), pos);
+        }
+    }
+
+    /**
+     * A buffer with a formatted message, the text before the first null is copied
+     */
+    template <size_t N>
+    static Result makeError(char (&desc)[N], size_t pos) requires(!details::STATIC_ERROR_TEXT) {
+        return makeError(std::string_view{desc, static_cast<size_t>(std::find(desc, desc + N, '\0') - desc)}, pos);
+    }
+
+    static Result makeError(details::SharedText desc, size_t pos) noexcept requires(!details::STATIC_ERROR_TEXT) {
+        if constexpr (DISABLE_ERROR_LOG) {
+            return makeError(pos);
+        } else {
+            return Result{details::ParsingError{std::move(desc), pos}};
+        }
+    }
+
+    template <typename U = T>
+        requires(std::convertible_to<U, T>)
+    static constexpr Result data(U&& t) noexcept(std::is_nothrow_convertible_v<U, T>) {
+        return Result{std::forward<U>(t)};
+    }
+private:
+    template <typename Out, size_t maxIteration, typename Capacity>
+    constexpr auto repeatTo(Capacity capacity) const noexcept {
+        using Fn = details::RepeatFn<Out, maxIteration, Capacity, Parser>;
+        return Parser<Out, Ctx>::make(Fn{*this, std::move(capacity)});
+    }
+
+    template <typename Out, size_t maxIteration, typename Capacity, ParserType Delimiter>
+    constexpr auto repeatTo(Capacity capacity, Delimiter tDelimiter) const noexcept {
+        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
+        using Fn = details::RepeatDelimiterFn<Out, maxIteration, Capacity, Parser, Delimiter>;
+        return Parser<Out, UCtx>::make(Fn{*this, std::move(tDelimiter), std::move(capacity)});
+    }
+
+    template <bool known, ParserType P>
+    static constexpr auto keepFirstSet(P parser, FirstSet first) noexcept {
+        if constexpr (known) {
+            return parser.withFirstSet(first);
+        } else {
+            return parser;
+        }
+    }
+
+    StoredFn m_fn;
+};
+
+}
+
+
+// #include <parsecpp/core/forwardImpl.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/core/forward.h>
+
+
+namespace prs {
+
+
+template <typename T, typename Ctx>
+template <typename ParserType>
+Pimpl<T, Ctx>::Pimpl(ParserType t) noexcept {
+    static_assert(std::is_same_v<std::decay_t<ParserType>, Parser<T, Ctx>>, "Pimpl can store only Common parser type");
+    static_assert(sizeof(t) == sizeof(m_storage));
+    static_assert(alignof(ParserType) == alignof(std::function<void(void)>));
+    new (&m_storage) ParserType(t);
+}
+
+
+template <typename T>
+template <typename ParserType>
+Pimpl<T, VoidContext>::Pimpl(ParserType t) noexcept {
+    static_assert(std::is_same_v<std::decay_t<ParserType>, Parser<T>>, "Pimpl can store only Common parser type");
+    static_assert(sizeof(t) == sizeof(m_storage));
+    static_assert(alignof(ParserType) == alignof(std::function<void(void)>));
+    new (&m_storage)ParserType(t);
+}
+
+
+template <typename T, typename Ctx>
+Pimpl<T, Ctx>::~Pimpl() {
+    using P = Parser<T, Ctx>;
+    std::destroy_at(std::launder(reinterpret_cast<P*>(&m_storage)));
+}
+
+
+template <typename T>
+Pimpl<T>::~Pimpl() {
+    using P = Parser<T>;
+    std::destroy_at(std::launder(reinterpret_cast<P*>(&m_storage)));
+}
+
+
+template<typename T, typename Ctx>
+Expected<T, details::ParsingError> Pimpl<T, Ctx>::operator()(Stream& s, Ctx& ctx) const {
+    using P = Parser<T, Ctx>;
+    return reinterpret_cast<P const&>(m_storage).apply(s, ctx);
+}
+
+
+template<typename T>
+Expected<T, details::ParsingError> Pimpl<T, VoidContext>::operator()(Stream& s) const {
+    using P = Parser<T>;
+    return reinterpret_cast<P const&>(m_storage).apply(s);
+}
+
+}
+// #include <parsecpp/core/lazy.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/utils/funcHelper.h>
+
+
+#include <source_location>
+
+namespace prs {
+
+template <std::invocable Fn>
+auto lazy(Fn genParser) noexcept {
+    using P = std::invoke_result_t<Fn>;
+    if constexpr (P::nocontext) {
+        return P::make([genParser](Stream& stream) {
+            return genParser().apply(stream);
+        });
+    } else {
+        return P::make([genParser](Stream& stream, auto& ctx) {
+            return genParser().apply(stream, ctx);
+        });
+    }
+}
+
+
+template <typename RetType, typename Fn>
+auto selfLazy(Fn parserGen) noexcept {
+    return Parser<RetType>::make([parserGen](Stream& stream) {
+        details::YParser t{[&](auto const& self, Stream& s) -> Parser<RetType>::Result {
+            return parserGen(Parser<RetType>::make([&](Stream& s) -> Parser<RetType>::Result {
+                return self(s);
+            })).apply(s);
+        }};
+
+        using YT = std::decay_t<decltype(t)>;
+        static_assert(std::is_invocable_v<YT, Stream&>);
+        static_assert(IsParserFn<YT, VoidContext>);
+//        static_assert(IsParserFn<details::YParser<Fn, VoidContext>, VoidContext>);
+
+        return t(stream);
+    });
+}
+
+
+template <typename tag, typename Fn>
+class LazyCached {
+public:
+    using P = std::invoke_result_t<Fn>;
+    using ParserResult = GetParserResult<P>;
+    static constexpr bool nocontext = IsVoidCtx<GetParserCtx<P>>;
+
+    explicit LazyCached(Fn const& generator) noexcept {
+        if (!insideWork) { // cannot use optional.has_value() because generator() invoke ctor before optional::emplace
+            insideWork = true;
+            cachedParser.emplace(generator());
+        }
+    }
+
+    auto operator()(Stream& stream) const requires(nocontext) {
+        return (*cachedParser)(stream);
+    }
+
+    auto operator()(Stream& stream, auto& ctx) const {
+        return (*cachedParser)(stream, ctx);
+    }
+private:
+    inline static bool insideWork = false;
+    inline static std::optional<std::invoke_result_t<Fn>> cachedParser;
+};
+
+
+template <auto tHash>
+struct AutoTag {
+    static constexpr auto value = tHash;
+};
+
+#define AutoTagT AutoTag<details::SourceLocation::current().hash()>
+#define AutoTagV AutoTagT{}
+
+
+template <typename Tag, std::invocable Fn>
+auto lazyCached(Fn const& genParser) noexcept(std::is_nothrow_invocable_v<Fn>) {
+    return make_parser<GetParserCtx<std::invoke_result_t<Fn>>>(LazyCached<Tag, Fn>{genParser});
+}
+
+template <typename Tag, std::invocable Fn>
+auto lazyCached(Fn const& genParser, Tag tag) noexcept(std::is_nothrow_invocable_v<Fn>) {
+    return make_parser<GetParserCtx<std::invoke_result_t<Fn>>>(LazyCached<Tag, Fn>{genParser});
+}
+
+
+template <typename T, typename tag>
+class LazyForget {
+    using InvokerType = typename Parser<T>::Result (*)(void*, Stream&);
+
+    template <typename ParserOut>
+    static InvokerType makeInvoker() noexcept {
+        return [](void* pParser, Stream& s) {
+            return static_cast<ParserOut*>(pParser)->apply(s);
+        };
+    }
+public:
+    template <typename Fn>
+        requires(!std::is_same_v<Fn, LazyForget<T, tag>>)
+    explicit LazyForget(Fn const& fn) noexcept(std::is_nothrow_invocable_v<Fn>) {
+        if (pInvoke == nullptr) {
+            using ParserOut = std::invoke_result_t<Fn>;
+            pInvoke = makeInvoker<ParserOut>();
+            pParser = new ParserOut(fn());
+        }
+    }
+
+    auto operator()(Stream& stream) const {
+        return pInvoke(pParser, stream);
+    }
+private:
+    static inline InvokerType pInvoke = nullptr;
+    static inline void* pParser = nullptr;
+};
+
+
+template <typename T, typename Ctx, typename tag>
+        requires (!IsVoidCtx<Ctx>)
+class LazyForgetCtx {
+    using InvokerType = typename Parser<T, Ctx>::Result (*)(void*, Stream&, Ctx&);
+
+    template <typename ParserOut>
+    static InvokerType makeInvoker() noexcept {
+        return [](void* pParser, Stream& s, auto& ctx) {
+            return static_cast<ParserOut*>(pParser)->apply(s, ctx);
+        };
+    }
+public:
+    template <typename Fn>
+        requires(!std::is_same_v<Fn, LazyForgetCtx<T, Ctx, tag>>)
+    explicit LazyForgetCtx(Fn const& fn) noexcept(std::is_nothrow_invocable_v<Fn>) {
+        if (pInvoke == nullptr) {
+            using ParserOut = std::invoke_result_t<Fn>;
+            pInvoke = makeInvoker<ParserOut>();
+            pParser = new ParserOut(fn());
+        }
+    }
+
+    auto operator()(Stream& stream, Ctx& ctx) const {
+        return pInvoke(pParser, stream, ctx);
+    }
+private:
+    static inline InvokerType pInvoke = nullptr;
+    static inline void* pParser = nullptr;
+};
+
+
+template <typename T, typename Tag, typename Fn>
+auto lazyForget(Fn const& f, Tag = {}) noexcept {
+    return Parser<T>::make(LazyForget<T, Tag>{f});
+}
+
+template <typename T, typename Ctx, typename Fn, typename Tag>
+auto lazyForgetCtx(Fn const& f, Tag = {}) noexcept {
+    return Parser<T>::make(LazyForgetCtx<T, Ctx, Tag>{f});
+}
+
+
+struct LazyBindingTag{};
+template <typename T, ContextType ParserCtx, typename Tag = LazyBindingTag>
+class LazyCtxBinding {
+public:
+    struct LazyContext;
+
+    static constexpr bool nocontext = false;
+    using Ctx = UnionCtx<ParserCtx, ContextWrapper<LazyContext const&>>;
+
+    using P = Parser<T, Ctx>;
+    using ParserResult = T;
+
+    /**
+     * Pointer to the bound parser of any type (common, erased) and its invoker
      */
-    template <typename CtxB, typename Rhs>
-        requires (IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
-        return Parser<T>::make([lhs = *this, rhs](Stream& stream) {
-            auto backup = stream.pos();
-            return lhs.apply(stream).flatMapError([&](details::ParsingError const& firstError) noexcept(Parser<T, CtxB, Rhs>::nothrow) {
-                stream.restorePos(backup);
-                return rhs.apply(stream).flatMapError([&](details::ParsingError const& secondError) {
-                    return PRS_MAKE_ERROR(
-                            "Or error: " + firstError.description + ", " + secondError.description
-                                 , std::max(firstError.pos, secondError.pos));
-                });
+    struct LazyContext {
+        template <typename Fn>
+        explicit LazyContext(Parser<T, Ctx, Fn> const* p) noexcept
+            : parser(p)
+            , invoke([](void const* bound, Stream& stream, Ctx& ctx) -> details::ResultType<T> {
+                return static_cast<Parser<T, Ctx, Fn> const*>(bound)->apply(stream, ctx);
+            }) {}
+        void const*const parser;
+        details::ResultType<T> (*const invoke)(void const*, Stream&, Ctx&);
+    };
+
+    explicit LazyCtxBinding() noexcept = default;
+
+    template <ContextType Context>
+    details::ResultType<ParserResult> operator()(Stream& stream, Context& ctx) const {
+        auto const& binding = get<LazyContext>(ctx);
+        return binding.invoke(binding.parser, stream, ctx);
+    }
+};
+
+template <typename Fn, typename Tag>
+auto lazyCtxBindingFn(Fn const& f [[maybe_unused]], Tag = {}) noexcept {
+    using P = std::invoke_result_t<Fn>;
+    using T = GetParserResult<P>;
+    using Ctx = GetParserCtx<P>;
+    using LZ = LazyCtxBinding<T, Ctx, Tag>;
+    return Parser<T, typename LZ::Ctx>::make(LZ{});
+}
+
+
+template <typename Tag, typename Fn>
+auto lazyCtxBindingFn(Fn const& f [[maybe_unused]]) noexcept {
+    return lazyCtxBinding(f, Tag{});
+}
+
+
+template <typename T, typename Tag = LazyBindingTag>
+auto lazyCtxBinding() noexcept {
+    using LZ = LazyCtxBinding<T, VoidContext, Tag>;
+    return Parser<T, typename LZ::Ctx>::make(LZ{});
+}
+
+
+template <typename T, typename Tag>
+auto lazyCtxBinding(Tag) noexcept {
+    return lazyCtxBinding<T, Tag>();
+}
+
+template <typename T, typename Ctx, typename Tag = LazyBindingTag>
+auto lazyCtxBindingCtx() noexcept {
+    using LZ = LazyCtxBinding<T, Ctx, Tag>;
+    return Parser<T, typename LZ::Ctx>::make(LZ{});
+}
+
+template <typename T, typename Ctx, typename Tag>
+auto lazyCtxBindingCtx(Tag = Tag{}) noexcept {
+    return lazyCtxBindingCtx<T, Ctx, Tag>();
+}
+
+template <typename T, ContextType Ctx, typename Tag = LazyBindingTag, typename Fn>
+requires (sizeCtx<Ctx> == 1)
+auto makeBindingCtx(Parser<T, Ctx, Fn> const& parser) noexcept {
+    using LazyCtx = typename LazyCtxBinding<T, VoidContext, Tag>::LazyContext;
+    return LazyCtx{std::addressof(parser)};
+}
+
+}
+// #include <parsecpp/core/lift.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/common/base.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/utils/cmp.h>
+
+
+#include <utility>
+
+
+namespace prs::details {
+
+template <typename T, typename First, typename ...Args>
+constexpr bool cmpAnyOf(T const& t, First &&f, Args &&...args) noexcept {
+    if constexpr (sizeof...(args) > 0) {
+        return f == t || cmpAnyOf(t, std::forward<Args>(args)...);
+    } else {
+        return f == t;
+    }
+}
+
+}
+
+namespace prs {
+
+/**
+ *
+ * @return Parser<T>
+ */
+template <typename T>
+auto pure(T tValue) noexcept {
+    using Value = std::decay_t<T>;
+    return Parser<Value>::make([t = std::move(tValue)](Stream&) {
+        return Parser<Value>::data(t);
+    });
+}
+
+/**
+ *
+ * @return Parser<Unit>
+ */
+inline auto success() noexcept {
+    return pure(Unit{});
+}
+
+/**
+ *
+ * @return Parser<Unit>
+ */
+inline auto fail() noexcept {
+    return Parser<Unit>::make([](Stream& s) {
+        return Parser<Unit>::makeError("Fail", s.pos());
+    });
+}
+
+/**
+ *
+ * @return Parser<Unit>
+ */
+inline auto fail(std::string const& text) noexcept {
+    return Parser<Unit>::make([text = details::keepErrorText(text)](Stream& s) {
+        return Parser<Unit>::makeError(text, s.pos());
+    });
+}
+
+}
+
+namespace prs {
+
+
+template <typename Ctx = VoidContext, typename Fn>
+auto make_parser(Fn &&f) noexcept {
+    using T = typename std::conditional_t<std::is_invocable_v<Fn, Stream&>
+            , std::invoke_result<Fn, Stream&>
+            , std::invoke_result<Fn, Stream&, Ctx&>>::type::Body;
+
+    return Parser<T, Ctx>::make(std::forward<Fn>(f));
+}
+
+namespace details {
+
+template <typename Fn, typename TupleParser, typename ...Values>
+auto liftRec(Fn const& fn, Stream& stream, TupleParser const& parsers, Values &&...values) noexcept {
+    constexpr size_t Ind = sizeof...(values);
+    if constexpr (std::tuple_size_v<TupleParser> == Ind) {
+        using ReturnType = std::invoke_result_t<Fn, Values...>;
+        return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)...));
+    } else {
+        return std::get<Ind>(parsers).apply(stream).flatMap([&](auto &&a) {
+            return liftRec(
+                    fn, stream, parsers, std::forward<Values>(values)..., std::forward<decltype(a)>(a));
+        });
+    }
+}
+
+
+template <typename Fn, typename Ctx, typename TupleParser, typename ...Values>
+auto liftRecCtx(Fn const& fn, Stream& stream, Ctx& ctx, TupleParser const& parsers, Values &&...values) noexcept {
+    constexpr size_t Ind = sizeof...(values);
+    if constexpr (std::tuple_size_v<TupleParser> == Ind) {
+        using ReturnType = std::invoke_result_t<Fn, Values...>;
+        if constexpr (std::is_invocable_v<Fn, Values...>) {
+            return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)...));
+        } else {
+            return Parser<ReturnType>::data(std::invoke(fn, std::forward<Values>(values)..., ctx));
+        }
+    } else {
+        return std::get<Ind>(parsers).apply(stream, ctx).flatMap([&](auto &&a) {
+            return liftRecCtx(
+                    fn, stream, ctx, parsers, std::forward<Values>(values)..., std::forward<decltype(a)>(a));
+        });
+    }
+}
+
+}
+
+template <typename Fn, ParserType ...Args>
+    requires(IsVoidCtx<GetContextTrait<Fn>> && (IsVoidCtx<GetParserCtx<Args>> && ...))
+auto liftM(Fn fn, Args &&...args) noexcept {
+    return make_parser([fn, parsers = std::make_tuple(args...)](Stream& s) {
+        return details::liftRec(fn, s, parsers);
+    });
+}
+
+
+/*
+ * Applicative
+ * liftM :: (A1 -> ... -> An -> B) -> Parser<A> -> ... -> Parser<An> -> Parser<B>
+ */
+template <typename Fn, ParserType ...Args>
+    requires(!IsVoidCtx<GetContextTrait<Fn>> || (!IsVoidCtx<GetParserCtx<Args>> || ...))
+auto liftM(Fn fn, Args &&...args) noexcept {
+    using Ctx = UnionCtx<GetContextTrait<Fn>, GetParserCtx<Args>...>;
+    return make_parser<Ctx>([fn, parsers = std::make_tuple(args...)](Stream& s, auto& ctx) {
+        return details::liftRecCtx(fn, s, ctx, parsers);
+    });
+}
+
+template <ParserType ...Args>
+auto concat(Args &&...args) noexcept {
+    return liftM(details::MakeTuple{}, std::forward<Args>(args)...);
+}
+
+namespace details {
+
+/**
+ * One byte that satisfies the test, adjacent ones are fused by `>>` and `<<`
+ */
+template <typename Fn>
+struct SatisfyFn {
+    Fn test;
+
+    ResultType<char> operator()(Stream& stream) const {
+        if (stream.eos()) {
+            return Parser<char>::PRS_MAKE_ERROR("satisfy eos", stream.pos());
+        }
+        char c = stream.front();
+        if (test(c)) {
+            stream.moveUnsafe();
+            return Parser<char>::data(c);
+        } else {
+            return Parser<char>::PRS_MAKE_ERROR("satisfy eq", stream.pos());
+        }
+    }
+
+    static constexpr size_t width() noexcept {
+        return 1;
+    }
+
+    constexpr bool matchAt(char const* p) const {
+        return test(*p);
+    }
+
+    static constexpr char valueAt(char const* p) noexcept {
+        return *p;
+    }
+};
+
+}
+
+/*
+ * satisfy :: (char -> bool) -> Parser<char>
+ */
+template <typename Fn>
+constexpr auto satisfy(Fn&& tTest) noexcept {
+    return Parser<char>::make(details::SatisfyFn<std::decay_t<Fn>>{std::forward<Fn>(tTest)});
+}
+
+}
+// #include <parsecpp/core/modifier.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+
+namespace prs {
+
+template <typename T>
+class ModifyCallerI {
+public:
+    using Type = T;
+    virtual details::ResultType<T> operator()() = 0;
+};
+
+template <ParserType Parser>
+class ModifyCaller : public ModifyCallerI<GetParserResult<Parser>> {
+public:
+    using Type = typename ModifyCallerI<GetParserResult<Parser>>::Type;
+
+    ModifyCaller(Parser const& p, Stream& s) noexcept
+        : m_parser(p)
+        , m_stream(s) {}
+
+    typename Parser::Result operator()() final {
+        return m_parser(m_stream);
+    }
+private:
+    Parser const& m_parser;
+    Stream& m_stream;
+};
+
+
+template <ParserType Parser, ContextType StoredCtx>
+class ModifyCallerCtx : public ModifyCallerI<GetParserResult<Parser>> {
+public:
+    ModifyCallerCtx(Parser const& p, Stream& s, StoredCtx& ctx) noexcept
+        : m_parser(p)
+        , m_stream(s)
+        , m_ctx(ctx) {
+
+    }
+
+    typename Parser::Result operator()() final {
+        return m_parser(m_stream, m_ctx);
+    }
+private:
+    Parser const& m_parser;
+    Stream& m_stream;
+    StoredCtx& m_ctx;
+};
+
+template <typename ModifierClass, typename Ctx>
+class ModifyWithContext {
+public:
+    explicit ModifyWithContext(ModifierClass fn) noexcept(std::is_nothrow_move_constructible_v<ModifierClass>)
+        : m_modifier(std::move(fn)) {
+
+    }
+
+    template <typename ...Args>
+    explicit ModifyWithContext(Args&& ...args) noexcept(std::is_nothrow_constructible_v<ModifierClass, Args...>)
+        : m_modifier(std::forward<Args>(args)...) {
+
+    }
+
+    auto operator()(auto& caller, Stream& stream, auto& ctx) const noexcept {
+        return m_modifier(caller, stream, ctx);
+    }
+private:
+    ModifierClass m_modifier;
+};
+
+
+template <ParserType ParserA, typename Modify>
+    requires(ParserA::nocontext && std::is_invocable_v<Modify, ModifyCallerI<GetParserResult<ParserA>>&, Stream&>)
+auto operator*(ParserA parserA, Modify modifier) noexcept {
+    return make_parser([parser = std::move(parserA), mod = std::move(modifier)](Stream& stream) {
+        ModifyCaller p{parser, stream};
+        return mod(p, stream);
+    });
+}
+
+
+template <ParserType ParserA, typename Modify>
+    requires(!ParserA::nocontext)
+auto operator*(ParserA parserA, Modify modifier) noexcept {
+    using Ctx = UnionCtx<GetParserCtx<ParserA>, GetContextTrait<Modify>>;
+    return make_parser<Ctx>(
+            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
+        ModifyCallerCtx p{parser, stream, ctx};
+        if constexpr (std::is_invocable_v<Modify, ModifyCallerI<GetParserResult<ParserA>>&, Stream&>) {
+            return mod(p, stream);
+        } else {
+            return mod(p, stream, ctx);
+        }
+    });
+}
+
+
+template <ParserType ParserA, typename Modify, typename Ctx>
+auto operator*(ParserA parserA, ModifyWithContext<Modify, Ctx> modifier) noexcept {
+    using UCtx = UnionCtx<GetParserCtx<ParserA>, Ctx>;
+    return make_parser<UCtx>(
+            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
+        if constexpr (ParserA::nocontext) {
+            ModifyCaller p{parser, stream};
+            return mod(p, stream, ctx);
+        } else {
+            ModifyCaller p{parser, stream, ctx};
+            return mod(p, stream, ctx);
+        }
+    });
+}
+
+template <ParserType ParserA, typename Modify>
+    requires (!IsVoidCtx<typename ContextTrait<Modify>::Ctx> && ParserA::nocontext)
+auto operator*(ParserA parserA, Modify modifier) noexcept {
+    using Ctx = typename ContextTrait<Modify>::Ctx;
+    using UCtx = UnionCtx<GetParserCtx<ParserA>, Ctx>;
+    return make_parser<UCtx>(
+            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
+        if constexpr (ParserA::nocontext) {
+            ModifyCaller p{parser, stream};
+            return mod(p, stream, ctx);
+        } else {
+            ModifyCaller p{parser, stream, ctx};
+            return mod(p, stream, ctx);
+        }
+    });
+}
+
+
+/*
+ * Priority for operator*
+ * a `op` b * mod === a `op` (b * mod)
+ * a `op` b *= mod === (a `op` b) * mod
+ * forall `op` != >>=
+ */
+template <ParserType ParserA, typename Modify>
+auto operator*=(ParserA parserA, Modify modify) noexcept {
+    return parserA * modify;
+}
+
+}
+
+// #include <parsecpp/common/base.h>
+
+// #include <parsecpp/common/choice.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+namespace prs {
+
+namespace details {
+
+template <size_t n>
+using ChoiceMask = std::conditional_t<n <= 8, uint8_t,
+                   std::conditional_t<n <= 16, uint16_t,
+                   std::conditional_t<n <= 32, uint32_t, uint64_t>>>;
+
+/**
+ * Apply viable alternatives (set bits of mask) in order, the same as `|` of them
+ */
+template <size_t I = 0, typename Mask, typename TupleParser, typename Ctx>
+auto applyChoice(Mask mask, TupleParser const& parsers, Stream& stream, Ctx& ctx) {
+    using Result = typename std::tuple_element_t<0, TupleParser>::Result;
+    if constexpr (I == std::tuple_size_v<TupleParser>) {
+        return Result{ParsingError{stream.pos()}};
+    } else {
+        if ((mask & (Mask{1} << I)) == 0) {
+            return applyChoice<I + 1>(mask, parsers, stream, ctx);
+        }
+
+        mask &= static_cast<Mask>(mask - 1);
+        if (mask == 0) {
+            return std::get<I>(parsers).apply(stream, ctx);
+        }
+
+        auto backup = stream.pos();
+        return std::get<I>(parsers).apply(stream, ctx).flatMapError([&](ParsingError const& firstError) {
+            stream.restorePos(backup);
+            return applyChoice<I + 1>(mask, parsers, stream, ctx).flatMapError([&](ParsingError const& secondError) {
+                return Result{ParsingError::orError(firstError, secondError)};
             });
         });
     }
+}
+
+}
+
+
+/**
+ * N-ary `|` with LL(1) dispatch: alternatives whose first set doesn't contain the next byte are not applied.
+ * The viable alternatives are found by a 256-entry table, the rest of them are applied with backtracking as in `|`.
+ * Alternatives without the first set (e.g. `lazy`, `satisfy`) are always viable, use withFirstSet to declare it.
+ * @def choice :: Parser<A, Ctx1> -> ... -> Parser<A, CtxN> -> Parser<A, Ctx1 & ... & CtxN>
+ */
+template <ParserType First, ParserType ...Rest>
+    requires((std::is_same_v<GetParserResult<First>, GetParserResult<Rest>> && ...) && sizeof...(Rest) < 64)
+constexpr auto choice(First first, Rest ...rest) noexcept {
+    using T = GetParserResult<First>;
+    using UCtx = UnionCtx<GetParserCtx<First>, GetParserCtx<Rest>...>;
+    using Mask = details::ChoiceMask<sizeof...(Rest) + 1>;
+    constexpr size_t EOS = CharSet::CHAR_MAPPING_SIZE;
+
+    std::array<FirstSet, sizeof...(Rest) + 1> const sets{first.firstSet(), rest.firstSet()...};
+    std::array<Mask, EOS + 1> table{};
+    FirstSet all{};
+    for (size_t i = 0; i != sets.size(); ++i) {
+        auto const bit = static_cast<Mask>(Mask{1} << i);
+        for (size_t c = 0; c != EOS; ++c) {
+            if (sets[i].viable(static_cast<char>(c))) {
+                table[c] |= bit;
+            }
+        }
+        if (sets[i].nullable()) {
+            table[EOS] |= bit;
+        }
+        all = all | sets[i];
+    }
+
+    auto parser = Parser<T, UCtx>::make([parsers = std::make_tuple(std::move(first), std::move(rest)...), table](Stream& stream, auto& ctx) {
+        Mask const mask = stream.eos() ? table[EOS] : table[static_cast<unsigned char>(stream.front())];
+        if (mask == 0) {
+            return Parser<T>::makeError("No viable alternative", stream.pos());
+        }
+        return details::applyChoice(mask, parsers, stream, ctx);
+    });
+
+    if constexpr (std::decay_t<First>::hasFirstSet && (std::decay_t<Rest>::hasFirstSet && ...)) {
+        return parser.withFirstSet(all);
+    } else {
+        return parser;
+    }
+}
+
+}
+// #include <parsecpp/common/keyword.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/utils/constexprString.hpp>
+
+
+namespace prs {
+
+namespace details {
+
+template<std::size_t N>
+struct MakeArray
+{
+    std::array<char, N> data;
+
+    template <std::size_t... Is>
+    constexpr MakeArray(char const(&arr)[N], std::integer_sequence<std::size_t, Is...>)
+        : data{arr[Is]...} {
+
+    }
+
+    constexpr MakeArray(char const(&arr)[N])
+        : MakeArray(arr, std::make_integer_sequence<std::size_t, N>()) {
+
+    }
+
+    constexpr auto size() const {
+        return N;
+    }
+};
+
+}
+
+template<std::size_t N>
+struct ConstexprString {
+    std::array<char, N + 1> m_str;
+
+    constexpr explicit ConstexprString(char const(&s)[N + 1]) noexcept {
+        for (std::size_t i = 0; i <= N; ++i) {
+            m_str[i] = s[i];
+        }
+    }
+
+    constexpr explicit ConstexprString(std::array<char, N + 1> arr) noexcept
+        : m_str(arr) {
+    }
+
+    constexpr explicit ConstexprString(details::MakeArray<N + 1> arr) noexcept{
+        for (size_t i = 0; i != N + 1; ++i) {
+            m_str[i] = arr.data[i];
+        }
+    }
+
+    static constexpr ConstexprString<1> fromChar(char c) noexcept {
+        return ConstexprString<1>({c});
+    }
+
+    constexpr const char* c_str() const noexcept {
+        return m_str.data();
+    }
+
+    constexpr size_t size() const noexcept {
+        return N;
+    }
 
-    /**
-     * @def `|` :: Parser<A, CtxA> -> Parser<A, CtxB> -> Parser<A, CtxA & CtxB>
-     */
-    template <typename CtxB, typename Rhs>
-        requires (!IsVoidCtx<UnionCtx<Ctx, CtxB>>)
-    constexpr auto operator|(Parser<T, CtxB, Rhs> rhs) const noexcept {
-        return Parser<T, UnionCtx<Ctx, CtxB>>::make([lhs = *this, rhs](Stream& stream, auto& ctx) {
-            auto backup = stream.pos();
-            return lhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& firstError) {
-                stream.restorePos(backup);
-                return rhs.apply(stream, ctx).flatMapError([&](details::ParsingError const& secondError) {
-                    return PRS_MAKE_ERROR(
-                            "Or error: " + firstError.description + ", " + secondError.description
-                                 , std::max(firstError.pos, secondError.pos));
-                });
-            });
-        });
+    constexpr std::string_view sv() const noexcept {
+        return std::string_view(c_str(), size());
     }
 
+    std::string toString() const noexcept {
+        return std::string(c_str(), size());
+    }
 
-    template <typename A>
-    using MaybeValue = std::conditional_t<std::is_same_v<A, Drop>, Drop, std::optional<A>>;
+    template<std::size_t M>
+    constexpr auto operator+(ConstexprString<M> const& other) const noexcept {
+        std::array<char, N + M + 1> new_str{};
+        for (std::size_t i = 0; i != N; ++i) {
+            new_str[i] = m_str[i];
+        }
+        for (std::size_t i = 0; i != M; ++i) {
+            new_str[N + i] = other.m_str[i];
+        }
+        return ConstexprString<N + M>(new_str);
+    }
 
-    /**
-     * @def maybe :: Parser<A> -> Parser<std::optional<B>>
-     * maybe :: Parser<Drop> -> Parser<Drop>
-     */
-    constexpr auto maybe() const noexcept {
-        if constexpr (nocontext) {
-            return Parser<MaybeValue<T>>::make([parser = *this](Stream& stream) {
-                auto backup = stream.pos();
-                return parser.apply(stream).map([](T t) {
-                    if constexpr (std::is_same_v<T, Drop>) {
-                        return Drop{};
-                    } else {
-                        return MaybeValue<T>{std::move(t)};
-                    }
-                }, [&stream, &backup](details::ParsingError const& error) {
-                    stream.restorePos(backup);
-                    return MaybeValue<T>{};
-                });
-            });
+    constexpr auto add(char c) const noexcept {
+        return operator+(fromChar(c));
+    }
+
+    constexpr auto between(char c) const noexcept {
+        return fromChar(c) + *this + fromChar(c);
+    }
+
+
+    constexpr auto between(char l, char r) const noexcept {
+        return fromChar(l) + *this + fromChar(r);
+    }
+
+
+    template <size_t M>
+    constexpr bool operator==(ConstexprString<M> const& rhs) const noexcept {
+        if constexpr (M != N) {
+            return false;
         } else {
-            return Parser<MaybeValue<T>, Ctx>::make([parser = *this](Stream& stream, auto& ctx) {
-                auto backup = stream.pos();
-                return parser.apply(stream, ctx).map([](T t) {
-                    if constexpr (std::is_same_v<T, Drop>) {
-                        return Drop{};
-                    } else {
-                        return MaybeValue<T>{std::move(t)};
-                    }
-                }, [&stream, &backup](details::ParsingError const& error) {
-                    stream.restorePos(backup);
-                    return MaybeValue<T>{};
-                });
-            });
+            for (auto i = 0; i != N; ++i) {
+                if (rhs[i] != this->operator[](i)) {
+                    return false;
+                }
+            }
+            return true;
         }
     }
 
+    template <size_t M>
+    constexpr bool operator!=(ConstexprString<M> const& rhs) const noexcept {
+        return !operator==(rhs);
+    }
 
-    /**
-     * @def maybeOr :: Parser<A> -> Parser<A>
-     */
-    constexpr auto maybeOr(T const& defaultValue) const noexcept {
-        if constexpr (nocontext) {
-            return Parser<T>::make([parser = *this, defaultValue](Stream& stream) {
-                auto backup = stream.pos();
-                return parser.apply(stream).flatMapError([&stream, &backup, &defaultValue](details::ParsingError const& error) {
-                    stream.restorePos(backup);
-                    return data(defaultValue);
-                });
-            });
-        } else {
-            return Parser<T, Ctx>::make([parser = *this, defaultValue](Stream& stream, auto& ctx) {
-                auto backup = stream.pos();
-                return parser.apply(stream, ctx).flatMapError([&stream, &backup, &defaultValue](details::ParsingError const& error) {
-                    stream.restorePos(backup);
-                    return data(defaultValue);
-                });
-            });
+    constexpr auto operator[](size_t i) const noexcept {
+        return m_str[i];
+    }
+
+
+    template <size_t M>
+    constexpr ConstexprString<std::min(M, N)> substr() const noexcept {
+        constexpr auto T = std::min(M, N);
+        std::array<char, T + 1> out{};
+        for (auto i = 0; i != T; ++i) {
+            out[i] = operator[](i);
         }
+        return ConstexprString<T>(out);
     }
 
+    template <size_t M>
+    requires(M <= N)
+    constexpr bool startsFrom(ConstexprString<M> const& prefix) const noexcept {
+        return substr<M>() == prefix;
+    }
+};
 
-    /**
-     * @def repeat :: Parser<A> -> Parser<std::vector<A>>
-     */
-    template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION>
-            requires(!std::is_same_v<T, Drop>)
-    constexpr auto repeat() const noexcept {
-        using Value = T;
-        using P = Parser<std::vector<Value>, Ctx>;
-        return P::make([value = *this](Stream& stream, auto& ctx) noexcept(nothrow) {
-            std::vector<Value> out{};
-            out.reserve(reserve);
+template <details::MakeArray arr>
+constexpr auto operator""_prs() {
+    return ConstexprString<arr.size() - 1>(arr);
+}
 
-            size_t iteration = 0;
 
-            auto backup = stream.pos();
-            do {
-                backup = stream.pos();
-                auto result = value.apply(stream, ctx);
-                if (!result.isError()) {
-                    out.emplace_back(std::move(result).data());
-                } else {
-                    stream.restorePos(backup);
-                    return P::data(std::move(out));
+}
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace prs {
+
+namespace details {
+
+struct KeywordMatch {
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    size_t index = NONE;
+    size_t length = 0;
+};
+
+/**
+ * Compile-time trie of keywords.
+ * Bytes are mapped to the alphabet of keywords, so transitions are a dense [node][class] table
+ * and the lookup is one table access per byte regardless of the number of keywords.
+ */
+template <ConstexprString ...words>
+class KeywordTrie {
+public:
+    static constexpr std::array<std::string_view, sizeof...(words)> WORDS{words.sv()...};
+
+    static constexpr size_t countNodes() noexcept {
+        auto sorted = WORDS;
+        std::sort(sorted.begin(), sorted.end());
+        size_t nodes = 1;
+        for (size_t i = 0; i != sorted.size(); ++i) {
+            size_t common = 0;
+            if (i != 0) {
+                while (common != sorted[i].size() && common != sorted[i - 1].size() && sorted[i][common] == sorted[i - 1][common]) {
+                    ++common;
                 }
-            } while (++iteration != maxIteration);
+            }
+            nodes += sorted[i].size() - common;
+        }
+        return nodes;
+    }
 
-            return P::makeError("Max iteration", stream.pos());
-        });
+    static constexpr size_t countClasses() noexcept {
+        std::array<bool, CharSet::CHAR_MAPPING_SIZE> used{};
+        size_t classes = 1;
+        for (auto word : WORDS) {
+            for (char c : word) {
+                auto& u = used[static_cast<unsigned char>(c)];
+                classes += u ? 0 : 1;
+                u = true;
+            }
+        }
+        return classes;
+    }
+
+    static constexpr size_t NODES = countNodes();
+    static constexpr size_t CLASSES = countClasses();
+    static_assert(NODES < std::numeric_limits<uint16_t>::max(), "Too many keywords");
+
+    constexpr KeywordTrie() noexcept {
+        uint8_t classes = 1;
+        for (auto word : WORDS) {
+            for (char c : word) {
+                auto& cls = m_classOf[static_cast<unsigned char>(c)];
+                if (cls == 0) {
+                    cls = classes++;
+                }
+            }
+        }
+
+        uint16_t nodes = 1;
+        for (size_t i = 0; i != WORDS.size(); ++i) {
+            size_t node = 0;
+            for (char c : WORDS[i]) {
+                auto& next = m_next[node * CLASSES + m_classOf[static_cast<unsigned char>(c)]];
+                if (next == 0) {
+                    next = nodes++;
+                }
+                node = next;
+            }
+            if (m_terminal[node] == 0) {
+                m_terminal[node] = static_cast<uint16_t>(i + 1);
+            }
+        }
     }
 
     /**
-     * @def repeat :: Parser<Drop> -> Parser<Drop>
+     * @return the longest keyword that is a prefix of str
      */
-    template <size_t maxIteration = MAX_ITERATION>
-            requires(std::is_same_v<T, Drop>)
-    constexpr auto repeat() const noexcept {
-        using P = Parser<Drop, Ctx>;
-        return P::make([value = *this](Stream& stream, auto& ctx) noexcept(nothrow) {
-            size_t iteration = 0;
+    constexpr KeywordMatch match(std::string_view str) const noexcept {
+        KeywordMatch out{};
+        size_t node = 0;
+        size_t i = 0;
+        while (true) {
+            if (m_terminal[node] != 0) {
+                out = KeywordMatch{m_terminal[node] - size_t{1}, i};
+            }
+            if (i == str.size()) {
+                return out;
+            }
 
-            auto backup = stream.pos();
-            do {
-                backup = stream.pos();
-                auto result = value.apply(stream, ctx);
-                if (result.isError()) {
-                    stream.restorePos(backup);
-                    return P::data({});
-                }
-            } while (++iteration != maxIteration);
+            auto const cls = m_classOf[static_cast<unsigned char>(str[i])];
+            if (cls == 0 || (node = m_next[node * CLASSES + cls]) == 0) {
+                return out;
+            }
+            ++i;
+        }
+    }
 
-            return P::makeError("Max iteration", stream.pos());
+    constexpr FirstSet firstSet() const noexcept {
+        auto first = FirstSet::fromPredicate([](char c) {
+            return std::any_of(WORDS.begin(), WORDS.end(), [c](std::string_view word) {
+                return !word.empty() && word.front() == c;
+            });
         });
+        return m_terminal[0] != 0 ? first.maybe() : first;
     }
+private:
+    std::array<uint8_t, CharSet::CHAR_MAPPING_SIZE> m_classOf{};
+    std::array<uint16_t, NODES * CLASSES> m_next{};
+    std::array<uint16_t, NODES> m_terminal{};
+};
 
+template <ConstexprString ...words>
+inline constexpr KeywordTrie<words...> keywordTrie{};
 
-    /**
-     * @def repeat :: Parser<A> -> Parser<Delim> -> Parser<std::vector<A>>
-     */
-    template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
-            requires(!std::is_same_v<T, Drop>)
-    constexpr auto repeat(Delimiter tDelimiter) const noexcept {
-        using Value = T;
-        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
-        using P = Parser<std::vector<Value>, UCtx>;
-        constexpr bool noexceptP = nothrow && Delimiter::nothrow;
-        return P::make([value = *this, delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) noexcept(noexceptP) {
-            std::vector<Value> out{};
-            out.reserve(reserve);
+}
 
-            size_t iteration = 0;
 
-            auto backup = stream.pos();
-            do {
-                auto result = value.apply(stream, ctx);
-                if (!result.isError()) {
-                    out.emplace_back(std::move(result).data());
-                } else {
-                    return P::data(std::move(out));
-                }
+/**
+ * One of the fixed words with the longest match semantics, O(length of the match) for any number of words.
+ * If the same word is listed twice, the first index is returned.
+ * @return Parser<size_t> - index of the matched word
+ */
+template <ConstexprString ...words>
+    requires(sizeof...(words) > 0)
+auto keyword() noexcept {
+    return Parser<size_t>::make([](Stream& stream) {
+        auto const match = details::keywordTrie<words...>.match(stream.sv());
+        if (match.index == details::KeywordMatch::NONE) {
+            return Parser<size_t>::makeError("Unknown keyword", stream.pos());
+        }
+        stream.moveUnsafe(match.length);
+        return Parser<size_t>::data(match.index);
+    }).withFirstSet(details::keywordTrie<words...>.firstSet());
+}
 
-                backup = stream.pos();
-            } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
 
-            if (iteration == maxIteration) {
-                return P::makeError("Max iteration", stream.pos());
-            } else {
-                stream.restorePos(backup);
-                return P::data(std::move(out));
-            }
-        });
+/**
+ * @param values - mapped value for each word
+ * @return Parser<std::common_type_t<Values...>>
+ */
+template <ConstexprString ...words, typename ...Values>
+    requires(sizeof...(words) > 0 && sizeof...(words) == sizeof...(Values))
+auto keyword(Values ...values) noexcept {
+    using T = std::common_type_t<Values...>;
+    return keyword<words...>() >>= [values = std::array<T, sizeof...(Values)>{static_cast<T>(values)...}](size_t index) {
+        return values[index];
+    };
+}
+
+}
+// #include <parsecpp/common/map.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+// #include <parsecpp/core/lift.h>
+
+// #include <parsecpp/utils/flatMap.h>
+
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace prs {
+
+/**
+ * Map stored as a vector of pairs sorted by key.
+ * Pairs are appended unsorted while parsing and sorted once by `sort()`, the last value wins for equal keys.
+ */
+template <typename Key, typename Value, typename Compare = std::less<>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using Storage = std::vector<value_type>;
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+
+    FlatMap() noexcept = default;
+
+    FlatMap(std::initializer_list<value_type> init)
+        : m_data(init) {
+        sort();
     }
 
+    void append(Key&& key, Value&& value) {
+        m_data.emplace_back(std::move(key), std::move(value));
+    }
 
     /**
-     * @def repeat :: Parser<Drop> -> Parser<Delim> -> Parser<Drop>
+     * Stable sort, keeps only the last pair for equal keys
      */
-    template <size_t maxIteration = MAX_ITERATION, ParserType Delimiter>
-            requires(std::is_same_v<T, Drop>)
-    constexpr auto repeat(Delimiter tDelimiter) const noexcept {
-        using UCtx = UnionCtx<Ctx, GetParserCtx<Delimiter>>;
-        using P = Parser<Drop, UCtx>;
-        return P::make([value = *this, delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) {
-            size_t iteration = 0;
-
-            auto backup = stream.pos();
-            do {
-                auto result = value.apply(stream, ctx);
-                if (result.isError()) {
-                    return P::data(Drop{});
+    void sort() {
+        constexpr size_t INSERTION_SORT_SIZE = 16;
+        auto const less = [](value_type const& lhs, value_type const& rhs) {
+            return Compare{}(lhs.first, rhs.first);
+        };
+        if (m_data.size() <= INSERTION_SORT_SIZE) {
+            for (size_t i = 1; i < m_data.size(); ++i) {
+                for (size_t j = i; j != 0 && less(m_data[j], m_data[j - 1]); --j) {
+                    std::swap(m_data[j], m_data[j - 1]);
                 }
+            }
+        } else {
+            std::stable_sort(m_data.begin(), m_data.end(), less);
+        }
 
-                backup = stream.pos();
-            } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
-
-            if (iteration == maxIteration) {
-                return P::makeError("Max iteration", stream.pos());
+        size_t out = 0;
+        for (size_t i = 0; i != m_data.size(); ++i) {
+            if (out != 0 && !less(m_data[out - 1], m_data[i])) {
+                m_data[out - 1] = std::move(m_data[i]);
             } else {
-                stream.restorePos(backup);
-                return P::data(Drop{});
+                if (out != i) {
+                    m_data[out] = std::move(m_data[i]);
+                }
+                ++out;
             }
+        }
+        m_data.erase(m_data.begin() + static_cast<std::ptrdiff_t>(out), m_data.end());
+    }
+
+    template <typename K>
+    const_iterator find(K const& key) const {
+        auto it = std::lower_bound(m_data.begin(), m_data.end(), key, [](value_type const& lhs, K const& rhs) {
+            return Compare{}(lhs.first, rhs);
         });
+        return it != m_data.end() && !Compare{}(key, it->first) ? it : m_data.end();
     }
 
+    template <typename K>
+    bool contains(K const& key) const {
+        return find(key) != end();
+    }
 
-    /**
-     * @def cond :: Parser<A> -> (A -> bool) -> Parser<A>
-     */
-    template <std::predicate<T const&> Fn>
-            requires (!std::predicate<T const&, Stream&> && nocontext)
-    constexpr auto cond(Fn test) const noexcept {
-        return Parser<T>::make([parser = *this, test](Stream& stream) {
-           return parser.apply(stream).flatMap([&test, &stream](T t) {
-               if (test(t)) {
-                   return Parser<T>::data(std::move(t));
-               } else {
-                   return Parser<T>::makeError("Cond failed", stream.pos());
-               }
-           });
-        });
+    template <typename K>
+    Value const& at(K const& key) const noexcept(false) {
+        if (auto it = find(key); it != end()) {
+            return it->second;
+        }
+        throw std::out_of_range("FlatMap::at");
     }
 
-    /**
-     * @def cond :: Parser<A> -> (A -> bool) -> Parser<A>
-     */
-    template <std::predicate<T const&> Fn>
-            requires (!std::predicate<T const&, Stream&> && !nocontext)
-    constexpr auto cond(Fn test) const noexcept {
-        return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&test, &stream](T t) {
-               if (test(t)) {
-                   return Parser<T>::data(std::move(t));
-               } else {
-                   return Parser<T>::makeError("Cond failed", stream.pos());
-               }
-           });
-        });
+    const_iterator begin() const noexcept {
+        return m_data.begin();
     }
 
-    /**
-     * @def cond :: Parser<A> -> (A -> Stream& -> bool) -> Parser<A>
-     */
-    template <std::predicate<T const&, Stream&> Fn>
-        requires(nocontext)
-    constexpr auto cond(Fn test) const noexcept {
-        return Parser<T>::make([parser = *this, test](Stream& stream) {
-           return parser.apply(stream).flatMap([&test, &stream](T t) {
-               if (test(t, stream)) {
-                   return Parser<T>::data(std::move(t));
-               } else {
-                   return Parser<T>::makeError("Cond failed", stream.pos());
-               }
-           });
-        });
+    const_iterator end() const noexcept {
+        return m_data.end();
     }
 
-    /**
-     * @def cond :: Parser<A> -> (A -> Stream& -> bool) -> Parser<A>
-     */
-    template <std::predicate<T const&, Stream&> Fn>
-        requires(!nocontext)
-    constexpr auto cond(Fn test) const noexcept {
-        return Parser<T, Ctx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&test, &stream](T t) {
-               if (test(t, stream)) {
-                   return Parser<T>::data(std::move(t));
-               } else {
-                   return Parser<T>::makeError("Cond failed", stream.pos());
-               }
-           });
-        });
+    size_t size() const noexcept {
+        return m_data.size();
     }
 
+    bool empty() const noexcept {
+        return m_data.empty();
+    }
 
     /**
-     * @def cond :: Parser<A, Ctx> -> (A -> CondCtx& -> bool) -> Parser<A, Ctx & CondCtx>
+     * Keeps the capacity
      */
-    template <ContextType CondContext, std::predicate<T const&, CondContext&> Fn>
-    constexpr auto condC(Fn test) const noexcept {
-        using UCtx = UnionCtx<Ctx, CondContext>;
-        return Parser<T, UCtx>::make([parser = *this, test](Stream& stream, auto& ctx) {
-           return parser.apply(stream, ctx).flatMap([&](T t) {
-               if (test(t, ctx)) {
-                   return Parser<T>::data(std::move(t));
-               } else {
-                   return Parser<T>::makeError("Cond failed", stream.pos());
-               }
-           });
-        });
+    void clear() noexcept {
+        m_data.clear();
     }
 
-    /**
-     * @def Drop :: Parser<A> -> Parser<Drop>
-     */
-    constexpr auto drop() const noexcept {
-        if constexpr (nocontext) {
-            return Parser<Drop>::make([p = *this](Stream& s) {
-                return p.apply(s).map([](auto &&) {
-                    return Drop{};
-                });
-            });
-        } else {
-            return Parser<Drop, Ctx>::make([p = *this](Stream& s, auto& ctx) {
-                return p.apply(s, ctx).map([](auto &&) {
-                    return Drop{};
-                });
-            });
+    bool operator==(FlatMap const& rhs) const = default;
+private:
+    Storage m_data;
+};
+
+
+/**
+ * Open addressing (linear probing) hash map, pairs are stored densely in the insertion order.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<>>
+class HashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using Storage = std::vector<value_type>;
+    using const_iterator = typename Storage::const_iterator;
+
+    HashMap() noexcept = default;
+
+    HashMap(std::initializer_list<value_type> init) {
+        for (auto const& [key, value] : init) {
+            insert_or_assign(Key{key}, Value{value});
         }
     }
 
-    /**
-     * @def endOfStream :: Parser<A> -> Parser<A>
-     */
-    constexpr auto endOfStream() const noexcept {
-        return cond([](T const& t, Stream& s) {
-            return s.eos();
-        });
+    void insert_or_assign(Key&& key, Value&& value) {
+        if ((m_data.size() + 1) * 2 > m_slots.size()) {
+            rehash(std::max<size_t>(MIN_SLOTS, m_slots.size() * 2));
+        }
+
+        size_t const mask = m_slots.size() - 1;
+        for (size_t i = Hash{}(key) & mask;; i = (i + 1) & mask) {
+            if (m_slots[i] == EMPTY) {
+                m_data.emplace_back(std::move(key), std::move(value));
+                m_slots[i] = static_cast<uint32_t>(m_data.size());
+                return;
+            } else if (auto& item = m_data[m_slots[i] - 1]; Equal{}(item.first, key)) {
+                item.second = std::move(value);
+                return;
+            }
+        }
     }
 
-    /**
-     * @def mustConsume :: Parser<A> -> Parser<A>
-     */
-    constexpr auto mustConsume() const noexcept {
-        return make([p = *this](Stream& s, auto& ctx) {
-            auto pos = s.pos();
-            return p.apply(s, ctx).flatMap([pos, &s](auto &&t) {
-               if (s.pos() > pos) {
-                   return data(t);
-               } else {
-                   return makeError("Didn't consume stream", s.pos());
-               }
-            });
-        });
+    const_iterator find(Key const& key) const {
+        if (m_slots.empty()) {
+            return end();
+        }
+
+        size_t const mask = m_slots.size() - 1;
+        for (size_t i = Hash{}(key) & mask; m_slots[i] != EMPTY; i = (i + 1) & mask) {
+            if (Equal{}(m_data[m_slots[i] - 1].first, key)) {
+                return m_data.begin() + (m_slots[i] - 1);
+            }
+        }
+        return end();
     }
 
+    bool contains(Key const& key) const {
+        return find(key) != end();
+    }
 
-    template <typename Fn>
-        requires(nocontext)
-    constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
-        return make_parser([parser = *this, fn](Stream& stream) {
-            return parser.apply(stream).flatMap([fn, &stream](T const& t) {
-                return fn(t).apply(stream);
-            });
-        });
+    Value const& at(Key const& key) const noexcept(false) {
+        if (auto it = find(key); it != end()) {
+            return it->second;
+        }
+        throw std::out_of_range("HashMap::at");
     }
 
+    const_iterator begin() const noexcept {
+        return m_data.begin();
+    }
 
-    template <typename Fn>
-        requires(!nocontext)
-    constexpr auto flatMap(Fn fn) const noexcept(std::is_nothrow_invocable_v<Fn, T const&>) {
-        return make_parser<Ctx>([parser = *this, fn](Stream& stream, auto& ctx) {
-            return parser.apply(stream, ctx).flatMap([fn, &stream](T const& t) {
-                return fn(t).apply(stream);
-            });
-        });
+    const_iterator end() const noexcept {
+        return m_data.end();
+    }
+
+    size_t size() const noexcept {
+        return m_data.size();
+    }
+
+    bool empty() const noexcept {
+        return m_data.empty();
     }
 
     /**
-     * @def toCommonType :: Parser<A, Ctx, Fn> -> Parser'<A, Ctx>
+     * Keeps the capacity and the slots
      */
-    constexpr auto toCommonType() const noexcept {
-        if constexpr (nocontext) {
-            details::StdFunction<T> f = [fn = *this](Stream& stream) {
-                return std::invoke(fn, stream);
-            };
-
-            return Parser<T>(f);
-        } else {
-            details::StdFunction<T, Ctx> f = [fn = *this](Stream& stream, auto& ctx) {
-                return std::invoke(fn, stream, ctx);
-            };
+    void clear() noexcept {
+        m_data.clear();
+        std::fill(m_slots.begin(), m_slots.end(), EMPTY);
+    }
 
-            return Parser<T, Ctx>(f);
+    bool operator==(HashMap const& rhs) const {
+        return size() == rhs.size() && std::all_of(begin(), end(), [&rhs](value_type const& item) {
+            auto it = rhs.find(item.first);
+            return it != rhs.end() && it->second == item.second;
+        });
+    }
+private:
+    static constexpr uint32_t EMPTY = 0; // slots store index + 1
+    static constexpr size_t MIN_SLOTS = 16;
+
+    void rehash(size_t slots) {
+        m_slots.assign(slots, EMPTY);
+        size_t const mask = slots - 1;
+        for (size_t index = 0; index != m_data.size(); ++index) {
+            size_t i = Hash{}(m_data[index].first) & mask;
+            while (m_slots[i] != EMPTY) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = static_cast<uint32_t>(index + 1);
         }
     }
 
-    static Result makeError(details::ParsingError error) noexcept {
-        return Result{error};
+    Storage m_data;
+    std::vector<uint32_t> m_slots;
+};
+
+}
+
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace prs {
+
+/**
+ * Result containers of toMap.
+ * Container::Type<Key, Value> is the result type, insert is called for each pair and finish once before return.
+ */
+struct StdMapContainer {
+    template <typename Key, typename Value>
+    using Type = std::map<Key, Value>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.insert_or_assign(std::forward<Key>(key), std::forward<Value>(value));
     }
 
-    static constexpr Result makeError(size_t pos) noexcept {
-        return Result{details::ParsingError{pos}};
+    template <typename Map>
+    static void finish(Map&) noexcept {}
+};
+
+/**
+ * Sorted vector, sorted once at the end
+ */
+struct FlatMapContainer {
+    template <typename Key, typename Value>
+    using Type = FlatMap<Key, Value>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.append(std::forward<Key>(key), std::forward<Value>(value));
     }
 
-    static constexpr Result makeError(std::string_view desc, size_t pos) noexcept {
-        return Result{details::ParsingError{desc, pos}};
+    template <typename Map>
+    static void finish(Map& map) {
+        map.sort();
     }
+};
 
-    template <typename U = T>
-        requires(std::convertible_to<U, T>)
-    static constexpr Result data(U&& t) noexcept(std::is_nothrow_convertible_v<U, T>) {
-        return Result{std::forward<U>(t)};
+/**
+ * Open addressing hash map, keeps the insertion order
+ */
+struct HashMapContainer : public StdMapContainer {
+    template <typename Key, typename Value>
+    using Type = HashMap<Key, Value>;
+};
+
+/**
+ * Plain vector of pairs in the input order, duplicates are kept
+ */
+struct PairVectorContainer {
+    template <typename Key, typename Value>
+    using Type = std::vector<std::pair<Key, Value>>;
+
+    template <typename Map, typename Key, typename Value>
+    static void insert(Map& map, Key&& key, Value&& value) {
+        map.emplace_back(std::forward<Key>(key), std::forward<Value>(value));
     }
-private:
-    StoredFn m_fn;
+
+    template <typename Map>
+    static void finish(Map&) noexcept {}
 };
 
-}
 
+namespace details {
+
+/**
+ * Common loop of toMap, makeMap :: Ctx& -> Map creates an empty container, into clears the caller's one
+ */
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map,
+        ParserType ParserKey, ParserType ParserValue, typename MakeMap>
+struct ToMapFn {
+    template <typename Ctx>
+    ResultType<Map> operator()(Stream& stream, Ctx& ctx) const {
+        Map out = makeMap(ctx);
+        return fill(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Map& out) const {
+        out.clear();
+        return fill(stream, ctx, out);
+    }
+
+    template <typename Ctx>
+    ResultType<Drop> fill(Stream& stream, Ctx& ctx, Map& out) const {
+        size_t iteration = 0;
+
+        [[maybe_unused]]
+        auto backup = stream.pos();
+        do {
+            auto keyRes = key.apply(stream, ctx);
+            if (!keyRes.isError()) {
+                auto valueRes = value.apply(stream, ctx);
+                if (!valueRes.isError()) {
+                    Container::insert(out, std::move(keyRes).data(), std::move(valueRes).data());
+                } else {
+                    if constexpr (errorInTheMiddle) {
+                        return ResultType<Drop>{ParsingError{"Parse key but cannot parse value", stream.pos()}};
+                    } else {
+                        stream.restorePos(backup);
+                        Container::finish(out);
+                        return ResultType<Drop>{Drop{}};
+                    }
+                }
+            } else {
+                stream.restorePos(backup);
+                Container::finish(out);
+                return ResultType<Drop>{Drop{}};
+            }
+
+            backup = stream.pos();
+        } while (++iteration != maxIteration);
 
-// #include <parsecpp/core/forwardImpl.h>
+        return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+    }
 
+    ParserKey key;
+    ParserValue value;
+    MakeMap makeMap;
+};
 
-// #include <parsecpp/core/parser.h>
 
-// #include <parsecpp/core/forward.h>
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map,
+        ParserType ParserKey, ParserType ParserValue, ParserType ParserDelimiter, typename MakeMap>
+struct ToMapDelimiterFn {
+    template <typename Ctx>
+    ResultType<Map> operator()(Stream& stream, Ctx& ctx) const {
+        Map out = makeMap(ctx);
+        return fill(stream, ctx, out).map([&out](Drop) {
+            return std::move(out);
+        });
+    }
 
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& stream, Ctx& ctx, Map& out) const {
+        out.clear();
+        return fill(stream, ctx, out);
+    }
 
-namespace prs {
+    template <typename Ctx>
+    ResultType<Drop> fill(Stream& stream, Ctx& ctx, Map& out) const {
+        size_t iteration = 0;
 
+        auto backup = stream.pos();
+        do {
+            auto keyRes = key.apply(stream, ctx);
+            if (!keyRes.isError()) {
+                auto valueRes = value.apply(stream, ctx);
+                if (!valueRes.isError()) {
+                    Container::insert(out, std::move(keyRes).data(), std::move(valueRes).data());
+                } else {
+                    if constexpr (errorInTheMiddle) {
+                        return ResultType<Drop>{ParsingError{"Parse key but cannot parse value", stream.pos()}};
+                    } else {
+                        stream.restorePos(backup);
+                        Container::finish(out);
+                        return ResultType<Drop>{Drop{}};
+                    }
+                }
+            } else {
+                stream.restorePos(backup);
+                Container::finish(out);
+                return ResultType<Drop>{Drop{}};
+            }
 
-template <typename T, typename Ctx>
-template <typename ParserType>
-Pimpl<T, Ctx>::Pimpl(ParserType t) noexcept {
-    static_assert(std::is_same_v<std::decay_t<ParserType>, Parser<T, Ctx>>, "Pimpl can store only Common parser type");
-    static_assert(sizeof(t) == sizeof(m_storage));
-    static_assert(alignof(ParserType) == alignof(std::function<void(void)>));
-    new (&m_storage) ParserType(t);
-}
+            backup = stream.pos();
+        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
 
+        if (iteration == maxIteration) {
+            return ResultType<Drop>{ParsingError{"Max iteration", stream.pos()}};
+        } else {
+            stream.restorePos(backup);
+            Container::finish(out);
+            return ResultType<Drop>{Drop{}};
+        }
+    }
 
-template <typename T>
-template <typename ParserType>
-Pimpl<T, VoidContext>::Pimpl(ParserType t) noexcept {
-    static_assert(std::is_same_v<std::decay_t<ParserType>, Parser<T>>, "Pimpl can store only Common parser type");
-    static_assert(sizeof(t) == sizeof(m_storage));
-    static_assert(alignof(ParserType) == alignof(std::function<void(void)>));
-    new (&m_storage)ParserType(t);
-}
+    ParserKey key;
+    ParserValue value;
+    ParserDelimiter delimiter;
+    MakeMap makeMap;
+};
 
 
-template <typename T, typename Ctx>
-Pimpl<T, Ctx>::~Pimpl() {
-    using P = Parser<T, Ctx>;
-    std::destroy_at(std::launder(reinterpret_cast<P*>(&m_storage)));
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map, typename UCtx,
+        ParserType ParserKey, ParserType ParserValue, typename MakeMap>
+auto toMapImpl(ParserKey key, ParserValue value, MakeMap makeMap) noexcept {
+    using Fn = ToMapFn<errorInTheMiddle, maxIteration, Container, Map, ParserKey, ParserValue, MakeMap>;
+    return Parser<Map, UCtx>::make(Fn{std::move(key), std::move(value), std::move(makeMap)});
 }
 
 
-template <typename T>
-Pimpl<T>::~Pimpl() {
-    using P = Parser<T>;
-    std::destroy_at(std::launder(reinterpret_cast<P*>(&m_storage)));
+template <bool errorInTheMiddle, size_t maxIteration, typename Container, typename Map, typename UCtx,
+        ParserType ParserKey, ParserType ParserValue, ParserType ParserDelimiter, typename MakeMap>
+auto toMapImpl(ParserKey key, ParserValue value, ParserDelimiter delimiter, MakeMap makeMap) noexcept {
+    using Fn = ToMapDelimiterFn<errorInTheMiddle, maxIteration, Container, Map, ParserKey, ParserValue, ParserDelimiter, MakeMap>;
+    return Parser<Map, UCtx>::make(Fn{std::move(key), std::move(value), std::move(delimiter), std::move(makeMap)});
 }
 
+}
 
-template<typename T, typename Ctx>
-Expected<T, details::ParsingError> Pimpl<T, Ctx>::operator()(Stream& s, Ctx& ctx) const {
-    using P = Parser<T, Ctx>;
-    return reinterpret_cast<P const&>(m_storage).apply(s, ctx);
+/**
+ * @tparam errorInTheMiddle - fail parser if key can be parsed and value cannot
+ * @tparam Container - StdMapContainer, FlatMapContainer, HashMapContainer, PairVectorContainer or custom one
+ * Key := ParserKey::Type
+ * Value := ParserValue::Type
+ * @return Parser<Container::Type<Key, Value>>, std::map<Key, Value> by default
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , typename Container = StdMapContainer
+        , ParserType ParserKey
+        , ParserType ParserValue>
+auto toMap(ParserKey key, ParserValue value) noexcept {
+    using Key = GetParserResult<ParserKey>;
+    using Value = GetParserResult<ParserValue>;
+    using Map = typename Container::template Type<Key, Value>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, Container, Map, UCtx>(std::move(key), std::move(value), [](auto&) {
+        return Map{};
+    });
 }
 
 
-template<typename T>
-Expected<T, details::ParsingError> Pimpl<T, VoidContext>::operator()(Stream& s) const {
-    using P = Parser<T>;
-    return reinterpret_cast<P const&>(m_storage).apply(s);
+/**
+ * @tparam errorInTheMiddle - fail parser if key or delim can be parsed and value(key) cannot
+ * @tparam Container - StdMapContainer, FlatMapContainer, HashMapContainer, PairVectorContainer or custom one
+ * Key := ParserKey::Type
+ * Value := ParserValue::Type
+ * @return Parser<Container::Type<Key, Value>>, std::map<Key, Value> by default
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , typename Container = StdMapContainer
+        , ParserType ParserKey
+        , ParserType ParserValue
+        , ParserType ParserDelimiter>
+auto toMap(ParserKey tKey, ParserValue tValue, ParserDelimiter tDelimiter) noexcept {
+    using Key = GetParserResult<ParserKey>;
+    using Value = GetParserResult<ParserValue>;
+    using Map = typename Container::template Type<Key, Value>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, Container, Map, UCtx>(std::move(tKey), std::move(tValue), std::move(tDelimiter), [](auto&) {
+        return Map{};
+    });
 }
 
 }
-// #include <parsecpp/core/lazy.h>
+// #include <parsecpp/common/arena.h>
 
 
 // #include <parsecpp/core/parser.h>
 
-// #include <parsecpp/utils/funcHelper.h>
+// #include <parsecpp/common/map.h>
 
 
-#include <source_location>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
 
 namespace prs {
 
-template <std::invocable Fn>
-auto lazy(Fn genParser) noexcept {
-    using P = std::invoke_result_t<Fn>;
-    if constexpr (P::nocontext) {
-        return P::make([genParser](Stream& stream) {
-            return genParser().apply(stream);
-        });
-    } else {
-        return P::make([genParser](Stream& stream, auto& ctx) {
-            return genParser().apply(stream, ctx);
-        });
-    }
-}
-
-
-template <typename RetType, typename Fn>
-auto selfLazy(Fn parserGen) noexcept {
-    return Parser<RetType>::make([parserGen](Stream& stream) {
-        details::YParser t{[&](auto const& self, Stream& s) -> Parser<RetType>::Result {
-            return parserGen(Parser<RetType>::make([&](Stream& s) -> Parser<RetType>::Result {
-                return self(s);
-            })).apply(s);
-        }};
-
-        using YT = std::decay_t<decltype(t)>;
-        static_assert(std::is_invocable_v<YT, Stream&>);
-        static_assert(IsParserFn<YT, VoidContext>);
-//        static_assert(IsParserFn<details::YParser<Fn, VoidContext>, VoidContext>);
+/**
+ * Parse-scoped monotonic arena for the results of arenaRepeat, arenaToMap and Repeat with ArenaCtx.
+ * All memory is released at once by reset(), results allocated from the arena must be destroyed before it.
+ * reset() grows the first block to the used size, so next documents of the same size don't use the heap at all.
+ */
+class ParseArena {
+public:
+    static constexpr size_t DEFAULT_SIZE = 64 * 1024;
 
-        return t(stream);
-    });
-}
+    explicit ParseArena(size_t initialSize = DEFAULT_SIZE)
+        : m_size(std::max<size_t>(initialSize, 1))
+        , m_buffer(new std::byte[m_size]) {
+        m_resource.emplace(m_buffer.get(), m_size, &m_upstream);
+    }
 
+    ParseArena(ParseArena const&) = delete;
+    ParseArena& operator=(ParseArena const&) = delete;
 
-template <typename tag, typename Fn>
-class LazyCached {
-public:
-    using P = std::invoke_result_t<Fn>;
-    using ParserResult = GetParserResult<P>;
-    static constexpr bool nocontext = IsVoidCtx<GetParserCtx<P>>;
+    std::pmr::memory_resource* resource() noexcept {
+        return &*m_resource;
+    }
 
-    explicit LazyCached(Fn const& generator) noexcept {
-        if (!insideWork) { // cannot use optional.has_value() because generator() invoke ctor before optional::emplace
-            insideWork = true;
-            cachedParser.emplace(generator());
+    /**
+     * Release all results of the previous parsing
+     */
+    void reset() {
+        auto const overflow = m_upstream.allocated;
+        m_resource.reset();
+        if (overflow != 0) {
+            m_size += overflow;
+            m_buffer.reset(new std::byte[m_size]);
         }
+        m_upstream.allocated = 0;
+        m_upstream.count = 0;
+        m_resource.emplace(m_buffer.get(), m_size, &m_upstream);
     }
 
-    auto operator()(Stream& stream) const {
-        return (*cachedParser)(stream);
+    /**
+     * Heap allocations since the last reset
+     */
+    size_t heapAllocations() const noexcept {
+        return m_upstream.count;
     }
 
-    auto operator()(Stream& stream, auto& ctx) const {
-        return (*cachedParser)(stream, ctx);
+    size_t capacity() const noexcept {
+        return m_size;
     }
 private:
-    inline static bool insideWork = false;
-    inline static std::optional<std::invoke_result_t<Fn>> cachedParser;
-};
+    struct CountingResource final : public std::pmr::memory_resource {
+        size_t allocated = 0;
+        size_t count = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) final {
+            allocated += bytes;
+            ++count;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
 
+        void do_deallocate(void* p, size_t bytes, size_t alignment) final {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
 
-template <auto tHash>
-struct AutoTag {
-    static constexpr auto value = tHash;
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept final {
+            return this == &other;
+        }
+    };
+
+    size_t m_size;
+    std::unique_ptr<std::byte[]> m_buffer;
+    CountingResource m_upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
 };
 
-#define AutoTagT AutoTag<details::SourceLocation::current().hash()>
-#define AutoTagV AutoTagT{}
+using ArenaCtx = ContextWrapper<ParseArena&>;
 
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
 
-template <typename Tag, std::invocable Fn>
-auto lazyCached(Fn const& genParser) noexcept(std::is_nothrow_invocable_v<Fn>) {
-    return make_parser(LazyCached<Tag, Fn>{genParser});
+template <typename Key, typename Value>
+using ArenaMap = std::pmr::map<Key, Value>;
+
+namespace details {
+
+template <ContextType Ctx>
+std::pmr::memory_resource* arenaResource(Ctx& ctx) noexcept {
+    return get<ParseArena>(ctx).resource();
 }
 
-template <typename Tag, std::invocable Fn>
-auto lazyCached(Fn const& genParser, Tag tag) noexcept(std::is_nothrow_invocable_v<Fn>) {
-    return make_parser(LazyCached<Tag, Fn>{genParser});
 }
 
 
-template <typename T, typename tag>
-class LazyForget {
-    using InvokerType = typename Parser<T>::Result (*)(void*, Stream&);
+/**
+ * repeat with the result in the arena from the context
+ * @def arenaRepeat :: Parser<A, Ctx> -> Parser<ArenaVector<A>, Ctx & ArenaCtx>
+ */
+template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Value>
+    requires(!std::is_same_v<GetParserResult<Value>, Drop>)
+auto arenaRepeat(Value value) noexcept {
+    using Out = ArenaVector<GetParserResult<Value>>;
+    using P = Parser<Out, UnionCtx<GetParserCtx<Value>, ArenaCtx>>;
+    return P::make([value = std::move(value)](Stream& stream, auto& ctx) {
+        Out out{details::arenaResource(ctx)};
+        out.reserve(reserve);
 
-    template <typename ParserOut>
-    static InvokerType makeInvoker() noexcept {
-        return [](void* pParser, Stream& s) {
-            return static_cast<ParserOut*>(pParser)->apply(s);
-        };
-    }
-public:
-    template <typename Fn>
-        requires(!std::is_same_v<Fn, LazyForget<T, tag>>)
-    explicit LazyForget(Fn const& fn) noexcept(std::is_nothrow_invocable_v<Fn>) {
-        if (pInvoke == nullptr) {
-            using ParserOut = std::invoke_result_t<Fn>;
-            pInvoke = makeInvoker<ParserOut>();
-            pParser = new ParserOut(fn());
-        }
-    }
+        size_t iteration = 0;
+        do {
+            auto backup = stream.pos();
+            auto result = value.apply(stream, ctx);
+            if (!result.isError()) {
+                out.emplace_back(std::move(result).data());
+            } else {
+                stream.restorePos(backup);
+                return P::data(std::move(out));
+            }
+        } while (++iteration != maxIteration);
 
-    auto operator()(Stream& stream) const {
-        return pInvoke(pParser, stream);
-    }
-private:
-    static inline InvokerType pInvoke = nullptr;
-    static inline void* pParser = nullptr;
-};
+        return P::makeError("Max iteration", stream.pos());
+    });
+}
 
 
-template <typename T, typename Ctx, typename tag>
-        requires (!IsVoidCtx<Ctx>)
-class LazyForgetCtx {
-    using InvokerType = typename Parser<T, Ctx>::Result (*)(void*, Stream&, Ctx&);
+/**
+ * @def arenaRepeat :: Parser<A, Ctx> -> Parser<Delim, CtxD> -> Parser<ArenaVector<A>, Ctx & CtxD & ArenaCtx>
+ */
+template <size_t reserve = 0, size_t maxIteration = MAX_ITERATION, ParserType Value, ParserType Delimiter>
+    requires(!std::is_same_v<GetParserResult<Value>, Drop>)
+auto arenaRepeat(Value value, Delimiter delimiter) noexcept {
+    using Out = ArenaVector<GetParserResult<Value>>;
+    using P = Parser<Out, UnionCtx<GetParserCtx<Value>, GetParserCtx<Delimiter>, ArenaCtx>>;
+    return P::make([value = std::move(value), delimiter = std::move(delimiter)](Stream& stream, auto& ctx) {
+        Out out{details::arenaResource(ctx)};
+        out.reserve(reserve);
 
-    template <typename ParserOut>
-    static InvokerType makeInvoker() noexcept {
-        return [](void* pParser, Stream& s, auto& ctx) {
-            return static_cast<ParserOut*>(pParser)->apply(s, ctx);
-        };
-    }
-public:
-    template <typename Fn>
-        requires(!std::is_same_v<Fn, LazyForgetCtx<T, Ctx, tag>>)
-    explicit LazyForgetCtx(Fn const& fn) noexcept(std::is_nothrow_invocable_v<Fn>) {
-        if (pInvoke == nullptr) {
-            using ParserOut = std::invoke_result_t<Fn>;
-            pInvoke = makeInvoker<ParserOut>();
-            pParser = new ParserOut(fn());
+        size_t iteration = 0;
+        auto backup = stream.pos();
+        do {
+            auto result = value.apply(stream, ctx);
+            if (!result.isError()) {
+                out.emplace_back(std::move(result).data());
+            } else {
+                return P::data(std::move(out));
+            }
+
+            backup = stream.pos();
+        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
+
+        if (iteration == maxIteration) {
+            return P::makeError("Max iteration", stream.pos());
+        } else {
+            stream.restorePos(backup);
+            return P::data(std::move(out));
         }
-    }
+    });
+}
 
-    auto operator()(Stream& stream, Ctx& ctx) const {
-        return pInvoke(pParser, stream, ctx);
-    }
-private:
-    static inline InvokerType pInvoke = nullptr;
-    static inline void* pParser = nullptr;
-};
+
+/**
+ * toMap with the result in the arena from the context
+ * @return Parser<ArenaMap<Key, Value>, CtxKey & CtxValue & ArenaCtx>
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , ParserType ParserKey
+        , ParserType ParserValue>
+auto arenaToMap(ParserKey key, ParserValue value) noexcept {
+    using Map = ArenaMap<GetParserResult<ParserKey>, GetParserResult<ParserValue>>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, ArenaCtx>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, StdMapContainer, Map, UCtx>(std::move(key), std::move(value), [](auto& ctx) {
+        return Map{details::arenaResource(ctx)};
+    });
+}
 
 
-template <typename T, typename Tag, typename Fn>
-auto lazyForget(Fn const& f, Tag = {}) noexcept {
-    return Parser<T>::make(LazyForget<T, Tag>{f});
+/**
+ * @return Parser<ArenaMap<Key, Value>, CtxKey & CtxValue & CtxDelim & ArenaCtx>
+ */
+template <bool errorInTheMiddle = true
+        , size_t maxIteration = MAX_ITERATION
+        , ParserType ParserKey
+        , ParserType ParserValue
+        , ParserType ParserDelimiter>
+auto arenaToMap(ParserKey key, ParserValue value, ParserDelimiter delimiter) noexcept {
+    using Map = ArenaMap<GetParserResult<ParserKey>, GetParserResult<ParserValue>>;
+    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>, ArenaCtx>;
+    return details::toMapImpl<errorInTheMiddle, maxIteration, StdMapContainer, Map, UCtx>(std::move(key), std::move(value), std::move(delimiter), [](auto& ctx) {
+        return Map{details::arenaResource(ctx)};
+    });
 }
 
-template <typename T, typename Ctx, typename Fn, typename Tag>
-auto lazyForgetCtx(Fn const& f, Tag = {}) noexcept {
-    return Parser<T>::make(LazyForgetCtx<T, Ctx, Tag>{f});
 }
+// #include <parsecpp/common/packrat.h>
 
 
-struct LazyBindingTag{};
-template <typename T, ContextType ParserCtx, typename Tag = LazyBindingTag>
-class LazyCtxBinding {
-public:
-    struct LazyContext;
+// #include <parsecpp/core/parser.h>
 
-    static constexpr bool nocontext = false;
-    using Ctx = UnionCtx<ParserCtx, ContextWrapper<LazyContext const&>>;
+// #include <parsecpp/utils/flatMap.h>
 
-    using P = Parser<T, Ctx>;
-    using ParserResult = T;
 
-    struct LazyContext {
-        explicit LazyContext(void const*const p) : parser(p) {};
-        void const*const parser;
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace prs {
+
+namespace details {
+
+class PackratCacheBase {
+public:
+    virtual ~PackratCacheBase() = default;
+};
+
+/**
+ * Direct-mapped window of results of one packrat parser, the entry of a position evicts the entry of position ± window
+ */
+template <typename T>
+class PackratCache final : public PackratCacheBase {
+public:
+    struct Entry {
+        size_t pos = std::string_view::npos;
+        uint64_t generation = 0;
+        size_t end = 0;
+        std::optional<ResultType<T>> result;
     };
 
-    explicit LazyCtxBinding() noexcept = default;
+    explicit PackratCache(size_t window)
+        : m_entries(window) {
 
-    template <ContextType Context>
-    details::ResultType<ParserResult> operator()(Stream& stream, Context& ctx) const {
-        auto const*const parser = reinterpret_cast<P const*const>(get<LazyContext>(ctx).parser);
-        return parser->apply(stream, ctx);
     }
+
+    Entry& slot(size_t pos) noexcept {
+        return m_entries[pos & (m_entries.size() - 1)];
+    }
+private:
+    std::vector<Entry> m_entries;
 };
 
-template <typename Fn, typename Tag>
-auto lazyCtxBindingFn(Fn const& f [[maybe_unused]], Tag = {}) noexcept {
-    using P = std::invoke_result_t<Fn>;
-    using T = GetParserResult<P>;
-    using Ctx = GetParserCtx<P>;
-    using LZ = LazyCtxBinding<T, Ctx, Tag>;
-    return Parser<T, typename LZ::Ctx>::make(LZ{});
+
+inline size_t nextPackratId() noexcept {
+    static std::atomic<size_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
 }
 
+template <typename Tag>
+size_t packratTagId() noexcept {
+    static size_t const id = nextPackratId();
+    return id;
+}
 
-template <typename Tag, typename Fn>
-auto lazyCtxBindingFn(Fn const& f [[maybe_unused]]) noexcept {
-    return lazyCtxBinding(f, Tag{});
 }
 
 
-template <typename T, typename Tag = LazyBindingTag>
-auto lazyCtxBinding() noexcept {
-    using LZ = LazyCtxBinding<T, VoidContext, Tag>;
-    return Parser<T, typename LZ::Ctx>::make(LZ{});
-}
+/**
+ * Cache of packrat parsers: (parser id, position) -> (result, end position).
+ * Every packrat parser keeps the last `window` positions (rounded up to a power of two),
+ * so memory is bounded by window * number of packrat parsers used with the table.
+ * The table is cleared in O(1) by reset() or when it's used with another input.
+ */
+class PackratTable {
+public:
+    static constexpr size_t DEFAULT_WINDOW = 1024;
 
+    explicit PackratTable(size_t window = DEFAULT_WINDOW)
+        : m_window(std::bit_ceil(std::max<size_t>(window, 1))) {
 
-template <typename T, typename Tag>
-auto lazyCtxBinding(Tag) noexcept {
-    return lazyCtxBinding<T, Tag>();
-}
+    }
 
-template <typename T, typename Ctx, typename Tag = LazyBindingTag>
-auto lazyCtxBindingCtx() noexcept {
-    using LZ = LazyCtxBinding<T, Ctx, Tag>;
-    return Parser<T, typename LZ::Ctx>::make(LZ{});
-}
+    PackratTable(PackratTable const&) = delete;
+    PackratTable& operator=(PackratTable const&) = delete;
 
-template <typename T, typename Ctx, typename Tag>
-auto lazyCtxBindingCtx(Tag = Tag{}) noexcept {
-    return lazyCtxBindingCtx<T, Ctx, Tag>();
-}
+    /**
+     * Forget all results, call it before parsing a new text in the same buffer
+     */
+    void reset() noexcept {
+        ++m_generation;
+        m_input = {};
+    }
 
-template <typename T, ContextType Ctx, typename Tag = LazyBindingTag>
-requires (sizeCtx<Ctx> == 1)
-auto makeBindingCtx(Parser<T, Ctx> const& parser) noexcept {
-    using LazyCtx = typename LazyCtxBinding<T, VoidContext, Tag>::LazyContext;
-    return LazyCtx{std::addressof(parser)};
-}
+    size_t window() const noexcept {
+        return m_window;
+    }
 
-}
-// #include <parsecpp/core/lift.h>
+    size_t hits() const noexcept {
+        return m_hits;
+    }
 
+    size_t misses() const noexcept {
+        return m_misses;
+    }
 
-// #include <parsecpp/core/parser.h>
+    /**
+     * Number of packrat parsers that have a cache in the table
+     */
+    size_t caches() const noexcept {
+        return m_caches.size();
+    }
 
-// #include <parsecpp/common/base.h>
+    template <typename T>
+    typename details::PackratCache<T>::Entry& entry(size_t id, Stream const& stream) {
+        if (auto const full = stream.full(); full.data() != m_input.data() || full.size() != m_input.size()) {
+            reset();
+            m_input = full;
+        }
 
+        // ids are global, the caches are keyed by them only for the parsers that used the table
+        auto it = m_caches.find(id);
+        if (it == m_caches.end()) {
+            m_caches.insert_or_assign(size_t{id}, std::make_unique<details::PackratCache<T>>(m_window));
+            it = m_caches.find(id);
+        }
+        return static_cast<details::PackratCache<T>&>(*it->second).slot(stream.pos());
+    }
 
-// #include <parsecpp/core/parser.h>
+    template <typename Entry>
+    bool lookup(Entry const& entry, size_t pos) noexcept {
+        bool const hit = entry.pos == pos && entry.generation == m_generation;
+        ++(hit ? m_hits : m_misses);
+        return hit;
+    }
 
-// #include <parsecpp/utils/cmp.h>
+    template <typename Entry, typename Result>
+    void store(Entry& entry, size_t pos, size_t end, Result const& result) {
+        entry.result.emplace(result);
+        entry.pos = pos;
+        entry.end = end;
+        entry.generation = m_generation;
+    }
+private:
+    size_t m_window;
+    uint64_t m_generation = 1;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    std::string_view m_input;
+    HashMap<size_t, std::unique_ptr<details::PackratCacheBase>> m_caches;
+};
 
+using PackratCtx = ContextWrapper<PackratTable&>;
 
-#include <utility>
 
+namespace details {
 
-namespace prs::details {
+template <ParserType P>
+auto packratImpl(P parser, size_t id) noexcept {
+    using T = GetParserResult<P>;
+    using R = Parser<T, UnionCtx<GetParserCtx<P>, PackratCtx>>;
+    auto const first = parser.firstSet();
+    auto out = R::make([parser = std::move(parser), id](Stream& stream, auto& ctx) {
+        auto& table = get<PackratTable>(ctx);
+        auto const pos = stream.pos();
+        auto& entry = table.template entry<T>(id, stream);
+        if (table.lookup(entry, pos)) {
+            stream.restorePos(entry.end);
+            return *entry.result;
+        }
 
-template <typename T, typename First, typename ...Args>
-constexpr bool cmpAnyOf(T const& t, First &&f, Args &&...args) noexcept {
-    if constexpr (sizeof...(args) > 0) {
-        return f == t || cmpAnyOf(t, std::forward<Args>(args)...);
+        auto result = parser.apply(stream, ctx);
+        // entry is stable, nested calls of the parser could only evict it
+        table.store(entry, pos, stream.pos(), result);
+        return result;
+    });
+
+    if constexpr (P::hasFirstSet) {
+        return out.withFirstSet(first);
     } else {
-        return f == t;
+        return out;
     }
 }
 
 }
 
-namespace prs {
-
-/**
- *
- * @return Parser<T>
- */
-template <typename T>
-auto pure(T tValue) noexcept {
-    using Value = std::decay_t<T>;
-    return Parser<Value>::make([t = std::move(tValue)](Stream&) {
-        return Parser<Value>::data(t);
-    });
-}
 
 /**
- *
- * @return Parser<Unit>
+ * Memoize results of the parser by position in the PackratTable from the context,
+ * it makes backtracking of alternatives with common prefixes linear.
+ * The id of the parser is unique for every call, build the parser once (lazyCached).
+ * Side effects of the parser on the context aren't repeated for cached results.
+ * @def packrat :: Parser<A, Ctx> -> Parser<A, Ctx & PackratCtx>
  */
-inline auto success() noexcept {
-    return pure(Unit{});
+template <ParserType P>
+    requires(std::copy_constructible<GetParserResult<P>>)
+auto packrat(P parser) noexcept {
+    auto const id = details::nextPackratId();
+    return details::packratImpl(std::move(parser), id);
 }
 
-/**
- *
- * @return Parser<Unit>
- */
-inline auto fail() noexcept {
-    return Parser<Unit>::make([](Stream& s) {
-        return Parser<Unit>::makeError("Fail", s.pos());
-    });
-}
 
 /**
- *
- * @return Parser<Unit>
+ * The id is unique for Tag, use it for the parsers that are rebuilt while parsing (lazy).
+ * Different parsers must have different tags.
  */
-inline auto fail(std::string const& text) noexcept {
-    return Parser<Unit>::make([text](Stream& s) {
-        return Parser<Unit>::makeError(text, s.pos());
-    });
+template <typename Tag, ParserType P>
+    requires(std::copy_constructible<GetParserResult<P>>)
+auto packrat(P parser) noexcept {
+    return details::packratImpl(std::move(parser), details::packratTagId<Tag>());
 }
 
 }
+// #include <parsecpp/common/number.h>
 
-namespace prs {
 
+// #include <parsecpp/core/parser.h>
 
-template <typename Ctx = VoidContext, typename Fn>
-auto make_parser(Fn &&f) noexcept {
-    using T = typename std::conditional_t<std::is_invocable_v<Fn, Stream&>
-            , std::invoke_result<Fn, Stream&>
-            , std::invoke_result<Fn, Stream&, Ctx&>>::type::Body;
+// #include <parsecpp/common/string.h>
 
-    return Parser<T, Ctx>::make(std::forward<Fn>(f));
-}
 
-namespace details {
+// #include <parsecpp/core/parser.h>
 
-template <typename Fn, typename TupleParser, typename ...Values>
-auto liftRec(Fn const& fn, Stream& stream, TupleParser const& parsers, Values &&...values) noexcept {
-    constexpr size_t Ind = sizeof...(values);
-    if constexpr (std::tuple_size_v<TupleParser> == Ind) {
-        using ReturnType = std::invoke_result_t<Fn, Values...>;
-        return Parser<ReturnType>::data(std::invoke(fn, values...));
-    } else {
-        return std::get<Ind>(parsers).apply(stream).flatMap([&](auto &&a) {
-            return liftRec(
-                    fn, stream, parsers, std::forward<Values>(values)..., a);
-        });
-    }
-}
+// #include <parsecpp/core/lift.h>
 
+// #include <parsecpp/core/textSearch.h>
 
-template <typename Fn, typename Ctx, typename TupleParser, typename ...Values>
-auto liftRecCtx(Fn const& fn, Stream& stream, Ctx& ctx, TupleParser const& parsers, Values &&...values) noexcept {
-    constexpr size_t Ind = sizeof...(values);
-    if constexpr (std::tuple_size_v<TupleParser> == Ind) {
-        using ReturnType = std::invoke_result_t<Fn, Values...>;
-        if constexpr (std::is_invocable_v<Fn, Values...>) {
-            return Parser<ReturnType>::data(std::invoke(fn, values...));
-        } else {
-            return Parser<ReturnType>::data(std::invoke(fn, values..., ctx));
-        }
-    } else {
-        return std::get<Ind>(parsers).apply(stream, ctx).flatMap([&](auto &&a) {
-            return liftRecCtx(
-                    fn, stream, ctx, parsers, std::forward<Values>(values)..., a);
-        });
-    }
-}
 
-}
+// #include <parsecpp/core/buildParams.h>
 
-template <typename Fn, ParserType ...Args>
-    requires(IsVoidCtx<GetContextTrait<Fn>> && (IsVoidCtx<GetParserCtx<Args>> && ...))
-auto liftM(Fn fn, Args &&...args) noexcept {
-    return make_parser([fn, parsers = std::make_tuple(args...)](Stream& s) {
-        return details::liftRec(fn, s, parsers);
-    });
-}
+// #include <parsecpp/core/simd.h>
 
 
-/*
- * Applicative
- * liftM :: (A1 -> ... -> An -> B) -> Parser<A> -> ... -> Parser<An> -> Parser<B>
- */
-template <typename Fn, ParserType ...Args>
-    requires(!IsVoidCtx<GetContextTrait<Fn>> || (!IsVoidCtx<GetParserCtx<Args>> || ...))
-auto liftM(Fn fn, Args &&...args) noexcept {
-    using Ctx = UnionCtx<GetContextTrait<Fn>, GetParserCtx<Args>...>;
-    return make_parser<Ctx>([fn, parsers = std::make_tuple(args...)](Stream& s, auto& ctx) {
-        return details::liftRecCtx(fn, s, ctx, parsers);
-    });
-}
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
 
-template <ParserType ...Args>
-auto concat(Args &&...args) noexcept {
-    return liftM(details::MakeTuple{}, std::forward<Args>(args)...);
-}
+namespace prs::details {
 
-/*
- * satisfy :: (char -> bool) -> Parser<char>
+/**
+ * Substring search with SIMD first/last byte candidate filter.
+ * Blocks of text are compared with the first and the last symbols of the pattern,
+ * only positions where both of them match are checked with memcmp.
+ * @tparam extent - size of the pattern if it's known at compile time
+ * @return position of the first entrance of pattern or npos
  */
-template <typename Fn>
-constexpr auto satisfy(Fn&& tTest) noexcept {
-    return Parser<char>::make([test = std::forward<Fn>(tTest)](Stream& stream) {
-        if (stream.eos()) {
-            return Parser<char>::PRS_MAKE_ERROR("satisfy eos", stream.pos());
+template <size_t extent = std::dynamic_extent>
+size_t findText(std::string_view str, std::string_view pattern) noexcept {
+    size_t const k = extent == std::dynamic_extent ? pattern.size() : extent;
+    if (k == 0) {
+        return 0;
+    }
+    if (k > str.size()) {
+        return std::string_view::npos;
+    }
+    if (k == 1) {
+        auto const* p = static_cast<char const*>(std::memchr(str.data(), pattern[0], str.size()));
+        return p == nullptr ? std::string_view::npos : p - str.data();
+    }
+
+    [[maybe_unused]] char const* const s = str.data();
+    [[maybe_unused]] char const* const needle = pattern.data();
+    [[maybe_unused]] size_t const lastStart = str.size() - k; // the last position where pattern can start
+    size_t i = 0;
+
+    if constexpr (!DISABLE_SIMD) {
+#ifdef PRS_SIMD_AVX2
+        __m256i const first32 = _mm256_set1_epi8(needle[0]);
+        __m256i const last32 = _mm256_set1_epi8(needle[k - 1]);
+        for (; i + 32 <= lastStart + 1; i += 32) {
+            __m256i const blockFirst = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i));
+            __m256i const blockLast = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i + k - 1));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+                    _mm256_cmpeq_epi8(blockFirst, first32), _mm256_cmpeq_epi8(blockLast, last32))));
+            while (mask != 0) {
+                auto const bit = std::countr_zero(mask);
+                if (std::memcmp(s + i + bit + 1, needle + 1, k - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
         }
-        char c = stream.front();
-        if (test(c)) {
-            stream.moveUnsafe();
-            return Parser<char>::data(c);
-        } else {
-            return Parser<char>::PRS_MAKE_ERROR("satisfy eq", stream.pos());
+#endif
+#ifdef PRS_SIMD_SSE2
+        __m128i const first16 = _mm_set1_epi8(needle[0]);
+        __m128i const last16 = _mm_set1_epi8(needle[k - 1]);
+        for (; i + 16 <= lastStart + 1; i += 16) {
+            __m128i const blockFirst = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i));
+            __m128i const blockLast = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i + k - 1));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16))));
+            while (mask != 0) {
+                auto const bit = std::countr_zero(mask);
+                if (std::memcmp(s + i + bit + 1, needle + 1, k - 2) == 0) {
+                    return i + bit;
+                }
+                mask &= mask - 1;
+            }
         }
-    });
+#endif
+    }
+
+    return str.find(pattern.substr(0, k), i);
 }
 
 }
-// #include <parsecpp/core/modifier.h>
 
+// #include <parsecpp/utils/constexprString.hpp>
 
-// #include <parsecpp/core/parser.h>
 
+#include <cstring>
+#include <string>
+#include <string_view>
 
 namespace prs {
 
-template <typename T>
-class ModifyCallerI {
-public:
-    using Type = T;
-    virtual details::ResultType<T> operator()() = 0;
-};
-
-template <ParserType Parser>
-class ModifyCaller : public ModifyCallerI<GetParserResult<Parser>> {
-public:
-    using Type = typename ModifyCallerI<GetParserResult<Parser>>::Type;
-
-    ModifyCaller(Parser const& p, Stream& s) noexcept
-        : m_parser(p)
-        , m_stream(s) {}
+/**
+ *
+ * @return Parser<char>
+ */
+inline auto anyChar() noexcept {
+    auto p = [](Stream& stream) {
+        if (stream.eos()) {
+            return Parser<char>::makeError("empty string", stream.pos());
+        } else {
+            char c = stream.front();
+            stream.moveUnsafe();
+            return Parser<char>::data(c);
+        }
+    };
 
-    typename Parser::Result operator()() final {
-        return m_parser(m_stream);
-    }
-private:
-    Parser const& m_parser;
-    Stream& m_stream;
-};
+    return make_parser(p);
+}
 
 
-template <ParserType Parser, ContextType StoredCtx>
-class ModifyCallerCtx : public ModifyCallerI<GetParserResult<Parser>> {
+class FromRange {
 public:
-    ModifyCallerCtx(Parser const& p, Stream& s, StoredCtx& ctx) noexcept
-        : m_parser(p)
-        , m_stream(s)
-        , m_ctx(ctx) {
+    constexpr FromRange(char begin, char end) noexcept
+        : m_begin(begin)
+        , m_end(end) {
 
     }
 
-    typename Parser::Result operator()() final {
-        return m_parser(m_stream, m_ctx);
+    friend constexpr bool operator==(FromRange const& range, char c) noexcept {
+        return range.m_begin <= c && c <= range.m_end;
     }
-private:
-    Parser const& m_parser;
-    Stream& m_stream;
-    StoredCtx& m_ctx;
-};
 
-template <typename ModifierClass, typename Ctx>
-class ModifyWithContext {
-public:
-    explicit ModifyWithContext(ModifierClass fn) noexcept(std::is_nothrow_move_constructible_v<ModifierClass>)
-        : m_modifier(std::move(fn)) {
+// no private to be structural and avoid next error:
+// 'prs::FromRange' is not a valid type for a template non-type parameter because it is not structural
+//private:
+    char m_begin;
+    char m_end;
+};
 
-    }
 
-    template <typename ...Args>
-    explicit ModifyWithContext(Args&& ...args) noexcept(std::is_nothrow_constructible_v<ModifierClass, Args...>)
-        : m_modifier(std::forward<Args>(args)...) {
+struct AnySpace {
+    constexpr AnySpace() = default;
 
+    // std::isspace for the "C" locale, but constexpr
+    friend constexpr bool operator==(AnySpace const& range, char c) noexcept {
+        return c == ' ' || ('\t' <= c && c <= '\r');
     }
+};
 
-    auto operator()(auto& caller, Stream& stream, auto& ctx) const noexcept {
-        return m_modifier(caller, stream, ctx);
-    }
-private:
-    ModifierClass m_modifier;
+
+template <typename T, typename U>
+concept LeftCmpWith = requires(const std::remove_reference_t<T>& t,
+        const std::remove_reference_t<U>& u) {
+    {t == u} -> std::convertible_to<bool>; // boolean-testable
 };
 
 
-template <ParserType ParserA, typename Modify>
-    requires(ParserA::nocontext && std::is_invocable_v<Modify, ModifyCallerI<GetParserResult<ParserA>>&, Stream&>)
-auto operator*(ParserA parserA, Modify modifier) noexcept {
-    return make_parser([parser = std::move(parserA), mod = std::move(modifier)](Stream& stream) {
-        ModifyCaller p{parser, stream};
-        return mod(p, stream);
-    });
+/**
+ *
+ * @return Parser<Unit>
+ */
+inline auto spaces() noexcept {
+    return make_parser([](Stream& str) {
+        str.takeWhile(details::charSetOf<AnySpace{}>);
+        return prs::Parser<Unit>::data({});
+    }).withFirstSet(FirstSet::of(details::charSetOf<AnySpace{}>, true));
 }
 
 
-template <ParserType ParserA, typename Modify>
-    requires(!ParserA::nocontext)
-auto operator*(ParserA parserA, Modify modifier) noexcept {
-    using Ctx = GetParserCtx<ParserA>;
-    return make_parser<Ctx>(
-            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
-        ModifyCallerCtx p{parser, stream, ctx};
-        if constexpr (std::is_invocable_v<Modify, ModifyCallerI<GetParserResult<ParserA>>&, Stream&>) {
-            return mod(p, stream);
-        } else {
-            return mod(p, stream, ctx);
-        }
+/**
+ *
+ * @return Parser<Unit>
+ */
+inline auto spacesFast() noexcept {
+    return make_parser([](Stream& str) {
+        str.takeWhile(details::charSetOf<' '>);
+        return prs::Parser<Unit>::data({});
     });
 }
 
 
-template <ParserType ParserA, typename Modify, typename Ctx>
-auto operator*(ParserA parserA, ModifyWithContext<Modify, Ctx> modifier) noexcept {
-    using UCtx = UnionCtx<GetParserCtx<ParserA>, Ctx>;
-    return make_parser<UCtx>(
-            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
-        if constexpr (ParserA::nocontext) {
-            ModifyCaller p{parser, stream};
-            return mod(p, stream, ctx);
-        } else {
-            ModifyCaller p{parser, stream, ctx};
-            return mod(p, stream, ctx);
-        }
-    });
-}
+namespace details {
 
-template <ParserType ParserA, typename Modify>
-    requires (!IsVoidCtx<typename ContextTrait<Modify>::Ctx> && ParserA::nocontext)
-auto operator*(ParserA parserA, Modify modifier) noexcept {
-    using Ctx = typename ContextTrait<Modify>::Ctx;
-    using UCtx = UnionCtx<GetParserCtx<ParserA>, Ctx>;
-    return make_parser<UCtx>(
-            [parser = std::move(parserA), mod = std::move(modifier)](Stream& stream, auto& ctx) {
-        if constexpr (ParserA::nocontext) {
-            ModifyCaller p{parser, stream};
-            return mod(p, stream, ctx);
-        } else {
-            ModifyCaller p{parser, stream, ctx};
-            return mod(p, stream, ctx);
+
+template <bool allowDigit>
+constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArrayGen() {
+    std::array<bool, 256> t{false};
+    for (int c = 0; c != Stream::CHAR_MAPPING_SIZE; ++c) {
+        if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || (allowDigit && ('0' <= c && c <= '9'))) {
+            t[c] = true;
         }
-    });
+    }
+    return t;
 }
 
+template <bool allowDigit>
+inline constexpr CharSet lettersSet = CharSet{lettersArrayGen<allowDigit>()};
 
-/*
- * Priority for operator*
- * a `op` b * mod === a `op` (b * mod)
- * a `op` b *= mod === (a `op` b) * mod
- * forall `op` != >>=
- */
-template <ParserType ParserA, typename Modify>
-auto operator*=(ParserA parserA, Modify modify) noexcept {
-    return parserA * modify;
+constexpr FirstSet literalFirstSet(std::string_view str) noexcept {
+    return str.empty() ? FirstSet{}.maybe() : FirstSet::anyOf(str.front());
 }
 
 }
 
-// #include <parsecpp/common/base.h>
+/**
+ *
+ * @return Parser<StringType>
+ */
+template <bool allowDigit = false, typename StringType = std::string_view>
+auto letters() noexcept {
+    return make_parser([](Stream& str) {
+        auto word = str.takeWhile(details::lettersSet<allowDigit>);
+        if (word.empty()) {
+            return Parser<StringType>::makeError("Empty word", str.pos());
+        } else {
+            return Parser<StringType>::data(StringType{word});
+        }
+    }).withFirstSet(FirstSet::of(details::lettersSet<allowDigit>));
+}
 
-// #include <parsecpp/common/map.h>
 
+template <typename StringType = std::string_view, LeftCmpWith<char> ...Args>
+auto lettersFrom(Args ...args) noexcept {
+    static_assert(sizeof...(args) > 0);
+    return make_parser([set = CharSet::anyOf(args...)](Stream& str) {
+        return Parser<StringType>::data(StringType{str.takeWhile(set)});
+    });
+}
 
-// #include <parsecpp/core/parser.h>
 
-// #include <parsecpp/core/lift.h>
+template <auto ...args>
+constexpr auto lettersFrom() noexcept {
+    static_assert(sizeof...(args) > 0);
+    using T = std::string_view;
+    return make_parser([](Stream& str) {
+        return Parser<T>::data(str.takeWhile(details::charSetOf<args...>));
+    });
+}
 
 
-#include <map>
+template <LeftCmpWith<char> ...Args>
+auto skipChars(Args ...args) noexcept {
+    static_assert(sizeof...(args) > 0);
+    return make_parser([set = CharSet::anyOf(args...)](Stream& str) {
+        str.takeWhile(set);
+        return Parser<Drop>::data({});
+    });
+}
 
 
-namespace prs {
+template <auto ...args>
+auto skipChars() noexcept {
+    static_assert(sizeof...(args) > 0);
+    return make_parser([](Stream& str) {
+        str.takeWhile(details::charSetOf<args...>);
+        return Parser<Drop>::data({});
+    });
+}
 
-/**
- * @tparam errorInTheMiddle - fail parser if key can be parsed and value cannot
- * Key := ParserKey::Type
- * Value := ParserValue::Type
- * @return Parser<std::map<Key, Value>>
- */
-template <bool errorInTheMiddle = true
-        , size_t maxIteration = MAX_ITERATION
-        , ParserType ParserKey
-        , ParserType ParserValue>
-auto toMap(ParserKey key, ParserValue value) noexcept {
-    using Key = GetParserResult<ParserKey>;
-    using Value = GetParserResult<ParserValue>;
-    using Map = std::map<Key, Value>;
-    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>>;
-    using P = Parser<Map, UCtx>;
-    return P::make([key, value](Stream& stream, auto& ctx) {
-        Map out{};
-        size_t iteration = 0;
 
-        [[maybe_unused]]
-        auto backup = stream.pos();
-        do {
-            auto keyRes = key.apply(stream, ctx);
-            if (!keyRes.isError()) {
-                auto valueRes = value.apply(stream, ctx);
-                if (!valueRes.isError()) {
-                    out.insert_or_assign(std::move(keyRes).data(), std::move(valueRes).data());
-                } else {
-                    if constexpr (errorInTheMiddle) {
-                        return P::makeError("Parse key but cannot parse value", stream.pos());
-                    } else {
-                        stream.restorePos(backup);
-                        return P::data(std::move(out));
-                    }
-                }
+template <bool forwardSearch = false>
+auto searchText(std::string const& searchPattern) noexcept {
+    // errors can outlive the parser, so they get their own text of the pattern
+    return Parser<Unit>::make([pattern = searchPattern, text = details::keepErrorText(searchPattern)](Stream& stream) {
+        std::string_view const patternView = pattern;
+        auto &str = stream.sv();
+        if (auto pos = details::findText(str, patternView); pos != std::string_view::npos) {
+            if constexpr (forwardSearch) {
+                stream.move(pos);
+                return Parser<Unit>::data({});
             } else {
-                stream.restorePos(backup);
-                return P::data(std::move(out));
+                str = str.substr(pos + patternView.size());
+                return Parser<Unit>::data({});
             }
-
-            backup = stream.pos();
-        } while (++iteration != maxIteration);
-
-        return P::makeError("Max iteration", stream.pos());
+        } else {
+            return Parser<Unit>::makeError(details::ParsingError::quoted("Cannot find", text, stream.pos()));
+        }
     });
 }
 
 
-/**
- * @tparam errorInTheMiddle - fail parser if key or delim can be parsed and value(key) cannot
- * Key := ParserKey::Type
- * Value := ParserValue::Type
- * @return Parser<std::map<Key, Value>>
- */
-template <bool errorInTheMiddle = true
-        , size_t maxIteration = MAX_ITERATION
-        , ParserType ParserKey
-        , ParserType ParserValue
-        , ParserType ParserDelimiter>
-auto toMap(ParserKey tKey, ParserValue tValue, ParserDelimiter tDelimiter) noexcept {
-    using Key = GetParserResult<ParserKey>;
-    using Value = GetParserResult<ParserValue>;
-    using Map = std::map<Key, Value>;
-    using UCtx = UnionCtx<GetParserCtx<ParserKey>, GetParserCtx<ParserValue>, GetParserCtx<ParserDelimiter>>;
-    using P = Parser<Map, UCtx>;
-    return P::make([key = std::move(tKey), value = std::move(tValue), delimiter = std::move(tDelimiter)](Stream& stream, auto& ctx) {
-        Map out{};
-        size_t iteration = 0;
-
-        auto backup = stream.pos();
-        do {
-            auto keyRes = key.apply(stream, ctx);
-            if (!keyRes.isError()) {
-                auto valueRes = value.apply(stream, ctx);
-                if (!valueRes.isError()) {
-                    out.insert_or_assign(std::move(keyRes).data(), std::move(valueRes).data());
-                } else {
-                    if constexpr (errorInTheMiddle) {
-                        return P::makeError("Parse key but cannot parse value", stream.pos());
-                    } else {
-                        stream.restorePos(backup);
-                        return P::data(std::move(out));
-                    }
-                }
+template <ConstexprString searchPattern, bool forwardSearch = false>
+auto searchText() noexcept {
+    return Parser<Unit>::make([](Stream& stream) {
+        auto &str = stream.sv();
+        if (auto pos = details::findText<searchPattern.size()>(str, searchPattern.sv()); pos != std::string_view::npos) {
+            if constexpr (forwardSearch) {
+                stream.move(pos);
+                return Parser<Unit>::data({});
             } else {
-                stream.restorePos(backup);
-                return P::data(std::move(out));
+                str = str.substr(pos + searchPattern.size());
+                return Parser<Unit>::data({});
             }
-
-            backup = stream.pos();
-        } while (!delimiter.apply(stream, ctx).isError() && ++iteration != maxIteration);
-
-        if (iteration == maxIteration) {
-            return P::makeError("Max iteration", stream.pos());
         } else {
-            stream.restorePos(backup);
-            return P::data(std::move(out));
+            return Parser<Unit>::makeError(details::ParsingError::quoted("Cannot find", details::StaticText::fromStatic(searchPattern.c_str()), stream.pos()));
         }
     });
 }
 
+
+template <LeftCmpWith<char> ...Args>
+constexpr auto charFrom(Args ...chars) noexcept {
+    auto test = [=](char c) {
+        return details::cmpAnyOf(c, chars...);
+    };
+    return satisfy(test).withFirstSet(FirstSet::fromPredicate(test));
 }
-// #include <parsecpp/common/number.h>
 
 
-// #include <parsecpp/core/parser.h>
+template <auto ...chars>
+constexpr auto charFrom() noexcept {
+    auto test = [](char c) {
+        return details::cmpAnyOf(c, chars...);
+    };
+    return satisfy(test).withFirstSet(FirstSet::fromPredicate(test));
+}
 
-// #include <parsecpp/common/string.h>
 
+template <LeftCmpWith<char> ...Args>
+auto charFromSpaces(Args ...chars) noexcept {
+    return spaces() >> charFrom(std::forward<Args>(chars)...) << spaces();
+}
 
-// #include <parsecpp/core/parser.h>
 
-// #include <parsecpp/core/lift.h>
+template <typename StringType = std::string_view>
+auto between(char borderLeft, char borderRight) noexcept {
+    using P = Parser<StringType>;
+    return P::make([borderLeft, borderRight, set = CharSet::anyOf(borderRight).inverse()](Stream& stream) {
+        if (stream.checkFirst(borderLeft) == 0) {
+            return P::makeError("No leftBorder", stream.pos());
+        }
 
+        auto ans = stream.takeWhile(set);
+        if (stream.checkFirst(borderRight) == 0) {
+            return P::makeError("No rightBorder", stream.pos());
+        }
 
-// #include <parsecpp/utils/constexprString.hpp>
+        return P::data(StringType{ans});
+    }).withFirstSet(FirstSet::anyOf(borderLeft));
+}
 
 
-namespace prs {
+template <typename StringType = std::string_view>
+auto between(char border) noexcept {
+    return between<StringType>(border, border);
+}
 
-namespace details {
 
-template<std::size_t N>
-struct MakeArray
-{
-    std::array<char, N> data;
+template <ParserType Parser>
+auto between(char borderLeft, char borderRight, Parser parser) noexcept {
+    return charFrom(borderLeft) >> parser << charFrom(borderRight);
+}
 
-    template <std::size_t... Is>
-    constexpr MakeArray(char const(&arr)[N], std::integer_sequence<std::size_t, Is...>)
-        : data{arr[Is]...} {
 
-    }
+template <typename StringType = std::string_view, std::predicate<char> Fn>
+auto until(Fn fn) noexcept {
+    return Parser<StringType>::make([fn](Stream& stream) {
+        auto start = stream.pos();
+        while (stream.checkFirst([&](char c) {
+            return !fn(c);
+        }));
 
-    constexpr MakeArray(char const(&arr)[N])
-        : MakeArray(arr, std::make_integer_sequence<std::size_t, N>()) {
+        auto end = stream.pos();
+        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
+    });
+}
 
-    }
 
-    constexpr auto size() const {
-        return N;
-    }
-};
+template <typename StringType = std::string_view, std::predicate<char, Stream&> Fn>
+auto until(Fn fn) noexcept {
+    return Parser<StringType>::make([fn](Stream& stream) {
+        auto start = stream.pos();
+        while (stream.checkFirst([&](char c) {
+            return !fn(c, stream);
+        }));
 
+        auto end = stream.pos();
+        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
+    });
 }
 
-template<std::size_t N>
-struct ConstexprString {
-    std::array<char, N + 1> m_str;
 
-    constexpr explicit ConstexprString(char const(&s)[N + 1]) noexcept {
-        for (std::size_t i = 0; i <= N; ++i) {
-            m_str[i] = s[i];
+template <typename StringType = std::string_view, typename ...Args>
+auto until(Args ...args) noexcept {
+    return Parser<StringType>::make([set = CharSet::anyOf(args...).inverse()](Stream& stream) {
+        return Parser<StringType>::data(StringType{stream.takeWhile(set)});
+    });
+}
+
+
+template <auto ...args>
+auto until() noexcept {
+    using StringType = std::string_view;
+    return Parser<StringType>::make([](Stream& stream) {
+        return Parser<StringType>::data(StringType{stream.takeWhile(details::charSetNotOf<args...>)});
+    });
+}
+
+
+template <typename StringType = std::string_view>
+auto untilEnd() noexcept {
+    return Parser<StringType>::make([](Stream& stream) {
+        auto out = stream.sv();
+        stream.moveUnsafe(out.size());
+        return Parser<StringType>::data(StringType{out});
+    });
+}
+
+
+inline auto nextLine() noexcept {
+    return Parser<Unit>::make([](Stream& stream) {
+        auto sv = stream.sv();
+        for (size_t i = 0; i != sv.size(); ++i) {
+            if (sv[i] == '\n' || sv[i] == '\r') {
+                if (sv[i] == '\r' && (i + 1) < sv.size() && sv[i + 1] == '\n') {
+                    ++i;
+                }
+                stream.moveUnsafe(i);
+                return Parser<Unit>::data({});
+            }
         }
-    }
+        stream.sv() = "";
+        return Parser<Unit>::data({}); // return empty view if no new line found
+    });
+}
 
-    constexpr explicit ConstexprString(std::array<char, N + 1> arr) noexcept
-        : m_str(arr) {
-    }
 
-    constexpr explicit ConstexprString(details::MakeArray<N + 1> arr) noexcept{
-        for (size_t i = 0; i != N + 1; ++i) {
-            m_str[i] = arr.data[i];
+template <ParserType Parser>
+auto between(char border, Parser parser) noexcept {
+    return between(border, border, std::move(parser));
+}
+
+
+namespace details {
+
+/**
+ * Literal known at runtime, adjacent literals and chars are fused by `>>` and `<<`
+ */
+template <typename StringType>
+struct LiteralFn {
+    std::string str;
+
+    ResultType<StringType> operator()(Stream& s) const {
+        if (s.sv().starts_with(str)) {
+            s.moveUnsafe(str.size());
+            return Parser<StringType>::data(StringType{str});
+        } else {
+            return Parser<StringType>::makeError("Cannot find literal", s.pos());
         }
     }
 
-    static constexpr ConstexprString<1> fromChar(char c) noexcept {
-        return ConstexprString<1>({c});
+    size_t width() const noexcept {
+        return str.size();
     }
 
-    constexpr const char* c_str() const noexcept {
-        return m_str.data();
+    bool matchAt(char const* p) const noexcept {
+        return str.empty() || std::memcmp(p, str.data(), str.size()) == 0;
     }
 
-    constexpr size_t size() const noexcept {
-        return N;
+    StringType valueAt(char const*) const {
+        return StringType{str};
     }
+};
 
-    constexpr std::string_view sv() const noexcept {
-        return std::string_view(c_str(), size());
+template <ConstexprString str>
+struct ConstLiteralFn {
+    ResultType<std::string_view> operator()(Stream& s) const {
+        if (s.sv().starts_with(str.sv())) {
+            s.moveUnsafe(str.size());
+            return Parser<std::string_view>::data(str.sv());
+        } else {
+            return Parser<std::string_view>::makeError("Cannot find literal", s.pos());
+        }
     }
 
-    std::string toString() const noexcept {
-        return std::string(c_str(), size());
+    static constexpr size_t width() noexcept {
+        return str.size();
     }
 
-    template<std::size_t M>
-    constexpr auto operator+(ConstexprString<M> const& other) const noexcept {
-        std::array<char, N + M + 1> new_str{};
-        for (std::size_t i = 0; i != N; ++i) {
-            new_str[i] = m_str[i];
-        }
-        for (std::size_t i = 0; i != M; ++i) {
-            new_str[N + i] = other.m_str[i];
-        }
-        return ConstexprString<N + M>(new_str);
+    // the size is a constant, so the comparison is inlined to word compares
+    static bool matchAt(char const* p) noexcept {
+        return str.size() == 0 || std::memcmp(p, str.c_str(), str.size()) == 0;
     }
 
-    constexpr auto add(char c) const noexcept {
-        return operator+(fromChar(c));
+    static constexpr std::string_view valueAt(char const*) noexcept {
+        return str.sv();
     }
+};
 
-    constexpr auto between(char c) const noexcept {
-        return fromChar(c) + *this + fromChar(c);
-    }
+}
 
 
-    constexpr auto between(char l, char r) const noexcept {
-        return fromChar(l) + *this + fromChar(r);
-    }
+template <typename StringType = std::string_view>
+auto literal(std::string str) noexcept {
+    auto const first = details::literalFirstSet(str);
+    return Parser<StringType>::make(details::LiteralFn<StringType>{std::move(str)}).withFirstSet(first);
+}
+
+template <ConstexprString str>
+auto literal() noexcept {
+    return Parser<std::string_view>::make(details::ConstLiteralFn<str>{}).withFirstSet(details::literalFirstSet(str.sv()));
+}
 
 
-    template <size_t M>
-    constexpr bool operator==(ConstexprString<M> const& rhs) const noexcept {
-        if constexpr (M != N) {
-            return false;
-        } else {
-            for (auto i = 0; i != N; ++i) {
-                if (rhs[i] != this->operator[](i)) {
-                    return false;
+namespace details {
+
+/**
+ * Unescape string from the position `from`, there is no escaped symbol before `from`
+ * @return position of endSymbol or npos
+ */
+template <char endSymbol, char escapingSymbol>
+size_t unescapeString(std::string_view sv, size_t from, std::string& out) {
+    static constexpr auto specialSymbols = CharSet::anyOf(endSymbol, escapingSymbol).inverse();
+
+    bool isEscaped = false;
+    size_t i = from;
+    while (true) {
+        auto const plain = specialSymbols.prefixLength(sv.substr(i));
+        out.append(sv.data() + i, plain);
+        i += plain;
+        if (i == sv.size()) {
+            return std::string_view::npos;
+        }
+
+        if constexpr (endSymbol != escapingSymbol) {
+            if (sv[i] == escapingSymbol) {
+                if (std::exchange(isEscaped, !isEscaped)) {
+                    out.push_back(escapingSymbol);
                 }
+            } else if (isEscaped) {
+                isEscaped = false;
+                out.push_back(endSymbol);
+            } else {
+                return i;
+            }
+        } else {
+            if (isEscaped) {
+                isEscaped = false;
+                out.push_back(endSymbol);
+            } else if (i + 1 != sv.size() && sv[i + 1] == endSymbol) {
+                isEscaped = true;
+            } else {
+                return i;
             }
-            return true;
         }
+        ++i;
     }
+}
 
-    template <size_t M>
-    constexpr bool operator!=(ConstexprString<M> const& rhs) const noexcept {
-        return !operator==(rhs);
-    }
+}
 
-    constexpr auto operator[](size_t i) const noexcept {
-        return m_str[i];
-    }
 
+namespace details {
 
-    template <size_t M>
-    constexpr ConstexprString<std::min(M, N)> substr() const noexcept {
-        constexpr auto T = std::min(M, N);
-        std::array<char, T + 1> out{};
-        for (auto i = 0; i != T; ++i) {
-            out[i] = operator[](i);
-        }
-        return ConstexprString<T>(out);
+template <char endSymbol, char escapingSymbol>
+struct EscapedStringFn {
+    ResultType<std::string> operator()(Stream& s) const {
+        std::string out;
+        return unescape(s, out).map([&out](Drop) {
+            return std::move(out);
+        });
     }
 
-    template <size_t M>
-    requires(M <= N)
-    constexpr bool startsFrom(ConstexprString<M> const& prefix) const noexcept {
-        return substr<M>() == prefix;
+    /**
+     * Reuses the capacity of the caller's string
+     */
+    template <typename Ctx>
+    ResultType<Drop> into(Stream& s, Ctx&, std::string& out) const {
+        out.clear();
+        return unescape(s, out);
+    }
+
+    static ResultType<Drop> unescape(Stream& s, std::string& out) {
+        if (auto end = unescapeString<endSymbol, escapingSymbol>(s.sv(), 0, out);
+                end != std::string_view::npos) {
+            s.moveUnsafe(end + 1);
+            return ResultType<Drop>{Drop{}};
+        } else {
+            return ResultType<Drop>{ParsingError{"Cannot find end symbol", s.pos()}};
+        }
     }
 };
 
-template <details::MakeArray arr>
-constexpr auto operator""_prs() {
-    return ConstexprString<arr.size() - 1>(arr);
 }
 
 
+template <char endSymbol, char escapingSymbol = '\\'>
+auto escapedString() noexcept {
+    return Parser<std::string>::make(details::EscapedStringFn<endSymbol, escapingSymbol>{});
 }
 
-namespace prs {
 
 /**
- *
- * @return Parser<char>
+ * String that refers to the source if it's possible and owns memory otherwise
  */
-inline auto anyChar() noexcept {
-    auto p = [](Stream& stream) {
-        if (stream.eos()) {
-            return Parser<char>::makeError("empty string", stream.pos());
-        } else {
-            char c = stream.front();
-            stream.moveUnsafe();
-            return Parser<char>::data(c);
-        }
-    };
+class MaybeOwnedString {
+public:
+    MaybeOwnedString() noexcept = default;
 
-    return make_parser(p);
-}
+    explicit MaybeOwnedString(std::string_view view) noexcept
+        : m_view(view) {
 
+    }
 
-/**
- *
- * @return Parser<Unit>
- */
-inline auto spaces() noexcept {
-    return make_parser([](Stream& str) {
-        while (str.checkFirst([](char c) {
-            return std::isspace(c);
-        }));
+    explicit MaybeOwnedString(char const* view) noexcept
+        : m_view(view) {
 
-        return prs::Parser<Unit>::data({});
-    });
-}
+    }
 
+    explicit MaybeOwnedString(std::string owned) noexcept
+        : m_owned(std::move(owned))
+        , m_isOwned(true) {
 
-/**
- *
- * @return Parser<Unit>
- */
-inline auto spacesFast() noexcept {
-    return make_parser([](Stream& str) {
-        while (str.checkFirst([](char c) {
-            return c == ' ';
-        }));
+    }
 
-        return prs::Parser<Unit>::data({});
-    });
-}
+    std::string_view sv() const noexcept {
+        return m_isOwned ? std::string_view{m_owned} : m_view;
+    }
 
+    operator std::string_view() const noexcept {
+        return sv();
+    }
 
-namespace details {
+    bool isOwned() const noexcept {
+        return m_isOwned;
+    }
 
+    std::string toString() const {
+        return std::string{sv()};
+    }
 
-template <bool allowDigit>
-constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArrayGen() {
-    std::array<bool, 256> t{false};
-    for (int c = 0; c != Stream::CHAR_MAPPING_SIZE; ++c) {
-        if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || (allowDigit && ('0' <= c && c <= '9'))) {
-            t[c] = true;
-        }
+    friend bool operator==(MaybeOwnedString const& lhs, MaybeOwnedString const& rhs) noexcept {
+        return lhs.sv() == rhs.sv();
     }
-    return t;
-}
 
-template <bool allowDigit>
-static constexpr std::array<bool, Stream::CHAR_MAPPING_SIZE> lettersArray = lettersArrayGen<allowDigit>();
+    friend bool operator==(MaybeOwnedString const& lhs, std::string_view rhs) noexcept {
+        return lhs.sv() == rhs;
+    }
+private:
+    std::string_view m_view;
+    std::string m_owned;
+    bool m_isOwned = false;
+};
 
-}
 
 /**
- *
- * @return Parser<StringType>
+ * The same as escapedString, but doesn't allocate memory if the string doesn't contain escaped symbols
+ * @return Parser<MaybeOwnedString>
  */
-template <bool allowDigit = false, typename StringType = std::string_view>
-auto letters() noexcept {
-    return make_parser([](Stream& str) {
-        auto start = str.pos();
+template <char endSymbol, char escapingSymbol = '\\'>
+auto escapedStringView() noexcept {
+    using P = Parser<MaybeOwnedString>;
+    return P::make([](Stream& s) {
+        static constexpr auto specialSymbols = CharSet::anyOf(endSymbol, escapingSymbol).inverse();
+
+        auto const sv = s.sv();
+        auto const plain = specialSymbols.prefixLength(sv);
+        if (plain == sv.size()) {
+            return P::makeError("Cannot find end symbol", s.pos());
+        }
 
-        while (str.checkFirst(details::lettersArray<allowDigit>));
+        bool const isEnd = endSymbol != escapingSymbol
+                ? sv[plain] == endSymbol
+                : plain + 1 == sv.size() || sv[plain + 1] != endSymbol;
+        if (isEnd) {
+            s.moveUnsafe(plain + 1);
+            return P::data(MaybeOwnedString{sv.substr(0, plain)});
+        }
 
-        auto end = str.pos();
-        if (start == end) {
-            return Parser<StringType>::makeError("Empty word", str.pos());
+        std::string out{sv.substr(0, plain)};
+        if (auto end = details::unescapeString<endSymbol, escapingSymbol>(sv, plain, out);
+                end != std::string_view::npos) {
+            s.moveUnsafe(end + 1);
+            return P::data(MaybeOwnedString{std::move(out)});
         } else {
-            return Parser<StringType>::data(StringType{str.get_sv(start, end)});
+            return P::makeError("Cannot find end symbol", s.pos());
         }
     });
 }
 
+}
+// #include <parsecpp/utils/numberParsing.h>
 
-class FromRange {
-public:
-    constexpr FromRange(char begin, char end) noexcept
-        : m_begin(begin)
-        , m_end(end) {
 
-    }
+// #include <parsecpp/utils/powersOfFive.h>
 
-    friend constexpr bool operator==(FromRange const& range, char c) noexcept {
-        return range.m_begin <= c && c <= range.m_end;
-    }
 
-// no private to be structural and avoid next error:
-// 'prs::FromRange' is not a valid type for a template non-type parameter because it is not structural
-//private:
-    char m_begin;
-    char m_end;
+#include <cstdint>
+
+namespace prs::details {
+
+static constexpr int32_t SMALLEST_POWER_OF_FIVE = -342;
+static constexpr int32_t LARGEST_POWER_OF_FIVE = 308;
+
+/**
+ * 128-bit truncated normalized powers of five for the Eisel-Lemire algorithm,
+ * high and low words of 5^q for q in [SMALLEST_POWER_OF_FIVE, LARGEST_POWER_OF_FIVE].
+ * Generated: for q < 0 - floor(2^b / 5^-q) + 1 truncated to 128 bits, for q >= 0 - 5^q shifted to 128 bits.
+ */
+static constexpr uint64_t POWER_OF_FIVE_128[2 * (LARGEST_POWER_OF_FIVE - SMALLEST_POWER_OF_FIVE + 1)] = {
+    0xeef453d6923bd65a, 0x113faa2906a13b3f, // 5^-342
+    0x9558b4661b6565f8, 0x4ac7ca59a424c507, // 5^-341
+    0xbaaee17fa23ebf76, 0x5d79bcf00d2df649, // 5^-340
+    0xe95a99df8ace6f53, 0xf4d82c2c107973dc, // 5^-339
+    0x91d8a02bb6c10594, 0x79071b9b8a4be869, // 5^-338
+    0xb64ec836a47146f9, 0x9748e2826cdee284, // 5^-337
+    0xe3e27a444d8d98b7, 0xfd1b1b2308169b25, // 5^-336
+    0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7, // 5^-335
+    0xb208ef855c969f4f, 0xbdbd2d335e51a935, // 5^-334
+    0xde8b2b66b3bc4723, 0xad2c788035e61382, // 5^-333
+    0x8b16fb203055ac76, 0x4c3bcb5021afcc31, // 5^-332
+    0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d, // 5^-331
+    0xd953e8624b85dd78, 0xd71d6dad34a2af0d, // 5^-330
+    0x87d4713d6f33aa6b, 0x8672648c40e5ad68, // 5^-329
+    0xa9c98d8ccb009506, 0x680efdaf511f18c2, // 5^-328
+    0xd43bf0effdc0ba48, 0x0212bd1b2566def2, // 5^-327
+    0x84a57695fe98746d, 0x014bb630f7604b57, // 5^-326
+    0xa5ced43b7e3e9188, 0x419ea3bd35385e2d, // 5^-325
+    0xcf42894a5dce35ea, 0x52064cac828675b9, // 5^-324
+    0x818995ce7aa0e1b2, 0x7343efebd1940993, // 5^-323
+    0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8, // 5^-322
+    0xca66fa129f9b60a6, 0xd41a26e077774ef6, // 5^-321
+    0xfd00b897478238d0, 0x8920b098955522b4, // 5^-320
+    0x9e20735e8cb16382, 0x55b46e5f5d5535b0, // 5^-319
+    0xc5a890362fddbc62, 0xeb2189f734aa831d, // 5^-318
+    0xf712b443bbd52b7b, 0xa5e9ec7501d523e4, // 5^-317
+    0x9a6bb0aa55653b2d, 0x47b233c92125366e, // 5^-316
+    0xc1069cd4eabe89f8, 0x999ec0bb696e840a, // 5^-315
+    0xf148440a256e2c76, 0xc00670ea43ca250d, // 5^-314
+    0x96cd2a865764dbca, 0x380406926a5e5728, // 5^-313
+    0xbc807527ed3e12bc, 0xc605083704f5ecf2, // 5^-312
+    0xeba09271e88d976b, 0xf7864a44c633682e, // 5^-311
+    0x93445b8731587ea3, 0x7ab3ee6afbe0211d, // 5^-310
+    0xb8157268fdae9e4c, 0x5960ea05bad82964, // 5^-309
+    0xe61acf033d1a45df, 0x6fb92487298e33bd, // 5^-308
+    0x8fd0c16206306bab, 0xa5d3b6d479f8e056, // 5^-307
+    0xb3c4f1ba87bc8696, 0x8f48a4899877186c, // 5^-306
+    0xe0b62e2929aba83c, 0x331acdabfe94de87, // 5^-305
+    0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, // 5^-304
+    0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9, // 5^-303
+    0xdb71e91432b1a24a, 0xc9e82cd9f69d6150, // 5^-302
+    0x892731ac9faf056e, 0xbe311c083a225cd2, // 5^-301
+    0xab70fe17c79ac6ca, 0x6dbd630a48aaf406, // 5^-300
+    0xd64d3d9db981787d, 0x092cbbccdad5b108, // 5^-299
+    0x85f0468293f0eb4e, 0x25bbf56008c58ea5, // 5^-298
+    0xa76c582338ed2621, 0xaf2af2b80af6f24e, // 5^-297
+    0xd1476e2c07286faa, 0x1af5af660db4aee1, // 5^-296
+    0x82cca4db847945ca, 0x50d98d9fc890ed4d, // 5^-295
+    0xa37fce126597973c, 0xe50ff107bab528a0, // 5^-294
+    0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8, // 5^-293
+    0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a, // 5^-292
+    0x9faacf3df73609b1, 0x77b191618c54e9ac, // 5^-291
+    0xc795830d75038c1d, 0xd59df5b9ef6a2417, // 5^-290
+    0xf97ae3d0d2446f25, 0x4b0573286b44ad1d, // 5^-289
+    0x9becce62836ac577, 0x4ee367f9430aec32, // 5^-288
+    0xc2e801fb244576d5, 0x229c41f793cda73f, // 5^-287
+    0xf3a20279ed56d48a, 0x6b43527578c1110f, // 5^-286
+    0x9845418c345644d6, 0x830a13896b78aaa9, // 5^-285
+    0xbe5691ef416bd60c, 0x23cc986bc656d553, // 5^-284
+    0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8, // 5^-283
+    0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9, // 5^-282
+    0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53, // 5^-281
+    0xe858ad248f5c22c9, 0xd1b3400f8f9cff68, // 5^-280
+    0x91376c36d99995be, 0x23100809b9c21fa1, // 5^-279
+    0xb58547448ffffb2d, 0xabd40a0c2832a78a, // 5^-278
+    0xe2e69915b3fff9f9, 0x16c90c8f323f516c, // 5^-277
+    0x8dd01fad907ffc3b, 0xae3da7d97f6792e3, // 5^-276
+    0xb1442798f49ffb4a, 0x99cd11cfdf41779c, // 5^-275
+    0xdd95317f31c7fa1d, 0x40405643d711d583, // 5^-274
+    0x8a7d3eef7f1cfc52, 0x482835ea666b2572, // 5^-273
+    0xad1c8eab5ee43b66, 0xda3243650005eecf, // 5^-272
+    0xd863b256369d4a40, 0x90bed43e40076a82, // 5^-271
+    0x873e4f75e2224e68, 0x5a7744a6e804a291, // 5^-270
+    0xa90de3535aaae202, 0x711515d0a205cb36, // 5^-269
+    0xd3515c2831559a83, 0x0d5a5b44ca873e03, // 5^-268
+    0x8412d9991ed58091, 0xe858790afe9486c2, // 5^-267
+    0xa5178fff668ae0b6, 0x626e974dbe39a872, // 5^-266
+    0xce5d73ff402d98e3, 0xfb0a3d212dc8128f, // 5^-265
+    0x80fa687f881c7f8e, 0x7ce66634bc9d0b99, // 5^-264
+    0xa139029f6a239f72, 0x1c1fffc1ebc44e80, // 5^-263
+    0xc987434744ac874e, 0xa327ffb266b56220, // 5^-262
+    0xfbe9141915d7a922, 0x4bf1ff9f0062baa8, // 5^-261
+    0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9, // 5^-260
+    0xc4ce17b399107c22, 0xcb550fb4384d21d3, // 5^-259
+    0xf6019da07f549b2b, 0x7e2a53a146606a48, // 5^-258
+    0x99c102844f94e0fb, 0x2eda7444cbfc426d, // 5^-257
+    0xc0314325637a1939, 0xfa911155fefb5308, // 5^-256
+    0xf03d93eebc589f88, 0x793555ab7eba27ca, // 5^-255
+    0x96267c7535b763b5, 0x4bc1558b2f3458de, // 5^-254
+    0xbbb01b9283253ca2, 0x9eb1aaedfb016f16, // 5^-253
+    0xea9c227723ee8bcb, 0x465e15a979c1cadc, // 5^-252
+    0x92a1958a7675175f, 0x0bfacd89ec191ec9, // 5^-251
+    0xb749faed14125d36, 0xcef980ec671f667b, // 5^-250
+    0xe51c79a85916f484, 0x82b7e12780e7401a, // 5^-249
+    0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810, // 5^-248
+    0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15, // 5^-247
+    0xdfbdcece67006ac9, 0x67a791e093e1d49a, // 5^-246
+    0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0, // 5^-245
+    0xaecc49914078536d, 0x58fae9f773886e18, // 5^-244
+    0xda7f5bf590966848, 0xaf39a475506a899e, // 5^-243
+    0x888f99797a5e012d, 0x6d8406c952429603, // 5^-242
+    0xaab37fd7d8f58178, 0xc8e5087ba6d33b83, // 5^-241
+    0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64, // 5^-240
+    0x855c3be0a17fcd26, 0x5cf2eea09a55067f, // 5^-239
+    0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e, // 5^-238
+    0xd0601d8efc57b08b, 0xf13b94daf124da26, // 5^-237
+    0x823c12795db6ce57, 0x76c53d08d6b70858, // 5^-236
+    0xa2cb1717b52481ed, 0x54768c4b0c64ca6e, // 5^-235
+    0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09, // 5^-234
+    0xfe5d54150b090b02, 0xd3f93b35435d7c4c, // 5^-233
+    0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf, // 5^-232
+    0xc6b8e9b0709f109a, 0x359ab6419ca1091b, // 5^-231
+    0xf867241c8cc6d4c0, 0xc30163d203c94b62, // 5^-230
+    0x9b407691d7fc44f8, 0x79e0de63425dcf1d, // 5^-229
+    0xc21094364dfb5636, 0x985915fc12f542e4, // 5^-228
+    0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d, // 5^-227
+    0x979cf3ca6cec5b5a, 0xa705992ceecf9c42, // 5^-226
+    0xbd8430bd08277231, 0x50c6ff782a838353, // 5^-225
+    0xece53cec4a314ebd, 0xa4f8bf5635246428, // 5^-224
+    0x940f4613ae5ed136, 0x871b7795e136be99, // 5^-223
+    0xb913179899f68584, 0x28e2557b59846e3f, // 5^-222
+    0xe757dd7ec07426e5, 0x331aeada2fe589cf, // 5^-221
+    0x9096ea6f3848984f, 0x3ff0d2c85def7621, // 5^-220
+    0xb4bca50b065abe63, 0x0fed077a756b53a9, // 5^-219
+    0xe1ebce4dc7f16dfb, 0xd3e8495912c62894, // 5^-218
+    0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c, // 5^-217
+    0xb080392cc4349dec, 0xbd8d794d96aacfb3, // 5^-216
+    0xdca04777f541c567, 0xecf0d7a0fc5583a0, // 5^-215
+    0x89e42caaf9491b60, 0xf41686c49db57244, // 5^-214
+    0xac5d37d5b79b6239, 0x311c2875c522ced5, // 5^-213
+    0xd77485cb25823ac7, 0x7d633293366b828b, // 5^-212
+    0x86a8d39ef77164bc, 0xae5dff9c02033197, // 5^-211
+    0xa8530886b54dbdeb, 0xd9f57f830283fdfc, // 5^-210
+    0xd267caa862a12d66, 0xd072df63c324fd7b, // 5^-209
+    0x8380dea93da4bc60, 0x4247cb9e59f71e6d, // 5^-208
+    0xa46116538d0deb78, 0x52d9be85f074e608, // 5^-207
+    0xcd795be870516656, 0x67902e276c921f8b, // 5^-206
+    0x806bd9714632dff6, 0x00ba1cd8a3db53b6, // 5^-205
+    0xa086cfcd97bf97f3, 0x80e8a40eccd228a4, // 5^-204
+    0xc8a883c0fdaf7df0, 0x6122cd128006b2cd, // 5^-203
+    0xfad2a4b13d1b5d6c, 0x796b805720085f81, // 5^-202
+    0x9cc3a6eec6311a63, 0xcbe3303674053bb0, // 5^-201
+    0xc3f490aa77bd60fc, 0xbedbfc4411068a9c, // 5^-200
+    0xf4f1b4d515acb93b, 0xee92fb5515482d44, // 5^-199
+    0x991711052d8bf3c5, 0x751bdd152d4d1c4a, // 5^-198
+    0xbf5cd54678eef0b6, 0xd262d45a78a0635d, // 5^-197
+    0xef340a98172aace4, 0x86fb897116c87c34, // 5^-196
+    0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0, // 5^-195
+    0xbae0a846d2195712, 0x8974836059cca109, // 5^-194
+    0xe998d258869facd7, 0x2bd1a438703fc94b, // 5^-193
+    0x91ff83775423cc06, 0x7b6306a34627ddcf, // 5^-192
+    0xb67f6455292cbf08, 0x1a3bc84c17b1d542, // 5^-191
+    0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, // 5^-190
+    0x8e938662882af53e, 0x547eb47b7282ee9c, // 5^-189
+    0xb23867fb2a35b28d, 0xe99e619a4f23aa43, // 5^-188
+    0xdec681f9f4c31f31, 0x6405fa00e2ec94d4, // 5^-187
+    0x8b3c113c38f9f37e, 0xde83bc408dd3dd04, // 5^-186
+    0xae0b158b4738705e, 0x9624ab50b148d445, // 5^-185
+    0xd98ddaee19068c76, 0x3badd624dd9b0957, // 5^-184
+    0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6, // 5^-183
+    0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c, // 5^-182
+    0xd47487cc8470652b, 0x7647c3200069671f, // 5^-181
+    0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073, // 5^-180
+    0xa5fb0a17c777cf09, 0xf468107100525890, // 5^-179
+    0xcf79cc9db955c2cc, 0x7182148d4066eeb4, // 5^-178
+    0x81ac1fe293d599bf, 0xc6f14cd848405530, // 5^-177
+    0xa21727db38cb002f, 0xb8ada00e5a506a7c, // 5^-176
+    0xca9cf1d206fdc03b, 0xa6d90811f0e4851c, // 5^-175
+    0xfd442e4688bd304a, 0x908f4a166d1da663, // 5^-174
+    0x9e4a9cec15763e2e, 0x9a598e4e043287fe, // 5^-173
+    0xc5dd44271ad3cdba, 0x40eff1e1853f29fd, // 5^-172
+    0xf7549530e188c128, 0xd12bee59e68ef47c, // 5^-171
+    0x9a94dd3e8cf578b9, 0x82bb74f8301958ce, // 5^-170
+    0xc13a148e3032d6e7, 0xe36a52363c1faf01, // 5^-169
+    0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1, // 5^-168
+    0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9, // 5^-167
+    0xbcb2b812db11a5de, 0x7415d448f6b6f0e7, // 5^-166
+    0xebdf661791d60f56, 0x111b495b3464ad21, // 5^-165
+    0x936b9fcebb25c995, 0xcab10dd900beec34, // 5^-164
+    0xb84687c269ef3bfb, 0x3d5d514f40eea742, // 5^-163
+    0xe65829b3046b0afa, 0x0cb4a5a3112a5112, // 5^-162
+    0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab, // 5^-161
+    0xb3f4e093db73a093, 0x59ed216765690f56, // 5^-160
+    0xe0f218b8d25088b8, 0x306869c13ec3532c, // 5^-159
+    0x8c974f7383725573, 0x1e414218c73a13fb, // 5^-158
+    0xafbd2350644eeacf, 0xe5d1929ef90898fa, // 5^-157
+    0xdbac6c247d62a583, 0xdf45f746b74abf39, // 5^-156
+    0x894bc396ce5da772, 0x6b8bba8c328eb783, // 5^-155
+    0xab9eb47c81f5114f, 0x066ea92f3f326564, // 5^-154
+    0xd686619ba27255a2, 0xc80a537b0efefebd, // 5^-153
+    0x8613fd0145877585, 0xbd06742ce95f5f36, // 5^-152
+    0xa798fc4196e952e7, 0x2c48113823b73704, // 5^-151
+    0xd17f3b51fca3a7a0, 0xf75a15862ca504c5, // 5^-150
+    0x82ef85133de648c4, 0x9a984d73dbe722fb, // 5^-149
+    0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba, // 5^-148
+    0xcc963fee10b7d1b3, 0x318df905079926a8, // 5^-147
+    0xffbbcfe994e5c61f, 0xfdf17746497f7052, // 5^-146
+    0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633, // 5^-145
+    0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0, // 5^-144
+    0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0, // 5^-143
+    0x9c1661a651213e2d, 0x06bea10ca65c084e, // 5^-142
+    0xc31bfa0fe5698db8, 0x486e494fcff30a62, // 5^-141
+    0xf3e2f893dec3f126, 0x5a89dba3c3efccfa, // 5^-140
+    0x986ddb5c6b3a76b7, 0xf89629465a75e01c, // 5^-139
+    0xbe89523386091465, 0xf6bbb397f1135823, // 5^-138
+    0xee2ba6c0678b597f, 0x746aa07ded582e2c, // 5^-137
+    0x94db483840b717ef, 0xa8c2a44eb4571cdc, // 5^-136
+    0xba121a4650e4ddeb, 0x92f34d62616ce413, // 5^-135
+    0xe896a0d7e51e1566, 0x77b020baf9c81d17, // 5^-134
+    0x915e2486ef32cd60, 0x0ace1474dc1d122e, // 5^-133
+    0xb5b5ada8aaff80b8, 0x0d819992132456ba, // 5^-132
+    0xe3231912d5bf60e6, 0x10e1fff697ed6c69, // 5^-131
+    0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1, // 5^-130
+    0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2, // 5^-129
+    0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde, // 5^-128
+    0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b, // 5^-127
+    0xad4ab7112eb3929d, 0x86c16c98d2c953c6, // 5^-126
+    0xd89d64d57a607744, 0xe871c7bf077ba8b7, // 5^-125
+    0x87625f056c7c4a8b, 0x11471cd764ad4972, // 5^-124
+    0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf, // 5^-123
+    0xd389b47879823479, 0x4aff1d108d4ec2c3, // 5^-122
+    0x843610cb4bf160cb, 0xcedf722a585139ba, // 5^-121
+    0xa54394fe1eedb8fe, 0xc2974eb4ee658828, // 5^-120
+    0xce947a3da6a9273e, 0x733d226229feea32, // 5^-119
+    0x811ccc668829b887, 0x0806357d5a3f525f, // 5^-118
+    0xa163ff802a3426a8, 0xca07c2dcb0cf26f7, // 5^-117
+    0xc9bcff6034c13052, 0xfc89b393dd02f0b5, // 5^-116
+    0xfc2c3f3841f17c67, 0xbbac2078d443ace2, // 5^-115
+    0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, // 5^-114
+    0xc5029163f384a931, 0x0a9e795e65d4df11, // 5^-113
+    0xf64335bcf065d37d, 0x4d4617b5ff4a16d5, // 5^-112
+    0x99ea0196163fa42e, 0x504bced1bf8e4e45, // 5^-111
+    0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6, // 5^-110
+    0xf07da27a82c37088, 0x5d767327bb4e5a4c, // 5^-109
+    0x964e858c91ba2655, 0x3a6a07f8d510f86f, // 5^-108
+    0xbbe226efb628afea, 0x890489f70a55368b, // 5^-107
+    0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e, // 5^-106
+    0x92c8ae6b464fc96f, 0x3b0b8bc90012929d, // 5^-105
+    0xb77ada0617e3bbcb, 0x09ce6ebb40173744, // 5^-104
+    0xe55990879ddcaabd, 0xcc420a6a101d0515, // 5^-103
+    0x8f57fa54c2a9eab6, 0x9fa946824a12232d, // 5^-102
+    0xb32df8e9f3546564, 0x47939822dc96abf9, // 5^-101
+    0xdff9772470297ebd, 0x59787e2b93bc56f7, // 5^-100
+    0x8bfbea76c619ef36, 0x57eb4edb3c55b65a, // 5^-99
+    0xaefae51477a06b03, 0xede622920b6b23f1, // 5^-98
+    0xdab99e59958885c4, 0xe95fab368e45eced, // 5^-97
+    0x88b402f7fd75539b, 0x11dbcb0218ebb414, // 5^-96
+    0xaae103b5fcd2a881, 0xd652bdc29f26a119, // 5^-95
+    0xd59944a37c0752a2, 0x4be76d3346f0495f, // 5^-94
+    0x857fcae62d8493a5, 0x6f70a4400c562ddb, // 5^-93
+    0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952, // 5^-92
+    0xd097ad07a71f26b2, 0x7e2000a41346a7a7, // 5^-91
+    0x825ecc24c873782f, 0x8ed400668c0c28c8, // 5^-90
+    0xa2f67f2dfa90563b, 0x728900802f0f32fa, // 5^-89
+    0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9, // 5^-88
+    0xfea126b7d78186bc, 0xe2f610c84987bfa8, // 5^-87
+    0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9, // 5^-86
+    0xc6ede63fa05d3143, 0x91503d1c79720dbb, // 5^-85
+    0xf8a95fcf88747d94, 0x75a44c6397ce912a, // 5^-84
+    0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba, // 5^-83
+    0xc24452da229b021b, 0xfbe85badce996168, // 5^-82
+    0xf2d56790ab41c2a2, 0xfae27299423fb9c3, // 5^-81
+    0x97c560ba6b0919a5, 0xdccd879fc967d41a, // 5^-80
+    0xbdb6b8e905cb600f, 0x5400e987bbc1c920, // 5^-79
+    0xed246723473e3813, 0x290123e9aab23b68, // 5^-78
+    0x9436c0760c86e30b, 0xf9a0b6720aaf6521, // 5^-77
+    0xb94470938fa89bce, 0xf808e40e8d5b3e69, // 5^-76
+    0xe7958cb87392c2c2, 0xb60b1d1230b20e04, // 5^-75
+    0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2, // 5^-74
+    0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3, // 5^-73
+    0xe2280b6c20dd5232, 0x25c6da63c38de1b0, // 5^-72
+    0x8d590723948a535f, 0x579c487e5a38ad0e, // 5^-71
+    0xb0af48ec79ace837, 0x2d835a9df0c6d851, // 5^-70
+    0xdcdb1b2798182244, 0xf8e431456cf88e65, // 5^-69
+    0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff, // 5^-68
+    0xac8b2d36eed2dac5, 0xe272467e3d222f3f, // 5^-67
+    0xd7adf884aa879177, 0x5b0ed81dcc6abb0f, // 5^-66
+    0x86ccbb52ea94baea, 0x98e947129fc2b4e9, // 5^-65
+    0xa87fea27a539e9a5, 0x3f2398d747b36224, // 5^-64
+    0xd29fe4b18e88640e, 0x8eec7f0d19a03aad, // 5^-63
+    0x83a3eeeef9153e89, 0x1953cf68300424ac, // 5^-62
+    0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7, // 5^-61
+    0xcdb02555653131b6, 0x3792f412cb06794d, // 5^-60
+    0x808e17555f3ebf11, 0xe2bbd88bbee40bd0, // 5^-59
+    0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, // 5^-58
+    0xc8de047564d20a8b, 0xf245825a5a445275, // 5^-57
+    0xfb158592be068d2e, 0xeed6e2f0f0d56712, // 5^-56
+    0x9ced737bb6c4183d, 0x55464dd69685606b, // 5^-55
+    0xc428d05aa4751e4c, 0xaa97e14c3c26b886, // 5^-54
+    0xf53304714d9265df, 0xd53dd99f4b3066a8, // 5^-53
+    0x993fe2c6d07b7fab, 0xe546a8038efe4029, // 5^-52
+    0xbf8fdb78849a5f96, 0xde98520472bdd033, // 5^-51
+    0xef73d256a5c0f77c, 0x963e66858f6d4440, // 5^-50
+    0x95a8637627989aad, 0xdde7001379a44aa8, // 5^-49
+    0xbb127c53b17ec159, 0x5560c018580d5d52, // 5^-48
+    0xe9d71b689dde71af, 0xaab8f01e6e10b4a6, // 5^-47
+    0x9226712162ab070d, 0xcab3961304ca70e8, // 5^-46
+    0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22, // 5^-45
+    0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, // 5^-44
+    0x8eb98a7a9a5b04e3, 0x77f3608e92adb242, // 5^-43
+    0xb267ed1940f1c61c, 0x55f038b237591ed3, // 5^-42
+    0xdf01e85f912e37a3, 0x6b6c46dec52f6688, // 5^-41
+    0x8b61313bbabce2c6, 0x2323ac4b3b3da015, // 5^-40
+    0xae397d8aa96c1b77, 0xabec975e0a0d081a, // 5^-39
+    0xd9c7dced53c72255, 0x96e7bd358c904a21, // 5^-38
+    0x881cea14545c7575, 0x7e50d64177da2e54, // 5^-37
+    0xaa242499697392d2, 0xdde50bd1d5d0b9e9, // 5^-36
+    0xd4ad2dbfc3d07787, 0x955e4ec64b44e864, // 5^-35
+    0x84ec3c97da624ab4, 0xbd5af13bef0b113e, // 5^-34
+    0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e, // 5^-33
+    0xcfb11ead453994ba, 0x67de18eda5814af2, // 5^-32
+    0x81ceb32c4b43fcf4, 0x80eacf948770ced7, // 5^-31
+    0xa2425ff75e14fc31, 0xa1258379a94d028d, // 5^-30
+    0xcad2f7f5359a3b3e, 0x096ee45813a04330, // 5^-29
+    0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, // 5^-28
+    0x9e74d1b791e07e48, 0x775ea264cf55347e, // 5^-27
+    0xc612062576589dda, 0x95364afe032a819e, // 5^-26
+    0xf79687aed3eec551, 0x3a83ddbd83f52205, // 5^-25
+    0x9abe14cd44753b52, 0xc4926a9672793543, // 5^-24
+    0xc16d9a0095928a27, 0x75b7053c0f178294, // 5^-23
+    0xf1c90080baf72cb1, 0x5324c68b12dd6339, // 5^-22
+    0x971da05074da7bee, 0xd3f6fc16ebca5e04, // 5^-21
+    0xbce5086492111aea, 0x88f4bb1ca6bcf585, // 5^-20
+    0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6, // 5^-19
+    0x9392ee8e921d5d07, 0x3aff322e62439fd0, // 5^-18
+    0xb877aa3236a4b449, 0x09befeb9fad487c3, // 5^-17
+    0xe69594bec44de15b, 0x4c2ebe687989a9b4, // 5^-16
+    0x901d7cf73ab0acd9, 0x0f9d37014bf60a11, // 5^-15
+    0xb424dc35095cd80f, 0x538484c19ef38c95, // 5^-14
+    0xe12e13424bb40e13, 0x2865a5f206b06fba, // 5^-13
+    0x8cbccc096f5088cb, 0xf93f87b7442e45d4, // 5^-12
+    0xafebff0bcb24aafe, 0xf78f69a51539d749, // 5^-11
+    0xdbe6fecebdedd5be, 0xb573440e5a884d1c, // 5^-10
+    0x89705f4136b4a597, 0x31680a88f8953031, // 5^-9
+    0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, // 5^-8
+    0xd6bf94d5e57a42bc, 0x3d32907604691b4d, // 5^-7
+    0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, // 5^-6
+    0xa7c5ac471b478423, 0x0fcf80dc33721d54, // 5^-5
+    0xd1b71758e219652b, 0xd3c36113404ea4a9, // 5^-4
+    0x83126e978d4fdf3b, 0x645a1cac083126ea, // 5^-3
+    0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, // 5^-2
+    0xcccccccccccccccc, 0xcccccccccccccccd, // 5^-1
+    0x8000000000000000, 0x0000000000000000, // 5^0
+    0xa000000000000000, 0x0000000000000000, // 5^1
+    0xc800000000000000, 0x0000000000000000, // 5^2
+    0xfa00000000000000, 0x0000000000000000, // 5^3
+    0x9c40000000000000, 0x0000000000000000, // 5^4
+    0xc350000000000000, 0x0000000000000000, // 5^5
+    0xf424000000000000, 0x0000000000000000, // 5^6
+    0x9896800000000000, 0x0000000000000000, // 5^7
+    0xbebc200000000000, 0x0000000000000000, // 5^8
+    0xee6b280000000000, 0x0000000000000000, // 5^9
+    0x9502f90000000000, 0x0000000000000000, // 5^10
+    0xba43b74000000000, 0x0000000000000000, // 5^11
+    0xe8d4a51000000000, 0x0000000000000000, // 5^12
+    0x9184e72a00000000, 0x0000000000000000, // 5^13
+    0xb5e620f480000000, 0x0000000000000000, // 5^14
+    0xe35fa931a0000000, 0x0000000000000000, // 5^15
+    0x8e1bc9bf04000000, 0x0000000000000000, // 5^16
+    0xb1a2bc2ec5000000, 0x0000000000000000, // 5^17
+    0xde0b6b3a76400000, 0x0000000000000000, // 5^18
+    0x8ac7230489e80000, 0x0000000000000000, // 5^19
+    0xad78ebc5ac620000, 0x0000000000000000, // 5^20
+    0xd8d726b7177a8000, 0x0000000000000000, // 5^21
+    0x878678326eac9000, 0x0000000000000000, // 5^22
+    0xa968163f0a57b400, 0x0000000000000000, // 5^23
+    0xd3c21bcecceda100, 0x0000000000000000, // 5^24
+    0x84595161401484a0, 0x0000000000000000, // 5^25
+    0xa56fa5b99019a5c8, 0x0000000000000000, // 5^26
+    0xcecb8f27f4200f3a, 0x0000000000000000, // 5^27
+    0x813f3978f8940984, 0x4000000000000000, // 5^28
+    0xa18f07d736b90be5, 0x5000000000000000, // 5^29
+    0xc9f2c9cd04674ede, 0xa400000000000000, // 5^30
+    0xfc6f7c4045812296, 0x4d00000000000000, // 5^31
+    0x9dc5ada82b70b59d, 0xf020000000000000, // 5^32
+    0xc5371912364ce305, 0x6c28000000000000, // 5^33
+    0xf684df56c3e01bc6, 0xc732000000000000, // 5^34
+    0x9a130b963a6c115c, 0x3c7f400000000000, // 5^35
+    0xc097ce7bc90715b3, 0x4b9f100000000000, // 5^36
+    0xf0bdc21abb48db20, 0x1e86d40000000000, // 5^37
+    0x96769950b50d88f4, 0x1314448000000000, // 5^38
+    0xbc143fa4e250eb31, 0x17d955a000000000, // 5^39
+    0xeb194f8e1ae525fd, 0x5dcfab0800000000, // 5^40
+    0x92efd1b8d0cf37be, 0x5aa1cae500000000, // 5^41
+    0xb7abc627050305ad, 0xf14a3d9e40000000, // 5^42
+    0xe596b7b0c643c719, 0x6d9ccd05d0000000, // 5^43
+    0x8f7e32ce7bea5c6f, 0xe4820023a2000000, // 5^44
+    0xb35dbf821ae4f38b, 0xdda2802c8a800000, // 5^45
+    0xe0352f62a19e306e, 0xd50b2037ad200000, // 5^46
+    0x8c213d9da502de45, 0x4526f422cc340000, // 5^47
+    0xaf298d050e4395d6, 0x9670b12b7f410000, // 5^48
+    0xdaf3f04651d47b4c, 0x3c0cdd765f114000, // 5^49
+    0x88d8762bf324cd0f, 0xa5880a69fb6ac800, // 5^50
+    0xab0e93b6efee0053, 0x8eea0d047a457a00, // 5^51
+    0xd5d238a4abe98068, 0x72a4904598d6d880, // 5^52
+    0x85a36366eb71f041, 0x47a6da2b7f864750, // 5^53
+    0xa70c3c40a64e6c51, 0x999090b65f67d924, // 5^54
+    0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d, // 5^55
+    0x82818f1281ed449f, 0xbff8f10e7a8921a4, // 5^56
+    0xa321f2d7226895c7, 0xaff72d52192b6a0d, // 5^57
+    0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490, // 5^58
+    0xfee50b7025c36a08, 0x02f236d04753d5b4, // 5^59
+    0x9f4f2726179a2245, 0x01d762422c946590, // 5^60
+    0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5, // 5^61
+    0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2, // 5^62
+    0x9b934c3b330c8577, 0x63cc55f49f88eb2f, // 5^63
+    0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, // 5^64
+    0xf316271c7fc3908a, 0x8bef464e3945ef7a, // 5^65
+    0x97edd871cfda3a56, 0x97758bf0e3cbb5ac, // 5^66
+    0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317, // 5^67
+    0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd, // 5^68
+    0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a, // 5^69
+    0xb975d6b6ee39e436, 0xb3e2fd538e122b44, // 5^70
+    0xe7d34c64a9c85d44, 0x60dbbca87196b616, // 5^71
+    0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd, // 5^72
+    0xb51d13aea4a488dd, 0x6babab6398bdbe41, // 5^73
+    0xe264589a4dcdab14, 0xc696963c7eed2dd1, // 5^74
+    0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2, // 5^75
+    0xb0de65388cc8ada8, 0x3b25a55f43294bcb, // 5^76
+    0xdd15fe86affad912, 0x49ef0eb713f39ebe, // 5^77
+    0x8a2dbf142dfcc7ab, 0x6e3569326c784337, // 5^78
+    0xacb92ed9397bf996, 0x49c2c37f07965404, // 5^79
+    0xd7e77a8f87daf7fb, 0xdc33745ec97be906, // 5^80
+    0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3, // 5^81
+    0xa8acd7c0222311bc, 0xc40832ea0d68ce0c, // 5^82
+    0xd2d80db02aabd62b, 0xf50a3fa490c30190, // 5^83
+    0x83c7088e1aab65db, 0x792667c6da79e0fa, // 5^84
+    0xa4b8cab1a1563f52, 0x577001b891185938, // 5^85
+    0xcde6fd5e09abcf26, 0xed4c0226b55e6f86, // 5^86
+    0x80b05e5ac60b6178, 0x544f8158315b05b4, // 5^87
+    0xa0dc75f1778e39d6, 0x696361ae3db1c721, // 5^88
+    0xc913936dd571c84c, 0x03bc3a19cd1e38e9, // 5^89
+    0xfb5878494ace3a5f, 0x04ab48a04065c723, // 5^90
+    0x9d174b2dcec0e47b, 0x62eb0d64283f9c76, // 5^91
+    0xc45d1df942711d9a, 0x3ba5d0bd324f8394, // 5^92
+    0xf5746577930d6500, 0xca8f44ec7ee36479, // 5^93
+    0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb, // 5^94
+    0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e, // 5^95
+    0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, // 5^96
+    0x95d04aee3b80ece5, 0xbba1f1d158724a12, // 5^97
+    0xbb445da9ca61281f, 0x2a8a6e45ae8edc97, // 5^98
+    0xea1575143cf97226, 0xf52d09d71a3293bd, // 5^99
+    0x924d692ca61be758, 0x593c2626705f9c56, // 5^100
+    0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c, // 5^101
+    0xe498f455c38b997a, 0x0b6dfb9c0f956447, // 5^102
+    0x8edf98b59a373fec, 0x4724bd4189bd5eac, // 5^103
+    0xb2977ee300c50fe7, 0x58edec91ec2cb657, // 5^104
+    0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed, // 5^105
+    0x8b865b215899f46c, 0xbd79e0d20082ee74, // 5^106
+    0xae67f1e9aec07187, 0xecd8590680a3aa11, // 5^107
+    0xda01ee641a708de9, 0xe80e6f4820cc9495, // 5^108
+    0x884134fe908658b2, 0x3109058d147fdcdd, // 5^109
+    0xaa51823e34a7eede, 0xbd4b46f0599fd415, // 5^110
+    0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a, // 5^111
+    0x850fadc09923329e, 0x03e2cf6bc604ddb0, // 5^112
+    0xa6539930bf6bff45, 0x84db8346b786151c, // 5^113
+    0xcfe87f7cef46ff16, 0xe612641865679a63, // 5^114
+    0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e, // 5^115
+    0xa26da3999aef7749, 0xe3be5e330f38f09d, // 5^116
+    0xcb090c8001ab551c, 0x5cadf5bfd3072cc5, // 5^117
+    0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6, // 5^118
+    0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa, // 5^119
+    0xc646d63501a1511d, 0xb281e1fd541501b8, // 5^120
+    0xf7d88bc24209a565, 0x1f225a7ca91a4226, // 5^121
+    0x9ae757596946075f, 0x3375788de9b06958, // 5^122
+    0xc1a12d2fc3978937, 0x0052d6b1641c83ae, // 5^123
+    0xf209787bb47d6b84, 0xc0678c5dbd23a49a, // 5^124
+    0x9745eb4d50ce6332, 0xf840b7ba963646e0, // 5^125
+    0xbd176620a501fbff, 0xb650e5a93bc3d898, // 5^126
+    0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe, // 5^127
+    0x93ba47c980e98cdf, 0xc66f336c36b10137, // 5^128
+    0xb8a8d9bbe123f017, 0xb80b0047445d4184, // 5^129
+    0xe6d3102ad96cec1d, 0xa60dc059157491e5, // 5^130
+    0x9043ea1ac7e41392, 0x87c89837ad68db2f, // 5^131
+    0xb454e4a179dd1877, 0x29babe4598c311fb, // 5^132
+    0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a, // 5^133
+    0x8ce2529e2734bb1d, 0x1899e4a65f58660c, // 5^134
+    0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f, // 5^135
+    0xdc21a1171d42645d, 0x76707543f4fa1f73, // 5^136
+    0x899504ae72497eba, 0x6a06494a791c53a8, // 5^137
+    0xabfa45da0edbde69, 0x0487db9d17636892, // 5^138
+    0xd6f8d7509292d603, 0x45a9d2845d3c42b6, // 5^139
+    0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2, // 5^140
+    0xa7f26836f282b732, 0x8e6cac7768d7141e, // 5^141
+    0xd1ef0244af2364ff, 0x3207d795430cd926, // 5^142
+    0x8335616aed761f1f, 0x7f44e6bd49e807b8, // 5^143
+    0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, // 5^144
+    0xcd036837130890a1, 0x36dba887c37a8c0f, // 5^145
+    0x802221226be55a64, 0xc2494954da2c9789, // 5^146
+    0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c, // 5^147
+    0xc83553c5c8965d3d, 0x6f92829494e5acc7, // 5^148
+    0xfa42a8b73abbf48c, 0xcb772339ba1f17f9, // 5^149
+    0x9c69a97284b578d7, 0xff2a760414536efb, // 5^150
+    0xc38413cf25e2d70d, 0xfef5138519684aba, // 5^151
+    0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, // 5^152
+    0x98bf2f79d5993802, 0xef2f773ffbd97a61, // 5^153
+    0xbeeefb584aff8603, 0xaafb550ffacfd8fa, // 5^154
+    0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38, // 5^155
+    0x952ab45cfa97a0b2, 0xdd945a747bf26183, // 5^156
+    0xba756174393d88df, 0x94f971119aeef9e4, // 5^157
+    0xe912b9d1478ceb17, 0x7a37cd5601aab85d, // 5^158
+    0x91abb422ccb812ee, 0xac62e055c10ab33a, // 5^159
+    0xb616a12b7fe617aa, 0x577b986b314d6009, // 5^160
+    0xe39c49765fdf9d94, 0xed5a7e85fda0b80b, // 5^161
+    0x8e41ade9fbebc27d, 0x14588f13be847307, // 5^162
+    0xb1d219647ae6b31c, 0x596eb2d8ae258fc8, // 5^163
+    0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb, // 5^164
+    0x8aec23d680043bee, 0x25de7bb9480d5854, // 5^165
+    0xada72ccc20054ae9, 0xaf561aa79a10ae6a, // 5^166
+    0xd910f7ff28069da4, 0x1b2ba1518094da04, // 5^167
+    0x87aa9aff79042286, 0x90fb44d2f05d0842, // 5^168
+    0xa99541bf57452b28, 0x353a1607ac744a53, // 5^169
+    0xd3fa922f2d1675f2, 0x42889b8997915ce8, // 5^170
+    0x847c9b5d7c2e09b7, 0x69956135febada11, // 5^171
+    0xa59bc234db398c25, 0x43fab9837e699095, // 5^172
+    0xcf02b2c21207ef2e, 0x94f967e45e03f4bb, // 5^173
+    0x8161afb94b44f57d, 0x1d1be0eebac278f5, // 5^174
+    0xa1ba1ba79e1632dc, 0x6462d92a69731732, // 5^175
+    0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, // 5^176
+    0xfcb2cb35e702af78, 0x5cda735244c3d43e, // 5^177
+    0x9defbf01b061adab, 0x3a0888136afa64a7, // 5^178
+    0xc56baec21c7a1916, 0x088aaa1845b8fdd0, // 5^179
+    0xf6c69a72a3989f5b, 0x8aad549e57273d45, // 5^180
+    0x9a3c2087a63f6399, 0x36ac54e2f678864b, // 5^181
+    0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd, // 5^182
+    0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5, // 5^183
+    0x969eb7c47859e743, 0x9f644ae5a4b1b325, // 5^184
+    0xbc4665b596706114, 0x873d5d9f0dde1fee, // 5^185
+    0xeb57ff22fc0c7959, 0xa90cb506d155a7ea, // 5^186
+    0x9316ff75dd87cbd8, 0x09a7f12442d588f2, // 5^187
+    0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f, // 5^188
+    0xe5d3ef282a242e81, 0x8f1668c8a86da5fa, // 5^189
+    0x8fa475791a569d10, 0xf96e017d694487bc, // 5^190
+    0xb38d92d760ec4455, 0x37c981dcc395a9ac, // 5^191
+    0xe070f78d3927556a, 0x85bbe253f47b1417, // 5^192
+    0x8c469ab843b89562, 0x93956d7478ccec8e, // 5^193
+    0xaf58416654a6babb, 0x387ac8d1970027b2, // 5^194
+    0xdb2e51bfe9d0696a, 0x06997b05fcc0319e, // 5^195
+    0x88fcf317f22241e2, 0x441fece3bdf81f03, // 5^196
+    0xab3c2fddeeaad25a, 0xd527e81cad7626c3, // 5^197
+    0xd60b3bd56a5586f1, 0x8a71e223d8d3b074, // 5^198
+    0x85c7056562757456, 0xf6872d5667844e49, // 5^199
+    0xa738c6bebb12d16c, 0xb428f8ac016561db, // 5^200
+    0xd106f86e69d785c7, 0xe13336d701beba52, // 5^201
+    0x82a45b450226b39c, 0xecc0024661173473, // 5^202
+    0xa34d721642b06084, 0x27f002d7f95d0190, // 5^203
+    0xcc20ce9bd35c78a5, 0x31ec038df7b441f4, // 5^204
+    0xff290242c83396ce, 0x7e67047175a15271, // 5^205
+    0x9f79a169bd203e41, 0x0f0062c6e984d386, // 5^206
+    0xc75809c42c684dd1, 0x52c07b78a3e60868, // 5^207
+    0xf92e0c3537826145, 0xa7709a56ccdf8a82, // 5^208
+    0x9bbcc7a142b17ccb, 0x88a66076400bb691, // 5^209
+    0xc2abf989935ddbfe, 0x6acff893d00ea435, // 5^210
+    0xf356f7ebf83552fe, 0x0583f6b8c4124d43, // 5^211
+    0x98165af37b2153de, 0xc3727a337a8b704a, // 5^212
+    0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c, // 5^213
+    0xeda2ee1c7064130c, 0x1162def06f79df73, // 5^214
+    0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8, // 5^215
+    0xb9a74a0637ce2ee1, 0x6d953e2bd7173692, // 5^216
+    0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437, // 5^217
+    0x910ab1d4db9914a0, 0x1d9c9892400a22a2, // 5^218
+    0xb54d5e4a127f59c8, 0x2503beb6d00cab4b, // 5^219
+    0xe2a0b5dc971f303a, 0x2e44ae64840fd61d, // 5^220
+    0x8da471a9de737e24, 0x5ceaecfed289e5d2, // 5^221
+    0xb10d8e1456105dad, 0x7425a83e872c5f47, // 5^222
+    0xdd50f1996b947518, 0xd12f124e28f77719, // 5^223
+    0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, // 5^224
+    0xace73cbfdc0bfb7b, 0x636cc64d1001550b, // 5^225
+    0xd8210befd30efa5a, 0x3c47f7e05401aa4e, // 5^226
+    0x8714a775e3e95c78, 0x65acfaec34810a71, // 5^227
+    0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, // 5^228
+    0xd31045a8341ca07c, 0x1ede48111209a050, // 5^229
+    0x83ea2b892091e44d, 0x934aed0aab460432, // 5^230
+    0xa4e4b66b68b65d60, 0xf81da84d5617853f, // 5^231
+    0xce1de40642e3f4b9, 0x36251260ab9d668e, // 5^232
+    0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019, // 5^233
+    0xa1075a24e4421730, 0xb24cf65b8612f81f, // 5^234
+    0xc94930ae1d529cfc, 0xdee033f26797b627, // 5^235
+    0xfb9b7cd9a4a7443c, 0x169840ef017da3b1, // 5^236
+    0x9d412e0806e88aa5, 0x8e1f289560ee864e, // 5^237
+    0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2, // 5^238
+    0xf5b5d7ec8acb58a2, 0xae10af696774b1db, // 5^239
+    0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, // 5^240
+    0xbff610b0cc6edd3f, 0x17fd090a58d32af3, // 5^241
+    0xeff394dcff8a948e, 0xddfc4b4cef07f5b0, // 5^242
+    0x95f83d0a1fb69cd9, 0x4abdaf101564f98e, // 5^243
+    0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1, // 5^244
+    0xea53df5fd18d5513, 0x84c86189216dc5ed, // 5^245
+    0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4, // 5^246
+    0xb7118682dbb66a77, 0x3fbc8c33221dc2a1, // 5^247
+    0xe4d5e82392a40515, 0x0fabaf3feaa5334a, // 5^248
+    0x8f05b1163ba6832d, 0x29cb4d87f2a7400e, // 5^249
+    0xb2c71d5bca9023f8, 0x743e20e9ef511012, // 5^250
+    0xdf78e4b2bd342cf6, 0x914da9246b255416, // 5^251
+    0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e, // 5^252
+    0xae9672aba3d0c320, 0xa184ac2473b529b1, // 5^253
+    0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e, // 5^254
+    0x8865899617fb1871, 0x7e2fa67c7a658892, // 5^255
+    0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, // 5^256
+    0xd51ea6fa85785631, 0x552a74227f3ea565, // 5^257
+    0x8533285c936b35de, 0xd53a88958f87275f, // 5^258
+    0xa67ff273b8460356, 0x8a892abaf368f137, // 5^259
+    0xd01fef10a657842c, 0x2d2b7569b0432d85, // 5^260
+    0x8213f56a67f6b29b, 0x9c3b29620e29fc73, // 5^261
+    0xa298f2c501f45f42, 0x8349f3ba91b47b8f, // 5^262
+    0xcb3f2f7642717713, 0x241c70a936219a73, // 5^263
+    0xfe0efb53d30dd4d7, 0xed238cd383aa0110, // 5^264
+    0x9ec95d1463e8a506, 0xf4363804324a40aa, // 5^265
+    0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, // 5^266
+    0xf81aa16fdc1b81da, 0xdd94b7868e94050a, // 5^267
+    0x9b10a4e5e9913128, 0xca7cf2b4191c8326, // 5^268
+    0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0, // 5^269
+    0xf24a01a73cf2dccf, 0xbc633b39673c8cec, // 5^270
+    0x976e41088617ca01, 0xd5be0503e085d813, // 5^271
+    0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18, // 5^272
+    0xec9c459d51852ba2, 0xddf8e7d60ed1219e, // 5^273
+    0x93e1ab8252f33b45, 0xcabb90e5c942b503, // 5^274
+    0xb8da1662e7b00a17, 0x3d6a751f3b936243, // 5^275
+    0xe7109bfba19c0c9d, 0x0cc512670a783ad4, // 5^276
+    0x906a617d450187e2, 0x27fb2b80668b24c5, // 5^277
+    0xb484f9dc9641e9da, 0xb1f9f660802dedf6, // 5^278
+    0xe1a63853bbd26451, 0x5e7873f8a0396973, // 5^279
+    0x8d07e33455637eb2, 0xdb0b487b6423e1e8, // 5^280
+    0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62, // 5^281
+    0xdc5c5301c56b75f7, 0x7641a140cc7810fb, // 5^282
+    0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d, // 5^283
+    0xac2820d9623bf429, 0x546345fa9fbdcd44, // 5^284
+    0xd732290fbacaf133, 0xa97c177947ad4095, // 5^285
+    0x867f59a9d4bed6c0, 0x49ed8eabcccc485d, // 5^286
+    0xa81f301449ee8c70, 0x5c68f256bfff5a74, // 5^287
+    0xd226fc195c6a2f8c, 0x73832eec6fff3111, // 5^288
+    0x83585d8fd9c25db7, 0xc831fd53c5ff7eab, // 5^289
+    0xa42e74f3d032f525, 0xba3e7ca8b77f5e55, // 5^290
+    0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb, // 5^291
+    0x80444b5e7aa7cf85, 0x7980d163cf5b81b3, // 5^292
+    0xa0555e361951c366, 0xd7e105bcc332621f, // 5^293
+    0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7, // 5^294
+    0xfa856334878fc150, 0xb14f98f6f0feb951, // 5^295
+    0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3, // 5^296
+    0xc3b8358109e84f07, 0x0a862f80ec4700c8, // 5^297
+    0xf4a642e14c6262c8, 0xcd27bb612758c0fa, // 5^298
+    0x98e7e9cccfbd7dbd, 0x8038d51cb897789c, // 5^299
+    0xbf21e44003acdd2c, 0xe0470a63e6bd56c3, // 5^300
+    0xeeea5d5004981478, 0x1858ccfce06cac74, // 5^301
+    0x95527a5202df0ccb, 0x0f37801e0c43ebc8, // 5^302
+    0xbaa718e68396cffd, 0xd30560258f54e6ba, // 5^303
+    0xe950df20247c83fd, 0x47c6b82ef32a2069, // 5^304
+    0x91d28b7416cdd27e, 0x4cdc331d57fa5441, // 5^305
+    0xb6472e511c81471d, 0xe0133fe4adf8e952, // 5^306
+    0xe3d8f9e563a198e5, 0x58180fddd97723a6, // 5^307
+    0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648, // 5^308
 };
 
+}
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
-struct AnySpace {
-    constexpr AnySpace() = default;
+namespace prs {
 
-    friend constexpr bool operator==(AnySpace const& range, char c) noexcept {
-        return std::isspace(c);
+enum class NumberFormat {
+    General, // the grammar of std::from_chars: leading zeros, ".5", "5.", inf, nan
+    Json     // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, the longest matching prefix is taken
+};
+
+/**
+ * Exact decimal number mantissa * 10^-scale, 1.50 and 1.5 are different representations
+ */
+template <std::integral Mantissa = int64_t>
+struct Decimal {
+    Mantissa mantissa = 0;
+    size_t scale = 0;
+
+    bool operator==(Decimal const&) const noexcept = default;
+
+    template <std::floating_point T = double>
+    T to() const noexcept {
+        T power = 1;
+        for (size_t i = 0; i != scale; ++i) {
+            power *= 10;
+        }
+        return static_cast<T>(mantissa) / power;
     }
 };
 
+namespace details {
 
-template <typename T, typename U>
-concept LeftCmpWith = requires(const std::remove_reference_t<T>& t,
-        const std::remove_reference_t<U>& u) {
-    {t == u} -> std::convertible_to<bool>; // boolean-testable
-};
+template <typename Number, typename = std::void_t<>>
+constexpr bool hasFromChars = false;
 
+template <typename Number>
+constexpr bool hasFromChars<Number, std::void_t<decltype(std::from_chars(nullptr, nullptr, std::declval<Number&>()))>> = true;
 
-template <typename StringType = std::string_view, LeftCmpWith<char> ...Args>
-auto lettersFrom(Args ...args) noexcept {
-    static_assert(sizeof...(args) > 0);
-    return make_parser([args...](Stream& str) {
-        auto start = str.pos();
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
 
-        auto end = str.pos();
-        return Parser<StringType>::data(StringType{str.get_sv(start, end)});
-    });
+constexpr bool isDigit(char c) noexcept {
+    return static_cast<unsigned char>(c - '0') < 10;
 }
 
+/**
+ * 8 bytes as a little-endian word
+ */
+inline uint64_t loadEightBytes(char const* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if constexpr (std::endian::native == std::endian::big) {
+        uint64_t out = 0;
+        for (size_t i = 0; i != sizeof(v); ++i) {
+            out = (out << 8) | ((v >> (8 * i)) & 0xFF);
+        }
+        v = out;
+    }
+    return v;
+}
 
-template <auto ...args>
-constexpr auto lettersFrom() noexcept {
-    static_assert(sizeof...(args) > 0);
-    using T = std::string_view;
-    return make_parser([](Stream& str) {
-        auto start = str.pos();
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
+constexpr bool isEightDigits(uint64_t v) noexcept {
+    return (((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333);
+}
 
-        auto end = str.pos();
-        return Parser<T>::data(str.get_sv(start, end));
-    });
+/**
+ * SWAR conversion of 8 ASCII digits: pairs, then quads, then the whole word, 3 multiplications
+ */
+constexpr uint32_t parseEightDigits(uint64_t v) noexcept {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    constexpr uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(v);
 }
 
+/**
+ * Consume all digits, w accumulates them modulo 2^64
+ */
+inline char const* accumulateDigits(char const* p, char const* last, uint64_t& w) noexcept {
+    while (last - p >= 8) {
+        auto const v = loadEightBytes(p);
+        if (!isEightDigits(v)) {
+            break;
+        }
+        w = w * 100000000 + parseEightDigits(v);
+        p += 8;
+    }
+    while (p != last && isDigit(*p)) {
+        w = w * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
 
-template <LeftCmpWith<char> ...Args>
-auto skipChars(Args ...args) noexcept {
-    static_assert(sizeof...(args) > 0);
-    return make_parser([args...](Stream& str) {
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
 
-        return Parser<Drop>::data({});
-    });
+/**
+ * value = +-acc if it fits T
+ */
+template <std::integral T>
+constexpr bool narrowTo(uint64_t acc, bool negative, T& value) noexcept {
+    using U = std::make_unsigned_t<T>;
+    uint64_t const maxValue = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    if (acc > maxValue) {
+        return false;
+    }
+    value = static_cast<T>(negative ? static_cast<U>(0 - acc) : static_cast<U>(acc));
+    return true;
 }
 
+/**
+ * Integer with the semantic of std::from_chars (base 10), for all platforms
+ */
+template <NumberFormat format = NumberFormat::General, std::integral T>
+    requires(!std::is_same_v<T, bool>)
+std::from_chars_result parseInteger(char const* first, char const* last, T& value) noexcept {
+    char const* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
 
-template <auto ...args>
-auto skipChars() noexcept {
-    static_assert(sizeof...(args) > 0);
-    return make_parser([](Stream& str) {
-        while (str.checkFirst([&](char c) {
-            return ((args == c) || ...);
-        }));
+    char const* const digitsStart = p;
+    char const* end = p;
+    if (format == NumberFormat::Json && end != last && *end == '0') {
+        ++end;
+    } else {
+        while (last - end >= 8 && isEightDigits(loadEightBytes(end))) {
+            end += 8;
+        }
+        while (end != last && isDigit(*end)) {
+            ++end;
+        }
+    }
+    if (end == digitsStart) {
+        return {first, std::errc::invalid_argument};
+    }
 
-        return Parser<Drop>::data({});
-    });
-}
+    while (p != end && *p == '0') {
+        ++p;
+    }
 
+    constexpr size_t MAX_SAFE_DIGITS = 19;
+    size_t const n = static_cast<size_t>(end - p);
+    if (n > MAX_SAFE_DIGITS + 1) {
+        return {end, std::errc::result_out_of_range};
+    }
 
-template <bool forwardSearch = false>
-auto searchText(std::string const& searchPattern) noexcept {
-    return Parser<Unit>::make([searchPattern](Stream& stream) {
-        auto &str = stream.sv();
-        if (auto pos = str.find(searchPattern); pos != std::string_view::npos) {
-            if constexpr (forwardSearch) {
-                stream.move(pos);
-                return Parser<Unit>::data({});
-            } else {
-                str = str.substr(pos + searchPattern.size());
-                return Parser<Unit>::data({});
-            }
-        } else {
-            return Parser<Unit>::PRS_MAKE_ERROR("Cannot find '" + std::string(searchPattern) + "'", stream.pos());
+    uint64_t acc = 0;
+    char const* const safeEnd = p + std::min(n, MAX_SAFE_DIGITS);
+    for (; safeEnd - p >= 8; p += 8) {
+        acc = acc * 100000000 + parseEightDigits(loadEightBytes(p));
+    }
+    for (; p != safeEnd; ++p) {
+        acc = acc * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if (n == MAX_SAFE_DIGITS + 1) {
+        auto const lastDigit = static_cast<uint64_t>(*p - '0');
+        if (acc > (std::numeric_limits<uint64_t>::max() - lastDigit) / 10) {
+            return {end, std::errc::result_out_of_range};
         }
-    });
+        acc = acc * 10 + lastDigit;
+    }
+
+    return {end, narrowTo(acc, negative, value) ? std::errc{} : std::errc::result_out_of_range};
 }
 
 
-template <ConstexprString searchPattern, bool forwardSearch = false>
-auto searchText() noexcept {
-    return Parser<Unit>::make([](Stream& stream) {
-        auto &str = stream.sv();
-        if (auto pos = str.find(searchPattern.sv()); pos != std::string_view::npos) {
-            if constexpr (forwardSearch) {
-                stream.move(pos);
-                return Parser<Unit>::data({});
-            } else {
-                str = str.substr(pos + searchPattern.size());
-                return Parser<Unit>::data({});
-            }
-        } else {
-            return Parser<Unit>::PRS_MAKE_ERROR("Cannot find '" + searchPattern.toString() + "'", stream.pos());
+/**
+ * Exact decimal "-?digits(.digits)?": mantissa and the number of fractional digits.
+ * '.' without digits after it isn't consumed, more than maxScale fractional digits or
+ * a mantissa out of range of Mantissa are result_out_of_range.
+ */
+template <std::integral Mantissa>
+std::from_chars_result parseDecimal(char const* first, char const* last, size_t maxScale,
+                                    Mantissa& mantissa, size_t& scale) noexcept {
+    char const* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<Mantissa>) {
+        if (p != last && *p == '-') {
+            negative = true;
+            ++p;
         }
-    });
-}
+    }
 
+    uint64_t acc = 0;
+    char const* const intStart = p;
+    char const* const intEnd = accumulateDigits(intStart, last, acc);
+    if (intEnd == intStart) {
+        return {first, std::errc::invalid_argument};
+    }
+    char const* fracStart = intEnd;
+    char const* fracEnd = intEnd;
+    if (intEnd != last && *intEnd == '.' && intEnd + 1 != last && isDigit(intEnd[1])) {
+        fracStart = intEnd + 1;
+        fracEnd = accumulateDigits(fracStart, last, acc);
+    }
+    scale = static_cast<size_t>(fracEnd - fracStart);
+    if (scale > maxScale) {
+        return {fracEnd, std::errc::result_out_of_range};
+    }
 
-template <LeftCmpWith<char> ...Args>
-constexpr auto charFrom(Args ...chars) noexcept {
-    return satisfy([=](char c) {
-        return details::cmpAnyOf(c, chars...);
-    });
+    constexpr size_t MAX_SAFE_DIGITS = 19;
+    if (static_cast<size_t>(fracEnd - intStart) > MAX_SAFE_DIGITS) {
+        // acc may have wrapped, the slow exact path
+        auto exact = [&acc](char const* d, char const* end) {
+            for (; d != end; ++d) {
+                auto const digit = static_cast<uint64_t>(*d - '0');
+                if (acc > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+                    return false;
+                }
+                acc = acc * 10 + digit;
+            }
+            return true;
+        };
+        acc = 0;
+        if (!exact(intStart, intEnd) || !exact(fracStart, fracEnd)) {
+            return {fracEnd, std::errc::result_out_of_range};
+        }
+    }
+    return {fracEnd, narrowTo(acc, negative, mantissa) ? std::errc{} : std::errc::result_out_of_range};
 }
 
-
-template <auto ...chars>
-constexpr auto charFrom() noexcept {
-    return satisfy([](char c) {
-        return details::cmpAnyOf(c, chars...);
-    });
+/**
+ * value * 10^power if it fits T
+ */
+template <std::integral T>
+constexpr bool scaleUp(T& value, size_t power) noexcept {
+    for (; power != 0; --power) {
+        if (value > std::numeric_limits<T>::max() / 10 || value < std::numeric_limits<T>::min() / 10) {
+            return false;
+        }
+        value *= 10;
+    }
+    return true;
 }
 
+template <typename T>
+struct BinaryFormat;
 
-template <LeftCmpWith<char> ...Args>
-auto charFromSpaces(Args ...chars) noexcept {
-    return spaces() >> charFrom(std::forward<Args>(chars)...) << spaces();
-}
+template <>
+struct BinaryFormat<double> {
+    using Bits = uint64_t;
+    static constexpr int MANTISSA_BITS = 52;
+    static constexpr int MIN_EXPONENT = -1023;
+    static constexpr int INFINITE_POWER = 0x7FF;
+    static constexpr int MIN_ROUND_TO_EVEN = -4;
+    static constexpr int MAX_ROUND_TO_EVEN = 23;
+    static constexpr int SMALLEST_POWER_OF_TEN = -342;
+    static constexpr int LARGEST_POWER_OF_TEN = 308;
+    static constexpr int MAX_EXPONENT_FAST_PATH = 22;
+    static constexpr uint64_t MAX_MANTISSA_FAST_PATH = uint64_t{2} << MANTISSA_BITS;
+    static constexpr double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
 
+template <>
+struct BinaryFormat<float> {
+    using Bits = uint32_t;
+    static constexpr int MANTISSA_BITS = 23;
+    static constexpr int MIN_EXPONENT = -127;
+    static constexpr int INFINITE_POWER = 0xFF;
+    static constexpr int MIN_ROUND_TO_EVEN = -17;
+    static constexpr int MAX_ROUND_TO_EVEN = 10;
+    static constexpr int SMALLEST_POWER_OF_TEN = -64;
+    static constexpr int LARGEST_POWER_OF_TEN = 38;
+    static constexpr int MAX_EXPONENT_FAST_PATH = 10;
+    static constexpr uint64_t MAX_MANTISSA_FAST_PATH = uint64_t{2} << MANTISSA_BITS;
+    static constexpr float POWERS_OF_TEN[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
 
-template <typename StringType = std::string_view>
-auto between(char borderLeft, char borderRight) noexcept {
-    using P = Parser<StringType>;
-    return P::make([borderLeft, borderRight](Stream& stream) {
-        if (stream.checkFirst(borderLeft) == 0) {
-            return P::makeError("No leftBorder", stream.pos());
-        }
+// Clinger's fast path is exact only without extended precision of intermediate results (x87)
+static constexpr bool EXACT_FLOAT_EVAL = FLT_EVAL_METHOD == 0;
 
-        auto start = stream.pos();
-        while (stream.checkFirst([borderRight](char c) {
-            return c != borderRight;
-        }));
 
-        auto ans = stream.full().substr(start, stream.pos() - start);
-        if (stream.checkFirst(borderRight) == 0) {
-            return P::makeError("No rightBorder", stream.pos());
-        }
+struct Value128 {
+    uint64_t low;
+    uint64_t high;
+};
 
-        return P::data(StringType{ans});
-    });
+inline Value128 fullMultiplication(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using UInt128 = unsigned __int128;
+    auto const r = static_cast<UInt128>(a) * b;
+    return {static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64)};
+#else
+    uint64_t const aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    uint64_t const bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    uint64_t const ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    uint64_t const mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return {(mid << 32) | (ll & 0xFFFFFFFF), hh + (lh >> 32) + (hl >> 32) + (mid >> 32)};
+#endif
 }
 
+struct AdjustedMantissa {
+    uint64_t mantissa = 0;
+    int32_t power2 = 0;
 
-template <typename StringType = std::string_view>
-auto between(char border) noexcept {
-    return between<StringType>(border, border);
-}
+    bool operator==(AdjustedMantissa const&) const noexcept = default;
+};
 
+/**
+ * Eisel-Lemire: w * 10^q rounded to the nearest T, the 128-bit product is always sufficient
+ * (Mushtak, Lemire, "Fast number parsing without fallback")
+ */
+template <typename T>
+AdjustedMantissa computeFloat(int64_t q, uint64_t w) noexcept {
+    using F = BinaryFormat<T>;
+    AdjustedMantissa answer;
+    if (w == 0 || q < F::SMALLEST_POWER_OF_TEN) {
+        return answer;
+    }
+    if (q > F::LARGEST_POWER_OF_TEN) {
+        answer.power2 = F::INFINITE_POWER;
+        return answer;
+    }
+
+    int const lz = std::countl_zero(w);
+    w <<= lz;
+
+    auto const index = 2 * static_cast<size_t>(q - SMALLEST_POWER_OF_FIVE);
+    Value128 product = fullMultiplication(w, POWER_OF_FIVE_128[index]);
+    constexpr uint64_t precisionMask = std::numeric_limits<uint64_t>::max() >> (F::MANTISSA_BITS + 3);
+    if ((product.high & precisionMask) == precisionMask) {
+        Value128 const second = fullMultiplication(w, POWER_OF_FIVE_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            ++product.high;
+        }
+    }
 
-template <ParserType Parser>
-auto between(char borderLeft, char borderRight, Parser parser) noexcept {
-    return charFrom(borderLeft) >> parser << charFrom(borderRight);
-}
+    int const upperBit = static_cast<int>(product.high >> 63);
+    int const shift = upperBit + 64 - F::MANTISSA_BITS - 3;
+    answer.mantissa = product.high >> shift;
+    int32_t const power = static_cast<int32_t>((((152170 + 65536) * q) >> 16) + 63); // floor(q * log2(10)) + 63
+    answer.power2 = power + upperBit - lz - F::MIN_EXPONENT;
 
+    if (answer.power2 <= 0) { // subnormal
+        if (-answer.power2 + 1 >= 64) {
+            return AdjustedMantissa{};
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (uint64_t{1} << F::MANTISSA_BITS) ? 0 : 1;
+        return answer;
+    }
 
-template <typename StringType = std::string_view, std::predicate<char> Fn>
-auto until(Fn fn) noexcept {
-    return Parser<StringType>::make([fn](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !fn(c);
-        }));
+    // exactly between two floats: round to even
+    if (product.low <= 1 && q >= F::MIN_ROUND_TO_EVEN && q <= F::MAX_ROUND_TO_EVEN
+            && (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == product.high) {
+        answer.mantissa &= ~uint64_t{1};
+    }
 
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
-    });
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (uint64_t{2} << F::MANTISSA_BITS)) {
+        answer.mantissa = uint64_t{1} << F::MANTISSA_BITS;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(uint64_t{1} << F::MANTISSA_BITS);
+    if (answer.power2 >= F::INFINITE_POWER) {
+        answer.power2 = F::INFINITE_POWER;
+        answer.mantissa = 0;
+    }
+    return answer;
 }
 
 
-template <typename StringType = std::string_view, std::predicate<char, Stream&> Fn>
-auto until(Fn fn) noexcept {
-    return Parser<StringType>::make([fn](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !fn(c, stream);
-        }));
-
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
-    });
+inline bool startsWithNoCase(char const* p, char const* last, std::string_view word) noexcept {
+    if (static_cast<size_t>(last - p) < word.size()) {
+        return false;
+    }
+    for (size_t i = 0; i != word.size(); ++i) {
+        if ((p[i] | 0x20) != word[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-
-template <typename StringType = std::string_view, typename ...Args>
-auto until(Args ...args) noexcept {
-    return Parser<StringType>::make([args...](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !((args == c) || ...);
-        }));
-
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
-    });
+template <std::floating_point T>
+std::from_chars_result parseInfNan(char const* first, char const* p, char const* last, bool negative, T& value) noexcept {
+    if (startsWithNoCase(p, last, "inf")) {
+        p += 3;
+        if (startsWithNoCase(p, last, "inity")) {
+            p += 5;
+        }
+        value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return {p, std::errc{}};
+    }
+    if (startsWithNoCase(p, last, "nan")) {
+        p += 3;
+        if (p != last && *p == '(') {
+            char const* q = p + 1;
+            while (q != last && (isDigit(*q) || *q == '_' || ('a' <= (*q | 0x20) && (*q | 0x20) <= 'z'))) {
+                ++q;
+            }
+            if (q != last && *q == ')') {
+                p = q + 1;
+            }
+        }
+        value = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+        return {p, std::errc{}};
+    }
+    return {first, std::errc::invalid_argument};
 }
 
+/**
+ * Unsigned integer of fixed capacity for the exact comparisons of the fallback
+ */
+class BigInteger {
+public:
+    // 768 digits times a power of five of the float range with the margin
+    static constexpr size_t LIMBS = 128;
+
+    BigInteger() noexcept = default;
 
-template <auto ...args>
-auto until() noexcept {
-    using StringType = std::string_view;
-    return Parser<StringType>::make([](Stream& stream) {
-        auto start = stream.pos();
-        while (stream.checkFirst([&](char c) {
-            return !((args == c) || ...);
-        }));
+    explicit BigInteger(uint64_t value) noexcept {
+        for (; value != 0; value >>= 32) {
+            m_limbs[m_size++] = static_cast<uint32_t>(value);
+        }
+    }
 
-        auto end = stream.pos();
-        return Parser<StringType>::data(StringType{stream.get_sv(start, end)});
-    });
-}
+    void mulAdd(uint32_t mul, uint32_t add) noexcept {
+        uint64_t carry = add;
+        for (size_t i = 0; i != m_size; ++i) {
+            uint64_t const r = static_cast<uint64_t>(m_limbs[i]) * mul + carry;
+            m_limbs[i] = static_cast<uint32_t>(r);
+            carry = r >> 32;
+        }
+        if (carry != 0) {
+            assert(m_size != LIMBS);
+            m_limbs[m_size++] = static_cast<uint32_t>(carry);
+        }
+    }
 
+    void mulPow5(uint64_t power) noexcept {
+        constexpr uint32_t POW5_13 = 1220703125;
+        for (; power >= 13; power -= 13) {
+            mulAdd(POW5_13, 0);
+        }
+        uint32_t rest = 1;
+        for (; power != 0; --power) {
+            rest *= 5;
+        }
+        mulAdd(rest, 0);
+    }
 
-template <typename StringType = std::string_view>
-auto untilEnd() noexcept {
-    return Parser<StringType>::make([](Stream& stream) {
-        auto out = stream.sv();
-        stream.moveUnsafe(out.size());
-        return Parser<StringType>::data(StringType{out});
-    });
-}
+    void shiftLeft(uint64_t bits) noexcept {
+        if (m_size == 0) {
+            return;
+        }
+        auto const limbs = static_cast<size_t>(bits / 32);
+        auto const shift = static_cast<unsigned>(bits % 32);
+        assert(m_size + limbs + 1 <= LIMBS);
+
+        m_limbs[m_size + limbs] = 0;
+        for (size_t i = m_size; i-- != 0;) {
+            uint64_t const moved = static_cast<uint64_t>(m_limbs[i]) << shift;
+            m_limbs[i + limbs + 1] |= static_cast<uint32_t>(moved >> 32);
+            m_limbs[i + limbs] = static_cast<uint32_t>(moved);
+        }
+        std::fill_n(m_limbs.begin(), limbs, 0);
+        m_size += limbs + 1;
+        while (m_size != 0 && m_limbs[m_size - 1] == 0) {
+            --m_size;
+        }
+    }
 
+    friend int compare(BigInteger const& lhs, BigInteger const& rhs) noexcept {
+        if (lhs.m_size != rhs.m_size) {
+            return lhs.m_size < rhs.m_size ? -1 : 1;
+        }
+        for (size_t i = lhs.m_size; i-- != 0;) {
+            if (lhs.m_limbs[i] != rhs.m_limbs[i]) {
+                return lhs.m_limbs[i] < rhs.m_limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+private:
+    std::array<uint32_t, LIMBS> m_limbs{};
+    size_t m_size = 0;
+};
 
-inline auto nextLine() noexcept {
-    return Parser<Unit>::make([](Stream& stream) {
-        auto sv = stream.sv();
-        for (size_t i = 0; i != sv.size(); ++i) {
-            if (sv[i] == '\n' || sv[i] == '\r') {
-                if (sv[i] == '\r' && (i + 1) < sv.size() && sv[i + 1] == '\n') {
-                    ++i;
-                }
-                stream.moveUnsafe(i);
-                return Parser<Unit>::data({});
+/**
+ * Correctly rounded digits * 10^exponent, used when the first 19 digits don't define the result.
+ * `lower` is the result of the truncated digits, the answer is it or the next float:
+ * the digits are compared exactly with the halfway point between them (fast_float's digit_comp).
+ */
+template <std::floating_point T>
+std::errc fallbackFloat(bool negative, std::string_view intDigits, std::string_view fracDigits, int64_t exponent,
+                        AdjustedMantissa lower, T& value) noexcept {
+    using F = BinaryFormat<T>;
+    // a halfway point has fewer significant digits, the rest only tells that the number is above it
+    constexpr size_t MAX_DIGITS = 768;
+
+    BigInteger digits;
+    size_t count = 0;
+    uint32_t chunk = 0;
+    uint32_t chunkPower = 1;
+    bool truncated = false;
+    for (std::string_view part : {intDigits, fracDigits}) {
+        for (char c : part) {
+            if (count == MAX_DIGITS) {
+                truncated |= c != '0';
+                ++exponent;
+                continue;
+            }
+            if (count == 0 && c == '0') {
+                continue;
+            }
+            ++count;
+            chunk = chunk * 10 + static_cast<uint32_t>(c - '0');
+            chunkPower *= 10;
+            if (chunkPower == 1000000000) {
+                digits.mulAdd(chunkPower, chunk);
+                chunk = 0;
+                chunkPower = 1;
             }
         }
-        stream.sv() = "";
-        return Parser<Unit>::data({}); // return empty view if no new line found
-    });
-}
+    }
+    digits.mulAdd(chunkPower, chunk + (truncated ? 1 : 0));
 
+    // lower = m * 2^e, the halfway point is (2m + 1) * 2^(e - 1)
+    auto bits = static_cast<uint64_t>(lower.mantissa | (static_cast<uint64_t>(lower.power2) << F::MANTISSA_BITS));
+    uint64_t const power2 = bits >> F::MANTISSA_BITS;
+    uint64_t const mantissa = (bits & ((uint64_t{1} << F::MANTISSA_BITS) - 1)) | (power2 != 0 ? uint64_t{1} << F::MANTISSA_BITS : 0);
+    int64_t const halfwayPower2 = static_cast<int64_t>(std::max<uint64_t>(power2, 1)) + F::MIN_EXPONENT - F::MANTISSA_BITS - 1;
 
-template <ParserType Parser>
-auto between(char border, Parser parser) noexcept {
-    return between(border, border, std::move(parser));
+    BigInteger halfway{2 * mantissa + 1};
+
+    // digits * 5^exponent * 2^exponent <=> halfway * 2^halfwayPower2
+    if (exponent >= 0) {
+        digits.mulPow5(static_cast<uint64_t>(exponent));
+    } else {
+        halfway.mulPow5(static_cast<uint64_t>(-exponent));
+    }
+    if (exponent >= halfwayPower2) {
+        digits.shiftLeft(static_cast<uint64_t>(exponent - halfwayPower2));
+    } else {
+        halfway.shiftLeft(static_cast<uint64_t>(halfwayPower2 - exponent));
+    }
+
+    int const order = compare(digits, halfway);
+    bits += order > 0 || (order == 0 && (bits & 1) != 0) ? 1 : 0;
+    if (bits == 0 || (bits >> F::MANTISSA_BITS) >= static_cast<uint64_t>(F::INFINITE_POWER)) {
+        return std::errc::result_out_of_range;
+    }
+
+    if (negative) {
+        bits |= uint64_t{1} << (sizeof(typename F::Bits) * 8 - 1);
+    }
+    value = std::bit_cast<T>(static_cast<typename F::Bits>(bits));
+    return std::errc{};
 }
 
 
-template <typename StringType = std::string_view>
-auto literal(std::string str) noexcept {
-    return Parser<StringType>::make([str](Stream& s) {
-        if (s.sv().starts_with(str)) {
-            s.moveUnsafe(str.size());
-            return Parser<StringType>::data(StringType{str});
-        } else {
-            return Parser<StringType>::makeError("Cannot find literal", s.pos());
+/**
+ * Floating point number with the semantic of std::from_chars (general format) or the JSON grammar:
+ * SWAR digits, Clinger's fast path, Eisel-Lemire, correctly rounded fallback for more than 19 significant digits.
+ * Results that are out of range of T (overflow or underflow to zero) are result_out_of_range.
+ */
+template <NumberFormat format = NumberFormat::General, std::floating_point T>
+    requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+std::from_chars_result parseFloat(char const* first, char const* last, T& value) {
+    using F = BinaryFormat<T>;
+    char const* p = first;
+    bool const negative = p != last && *p == '-';
+    p += negative ? 1 : 0;
+
+    if constexpr (format == NumberFormat::General) {
+        if (p != last && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+            return parseInfNan(first, p, last, negative, value);
         }
-    });
-}
+    }
 
-template <ConstexprString str>
-auto literal() noexcept {
-    using StringType = std::string_view;
-    return Parser<StringType>::make([](Stream& s) {
-        if (s.sv().starts_with(str.sv())) {
-            s.moveUnsafe(str.size());
-            return Parser<StringType>::data(str.sv());
+    uint64_t w = 0;
+    char const* const intStart = p;
+    if (format == NumberFormat::Json && p != last && *p == '0') {
+        ++p;
+    } else {
+        p = accumulateDigits(p, last, w);
+    }
+    char const* const intEnd = p;
+
+    char const* fracStart = p;
+    char const* fracEnd = p;
+    if (p != last && *p == '.') {
+        fracStart = p + 1;
+        fracEnd = accumulateDigits(fracStart, last, w);
+        if (format == NumberFormat::General || fracEnd != fracStart) {
+            p = fracEnd;
         } else {
-            return Parser<StringType>::makeError("Cannot find literal", s.pos());
+            fracStart = fracEnd = intEnd;
         }
-    });
-}
+    }
 
+    size_t digits = static_cast<size_t>((intEnd - intStart) + (fracEnd - fracStart));
+    if (digits == 0 || (format == NumberFormat::Json && intEnd == intStart)) {
+        return {first, std::errc::invalid_argument};
+    }
 
-template <char endSymbol, char escapingSymbol = '\\'>
-auto escapedString() noexcept {
-    if constexpr (endSymbol != escapingSymbol) {
-        return Parser<std::string>::make([](Stream& s) {
-            bool isEscaped = false;
-            const auto sv = s.sv();
-            std::string out;
-            for (size_t i = 0; i != sv.size(); ++i) {
-                switch (sv[i]) {
-                    case escapingSymbol: {
-                        if (std::exchange(isEscaped, !isEscaped)) {
-                            out.push_back(escapingSymbol);
-                        }
-                        break;
-                    }
-                    case endSymbol: {
-                        if (isEscaped) {
-                            isEscaped = false;
-                            out.push_back(endSymbol);
-                        } else {
-                            s.moveUnsafe(i + 1);
-                            return Parser<std::string>::data(std::move(out));
-                        }
-                        break;
-                    }
-                    default: out.push_back(sv[i]);
+    int64_t explicitExponent = 0;
+    if (p != last && (*p | 0x20) == 'e') {
+        char const* q = p + 1;
+        bool expNegative = false;
+        if (q != last && (*q == '+' || *q == '-')) {
+            expNegative = *q == '-';
+            ++q;
+        }
+        if (q != last && isDigit(*q)) {
+            constexpr int64_t EXPONENT_LIMIT = 0x10000000;
+            for (; q != last && isDigit(*q); ++q) {
+                if (explicitExponent < EXPONENT_LIMIT) {
+                    explicitExponent = explicitExponent * 10 + (*q - '0');
                 }
             }
+            explicitExponent = expNegative ? -explicitExponent : explicitExponent;
+            p = q;
+        }
+    }
+    int64_t exponent = explicitExponent - (fracEnd - fracStart);
 
-            return Parser<std::string>::makeError("Cannot find end symbol", s.pos());
-        });
-    } else {
-        return Parser<std::string>::make([](Stream& s) {
-            bool isEscaped = false;
-            const auto sv = s.sv();
-            std::string out;
-            for (size_t i = 0; i != sv.size(); ++i) {
-                if (sv[i] == endSymbol) {
-                    if (isEscaped) {
-                        isEscaped = false;
-                        out.push_back(endSymbol);
-                    } else {
-                        if (i + 1 != sv.size() && sv[i + 1] == endSymbol) {
-                            isEscaped = true;
-                        } else {
-                            s.moveUnsafe(i + 1);
-                            return Parser<std::string>::data(std::move(out));
-                        }
-                    }
-                } else {
-                    out.push_back(sv[i]);
+    constexpr size_t MAX_DIGITS = 19;
+    bool tooManyDigits = false;
+    if (digits > MAX_DIGITS) {
+        for (char const* s = intStart; s != fracEnd && (*s == '0' || *s == '.'); ++s) {
+            digits -= *s == '0' ? 1 : 0;
+        }
+        if (digits > MAX_DIGITS) {
+            // keep the first 19 significant digits, the exponent is corrected to the truncated value
+            tooManyDigits = true;
+            constexpr uint64_t MIN_NINETEEN_DIGITS = 1000000000000000000;
+            w = 0;
+            char const* s = intStart;
+            for (; w < MIN_NINETEEN_DIGITS && s != intEnd; ++s) {
+                w = w * 10 + static_cast<uint64_t>(*s - '0');
+            }
+            if (w >= MIN_NINETEEN_DIGITS) {
+                exponent = (intEnd - s) + explicitExponent;
+            } else {
+                s = fracStart;
+                for (; w < MIN_NINETEEN_DIGITS && s != fracEnd; ++s) {
+                    w = w * 10 + static_cast<uint64_t>(*s - '0');
                 }
+                exponent = (fracStart - s) + explicitExponent;
             }
+        }
+    }
 
-            return Parser<std::string>::makeError("Cannot find end symbol", s.pos());
-        });
+    if (EXACT_FLOAT_EVAL && !tooManyDigits && -F::MAX_EXPONENT_FAST_PATH <= exponent && exponent <= F::MAX_EXPONENT_FAST_PATH
+            && w <= F::MAX_MANTISSA_FAST_PATH) {
+        auto out = static_cast<T>(w);
+        out = exponent < 0 ? out / F::POWERS_OF_TEN[-exponent] : out * F::POWERS_OF_TEN[exponent];
+        value = negative ? -out : out;
+        return {p, std::errc{}};
+    }
+
+    auto am = computeFloat<T>(exponent, w);
+    if (tooManyDigits && am != computeFloat<T>(exponent, w + 1)) {
+        return {p, fallbackFloat(negative, std::string_view(intStart, intEnd), std::string_view(fracStart, fracEnd),
+                                 explicitExponent - (fracEnd - fracStart), am, value)};
+    }
+
+    if (am.power2 == F::INFINITE_POWER || (am.power2 == 0 && am.mantissa == 0 && w != 0)) {
+        return {p, std::errc::result_out_of_range};
+    }
+
+    auto bits = static_cast<typename F::Bits>(am.mantissa | (static_cast<uint64_t>(am.power2) << F::MANTISSA_BITS));
+    if (negative) {
+        bits |= typename F::Bits{1} << (sizeof(bits) * 8 - 1);
     }
+    value = std::bit_cast<T>(bits);
+    return {p, std::errc{}};
 }
 
 }
 
+}
+
+#include <cerrno>
 #include <charconv>
 
 
 namespace prs {
 
-namespace {
+namespace details {
 
-template <typename Number, typename = std::void_t<>>
-constexpr bool hasFromCharsMethod = false;
+/**
+ * Superset of the first symbols accepted by from_chars (or strtod)
+ */
+template <typename Number, NumberFormat format = NumberFormat::General>
+constexpr FirstSet numberFirstSet() noexcept {
+    return FirstSet::fromPredicate([](char c) {
+        bool const isDigit = '0' <= c && c <= '9';
+        if constexpr (std::is_integral_v<Number>) {
+            return isDigit || (std::is_signed_v<Number> && c == '-');
+        } else if constexpr (format == NumberFormat::Json) {
+            return isDigit || c == '-';
+        } else if constexpr (hasFromChars<Number> || std::is_same_v<Number, float> || std::is_same_v<Number, double>) {
+            return isDigit || c == '-' || c == '.' || c == 'i' || c == 'I' || c == 'n' || c == 'N';
+        } else {
+            return isDigit || c == '-' || c == '+' || c == '.' || c == 'i' || c == 'I' || c == 'n' || c == 'N'
+                || c == ' ' || ('\t' <= c && c <= '\r');
+        }
+    });
+}
 
 template <typename Number>
-constexpr bool hasFromCharsMethod<Number, std::void_t<decltype(std::from_chars(nullptr, nullptr, std::declval<Number&>()))>> = true;
+constexpr bool hasBuiltinParsing = std::is_same_v<Number, float> || std::is_same_v<Number, double>
+    || (std::is_integral_v<Number> && !std::is_same_v<Number, bool>);
 
 }
 
 /**
+ * Integers, float and double are parsed by the built-in parser (the same result on every platform),
+ * other types by from_chars or strtod
+ * @tparam format - NumberFormat::Json accepts only JSON numbers
  * @return Parser<Number>
  */
-template <typename Number = double>
+template <typename Number = double, NumberFormat format = NumberFormat::General>
     requires (std::is_arithmetic_v<Number>)
 constexpr auto number() noexcept {
+    static_assert(format == NumberFormat::General || details::hasBuiltinParsing<Number>, "Json format requires the built-in parsing");
     return Parser<Number>::make([](Stream& s) {
         auto sv = s.sv();
         Number n{};
-        if constexpr (hasFromCharsMethod<Number>) {
+        if constexpr (details::hasBuiltinParsing<Number>) {
+            std::from_chars_result res;
+            if constexpr (std::is_floating_point_v<Number>) {
+                res = details::parseFloat<format>(sv.data(), sv.data() + sv.size(), n);
+            } else {
+                res = details::parseInteger<format>(sv.data(), sv.data() + sv.size(), n);
+            }
+            if (res.ec == std::errc{}) {
+                s.moveUnsafe(res.ptr - sv.data());
+                return Parser<Number>::data(n);
+            }
+            return Parser<Number>::makeError("Cannot parse number", s.pos());
+        } else if constexpr (details::hasFromChars<Number>) {
             if (auto res = std::from_chars(sv.data(), sv.data() + sv.size(), n);
                     res.ec == std::errc{}) {
                 s.moveUnsafe(res.ptr - sv.data());
@@ -3157,21 +7731,10 @@ constexpr auto number() noexcept {
                 return Parser<Number>::makeError("Cannot parse number", s.pos());
             }
         } else { // some system doesn't have from_chars for floating point numbers
-            if constexpr (std::is_same_v<Number, double>) {
-                char *end = const_cast<char*>(sv.end());
-                n = std::strtod(sv.data(), &end);
-                size_t endIndex = end - sv.data();
-                if (endIndex == 0) {
-                    return Parser<Number>::makeError("Cannot parse number", s.pos());
-                }
-                if (errno == ERANGE) {
-                    return Parser<Number>::makeError("Cannot parse number ERANGE", s.pos());
-                }
-                s.moveUnsafe(endIndex);
-                return Parser<Number>::data(n);
-            } else if (std::is_same_v<Number, float>) {
+            if constexpr (std::is_same_v<Number, long double>) {
                 char *end = const_cast<char*>(sv.end());
-                n = std::strtof(sv.data(), &end);
+                errno = 0;
+                n = std::strtold(sv.data(), &end);
                 size_t endIndex = end - sv.data();
                 if (endIndex == 0) {
                     return Parser<Number>::makeError("Cannot parse number", s.pos());
@@ -3186,7 +7749,67 @@ constexpr auto number() noexcept {
                 return Parser<Number>::makeError("Not supported", s.pos());
             }
         }
-    });
+    }).withFirstSet(details::numberFirstSet<Number, format>());
+}
+
+
+namespace details {
+
+template <std::integral Mantissa>
+constexpr FirstSet decimalFirstSet() noexcept {
+    return FirstSet::fromPredicate([](char c) {
+        return ('0' <= c && c <= '9') || (std::is_signed_v<Mantissa> && c == '-');
+    });
+}
+
+}
+
+/**
+ * Exact decimal "-?digits(.digits)?" in one pass, without double
+ * @tparam maxScale - max number of fractional digits
+ * @return Parser<Decimal<Mantissa>>
+ */
+template <std::integral Mantissa = int64_t, size_t maxScale = 18>
+    requires (!std::is_same_v<Mantissa, bool>)
+constexpr auto decimal() noexcept {
+    using Result = Decimal<Mantissa>;
+    return Parser<Result>::make([](Stream& s) {
+        auto sv = s.sv();
+        Result n;
+        auto const res = details::parseDecimal(sv.data(), sv.data() + sv.size(), maxScale, n.mantissa, n.scale);
+        if (res.ec == std::errc{}) {
+            s.moveUnsafe(res.ptr - sv.data());
+            return Parser<Result>::data(n);
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            return Parser<Result>::makeError("Decimal overflow", s.pos());
+        }
+        return Parser<Result>::makeError("Cannot parse decimal", s.pos());
+    }).withFirstSet(details::decimalFirstSet<Mantissa>());
+}
+
+/**
+ * Fixed point decimal, "1.5" -> 150 for scale = 2
+ * @tparam scale - max number of fractional digits, the result is multiplied by 10^scale
+ * @return Parser<Mantissa>
+ */
+template <size_t scale, std::integral Mantissa = int64_t>
+    requires (!std::is_same_v<Mantissa, bool>)
+constexpr auto fixedPoint() noexcept {
+    return Parser<Mantissa>::make([](Stream& s) {
+        auto sv = s.sv();
+        Mantissa n{};
+        size_t parsedScale = 0;
+        auto const res = details::parseDecimal(sv.data(), sv.data() + sv.size(), scale, n, parsedScale);
+        if (res.ec == std::errc{} && details::scaleUp(n, scale - parsedScale)) {
+            s.moveUnsafe(res.ptr - sv.data());
+            return Parser<Mantissa>::data(n);
+        }
+        if (res.ec == std::errc::invalid_argument) {
+            return Parser<Mantissa>::makeError("Cannot parse decimal", s.pos());
+        }
+        return Parser<Mantissa>::makeError("Decimal overflow", s.pos());
+    }).withFirstSet(details::decimalFirstSet<Mantissa>());
 }
 
 
@@ -3289,34 +7912,45 @@ auto search(P tParser) noexcept {
 }
 
 
-template <typename Derived, typename Container, ContextType Ctx>
+/**
+ * CRTP base for repeat modifiers that accumulate results in place.
+ * Derived defines add(Container&, Value[, Ctx&]) and can override init([Ctx&]) to create the container, e.g. from ArenaCtx.
+ */
+template <typename Derived, typename ContainerT, ContextType CtxT>
 class Repeat {
 public:
+    using Container = ContainerT;
+    using Ctx = CtxT;
+
     Repeat() noexcept = default;
 
-    auto operator()(auto& parser, Stream& stream, Ctx& ctx) const {
-        using P = Parser<typename std::decay_t<decltype(parser)>::Type, Ctx>;
+    auto operator()(auto& parser, Stream& stream, auto& ctx) const {
+        using P = Parser<Container, Ctx>;
 
-        get().init();
+        decltype(auto) container = get().init(ctx);
         size_t iteration = 0;
-        auto backup = stream.pos();
         do {
-            backup = stream.pos();
+            auto backup = stream.pos();
             auto result = parser();
             if (!result.isError()) {
-                get().add(std::move(result).data(), ctx);
+                get().add(container, std::move(result).data(), ctx);
             } else {
                 stream.restorePos(backup);
-                return P::data(get().value());
+                return P::data(std::move(container));
             }
         } while (++iteration != MAX_ITERATION);
 
         return P::makeError("Max iteration", stream.pos());
     }
 
+protected:
+    Container init(auto& ctx) const noexcept {
+        return {};
+    }
+
 private:
-    Derived& get() noexcept {
-        return static_cast<Derived&>(*this);
+    Derived const& get() const noexcept {
+        return static_cast<Derived const&>(*this);
     }
 };
 
@@ -3400,7 +8034,7 @@ public:
             Stream localStream{t};
             return m_parser(localStream).flatMapError([&](details::ParsingError const& error) {
                 auto posOfError = stream.pos() - (localStream.full().size() - error.pos);
-                return P::PRS_MAKE_ERROR("Internal parser fail: " + error.description, posOfError);
+                return P::makeError(details::ParsingError::internalError(error, posOfError));
             });
         });
     }
@@ -3412,7 +8046,7 @@ public:
             Stream localStream{t};
             return m_parser(localStream, ctx).flatMapError([&](details::ParsingError const& error) {
                 auto posOfError = stream.pos() - (localStream.full().size() - error.pos);
-                return Parser<ParserResult>::PRS_MAKE_ERROR("Internal parser fail: " + error.description, posOfError);
+                return Parser<ParserResult>::makeError(details::ParsingError::internalError(error, posOfError));
             });
         });
     }
@@ -3427,3 +8061,677 @@ auto convertResult(P parser) noexcept {
 }
 
 }
+// #include <parsecpp/common/bytecode.h>
+
+
+// #include <parsecpp/core/parser.h>
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace prs::vm {
+
+/**
+ * Instructions of the parsing machine, `aux` is a byte or an index of a set, `arg` is an address or an index
+ */
+enum class Op : uint8_t {
+    Char,          // match the byte aux
+    Set,           // match a byte of sets[aux]
+    Span,          // skip bytes of sets[aux]
+    Literal,       // match literals[arg]
+    Any,           // match any byte
+    TestSet,       // jump to arg without backtracking if the byte isn't in sets[aux]
+    Choice,        // push a backtrack entry to arg
+    Commit,        // pop the backtrack entry, jump to arg
+    PartialCommit, // update the backtrack entry to the current position, jump to arg
+    Jump,
+    Call,
+    Return,
+    Fail,
+    Open,          // start of a capture
+    Close,         // end of a capture with the action arg
+    End
+};
+
+struct Instruction {
+    Op op;
+    uint16_t aux = 0;
+    uint32_t arg = 0;
+};
+
+template <typename State>
+using Action = void (*)(std::string_view, State&);
+
+
+struct Node;
+
+/**
+ * Expression of a grammar, it's a value: subexpressions are shared
+ */
+class Expr {
+public:
+    explicit Expr(std::shared_ptr<Node const> node) noexcept
+        : m_node(std::move(node)) {
+
+    }
+
+    Node const& node() const noexcept {
+        return *m_node;
+    }
+private:
+    std::shared_ptr<Node const> m_node;
+};
+
+struct Node {
+    enum class Kind {Char, Set, Literal, Any, Seq, Alt, Many, Opt, Rule, Capture};
+
+    Kind kind;
+    char c = 0;
+    CharSet set{};
+    std::string literal{};
+    size_t index = 0; // rule or action
+    std::vector<Expr> children{};
+};
+
+namespace impl {
+
+inline Expr makeNode(Node node) {
+    return Expr{std::make_shared<Node const>(std::move(node))};
+}
+
+inline Expr makeList(Node::Kind kind, Expr const& lhs, Expr const& rhs) {
+    Node out{kind};
+    for (auto const* e : {&lhs, &rhs}) {
+        if (e->node().kind == kind) {
+            out.children.insert(out.children.end(), e->node().children.begin(), e->node().children.end());
+        } else {
+            out.children.push_back(*e);
+        }
+    }
+    return makeNode(std::move(out));
+}
+
+}
+
+inline Expr ch(char c) {
+    return impl::makeNode(Node{Node::Kind::Char, c});
+}
+
+inline Expr chars(CharSet const& set) {
+    return impl::makeNode(Node{Node::Kind::Set, 0, set});
+}
+
+inline Expr range(char from, char to) {
+    return chars(CharSet::fromPredicate([from, to](char c) {
+        return from <= c && c <= to;
+    }));
+}
+
+inline Expr lit(std::string_view str) {
+    return impl::makeNode(Node{Node::Kind::Literal, 0, {}, std::string(str)});
+}
+
+inline Expr any() {
+    return impl::makeNode(Node{Node::Kind::Any});
+}
+
+inline Expr operator>>(Expr const& lhs, Expr const& rhs) {
+    return impl::makeList(Node::Kind::Seq, lhs, rhs);
+}
+
+/**
+ * Ordered choice: rhs is tried only if lhs fails
+ */
+inline Expr operator|(Expr const& lhs, Expr const& rhs) {
+    return impl::makeList(Node::Kind::Alt, lhs, rhs);
+}
+
+/**
+ * Greedy repetition, an iteration that doesn't consume input stops the loop
+ */
+inline Expr many(Expr const& e) {
+    return impl::makeNode(Node{Node::Kind::Many, 0, {}, {}, 0, {e}});
+}
+
+inline Expr many1(Expr const& e) {
+    return e >> many(e);
+}
+
+inline Expr opt(Expr const& e) {
+    return impl::makeNode(Node{Node::Kind::Opt, 0, {}, {}, 0, {e}});
+}
+
+/**
+ * On success of the whole match actions[action] is called with the text matched by e.
+ * Actions are called in postfix order: nested captures before the enclosing one.
+ */
+inline Expr capture(Expr const& e, size_t action) {
+    return impl::makeNode(Node{Node::Kind::Capture, 0, {}, {}, action, {e}});
+}
+
+
+namespace impl {
+
+class Compiler;
+
+}
+
+
+/**
+ * Compiled grammar: flat array of instructions, a backtracking stack machine in the spirit of LPeg.
+ */
+class Program {
+public:
+    static constexpr size_t MAX_STACK = size_t{1} << 16;
+
+    std::span<Instruction const> code() const noexcept {
+        return m_code;
+    }
+
+    /**
+     * First bytes of the start rule, if they are known
+     */
+    std::optional<CharSet> const& firstSet() const noexcept {
+        return m_first;
+    }
+
+    /**
+     * Match from the current position, on success the stream is moved to the end of the match
+     * and actions of the captures are called.
+     * @return the furthest failed position on error
+     */
+    template <typename State>
+    details::ResultType<Unit> run(Stream& stream, State& state, std::span<Action<State> const> actions) const {
+        ScratchLease scratch;
+        auto result = exec(stream, *scratch);
+        if (result.isError()) {
+            return result;
+        }
+
+        auto& opens = scratch->opens;
+        auto const str = stream.full();
+        for (auto const& capture : scratch->captures) {
+            if (capture.action == OPEN) {
+                opens.push_back(capture.pos);
+            } else {
+                assert(capture.action < actions.size());
+                actions[capture.action](str.substr(opens.back(), capture.pos - opens.back()), state);
+                opens.pop_back();
+            }
+        }
+        return result;
+    }
+
+    details::ResultType<Unit> run(Stream& stream) const {
+        ScratchLease scratch;
+        return exec(stream, *scratch);
+    }
+private:
+    friend class impl::Compiler;
+
+    static constexpr uint32_t OPEN = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t CALL_FRAME = std::numeric_limits<size_t>::max();
+    static constexpr size_t INITIAL_STACK = 64;
+
+    struct Capture {
+        uint32_t action;
+        size_t pos;
+    };
+
+    struct Frame {
+        uint32_t pc;
+        uint32_t captures;
+        size_t pos; // CALL_FRAME for return addresses
+    };
+
+    /**
+     * Buffers of a run, they are kept by the thread between runs
+     */
+    struct Scratch {
+        std::vector<Frame> stack;
+        std::vector<Capture> captures;
+        std::vector<size_t> opens;
+    };
+
+    /**
+     * Takes the buffers of the thread and gives them back cleared.
+     * An action can run a program, the nested run finds no buffers and allocates its own.
+     */
+    class ScratchLease {
+    public:
+        ScratchLease() noexcept
+            : m_scratch(std::exchange(cached(), Scratch{})) {
+
+        }
+
+        ScratchLease(ScratchLease const&) = delete;
+        ScratchLease& operator=(ScratchLease const&) = delete;
+
+        ~ScratchLease() {
+            m_scratch.stack.clear();
+            m_scratch.captures.clear();
+            m_scratch.opens.clear();
+            cached() = std::move(m_scratch);
+        }
+
+        Scratch& operator*() noexcept {
+            return m_scratch;
+        }
+
+        Scratch* operator->() noexcept {
+            return &m_scratch;
+        }
+    private:
+        static Scratch& cached() noexcept {
+            thread_local Scratch scratch;
+            return scratch;
+        }
+
+        Scratch m_scratch;
+    };
+
+    details::ResultType<Unit> exec(Stream& stream, Scratch& scratch) const {
+        auto const str = stream.full();
+        auto const* code = m_code.data();
+        size_t pos = stream.pos();
+        size_t furthest = pos;
+        uint32_t pc = 0;
+        auto& stack = scratch.stack;
+        auto& captures = scratch.captures;
+        stack.reserve(INITIAL_STACK);
+
+        while (true) {
+            auto const& ins = code[pc];
+            switch (ins.op) {
+                case Op::Char:
+                    if (pos != str.size() && str[pos] == static_cast<char>(ins.aux)) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Set:
+                    if (pos != str.size() && m_sets[ins.aux].contains(str[pos])) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Span:
+                    pos += m_sets[ins.aux].prefixLength(str.substr(pos));
+                    ++pc;
+                    continue;
+                case Op::Literal:
+                    if (str.substr(pos).starts_with(m_literals[ins.arg])) {
+                        pos += m_literals[ins.arg].size();
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::Any:
+                    if (pos != str.size()) {
+                        ++pos;
+                        ++pc;
+                        continue;
+                    }
+                    break;
+                case Op::TestSet:
+                    if (pos != str.size() && m_sets[ins.aux].contains(str[pos])) {
+                        ++pc;
+                    } else {
+                        furthest = std::max(furthest, pos);
+                        pc = ins.arg;
+                    }
+                    continue;
+                case Op::Choice:
+                    if (stack.size() == MAX_STACK) {
+                        return Parser<Unit>::makeError("Stack overflow", pos);
+                    }
+                    stack.push_back(Frame{ins.arg, static_cast<uint32_t>(captures.size()), pos});
+                    ++pc;
+                    continue;
+                case Op::Commit:
+                    stack.pop_back();
+                    pc = ins.arg;
+                    continue;
+                case Op::PartialCommit:
+                    if (auto& top = stack.back(); top.pos != pos) {
+                        top.pos = pos;
+                        top.captures = static_cast<uint32_t>(captures.size());
+                        pc = ins.arg;
+                    } else {
+                        pc = top.pc;
+                        stack.pop_back();
+                    }
+                    continue;
+                case Op::Jump:
+                    pc = ins.arg;
+                    continue;
+                case Op::Call:
+                    if (stack.size() == MAX_STACK) {
+                        return Parser<Unit>::makeError("Stack overflow", pos);
+                    }
+                    stack.push_back(Frame{pc + 1, 0, CALL_FRAME});
+                    pc = ins.arg;
+                    continue;
+                case Op::Return:
+                    pc = stack.back().pc;
+                    stack.pop_back();
+                    continue;
+                case Op::Fail:
+                    break;
+                case Op::Open:
+                    captures.push_back(Capture{OPEN, pos});
+                    ++pc;
+                    continue;
+                case Op::Close:
+                    captures.push_back(Capture{ins.arg, pos});
+                    ++pc;
+                    continue;
+                case Op::End:
+                    stream.restorePos(pos);
+                    return Parser<Unit>::data(Unit{});
+            }
+
+            furthest = std::max(furthest, pos);
+            while (!stack.empty() && stack.back().pos == CALL_FRAME) {
+                stack.pop_back();
+            }
+            if (stack.empty()) {
+                return Parser<Unit>::makeError("Grammar doesn't match", furthest);
+            }
+            pc = stack.back().pc;
+            pos = stack.back().pos;
+            captures.resize(stack.back().captures);
+            stack.pop_back();
+        }
+    }
+
+    std::vector<Instruction> m_code;
+    std::vector<CharSet> m_sets;
+    std::vector<std::string> m_literals;
+    std::optional<CharSet> m_first;
+};
+
+
+/**
+ * Set of rules, rules can be referenced before the definition, so grammars can be recursive.
+ * Left recursion isn't supported, it fails with "Stack overflow".
+ */
+class Grammar {
+public:
+    Expr rule() {
+        m_rules.emplace_back();
+        return impl::makeNode(Node{Node::Kind::Rule, 0, {}, {}, m_rules.size() - 1});
+    }
+
+    void define(Expr const& rule, Expr body) {
+        assert(rule.node().kind == Node::Kind::Rule);
+        m_rules[rule.node().index] = std::move(body);
+    }
+
+    Program compile(Expr const& start) const;
+private:
+    std::vector<std::optional<Expr>> m_rules;
+};
+
+
+namespace impl {
+
+class Compiler {
+public:
+    explicit Compiler(std::vector<std::optional<Expr>> const& rules)
+        : m_rules(rules)
+        , m_addresses(rules.size(), UNKNOWN) {
+
+    }
+
+    Program compile(Expr const& start) {
+        emitRoot(start);
+        emit(Op::End);
+        for (size_t i = 0; i != m_rules.size(); ++i) {
+            m_addresses[i] = here();
+            if (m_rules[i]) {
+                emitRoot(*m_rules[i]);
+            } else {
+                assert(false && "Rule is not defined");
+                emit(Op::Fail);
+            }
+            emit(Op::Return);
+        }
+        for (auto [at, rule] : m_calls) {
+            m_program.m_code[at].arg = m_addresses[rule];
+        }
+        m_program.m_first = firstOf(start.node(), 0);
+        return std::move(m_program);
+    }
+private:
+    static constexpr uint32_t UNKNOWN = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MAX_FIRST_DEPTH = 16;
+
+    uint32_t here() const noexcept {
+        return static_cast<uint32_t>(m_program.m_code.size());
+    }
+
+    size_t emit(Op op, uint16_t aux = 0, uint32_t arg = 0) {
+        m_program.m_code.push_back(Instruction{op, aux, arg});
+        return m_program.m_code.size() - 1;
+    }
+
+    void patch(size_t at) noexcept {
+        m_program.m_code[at].arg = here();
+    }
+
+    uint16_t addSet(CharSet const& set) {
+        assert(m_program.m_sets.size() < std::numeric_limits<uint16_t>::max());
+        m_program.m_sets.push_back(set);
+        return static_cast<uint16_t>(m_program.m_sets.size() - 1);
+    }
+
+    void emitRoot(Expr const& e) {
+        emitNode(e.node());
+    }
+
+    /**
+     * The set of first bytes if the expression cannot match the empty string
+     */
+    std::optional<CharSet> firstOf(Node const& node, size_t depth) const {
+        switch (node.kind) {
+            case Node::Kind::Char:
+                return CharSet::anyOf(node.c);
+            case Node::Kind::Set:
+                return node.set;
+            case Node::Kind::Literal:
+                return node.literal.empty() ? std::nullopt : std::optional{CharSet::anyOf(node.literal.front())};
+            case Node::Kind::Seq:
+                return firstOf(node.children.front().node(), depth);
+            case Node::Kind::Alt: {
+                std::vector<CharSet> sets;
+                for (auto const& child : node.children) {
+                    auto first = firstOf(child.node(), depth);
+                    if (!first) {
+                        return std::nullopt;
+                    }
+                    sets.push_back(*first);
+                }
+                return CharSet::fromPredicate([&sets](char c) {
+                    return std::any_of(sets.begin(), sets.end(), [c](CharSet const& set) {
+                        return set.contains(c);
+                    });
+                });
+            }
+            case Node::Kind::Rule:
+                if (depth == MAX_FIRST_DEPTH || !m_rules[node.index]) {
+                    return std::nullopt;
+                }
+                return firstOf(m_rules[node.index]->node(), depth + 1);
+            case Node::Kind::Capture:
+                return firstOf(node.children.front().node(), depth);
+            case Node::Kind::Any:
+            case Node::Kind::Many:
+            case Node::Kind::Opt:
+                return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Skip the backtrack entry if the first byte cannot start the expression
+     */
+    std::optional<size_t> emitTest(Node const& node) {
+        if (auto first = firstOf(node, 0); first) {
+            return emit(Op::TestSet, addSet(*first));
+        }
+        return std::nullopt;
+    }
+
+    void emitNode(Node const& node) {
+        switch (node.kind) {
+            case Node::Kind::Char:
+                emit(Op::Char, static_cast<unsigned char>(node.c));
+                break;
+            case Node::Kind::Set:
+                emit(Op::Set, addSet(node.set));
+                break;
+            case Node::Kind::Literal:
+                if (node.literal.size() == 1) {
+                    emit(Op::Char, static_cast<unsigned char>(node.literal.front()));
+                } else if (!node.literal.empty()) {
+                    m_program.m_literals.push_back(node.literal);
+                    emit(Op::Literal, 0, static_cast<uint32_t>(m_program.m_literals.size() - 1));
+                }
+                break;
+            case Node::Kind::Any:
+                emit(Op::Any);
+                break;
+            case Node::Kind::Seq:
+                for (auto const& child : node.children) {
+                    emitNode(child.node());
+                }
+                break;
+            case Node::Kind::Alt: {
+                // TestSet next; Choice next; alt; Commit end; next: ...
+                std::vector<size_t> commits;
+                for (size_t i = 0; i + 1 != node.children.size(); ++i) {
+                    auto const test = emitTest(node.children[i].node());
+                    auto const choice = emit(Op::Choice);
+                    emitNode(node.children[i].node());
+                    commits.push_back(emit(Op::Commit));
+                    patch(choice);
+                    if (test) {
+                        patch(*test);
+                    }
+                }
+                emitNode(node.children.back().node());
+                for (auto commit : commits) {
+                    patch(commit);
+                }
+                break;
+            }
+            case Node::Kind::Many: {
+                auto const& body = node.children.front().node();
+                if (body.kind == Node::Kind::Set || body.kind == Node::Kind::Char) {
+                    emit(Op::Span, addSet(body.kind == Node::Kind::Set ? body.set : CharSet::anyOf(body.c)));
+                    break;
+                }
+                // TestSet end; Choice end; loop: body; PartialCommit loop; end:
+                auto const test = emitTest(body);
+                auto const choice = emit(Op::Choice);
+                emitNode(body);
+                emit(Op::PartialCommit, 0, static_cast<uint32_t>(choice + 1));
+                patch(choice);
+                if (test) {
+                    patch(*test);
+                }
+                break;
+            }
+            case Node::Kind::Opt: {
+                auto const& body = node.children.front().node();
+                auto const test = emitTest(body);
+                auto const choice = emit(Op::Choice);
+                emitNode(body);
+                auto const commit = emit(Op::Commit);
+                patch(choice);
+                patch(commit);
+                if (test) {
+                    patch(*test);
+                }
+                break;
+            }
+            case Node::Kind::Rule:
+                m_calls.emplace_back(emit(Op::Call), node.index);
+                break;
+            case Node::Kind::Capture:
+                emit(Op::Open);
+                emitNode(node.children.front().node());
+                emit(Op::Close, 0, static_cast<uint32_t>(node.index));
+                break;
+        }
+    }
+
+    std::vector<std::optional<Expr>> const& m_rules;
+    std::vector<uint32_t> m_addresses;
+    std::vector<std::pair<size_t, size_t>> m_calls;
+    Program m_program;
+};
+
+}
+
+
+inline Program Grammar::compile(Expr const& start) const {
+    return impl::Compiler{m_rules}.compile(start);
+}
+
+
+namespace impl {
+
+template <typename R, typename Fn>
+auto withProgramFirstSet(Program const& program, Fn fn) {
+    auto parser = Parser<R>::make(std::move(fn));
+    if (auto const& first = program.firstSet(); first) {
+        return parser.withFirstSet(FirstSet::of(*first));
+    }
+    return parser.withFirstSet(FirstSet::any());
+}
+
+}
+
+
+/**
+ * Parser that runs the program, the captures are ignored
+ * @return Parser<Unit>
+ */
+inline auto toParser(std::shared_ptr<Program const> program) {
+    auto const& ref = *program;
+    return impl::withProgramFirstSet<Unit>(ref, [program = std::move(program)](Stream& stream) {
+        return program->run(stream);
+    });
+}
+
+/**
+ * Parser that runs the program with a new State, calls the actions of captures and returns result(state)
+ * @return Parser<std::invoke_result_t<Fn, State&>>
+ */
+template <typename State, typename Fn>
+auto toParser(std::shared_ptr<Program const> program, std::vector<Action<State>> actions, Fn result) {
+    using R = std::decay_t<std::invoke_result_t<Fn, State&>>;
+    auto const& ref = *program;
+    return impl::withProgramFirstSet<R>(ref, [program = std::move(program), actions = std::move(actions), result = std::move(result)](Stream& stream) {
+        State state{};
+        return program->run<State>(stream, state, actions).map([&](Unit) {
+            return result(state);
+        });
+    });
+}
+
+}
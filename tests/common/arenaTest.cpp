@@ -0,0 +1,105 @@
+#include "../testHelper.h"
+
+
+TEST(Arena, Repeat) {
+    ParseArena arena;
+    ArenaCtx ctx{arena};
+    auto parser = arenaRepeat(charFrom('a', 'b'));
+
+    success_parsing(parser, {'a', 'b', 'a'}, "abac", "c", ctx);
+    success_parsing(parser, {}, "cab", "cab", ctx);
+
+    Stream s{"aab"};
+    auto result = parser(s, ctx);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data().get_allocator().resource(), arena.resource());
+}
+
+TEST(Arena, RepeatDelimiter) {
+    ParseArena arena;
+    ArenaCtx ctx{arena};
+    auto parser = arenaRepeat<4>(number<int>(), charFrom(','));
+
+    success_parsing(parser, {1, 2, 3}, "1,2,3", "", ctx);
+    success_parsing(parser, {1, 2}, "1,2,", "", ctx);
+    success_parsing(parser, {}, "a", "a", ctx);
+}
+
+TEST(Arena, ToMap) {
+    ParseArena arena;
+    ArenaCtx ctx{arena};
+    auto parser = arenaToMap(letters() << charFrom(':'), number<int>(), charFrom(','));
+
+    success_parsing(parser, {{"a", 1}, {"b", 2}}, "a:1,b:2", "", ctx);
+    success_parsing(parser, {{"a", 3}}, "a:1,a:3,", ",", ctx);
+    failed_parsing(parser, 6, "a:1,b:c", ctx);
+
+    auto noDelimiter = arenaToMap<false>(letters() << charFrom(':'), number<int>() << charFrom(';'));
+    success_parsing(noDelimiter, {{"a", 1}, {"b", 2}}, "a:1;b:2;c:d", "c:d", ctx);
+}
+
+TEST(Arena, Nested) {
+    ParseArena arena;
+    ArenaCtx ctx{arena};
+    auto parser = arenaRepeat(charFrom('[') >> arenaRepeat(number<int>(), charFrom(',')) << charFrom(']'));
+
+    Stream s{"[1,2][][3]"};
+    auto result = parser(s, ctx);
+    ASSERT_FALSE(result.isError());
+    auto const& data = result.data();
+    ASSERT_EQ(data.size(), 3);
+    EXPECT_EQ(data[0], ArenaVector<int>({1, 2}));
+    EXPECT_TRUE(data[1].empty());
+    EXPECT_EQ(data[2], ArenaVector<int>({3}));
+    EXPECT_EQ(data[0].get_allocator().resource(), arena.resource());
+}
+
+TEST(Arena, ResetGrows) {
+    ParseArena arena{16};
+    auto parser = arenaRepeat(number<int>(), charFrom(','));
+
+    std::string text = "0";
+    for (int i = 1; i != 1000; ++i) {
+        text += "," + std::to_string(i);
+    }
+
+    for (int i = 0; i != 3; ++i) {
+        {
+            ArenaCtx ctx{arena};
+            Stream s{text};
+            auto result = parser(s, ctx);
+            ASSERT_FALSE(result.isError());
+            EXPECT_EQ(result.data().size(), 1000);
+            EXPECT_EQ(result.data().back(), 999);
+        }
+        if (i == 0) {
+            EXPECT_GT(arena.heapAllocations(), 0);
+        } else {
+            EXPECT_EQ(arena.heapAllocations(), 0);
+        }
+        arena.reset();
+    }
+    EXPECT_GE(arena.capacity(), 1000 * sizeof(int));
+}
+
+
+struct ArenaSum : public Repeat<ArenaSum, ArenaVector<int>, ArenaCtx> {
+    ArenaVector<int> init(auto& ctx) const {
+        return ArenaVector<int>{details::arenaResource(ctx)};
+    }
+
+    void add(Container& out, int value, auto& ctx) const {
+        out.push_back(out.empty() ? value : out.back() + value);
+    }
+};
+
+TEST(Arena, RepeatModifier) {
+    ParseArena arena;
+    ArenaCtx ctx{arena};
+    auto parser = (number<int>() << charFrom(';')) * ArenaSum{};
+
+    success_parsing(parser, {1, 3, 6}, "1;2;3;4", "4", ctx);
+
+    Stream s{"1;"};
+    EXPECT_EQ(parser(s, ctx).data().get_allocator().resource(), arena.resource());
+}
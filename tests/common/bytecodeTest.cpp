@@ -0,0 +1,188 @@
+#include "../testHelper.h"
+
+#include <charconv>
+
+namespace {
+
+using Stack = std::vector<double>;
+
+enum CalcAction : size_t {
+    PUSH,
+    BINARY
+};
+
+/**
+ * E = T (('+' | '-') T)*, T = F (('*' | '/') F)*, F = number | '(' E ')'
+ */
+std::shared_ptr<vm::Program const> calcProgram() {
+    using namespace vm;
+    Grammar g;
+    auto expr = g.rule();
+    auto term = g.rule();
+    auto factor = g.rule();
+
+    auto ws = many(ch(' '));
+    auto digits = many1(range('0', '9'));
+    auto number = capture(digits >> opt(ch('.') >> digits), PUSH) >> ws;
+
+    g.define(factor, number | (ch('(') >> ws >> expr >> ch(')') >> ws));
+    g.define(term, factor >> many(capture(chars(CharSet::anyOf('*', '/')) >> ws >> factor, BINARY)));
+    g.define(expr, ws >> term >> many(capture(chars(CharSet::anyOf('+', '-')) >> ws >> term, BINARY)));
+    return std::make_shared<vm::Program const>(g.compile(expr));
+}
+
+std::vector<vm::Action<Stack>> calcActions() {
+    return {
+        [](std::string_view text, Stack& stack) {
+            double value = 0;
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            stack.push_back(value);
+        },
+        [](std::string_view text, Stack& stack) {
+            double const rhs = stack.back();
+            stack.pop_back();
+            double& lhs = stack.back();
+            switch (text.front()) {
+                case '+': lhs += rhs; break;
+                case '-': lhs -= rhs; break;
+                case '*': lhs *= rhs; break;
+                default: lhs /= rhs; break;
+            }
+        }
+    };
+}
+
+auto calc() {
+    return vm::toParser(calcProgram(), calcActions(), [](Stack const& stack) {
+        return stack.back();
+    });
+}
+
+}
+
+TEST(Bytecode, Primitives) {
+    using namespace vm;
+    Grammar g;
+    auto start = g.rule();
+    g.define(start, lit("ab") >> range('0', '9') >> any() >> ch('!'));
+    auto parser = toParser(std::make_shared<Program const>(g.compile(start)));
+
+    success_parsing(parser, {}, "ab1x!rest", "rest");
+    failed_parsing(parser, 0, "ac1x!");
+    failed_parsing(parser, 2, "abx");
+    failed_parsing(parser, 4, "ab1x");
+}
+
+TEST(Bytecode, ChoiceBacktracks) {
+    using namespace vm;
+    Grammar g;
+    auto start = g.rule();
+    g.define(start, (lit("abc") | lit("abd") | (ch('a') >> opt(ch('b')))) >> ch(';'));
+    auto parser = toParser(std::make_shared<Program const>(g.compile(start)));
+
+    success_parsing(parser, {}, "abc;");
+    success_parsing(parser, {}, "abd;");
+    success_parsing(parser, {}, "ab;");
+    success_parsing(parser, {}, "a;");
+    failed_parsing(parser, 2, "abe;");
+}
+
+TEST(Bytecode, Repeat) {
+    using namespace vm;
+    Grammar g;
+    auto start = g.rule();
+    auto spanned = many(range('a', 'z'));
+    g.define(start, spanned >> many(lit("12")) >> many(opt(ch('x'))));
+    auto program = std::make_shared<Program const>(g.compile(start));
+    auto parser = toParser(program);
+
+    success_parsing(parser, {}, "abc1212xx", "");
+    success_parsing(parser, {}, "12121", "1");
+    success_parsing(parser, {}, "", "");
+
+    auto const code = program->code();
+    EXPECT_EQ(std::count_if(code.begin(), code.end(), [](Instruction const& ins) {
+        return ins.op == Op::Span;
+    }), 1);
+}
+
+TEST(Bytecode, Captures) {
+    using namespace vm;
+    using Log = std::vector<std::string>;
+    Grammar g;
+    auto start = g.rule();
+    auto word = capture(many1(range('a', 'z')), 0);
+    // the failed first alternative must not leave captures
+    g.define(start, capture((word >> ch('!')) | (word >> ch('?')), 1));
+
+    std::vector<Action<Log>> actions{
+        [](std::string_view text, Log& log) {
+            log.emplace_back(text);
+        },
+        [](std::string_view text, Log& log) {
+            log.emplace_back("all:" + std::string(text));
+        }
+    };
+    auto parser = toParser(std::make_shared<Program const>(g.compile(start)), actions, [](Log const& log) {
+        return log;
+    });
+    success_parsing(parser, Log{"abc", "all:abc?"}, "abc?");
+}
+
+TEST(Bytecode, NestedRun) {
+    using namespace vm;
+    using Sums = std::vector<double>;
+    Grammar g;
+    auto start = g.rule();
+    g.define(start, many(capture(many1(chars(CharSet::anyOf(';').inverse())), 0) >> ch(';')));
+
+    // the action runs a program while the outer captures are still read
+    std::vector<Action<Sums>> actions{
+        [](std::string_view text, Sums& sums) {
+            Stream stream{text};
+            sums.push_back(calc()(stream).data());
+        }
+    };
+    auto parser = toParser(std::make_shared<Program const>(g.compile(start)), actions, [](Sums const& sums) {
+        return sums;
+    });
+    success_parsing(parser, Sums{3., 8., 1.}, "1+2;(1+3)*2;1;");
+    success_parsing(parser, Sums{6.}, "2*3;");
+}
+
+TEST(Bytecode, Calc) {
+    auto parser = calc();
+    success_parsing(parser, 7., "1 + 2 * 3");
+    success_parsing(parser, 9., "(1 + 2) * 3");
+    success_parsing(parser, 2.5, " 10 / 2 / 2 ");
+    success_parsing(parser, -4., "1 - (2 + 3)", "");
+    success_parsing(parser, 1., "1 + ", "+ ");
+    failed_parsing(parser, 5, "(1 + )");
+}
+
+TEST(Bytecode, Recursion) {
+    using namespace vm;
+    Grammar g;
+    auto nested = g.rule();
+    g.define(nested, ch('(') >> opt(nested) >> ch(')'));
+    auto parser = toParser(std::make_shared<Program const>(g.compile(nested)));
+
+    success_parsing(parser, {}, "((()))");
+    failed_parsing(parser, 3, "(((");
+
+    std::string deep(Program::MAX_STACK + 1, '(');
+    Stream stream{deep};
+    EXPECT_TRUE(parser(stream).isError());
+
+    auto left = g.rule();
+    g.define(left, left >> ch('a'));
+    Stream leftStream{"aa"};
+    EXPECT_TRUE(toParser(std::make_shared<Program const>(g.compile(left)))(leftStream).isError());
+}
+
+TEST(Bytecode, Composition) {
+    auto parser = charFrom('=') >> calc() << charFrom(';');
+    success_parsing(parser, 3., "=1+2;");
+    EXPECT_TRUE(parser.firstSet().contains('='));
+    EXPECT_TRUE(calc().firstSet().contains('('));
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "../testHelper.h"
+
+
+TEST(Choice, FirstSet) {
+    EXPECT_TRUE((charFrom<'a', 'b'>().firstSet().contains('b')));
+    EXPECT_FALSE((charFrom<'a', 'b'>().firstSet().contains('c')));
+    EXPECT_TRUE(digit().firstSet().contains('7'));
+    EXPECT_FALSE(letters().firstSet().contains('7'));
+    EXPECT_TRUE(number<int>().firstSet().contains('-'));
+    EXPECT_FALSE(number<unsigned>().firstSet().contains('-'));
+    EXPECT_EQ(literal("null").firstSet(), FirstSet::anyOf('n'));
+    EXPECT_EQ(literal<"true"_prs>().firstSet(), FirstSet::anyOf('t'));
+
+    auto seq = spaces() >> charFrom('{') << spaces();
+    static_assert(decltype(seq)::hasFirstSet);
+    EXPECT_TRUE(seq.firstSet().contains(' '));
+    EXPECT_TRUE(seq.firstSet().contains('{'));
+    EXPECT_FALSE(seq.firstSet().contains('['));
+    EXPECT_FALSE(seq.firstSet().nullable());
+
+    auto alt = (literal("true") >> pure(true)) | (literal("false") >> pure(false));
+    EXPECT_EQ(alt.firstSet(), FirstSet::anyOf('t', 'f'));
+    EXPECT_TRUE(charFrom('a').maybe().firstSet().nullable());
+
+    auto unknown = satisfy([](char c) { return c == 'a'; });
+    static_assert(!decltype(unknown)::hasFirstSet);
+    EXPECT_EQ(unknown.firstSet(), FirstSet::any());
+    EXPECT_EQ(unknown.withFirstSet(FirstSet::anyOf('a')).firstSet(), FirstSet::anyOf('a'));
+    static_assert(!decltype(charFrom('a') | unknown)::hasFirstSet);
+}
+
+TEST(Choice, Dispatch) {
+    auto parser = choice(literal("null") >> pure(0)
+                         , literal("true") >> pure(1)
+                         , literal("false") >> pure(2)
+                         , number<int>()
+                         , between('"') >> pure(-1));
+
+    success_parsing(parser, 0, "null,", ",");
+    success_parsing(parser, 1, "true", "");
+    success_parsing(parser, 2, "false", "");
+    success_parsing(parser, 42, "42]", "]");
+    success_parsing(parser, -5, "-5", "");
+    success_parsing(parser, -1, "\"str\"", "");
+
+    failed_parsing(parser, 0, "");
+    failed_parsing(parser, 0, "x");
+    failed_parsing(parser, 0, "nuLL");
+    failed_parsing(parser, 4, "\"str");
+}
+
+TEST(Choice, Backtracking) {
+    int calls = 0;
+    auto counted = satisfy([&calls](char c) {
+        ++calls;
+        return c == 'b';
+    }) >> pure(3);
+
+    auto parser = choice((charFrom('a') >> charFrom('x') >> pure(1))
+                         , (charFrom('a') >> pure(2))
+                         , counted);
+
+    success_parsing(parser, 2, "ab", "b");
+    EXPECT_EQ(calls, 0);
+    success_parsing(parser, 1, "ax", "");
+    success_parsing(parser, 3, "b", "");
+    EXPECT_EQ(calls, 1);
+    failed_parsing(parser, 0, "c");
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(Choice, SameAsOr) {
+    auto value = [](auto p, int v) {
+        return spaces() >> p >> pure(v);
+    };
+    auto orParser = value(charFrom('['), 1) | value(charFrom('{'), 2) | value(literal("null"), 3) | value(number<int>(), 4).fmap([](int) { return 4; });
+    auto choiceParser = choice(value(charFrom('['), 1), value(charFrom('{'), 2), value(literal("null"), 3), value(number<int>(), 4));
+
+    for (std::string_view str : {"[", " {", "  null", "12", " x", "", "nul"}) {
+        Stream s1{str};
+        Stream s2{str};
+        auto const r1 = orParser(s1);
+        auto const r2 = choiceParser(s2);
+        ASSERT_EQ(r1.isError(), r2.isError()) << str;
+        if (r1.isError()) {
+            EXPECT_EQ(r1.error().pos, r2.error().pos) << str;
+        } else {
+            EXPECT_EQ(r1.data(), r2.data()) << str;
+            EXPECT_EQ(s1.pos(), s2.pos()) << str;
+        }
+    }
+}
+
+TEST(Choice, Context) {
+    using CtxI = ContextWrapper<int&>;
+    auto ctxParser = make_parser<CtxI>([](Stream& stream, CtxI& ctx) {
+        ++get<int>(ctx);
+        return (charFrom('b') >> pure(2)).apply(stream);
+    });
+    auto parser = choice(charFrom('a') >> pure(1), ctxParser.withFirstSet(FirstSet::anyOf('b')));
+
+    int n = 0;
+    CtxI ctx{n};
+    success_parsing(parser, 1, "a", "", ctx);
+    EXPECT_EQ(n, 0);
+    success_parsing(parser, 2, "b", "", ctx);
+    EXPECT_EQ(n, 1);
+    failed_parsing(parser, 0, "c", ctx);
+    EXPECT_EQ(n, 1);
+}
\ No newline at end of file
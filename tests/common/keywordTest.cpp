@@ -0,0 +1,63 @@
+#include "../testHelper.h"
+
+
+TEST(Keyword, Index) {
+    auto parser = keyword<"GET"_prs, "POST"_prs, "PUT"_prs, "PATCH"_prs, "DELETE"_prs>();
+
+    success_parsing(parser, 0, "GET /", " /");
+    success_parsing(parser, 1, "POST", "");
+    success_parsing(parser, 2, "PUT", "");
+    success_parsing(parser, 3, "PATCHES", "ES");
+    success_parsing(parser, 4, "DELETE", "");
+
+    failed_parsing(parser, 0, "");
+    failed_parsing(parser, 0, "get");
+    failed_parsing(parser, 0, "PO");
+    failed_parsing(parser, 0, "PAT");
+}
+
+TEST(Keyword, LongestMatch) {
+    auto parser = keyword<"or"_prs, "order"_prs, "orders"_prs, "ord"_prs>();
+
+    success_parsing(parser, 0, "or", "");
+    success_parsing(parser, 3, "orde", "e");
+    success_parsing(parser, 0, "ora", "a");
+    success_parsing(parser, 3, "ord", "");
+    success_parsing(parser, 1, "order-algo", "-algo");
+    success_parsing(parser, 2, "orders", "");
+    success_parsing(parser, 2, "ordersss", "ss");
+    failed_parsing(parser, 0, "o");
+}
+
+TEST(Keyword, Duplicates) {
+    auto parser = keyword<"a"_prs, "b"_prs, "a"_prs>();
+
+    success_parsing(parser, 0, "a", "");
+    success_parsing(parser, 1, "b", "");
+}
+
+TEST(Keyword, MappedValue) {
+    enum class Level {
+        Debug, Info, Warning, Error
+    };
+
+    auto parser = keyword<"DEBUG"_prs, "INFO"_prs, "WARN"_prs, "WARNING"_prs, "ERROR"_prs>(
+            Level::Debug, Level::Info, Level::Warning, Level::Warning, Level::Error);
+
+    success_parsing(parser, Level::Warning, "WARN ", " ");
+    success_parsing(parser, Level::Warning, "WARNING ", " ");
+    success_parsing(parser, Level::Error, "ERROR", "");
+    failed_parsing(parser, 0, "FATAL");
+}
+
+TEST(Keyword, FirstSet) {
+    auto parser = keyword<"null"_prs, "true"_prs, "false"_prs>();
+    EXPECT_EQ(parser.firstSet(), FirstSet::anyOf('n', 't', 'f'));
+
+    constexpr auto& trie = details::keywordTrie<"ab"_prs, "abc"_prs, "b"_prs>;
+    static_assert(trie.NODES == 5);
+    static_assert(trie.CLASSES == 4);
+    static_assert(trie.match("abd").index == 0);
+    static_assert(trie.match("abc").length == 3);
+    static_assert(trie.match("a").index == details::KeywordMatch::NONE);
+}
\ No newline at end of file
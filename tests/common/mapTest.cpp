@@ -82,4 +82,41 @@ TEST(Map, KeyValueMaxIter) {
     auto parser = toMap(key, value).endOfStream();
 
     failed_parsing(parser, 5, "test=4");
-}
\ No newline at end of file
+}
+
+template <typename Container>
+static void testContainer(auto const& ans, auto const& ansLast) {
+    auto key = letters<false, std::string>() << spaces() << charFrom('=') << spaces();
+    auto value = spaces() >> number<int>() << spaces();
+    auto delimiter = spaces() >> charFrom(',') << spaces();
+    auto parser = toMap<true, MAX_ITERATION, Container>(key, value, delimiter).endOfStream();
+
+    success_parsing(parser, ans, "test=1, p =   -3    ");
+    success_parsing(parser, ansLast, "p=-1, test = 1, p = -3   ");
+    failed_parsing(parser, 10, "test=1, q=");
+
+    auto parserNotInTheMiddle = toMap<false, MAX_ITERATION, Container>(key, value, delimiter);
+    success_parsing(parserNotInTheMiddle, ans, "test=1, p =   -3  , t=  ", ", t=  ");
+
+    auto parserNoDelimiter = toMap<false, MAX_ITERATION, Container>(key, value << charFrom(';'));
+    success_parsing(parserNoDelimiter, ans, "test=1;p=-3;t=", "t=");
+
+    auto parserMaxIteration = toMap<true, 2, Container>(key, value, delimiter);
+    failed_parsing(parserMaxIteration, 10, "a=1, b=2, c=3");
+}
+
+TEST(Map, FlatMapContainer) {
+    FlatMap<std::string, int> ans{{"test", 1}, {"p", -3}};
+    testContainer<FlatMapContainer>(ans, ans);
+}
+
+TEST(Map, HashMapContainer) {
+    HashMap<std::string, int> ans{{"test", 1}, {"p", -3}};
+    testContainer<HashMapContainer>(ans, ans);
+}
+
+TEST(Map, PairVectorContainer) {
+    std::vector<std::pair<std::string, int>> ans{{"test", 1}, {"p", -3}};
+    std::vector<std::pair<std::string, int>> ansAll{{"p", -1}, {"test", 1}, {"p", -3}};
+    testContainer<PairVectorContainer>(ans, ansAll);
+}
@@ -1,6 +1,9 @@
 #include "../testHelper.h"
 
+#include <bit>
+#include <charconv>
 #include <cmath>
+#include <random>
 
 TEST(Number, ParseUnsigned) {
     auto parser = number<unsigned>();
@@ -73,3 +76,173 @@ TEST(Number, Digit) {
     failed_parsing(parser, 0, "abc");
     failed_parsing(parser, 0, "");
 }
+
+
+TEST(Number, IntegerLimits) {
+    success_parsing(number<int64_t>(), std::numeric_limits<int64_t>::min(), "-9223372036854775808", "");
+    success_parsing(number<int64_t>(), std::numeric_limits<int64_t>::max(), "9223372036854775807", "");
+    success_parsing(number<uint64_t>(), std::numeric_limits<uint64_t>::max(), "18446744073709551615x", "x");
+    success_parsing(number<int8_t>(), int8_t{-128}, "-128", "");
+    success_parsing(number<int>(), 12345678, "0000000000000000000000012345678", "");
+    success_parsing(number<int>(), 0, "-0", "");
+
+    failed_parsing(number<int64_t>(), 0, "-9223372036854775809");
+    failed_parsing(number<uint64_t>(), 0, "18446744073709551616");
+    failed_parsing(number<int8_t>(), 0, "128");
+    failed_parsing(number<unsigned>(), 0, "-1");
+    failed_parsing(number<int>(), 0, "-");
+}
+
+TEST(Number, DoubleEdgeCases) {
+    auto parser = number<double>();
+
+    success_parsing(parser, .5, ".5", "");
+    success_parsing(parser, 5., "5.e", "e");
+    success_parsing(parser, 1., "1e+", "e+");
+    success_parsing(parser, 1e300, "1e300", "");
+    success_parsing(parser, 4.9406564584124654e-324, "4.9406564584124654e-324", "");
+    success_parsing(parser, 2.2250738585072014e-308, "2.2250738585072014e-308", "");
+    success_parsing(parser, 0.1, "0.1000000000000000000000000000000000000001", "");
+    success_parsing(parser, 9007199254740993., "9007199254740993", "");
+    // exactly between two doubles, the following digit decides
+    success_parsing(parser, 9007199254740994., "9007199254740993.0000000000000000000000001", "");
+    success_parsing(parser, 0., "0.0000000000000000000000000000000000000000e999999999", "");
+    success_parsing(parser, -std::numeric_limits<double>::infinity(), "-Infinity", "");
+    success_parsing(parser, 0., "0x10", "x10");
+
+    failed_parsing(parser, 0, "1e309");
+    failed_parsing(parser, 0, "1e-400");
+    failed_parsing(parser, 0, ".");
+    failed_parsing(parser, 0, "-");
+    failed_parsing(parser, 0, "+1");
+    success_parsing(parser, std::numeric_limits<double>::infinity(), "info", "o");
+    failed_parsing(parser, 0, "in");
+}
+
+TEST(Number, JsonFormat) {
+    auto parser = number<double, NumberFormat::Json>();
+
+    success_parsing(parser, -12.5e3, "-12.5e3", "");
+    success_parsing(parser, 0., "01", "1");
+    success_parsing(parser, 1., "1.", ".");
+    success_parsing(parser, 1., "1.e5", ".e5");
+    success_parsing(parser, 0.25, "0.25E+0,", ",");
+
+    failed_parsing(parser, 0, ".5");
+    failed_parsing(parser, 0, "nan");
+    failed_parsing(parser, 0, "Infinity");
+    failed_parsing(parser, 0, "-.5");
+    EXPECT_FALSE(parser.firstSet().contains('.'));
+    EXPECT_FALSE(parser.firstSet().contains('n'));
+
+    success_parsing(number<int, NumberFormat::Json>(), 0, "012", "12");
+    success_parsing(number<int, NumberFormat::Json>(), -120, "-120", "");
+}
+
+/**
+ * The built-in parser must agree with from_chars on the shortest and the longest representations
+ */
+TEST(Number, RoundTrip) {
+    std::mt19937_64 gen{42};
+    for (size_t i = 0; i != 20000; ++i) {
+        double const expected = std::bit_cast<double>(gen());
+        float const expectedFloat = std::bit_cast<float>(static_cast<uint32_t>(gen()));
+        if (!std::isfinite(expected) || !std::isfinite(expectedFloat)) {
+            continue;
+        }
+        char buf[64];
+        auto end = std::to_chars(buf, buf + sizeof(buf), expected).ptr;
+        success_parsing(number<double>(), expected, std::string(buf, end), "");
+        end = std::to_chars(buf, buf + sizeof(buf), expectedFloat).ptr;
+        success_parsing(number<float>(), expectedFloat, std::string(buf, end), "");
+
+        end = std::to_chars(buf, buf + sizeof(buf), expected, std::chars_format::scientific, 30).ptr;
+        success_parsing(number<double>(), expected, std::string(buf, end), "");
+    }
+}
+
+/**
+ * Exact halfway points between two floats need all their digits (up to 767), they are rounded to even
+ */
+TEST(Number, HalfwayFallback) {
+    success_parsing(number<double>(), 9007199254740992., "9007199254740993.0000000000000000000000", "");
+    success_parsing(number<double>(), 9007199254740994., "9007199254740993.0000000000000000000001", "");
+    success_parsing(number<double>(), 9007199254740992., "9007199254740992.9999999999999999999999", "");
+    success_parsing(number<double>(), 9007199254740996., "9007199254740995.0000000000000000000000", "");
+    success_parsing(number<double>(), 9007199254740994., "9007199254740993" + std::string(800, '0') + "1e-801", "");
+
+    std::mt19937_64 gen{7};
+    char buf[1024];
+    if constexpr (std::numeric_limits<long double>::digits >= 64) {
+        // between zero and the smallest subnormal
+        failed_parsing(number<double>(), 0, std::string(buf, std::snprintf(buf, sizeof(buf), "%.780Le", std::ldexp(1.0L, -1075))));
+    }
+    for (size_t i = 0; i != 2000; ++i) {
+        double const lower = std::abs(std::bit_cast<double>(gen()));
+        double const upper = std::nextafter(lower, std::numeric_limits<double>::infinity());
+        if (!std::isfinite(upper)) {
+            continue;
+        }
+        bool const lowerIsEven = (std::bit_cast<uint64_t>(lower) & 1) == 0;
+
+        if constexpr (std::numeric_limits<long double>::digits >= 64) {
+            long double const halfway = (static_cast<long double>(lower) + upper) / 2;
+            auto const text = std::string(buf, std::snprintf(buf, sizeof(buf), "%.780Le", halfway));
+            success_parsing(number<double>(), lowerIsEven ? lower : upper, text, "");
+            auto const above = text.substr(0, text.find('e')) + "1" + text.substr(text.find('e'));
+            success_parsing(number<double>(), upper, above, "");
+            auto const below = std::string(buf, std::snprintf(buf, sizeof(buf), "%.780Le", std::nextafter(halfway, 0.0L)));
+            success_parsing(number<double>(), lower, below, "");
+        }
+
+        float const lowerFloat = std::abs(std::bit_cast<float>(static_cast<uint32_t>(gen())));
+        float const upperFloat = std::nextafter(lowerFloat, std::numeric_limits<float>::infinity());
+        if (std::isfinite(upperFloat)) {
+            double const halfway = (static_cast<double>(lowerFloat) + upperFloat) / 2;
+            auto const text = std::string(buf, std::snprintf(buf, sizeof(buf), "%.160e", halfway));
+            success_parsing(number<float>(), (std::bit_cast<uint32_t>(lowerFloat) & 1) == 0 ? lowerFloat : upperFloat, text, "");
+        }
+    }
+}
+
+TEST(Number, Decimal) {
+    auto parser = decimal<int64_t, 8>();
+
+    success_parsing(parser, Decimal<int64_t>{1468400, 8}, "0.01468400\"", "\"");
+    success_parsing(parser, Decimal<int64_t>{-125, 2}, "-1.25", "");
+    success_parsing(parser, Decimal<int64_t>{42, 0}, "42.x", ".x");
+    success_parsing(parser, Decimal<int64_t>{std::numeric_limits<int64_t>::min(), 0}, "-9223372036854775808", "");
+    success_parsing(parser, Decimal<int64_t>{922337203685477580, 1}, "00092233720368547758.0", "");
+    EXPECT_DOUBLE_EQ((Decimal<int64_t>{-125, 2}.to()), -1.25);
+
+    failed_parsing(parser, 0, "1.123456789");
+    failed_parsing(parser, 0, "9223372036854775808");
+    failed_parsing(parser, 0, "123456789012345678901.5");
+    failed_parsing(parser, 0, ".5");
+    failed_parsing(parser, 0, "-");
+    failed_parsing(decimal<unsigned>(), 0, "-1");
+}
+
+TEST(Number, FixedPoint) {
+    auto parser = fixedPoint<8>();
+
+    success_parsing(parser, int64_t{1468400}, "0.01468400", "");
+    success_parsing(parser, int64_t{150000000}, "1.5", "");
+    success_parsing(parser, int64_t{-300000000}, "-3,", ",");
+    success_parsing(fixedPoint<2, uint32_t>(), 4294967295u, "42949672.95", "");
+
+    failed_parsing(fixedPoint<2, uint32_t>(), 0, "42949673");
+    failed_parsing(parser, 0, "0.000000001");
+    failed_parsing(parser, 0, "x");
+
+    struct Trade {
+        int64_t price;
+        int64_t qty;
+    };
+    auto trade = liftM(details::MakeClass<Trade>{}, parser, charFrom(' ') >> fixedPoint<4>());
+    Stream s{"12.5 0.001"};
+    auto result = trade(s);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data().price, 1250000000);
+    EXPECT_EQ(result.data().qty, 10);
+}
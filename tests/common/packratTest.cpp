@@ -0,0 +1,106 @@
+#include "../testHelper.h"
+
+namespace {
+
+using CountedCtx = UnionCtx<ContextWrapper<HitCounterType<>>, PackratCtx>;
+
+/**
+ * S = (S)a | (S)b | x, every level without memoization parses (S) twice
+ */
+Parser<char, CountedCtx> nested() {
+    auto inner = packrat(hitCounter() >> charFrom('(') >> lazyCached<AutoTagT>(nested) << charFrom(')'));
+    return ((inner >> charFrom('a')) | (inner >> charFrom('b')) | charFrom('x')).toCommonType();
+}
+
+Parser<char, CountedCtx> nestedLazy() {
+    struct Tag;
+    auto inner = packrat<Tag>(hitCounter() >> charFrom('(') >> lazy(nestedLazy) << charFrom(')'));
+    return ((inner >> charFrom('a')) | (inner >> charFrom('b')) | charFrom('x')).toCommonType();
+}
+
+std::string nestedTextB(size_t depth) {
+    std::string out(depth, '(');
+    out += 'x';
+    for (size_t i = 0; i != depth; ++i) {
+        out += ")b";
+    }
+    return out;
+}
+
+}
+
+TEST(Packrat, Linear) {
+    constexpr size_t DEPTH = 16;
+    PackratTable table;
+    CountedCtx ctx{0u, table};
+
+    success_parsing(nested(), 'b', nestedTextB(DEPTH), "", ctx);
+    EXPECT_EQ(get<HitCounterType<>>(ctx), DEPTH + 1);
+    EXPECT_EQ(table.hits(), DEPTH + 1);
+}
+
+TEST(Packrat, Tag) {
+    constexpr size_t DEPTH = 16;
+    PackratTable table;
+    CountedCtx ctx{0u, table};
+
+    success_parsing(nestedLazy(), 'b', nestedTextB(DEPTH), "", ctx);
+    EXPECT_EQ(get<HitCounterType<>>(ctx), DEPTH + 1);
+}
+
+TEST(Packrat, Error) {
+    PackratTable table;
+    CountedCtx ctx{0u, table};
+    auto parser = nested();
+
+    failed_parsing(parser, 6, "((x)b)c", ctx);
+    success_parsing(parser, 'a', "((x)b)a", "", ctx);
+    success_parsing(parser, 'x', "x)b", ")b", ctx);
+}
+
+TEST(Packrat, Window) {
+    PackratTable table{1};
+    CountedCtx ctx{0u, table};
+    auto parser = nested();
+
+    EXPECT_EQ(table.window(), 1);
+    success_parsing(parser, 'b', nestedTextB(8), "", ctx);
+    success_parsing(parser, 'a', "(((x)b)a)a", "", ctx);
+    EXPECT_EQ(PackratTable{1000}.window(), 1024);
+}
+
+TEST(Packrat, Reset) {
+    PackratTable table;
+    PackratCtx ctx{table};
+    auto parser = packrat(number<int>());
+
+    std::string text = "123";
+    success_parsing(parser, 123, text, "", ctx);
+    success_parsing(parser, 123, text, "", ctx);
+    EXPECT_EQ(table.hits(), 1);
+
+    text = "45";
+    table.reset();
+    success_parsing(parser, 45, text, "", ctx);
+    EXPECT_EQ(table.hits(), 1);
+}
+
+TEST(Packrat, CachesOfTable) {
+    std::vector<decltype(packrat(number<int>()))> parsers;
+    for (size_t i = 0; i != 1000; ++i) {
+        parsers.push_back(packrat(number<int>()));
+    }
+
+    PackratTable table;
+    PackratCtx ctx{table};
+    success_parsing(parsers.back(), 12, "12", "", ctx);
+    success_parsing(parsers.front(), 12, "12", "", ctx);
+    success_parsing(parsers.back(), 12, "12", "", ctx);
+    EXPECT_EQ(table.caches(), 2);
+}
+
+TEST(Packrat, FirstSet) {
+    auto parser = packrat(charFrom('a', 'b'));
+    static_assert(decltype(parser)::hasFirstSet);
+    EXPECT_EQ(parser.firstSet(), charFrom('a', 'b').firstSet());
+}
\ No newline at end of file
@@ -131,3 +131,88 @@ TEST(String, escapedStringSame) {
     failed_parsing(parser, 1, R"("test"""")");
     failed_parsing(parser, 1, R"(")");
 }
+
+
+TEST(String, lettersLongWord) {
+    auto parser = letters<true, std::string>();
+
+    std::string word(100, 'a');
+    word[37] = 'Z';
+    word[70] = '7';
+    success_parsing(parser, word, word + " tail", " tail");
+    success_parsing(parser, word.substr(0, 63), word.substr(0, 63) + "\x80" + word, "\x80" + word);
+}
+
+TEST(String, untilLongText) {
+    auto parser = until<'\n'>();
+
+    std::string line(80, 'x');
+    success_parsing(parser, line, line + "\nnext", "\nnext");
+    success_parsing(parser, line + line, line + line, "");
+}
+
+TEST(String, skipCharsLongText) {
+    auto parser = skipChars<AnySpace{}>();
+
+    success_parsing(parser, {}, std::string(50, ' ') + "\t\n\r" + std::string(20, ' ') + "test", "test");
+}
+
+TEST(String, searchTextLongText) {
+    std::string text(70, 'a');
+    text += "ab:c";
+    text += std::string(70, 'b');
+    text += "ab:";
+
+    success_parsing(searchText("ab:"), {}, text, "c" + std::string(70, 'b') + "ab:");
+    success_parsing(searchText<"ab:"_prs>(), {}, text, "c" + std::string(70, 'b') + "ab:");
+    success_parsing(searchText<"ab:"_prs, true>(), {}, text, "ab:c" + std::string(70, 'b') + "ab:");
+
+    failed_parsing(searchText<"ab:d"_prs>(), 0, text);
+    failed_parsing(searchText("b:ca"), 0, text);
+}
+
+TEST(String, escapedStringView) {
+    auto parser = charFrom<'"'>() >> escapedStringView<'"', '\\'>();
+
+    success_parsing(parser, MaybeOwnedString{"test"}, R"("test")");
+    success_parsing(parser, MaybeOwnedString{R"(te"st)"}, R"("te\"st")");
+    success_parsing(parser, MaybeOwnedString{R"(te\"st)"}, R"("te\\\"st")");
+    success_parsing(parser, MaybeOwnedString{R"(te\)"}, R"("te\\"st")", R"(st")");
+
+    failed_parsing(parser, 1, R"("test)");
+    failed_parsing(parser, 1, R"("test\")");
+    failed_parsing(parser, 1, R"(")");
+
+    std::string longText = "\"" + std::string(100, 'a') + "\"tail";
+    Stream s{longText};
+    auto result = parser(s);
+    ASSERT_FALSE(result.isError());
+    EXPECT_FALSE(result.data().isOwned());
+    EXPECT_EQ(result.data().sv().data(), longText.data() + 1);
+    EXPECT_EQ(s.remaining(), "tail");
+
+    Stream escaped{R"("a\"b")"};
+    auto escapedResult = parser(escaped);
+    ASSERT_FALSE(escapedResult.isError());
+    EXPECT_TRUE(escapedResult.data().isOwned());
+}
+
+TEST(String, escapedStringViewSame) {
+    auto parser = charFrom('"') >> escapedStringView<'"', '"'>();
+
+    success_parsing(parser, MaybeOwnedString{"test"}, R"("test")");
+    success_parsing(parser, MaybeOwnedString{R"(te"st)"}, R"("te""st")");
+    success_parsing(parser, MaybeOwnedString{R"(te""st)"}, R"("te""""st")");
+    success_parsing(parser, MaybeOwnedString{R"(te")"}, R"("te"""st")", R"(st")");
+
+    failed_parsing(parser, 1, R"("test)");
+    failed_parsing(parser, 1, R"("test"")");
+    failed_parsing(parser, 1, R"(")");
+}
+
+TEST(String, escapedStringLongText) {
+    auto parser = charFrom<'"'>() >> escapedString<'"', '\\'>();
+
+    std::string body(50, 'x');
+    success_parsing(parser, body + "\"" + body, "\"" + body + "\\\"" + body + "\"");
+}
@@ -0,0 +1,53 @@
+#include "../testHelper.h"
+
+
+TEST(CharSet, Contains) {
+    constexpr auto set = CharSet::anyOf(FromRange('a', 'c'), 'x', '\xF0');
+
+    static_assert(set.contains('a'));
+    static_assert(set.contains('c'));
+    static_assert(!set.contains('d'));
+    static_assert(set.contains('\xF0'));
+    static_assert(set.hasSimdRanges());
+
+    EXPECT_FALSE(set.inverse().contains('b'));
+    EXPECT_TRUE(set.inverse().contains('\0'));
+}
+
+TEST(CharSet, PrefixLengthSameAsScalar) {
+    constexpr auto set = CharSet::anyOf(FromRange('a', 'z'), FromRange('0', '9'), '_');
+
+    std::string text;
+    for (size_t i = 0; i != 300; ++i) {
+        text += static_cast<char>('a' + i % 26);
+    }
+
+    for (size_t stop = 0; stop != text.size(); ++stop) {
+        for (char stopSymbol : {'-', '\xFF', '\0'}) {
+            auto str = text;
+            str[stop] = stopSymbol;
+            EXPECT_EQ(set.prefixLength(str), stop);
+            EXPECT_EQ(set.prefixLengthScalar(str.data(), str.data() + str.size()), stop);
+        }
+    }
+
+    EXPECT_EQ(set.prefixLength(text), text.size());
+    EXPECT_EQ(set.prefixLength(""), 0);
+}
+
+TEST(CharSet, ManyRangesUseScalar) {
+    constexpr auto set = CharSet::fromPredicate([](char c) {
+        return c % 2 == 0;
+    });
+
+    static_assert(!set.hasSimdRanges());
+    EXPECT_EQ(set.prefixLength(std::string_view("\x02\x04\x06\x07")), 3);
+}
+
+TEST(CharSet, StreamTakeWhile) {
+    Stream s{"   \t test"};
+    EXPECT_EQ(s.takeWhile(CharSet::anyOf(AnySpace{})), "   \t ");
+    EXPECT_EQ(s.remaining(), "test");
+    EXPECT_EQ(s.takeWhile(CharSet::anyOf(' ')), "");
+    EXPECT_EQ(s.pos(), 5);
+}
@@ -0,0 +1,78 @@
+#include "../testHelper.h"
+
+
+TEST(Erased, Common) {
+    auto parser = (charFrom('a') >> number<int>()).toErased();
+    static_assert(std::is_same_v<decltype(parser), ErasedParser<int>>);
+    static_assert(!std::is_copy_constructible_v<decltype(parser)>);
+    static_assert(std::is_move_constructible_v<decltype(parser)>);
+
+    success_parsing(parser.ref(), 12, "a12b", "b");
+    failed_parsing(parser.ref(), 0, "b12");
+
+    auto moved = std::move(parser);
+    success_parsing(moved.ref(), 3, "a3", "");
+}
+
+TEST(Erased, InlineSize) {
+    auto parser = literal("abc").toErased<sizeof(literal("abc"))>();
+    static_assert(sizeof(parser) <= sizeof(literal("abc")) + alignof(std::max_align_t) + 2 * sizeof(void*));
+
+    Stream s{"abcd"};
+    auto result = parser(s);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(s.remaining(), "d");
+}
+
+TEST(Erased, Context) {
+    using Ctx = ContextWrapper<HitCounterType<>>;
+    auto parser = (charFrom('a') >> hitCounter()).repeat().toErased();
+    static_assert(std::is_same_v<decltype(parser), ErasedParser<std::vector<Unit>, Ctx>>);
+
+    Ctx ctx{0};
+    Stream s{"aaab"};
+    auto result = parser(s, ctx);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data().size(), 3);
+    EXPECT_EQ(ctx.get(), 3);
+}
+
+TEST(Erased, Ref) {
+    auto base = number<int>();
+    auto ref = base.ref();
+    static_assert(std::is_same_v<decltype(ref), ParserRef<int>>);
+    static_assert(std::is_trivially_copyable_v<decltype(ref)>);
+
+    auto parser = concat(ref, charFrom(',') >> ref);
+    success_parsing(parser, {1, 2}, "1,2", "");
+}
+
+namespace {
+
+struct ErasedTestTag {};
+
+ErasedParser<char> makeErased() {
+    return (charFrom('A') >> (charFrom('B') | lazyCached<ErasedTestTag>(makeErased))).toErased();
+}
+
+struct ErasedBindingTag;
+
+auto makeErasedBinding() {
+    return (charFrom('A') >> (charFrom('B') | lazyCtxBinding<char, ErasedBindingTag>())).toErased();
+}
+
+}
+
+TEST(Erased, LazyCached) {
+    auto parser = lazyCached<ErasedTestTag>(makeErased);
+    success_parsing(parser, 'B', "AAAB", "");
+    failed_parsing(parser, 3, "AAAC");
+}
+
+TEST(Erased, LazyCtxBinding) {
+    auto const parser = makeErasedBinding();
+    auto lazyBindingStorage = makeBindingCtx<char, GetParserCtx<decltype(parser)>, ErasedBindingTag>(parser);
+    auto ctx = parser.makeCtx(lazyBindingStorage);
+    success_parsing(parser.ref(), 'B', "AAAAAB", "", ctx);
+    failed_parsing(parser.ref(), 4, "AAAAC", ctx);
+}
\ No newline at end of file
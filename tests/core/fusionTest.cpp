@@ -0,0 +1,82 @@
+#include "../testHelper.h"
+
+namespace {
+
+template <ParserType P>
+constexpr bool isFused = details::IsFused<details::UnwrapFirstSet<typename P::StoredFn>>;
+
+/**
+ * The fused and the not fused parsers must give the same result, the same remaining and the same error
+ */
+template <ParserType Fused, ParserType Plain>
+void expect_same(Fused const& fused, Plain const& plain, std::string_view str,
+                 details::SourceLocation sourceLocation = details::SourceLocation::current()) {
+    Stream fusedStream{str};
+    Stream plainStream{str};
+    auto fusedResult = fused(fusedStream);
+    auto plainResult = plain(plainStream);
+
+    ASSERT_EQ(fusedResult.isError(), plainResult.isError()) << "Test: " << sourceLocation.prettyPrint();
+    if (fusedResult.isError()) {
+        EXPECT_EQ(fusedResult.error().pos, plainResult.error().pos) << "Test: " << sourceLocation.prettyPrint();
+        EXPECT_EQ(fusedStream.generateErrorText(fusedResult.error()), plainStream.generateErrorText(plainResult.error()))
+            << "Test: " << sourceLocation.prettyPrint();
+    } else {
+        EXPECT_EQ(fusedResult.data(), plainResult.data()) << "Test: " << sourceLocation.prettyPrint();
+        EXPECT_EQ(fusedStream.pos(), plainStream.pos()) << "Test: " << sourceLocation.prettyPrint();
+    }
+}
+
+}
+
+TEST(Fusion, Chars) {
+    auto parser = charFrom('(') >> charFrom('a', 'b') << charFrom(')');
+    static_assert(isFused<decltype(parser)>);
+    auto plain = charFrom('(').toCommonType() >> charFrom('a', 'b').toCommonType() << charFrom(')').toCommonType();
+    static_assert(!isFused<decltype(plain)>);
+
+    success_parsing(parser, 'b', "(b)rest", "rest");
+    for (auto str : {"(a)", "(b)", "(c)", "(a", "(", "", "[a)", "(a]"}) {
+        expect_same(parser, plain, str);
+    }
+}
+
+TEST(Fusion, Literals) {
+    auto parser = literal<"ABC"_prs>() >> literal<"DE"_prs>() << literal("F") << charFrom(';');
+    static_assert(isFused<decltype(parser)>);
+    auto plain = literal<"ABC"_prs>().toCommonType() >> literal<"DE"_prs>().toCommonType() << literal("F").toCommonType() << charFrom(';').toCommonType();
+
+    success_parsing(parser, "DE", "ABCDEF;", "");
+    for (auto str : {"ABCDEF;", "ABCDEF", "ABCDE", "ABCDF;", "ABDEF;", "", "ABCDEF;;"}) {
+        expect_same(parser, plain, str);
+    }
+}
+
+TEST(Fusion, ResultIndex) {
+    auto keepLeft = (charFrom('a') << charFrom('b')) << (charFrom('c') >> charFrom('d'));
+    auto nested = charFrom('a') >> (charFrom('b') << charFrom('c'));
+    auto runtime = literal<std::string>("xy") << charFrom('!');
+    static_assert(isFused<decltype(keepLeft)> && isFused<decltype(nested)> && isFused<decltype(runtime)>);
+
+    success_parsing(keepLeft, 'a', "abcd");
+    success_parsing(nested, 'b', "abc");
+    success_parsing(runtime, std::string("xy"), "xy!");
+    failed_parsing(nested, 2, "abd");
+}
+
+TEST(Fusion, FirstSet) {
+    auto parser = charFrom('x', 'y') >> literal<"z"_prs>();
+    EXPECT_TRUE(parser.firstSet().contains('x'));
+    EXPECT_TRUE(parser.firstSet().contains('y'));
+    EXPECT_FALSE(parser.firstSet().contains('z'));
+
+    auto withEmpty = literal<""_prs>() >> charFrom('q');
+    EXPECT_TRUE(withEmpty.firstSet().contains('q'));
+    success_parsing(withEmpty, 'q', "q");
+}
+
+TEST(Fusion, NotPrimitive) {
+    auto parser = charFrom('(') >> number<int>() << charFrom(';');
+    static_assert(!isFused<decltype(parser)>);
+    success_parsing(parser, 12, "(12;");
+}
\ No newline at end of file
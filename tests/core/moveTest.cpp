@@ -0,0 +1,105 @@
+#include "../testHelper.h"
+
+#include <map>
+
+namespace {
+
+/**
+ * Counts copies of heavy results, moves are free
+ */
+struct Counted {
+    static inline size_t copies = 0;
+
+    Counted() = default;
+
+    explicit Counted(std::string v)
+        : value(std::move(v)) {}
+
+    Counted(Counted const& other)
+        : value(other.value) {
+        ++copies;
+    }
+
+    Counted(Counted&&) noexcept = default;
+
+    Counted& operator=(Counted const& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    Counted& operator=(Counted&&) noexcept = default;
+
+    bool operator==(Counted const&) const = default;
+    auto operator<=>(Counted const&) const = default;
+
+    std::string value;
+};
+
+auto word() {
+    return letters().fmap([](std::string_view sv) {
+        return Counted{std::string(sv)};
+    });
+}
+
+template <typename Parser, typename Ctx = VoidContext>
+void expect_no_copies(Parser parser, std::string_view str, Ctx& ctx = VOID_CONTEXT,
+                      details::SourceLocation sourceLocation = details::SourceLocation::current()) {
+    Stream s{str};
+    Counted::copies = 0;
+    auto result = parser.apply(s, ctx);
+    ASSERT_FALSE(result.isError()) << "Test: " << sourceLocation.prettyPrint();
+    [[maybe_unused]] auto const data = std::move(result).data();
+    EXPECT_EQ(Counted::copies, 0) << "Test: " << sourceLocation.prettyPrint();
+}
+
+}
+
+TEST(Move, Operators) {
+    expect_no_copies(word(), "abc");
+    expect_no_copies(charFrom('(') >> word() << charFrom(')'), "(abc)");
+    expect_no_copies((word() << charFrom(';')).toCommonType(), "abc;");
+    expect_no_copies(word() | word(), "abc");
+    expect_no_copies(word().maybe(), "abc");
+    expect_no_copies(word().mustConsume(), "abc");
+    expect_no_copies(word().cond([](Counted const& c) {
+        return !c.value.empty();
+    }), "abc");
+    expect_no_copies(word().cond([](Counted const&, Stream& s) {
+        return s.eos();
+    }), "abc");
+    expect_no_copies(word().endOfStream(), "abc");
+    // the value is moved to the function
+    expect_no_copies(word().bind([](Counted c) {
+        return charFrom(c.value.empty() ? '?' : ';');
+    }), "abc;");
+}
+
+TEST(Move, Context) {
+    using Ctx = ContextWrapper<size_t>;
+    Ctx ctx{size_t{3}};
+    expect_no_copies(word().condC<Ctx>([](Counted const& c, Ctx& ctx) {
+        return c.value.size() == get<size_t>(ctx);
+    }), "abc", ctx);
+    expect_no_copies(word().condC<Ctx>([](Counted const& c, Ctx&) {
+        return true;
+    }) << charFrom(';'), "abc;", ctx);
+}
+
+TEST(Move, Containers) {
+    auto words = word().repeat(charFrom(','));
+    expect_no_copies(words, "a,bb,ccc");
+    expect_no_copies((word() << charFrom(',')).repeat(), "a,bb,ccc,");
+    expect_no_copies(toMap(word() << charFrom('='), word(), charFrom(',')), "a=b,c=d");
+    expect_no_copies(concat(word(), charFrom(' ') >> word()), "ab cd");
+
+    struct Pair {
+        Counted first;
+        std::vector<Counted> second;
+    };
+    expect_no_copies(liftM(details::MakeClass<Pair>{}, word(), charFrom(' ') >> words), "ab cd,ef");
+    expect_no_copies(liftM([](Counted a, std::vector<Counted> b) {
+        b.push_back(std::move(a));
+        return b;
+    }, word(), charFrom(' ') >> words), "ab cd,ef");
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "../testHelper.h"
+
+
+TEST(ParseInto, Repeat) {
+    auto parser = charFrom('[') >> number<int>().repeat(charFrom(',')) << charFrom(']');
+    std::vector<int> out;
+    Stream s{"[1,2,3,4]"};
+    ASSERT_FALSE(parser.parseInto(s, out).isError());
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4}));
+
+    auto const* data = out.data();
+    Stream s2{"[5,6]rest"};
+    ASSERT_FALSE(parser.parseInto(s2, out).isError());
+    EXPECT_EQ(out, (std::vector<int>{5, 6}));
+    EXPECT_EQ(out.data(), data);
+    EXPECT_EQ(s2.remaining(), "rest");
+
+    Stream s3{"[5,6"};
+    EXPECT_TRUE(parser.parseInto(s3, out).isError());
+    EXPECT_EQ(s3.pos(), 4);
+}
+
+TEST(ParseInto, NestedStrings) {
+    auto word = escapedString<'"'>();
+    auto parser = (charFrom('"') >> word).repeat(charFrom(','));
+    std::vector<std::string> out;
+    Stream s{"\"a long enough string to be on the heap\",\"b\\\"\""};
+    ASSERT_FALSE(parser.parseInto(s, out).isError());
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[1], "b\"");
+
+    auto const* data = out[0].data();
+    Stream s2{"\"short\""};
+    ASSERT_FALSE(parser.parseInto(s2, out).isError());
+    EXPECT_EQ(out, std::vector<std::string>{"short"});
+    EXPECT_EQ(out[0].data(), data);
+
+    std::string str;
+    Stream s3{"x\\\"y\"z"};
+    ASSERT_FALSE(word.parseInto(s3, str).isError());
+    EXPECT_EQ(str, "x\"y");
+    EXPECT_EQ(s3.remaining(), "z");
+}
+
+TEST(ParseInto, Map) {
+    auto parser = toMap<true, MAX_ITERATION, HashMapContainer>(letters() << charFrom('='), number<int>(), charFrom(','));
+    HashMap<std::string_view, int> out;
+    Stream s{"a=1,b=2,a=3"};
+    ASSERT_FALSE(parser.parseInto(s, out).isError());
+    EXPECT_EQ(out, (HashMap<std::string_view, int>{{"a", 3}, {"b", 2}}));
+
+    Stream s2{"c=4"};
+    ASSERT_FALSE(parser.parseInto(s2, out).isError());
+    EXPECT_EQ(out, (HashMap<std::string_view, int>{{"c", 4}}));
+    EXPECT_FALSE(out.contains("a"));
+
+    std::map<std::string_view, int> map;
+    Stream s3{"x=1,y="};
+    EXPECT_TRUE(toMap(letters() << charFrom('='), number<int>(), charFrom(',')).parseInto(s3, map).isError());
+}
+
+TEST(ParseInto, Context) {
+    using Ctx = ContextWrapper<size_t>;
+    Ctx ctx{size_t{0}};
+    auto counted = number<int>().condC<Ctx>([](int, Ctx& ctx) {
+        ++get<size_t>(ctx);
+        return true;
+    });
+    auto parser = counted.repeat(charFrom(';'));
+    std::vector<int> out{7, 7, 7};
+    Stream s{"1;2"};
+    ASSERT_FALSE(parser.parseInto(s, ctx, out).isError());
+    EXPECT_EQ(out, (std::vector<int>{1, 2}));
+    EXPECT_EQ(get<size_t>(ctx), 2);
+
+    // parsers without the reuse assign the result
+    int value = 0;
+    Stream s2{"42"};
+    ASSERT_FALSE(number<int>().parseInto(s2, value).isError());
+    EXPECT_EQ(value, 42);
+}
@@ -0,0 +1,265 @@
+#include "../testHelper.h"
+
+#include <cstdio>
+#include <thread>
+
+
+TEST(ParsingError, LazyFormat) {
+    using Error = details::LazyParsingError;
+    static_assert(std::is_trivially_copyable_v<Error>);
+    static_assert(sizeof(Error) == 6 * sizeof(size_t));
+
+    EXPECT_EQ(Error{3}.getDescription(), "");
+    EXPECT_EQ(Error("satisfy eq", 3).getDescription(), "satisfy eq");
+    EXPECT_EQ(Error::quoted("Cannot find", "abc", 3).getDescription(), "Cannot find 'abc'");
+
+    auto const orError = Error::orError(Error("satisfy eq", 5), Error("satisfy eos", 5));
+    EXPECT_EQ(orError.pos, 5);
+    EXPECT_EQ(orError.getDescription(), "Expected one of: satisfy eq, satisfy eos");
+
+    auto const internal = Error::internalError(orError, 10);
+    EXPECT_EQ(internal.pos, 10);
+    EXPECT_EQ(internal.getDescription(), "Internal parser fail: Expected one of: satisfy eq, satisfy eos");
+}
+
+TEST(ParsingError, LazyFurthestFailure) {
+    using Error = details::LazyParsingError;
+
+    auto const further = Error::orError(Error("satisfy eq", 3), Error("Empty word", 5));
+    EXPECT_EQ(further.pos, 5);
+    EXPECT_EQ(further.getDescription(), "Empty word");
+    EXPECT_EQ(Error::orError(further, Error("satisfy eos", 1)).getDescription(), "Empty word");
+
+    Error merged{"a", 7};
+    for (auto const& other : {Error("b", 7), Error("a", 7), Error("c", 7), Error("d", 7), Error("e", 7), Error("f", 7)}) {
+        merged = Error::orError(merged, other);
+    }
+    EXPECT_EQ(merged.count, Error::MAX_EXPECTED);
+    EXPECT_EQ(merged.getDescription(), "Expected one of: a, b, c, d, ...");
+}
+
+TEST(ParsingError, LazyRuntimeText) {
+    using Error = details::LazyParsingError;
+    static_assert(!std::is_constructible_v<Error, std::string, size_t>);
+    static_assert(!std::is_constructible_v<Error, std::string_view, size_t>);
+
+    Error const error = [] {
+        std::string const text(40, 'x');
+        return Error::quoted(details::StaticText::intern(text), details::StaticText::intern(text + "y"), 2);
+    }();
+    EXPECT_EQ(error.getDescription(), std::string(40, 'x') + " '" + std::string(40, 'x') + "y'");
+    EXPECT_EQ(details::StaticText::intern(std::string(40, 'x')).c_str(), error.expected[0]);
+
+    // the parsers with their copies of the texts are destroyed before the errors are printed
+    auto const failed = [] {
+        Stream stream{"abc"};
+        return fail(std::string(40, 'z'))(stream);
+    }();
+    auto const notFound = [] {
+        Stream stream{"abc"};
+        return searchText(std::string(20, 'w'))(stream);
+    }();
+    ASSERT_TRUE(failed.isError());
+    ASSERT_TRUE(notFound.isError());
+    if constexpr (!DISABLE_ERROR_LOG) {
+        EXPECT_EQ(std::string(failed.error().getDescription()), std::string(40, 'z'));
+        EXPECT_EQ(std::string(notFound.error().getDescription()), "Cannot find '" + std::string(20, 'w') + "'");
+    }
+}
+
+TEST(ParsingError, ErrorTextOfParser) {
+    std::string const text(30, 'q');
+    auto const check = [&text](auto const& kept) {
+        if constexpr (DISABLE_ERROR_LOG) {
+            EXPECT_EQ(kept.sv(), "");
+        } else if constexpr (details::STATIC_ERROR_TEXT) {
+            EXPECT_EQ(kept.c_str(), details::StaticText::intern(text).c_str());
+        } else {
+            // the parser and its errors share one copy
+            auto const error = details::ParsingError{kept, 1};
+            EXPECT_EQ(std::string(error.getDescription()), text);
+            EXPECT_EQ(kept.use_count(), 2);
+        }
+    };
+    check(details::keepErrorText(text));
+}
+
+TEST(ParsingError, SharedText) {
+    using Error = details::ParsingErrorT<false>;
+    auto const shared = [](std::string text) {
+        return std::make_shared<std::string const>(std::move(text));
+    };
+
+    std::weak_ptr<std::string const> weak;
+    {
+        auto text = shared("runtime " + std::to_string(42));
+        weak = text;
+        Error const error{std::move(text), 3};
+        EXPECT_EQ(error.getDescription(), "runtime 42");
+
+        auto const merged = Error::orError(Error{"satisfy eq", 3}, error);
+        EXPECT_EQ(merged.getDescription(), "Expected one of: satisfy eq, runtime 42");
+        // only one runtime text is kept
+        EXPECT_EQ(Error::orError(merged, Error{shared("other"), 3}).getDescription(), "Expected one of: satisfy eq, runtime 42, ...");
+        EXPECT_EQ(Error::orError(Error{shared("other"), 3}, merged).getDescription(), "Expected one of: other, satisfy eq, ...");
+        EXPECT_EQ(Error::orError(error, Error{shared("runtime 42"), 3}).getDescription(), "runtime 42");
+
+        Error moved = merged;
+        Error const target = std::move(moved);
+        EXPECT_EQ(moved.getDescription(), target.getDescription());
+        EXPECT_EQ(Error::internalError(target, 5).getDescription(), "Internal parser fail: Expected one of: satisfy eq, runtime 42");
+        EXPECT_EQ(Error::quoted("Cannot find", shared("abc"), 1).getDescription(), "Cannot find 'abc'");
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(ParsingError, Compact) {
+    using Error = details::CompactParsingError;
+
+    EXPECT_EQ(Error{3}.getDescription(), "");
+    EXPECT_EQ(Error("satisfy eq", 3).getDescription(), "satisfy eq");
+    EXPECT_EQ(Error::quoted("Cannot find", "abc", 3).getDescription(), "Cannot find 'abc'");
+
+    auto const orError = Error::orError(Error("satisfy eq", 5), Error("satisfy eos", 5));
+    EXPECT_EQ(orError.pos, 5);
+    EXPECT_EQ(orError.getDescription(), "Expected one of: satisfy eq, satisfy eos");
+    EXPECT_EQ(Error::orError(orError, Error("Empty word", 1)).getDescription(), orError.getDescription());
+    EXPECT_EQ(Error::internalError(orError, 10).pos, 10);
+
+    // copies share the description
+    Error copy = orError;
+    {
+        Error const scoped = copy;
+        copy = Error("Empty word", 7);
+        EXPECT_EQ(scoped.getDescription(), "Expected one of: satisfy eq, satisfy eos");
+    }
+    EXPECT_EQ(copy.getDescription(), "Empty word");
+    EXPECT_EQ(orError.getDescription(), "Expected one of: satisfy eq, satisfy eos");
+}
+
+TEST(ParsingError, CompactThreads) {
+    using Error = details::CompactParsingError;
+    Error const shared{"satisfy eq", 1};
+
+    // the copies are made concurrently, the last ones are released by the threads without own errors
+    std::vector<std::thread> threads;
+    std::vector<std::vector<Error>> copies(4);
+    for (auto& local : copies) {
+        threads.emplace_back([&shared, &local] {
+            for (size_t i = 0; i != 1000; ++i) {
+                local.push_back(shared);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    std::vector<Error> own;
+    for (size_t i = 0; i != 100; ++i) {
+        own.push_back(Error{"satisfy eos", i});
+    }
+    threads.emplace_back([own = std::move(own), &copies]() mutable {
+        own.clear();
+        copies.clear();
+    });
+    threads.front().join();
+    EXPECT_EQ(shared.getDescription(), "satisfy eq");
+}
+
+TEST(ParsingError, CompactResult) {
+    using Error = details::CompactParsingError;
+    static_assert(sizeof(Error) == 2 * sizeof(size_t));
+    static_assert(sizeof(Expected<char, Error>) <= 3 * sizeof(size_t));
+    static_assert(sizeof(Expected<Drop, Error>) == sizeof(Error));
+
+    Expected<Drop, Error> const success{Drop{}};
+    EXPECT_FALSE(success.isError());
+    Expected<Drop, Error> const failure{Error{"satisfy eq", 4}};
+    ASSERT_TRUE(failure.isError());
+    EXPECT_EQ(failure.error().pos, 4);
+    EXPECT_TRUE((Expected<Drop, Error>{Error{4}}.isError()));
+
+    auto const mapped = failure.map([](Drop) {
+        return 1;
+    });
+    ASSERT_TRUE(mapped.isError());
+    EXPECT_EQ(mapped.error().getDescription(), "satisfy eq");
+}
+
+TEST(ParsingError, OrError) {
+    auto parser = charFrom<'a'>() | charFrom<'b'>() | letters<false>().fmap([](auto) { return 'c'; });
+    Stream stream{"123"};
+    auto const result = parser(stream);
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(result.error().pos, 0);
+
+    if constexpr (!DISABLE_ERROR_LOG) {
+        auto const text = stream.generateErrorText(result.error());
+        EXPECT_NE(text.find("Expected one of: satisfy eq, Empty word"), std::string::npos) << text;
+    }
+    static_assert(!LAZY_ERROR_LOG || COMPACT_ERROR || std::is_trivially_copyable_v<details::ParsingError>, "| merges errors without allocations");
+}
+
+TEST(ParsingError, RuntimeMakeError) {
+    auto const check = [](auto parser) {
+        using P = decltype(parser);
+        constexpr bool runtimeText = requires(std::string const& text) {
+            P::makeError(text, 0);
+        };
+        static_assert(runtimeText == !details::STATIC_ERROR_TEXT);
+
+        if constexpr (runtimeText) {
+            auto const result = [] {
+                std::string const text = "runtime " + std::to_string(42);
+                return P::makeError(text, 3);
+            }();
+            ASSERT_TRUE(result.isError());
+            EXPECT_EQ(result.error().pos, 3);
+            if constexpr (!DISABLE_ERROR_LOG) {
+                EXPECT_EQ(std::string(result.error().getDescription()), "runtime 42");
+            }
+
+            auto const formatted = [] {
+                char buffer[32];
+                std::snprintf(buffer, sizeof(buffer), "formatted %d", 42);
+                return P::makeError(buffer, 4);
+            }();
+            ASSERT_TRUE(formatted.isError());
+            EXPECT_EQ(formatted.error().pos, 4);
+            if constexpr (!DISABLE_ERROR_LOG) {
+                EXPECT_EQ(std::string(formatted.error().getDescription()), "formatted 42");
+            }
+        }
+
+        static constexpr char constant[] = "constant array";
+        auto const result = P::makeError(constant, 5);
+        ASSERT_TRUE(result.isError());
+        if constexpr (!DISABLE_ERROR_LOG) {
+            EXPECT_EQ(std::string(result.error().getDescription()), "constant array");
+        }
+    };
+    check(success());
+}
+
+TEST(ParsingError, FurthestFailure) {
+    auto parser = (charFrom<'a'>() >> charFrom<'b'>() >> charFrom<'c'>()) | (charFrom<'a'>() >> charFrom<'x'>());
+    Stream stream{"abd"};
+    auto const result = parser(stream);
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(result.error().pos, 2);
+
+    if constexpr (!DISABLE_ERROR_LOG) {
+        EXPECT_EQ(std::string(result.error().getDescription()), "satisfy eq");
+    }
+}
+
+TEST(ParsingError, SearchText) {
+    Stream stream{"abc"};
+    auto const result = searchText<"xyz"_prs>()(stream);
+    ASSERT_TRUE(result.isError());
+    if constexpr (!DISABLE_ERROR_LOG) {
+        EXPECT_EQ(std::string(result.error().getDescription()), "Cannot find 'xyz'");
+    }
+}
\ No newline at end of file
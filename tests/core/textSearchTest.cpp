@@ -0,0 +1,33 @@
+#include "../testHelper.h"
+
+
+TEST(TextSearch, SameAsFind) {
+    std::string text;
+    for (size_t i = 0; i != 500; ++i) {
+        text += static_cast<char>('a' + (i * i * 13 + 7 * i) % 5);
+    }
+
+    for (size_t start = 0; start < text.size(); start += 37) {
+        for (size_t len : {1, 2, 3, 5, 8, 17, 40}) {
+            auto const pattern = std::string_view(text).substr(start, len);
+            for (size_t from : {size_t(0), start / 2, start}) {
+                auto const sv = std::string_view(text).substr(from);
+                EXPECT_EQ(details::findText(sv, pattern), sv.find(pattern)) << pattern;
+            }
+        }
+    }
+
+    EXPECT_EQ(details::findText(text, "ac" + std::string(20, 'e')), std::string_view::npos);
+    EXPECT_EQ(details::findText(text, ""), 0);
+    EXPECT_EQ(details::findText("", "a"), std::string_view::npos);
+}
+
+TEST(TextSearch, StaticExtent) {
+    std::string text(100, 'x');
+    text += "needle";
+    text += std::string(100, 'y');
+
+    constexpr auto pattern = "needle"_prs;
+    EXPECT_EQ(details::findText<pattern.size()>(text, pattern.sv()), 100);
+    EXPECT_EQ(details::findText<pattern.size()>(std::string_view(text).substr(101), pattern.sv()), std::string_view::npos);
+}
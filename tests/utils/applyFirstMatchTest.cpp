@@ -125,4 +125,106 @@ TEST(ApplyFirstMatch, ReferenceNonConst) {
     static_assert(std::is_same_v<decltype(ans2), int const&>);
     EXPECT_EQ(ans2, 3);
     EXPECT_EQ(std::addressof(ans2), std::addressof(unhandled));
+}
+
+namespace {
+
+enum class Colour {
+    C0, C1, C2, C3, C4, C5, C6, C7, C8, C9
+};
+
+template <size_t ...Is>
+constexpr auto makeIdentityMatch(int step, std::index_sequence<Is...>) {
+    return details::makeFirstMatch(-1, std::make_tuple(static_cast<int>(Is) * step, static_cast<int>(Is))...);
+}
+
+}
+
+TEST(ApplyFirstMatch, Strategy) {
+    using namespace std::string_view_literals;
+    using details::FirstMatchStrategy;
+
+    static_assert(decltype(makeIdentityMatch(1, std::make_index_sequence<8>{}))::strategy == FirstMatchStrategy::Linear);
+    static_assert(decltype(makeIdentityMatch(1, std::make_index_sequence<9>{}))::strategy == FirstMatchStrategy::Integral);
+
+    auto strings = details::makeFirstMatch(0, std::make_tuple("a"sv, 1), std::make_tuple("b"sv, 2), std::make_tuple("c"sv, 3)
+            , std::make_tuple("d"sv, 4), std::make_tuple("e"sv, 5), std::make_tuple("f"sv, 6)
+            , std::make_tuple("g"sv, 7), std::make_tuple("h"sv, 8), std::make_tuple("i"sv, 9));
+    static_assert(decltype(strings)::strategy == FirstMatchStrategy::String);
+
+    auto mixed = details::makeFirstMatch(0, std::make_tuple(1, 1), std::make_tuple(2, 2), std::make_tuple(3, 3)
+            , std::make_tuple(4, 4), std::make_tuple(5, 5), std::make_tuple(6, 6)
+            , std::make_tuple(7, 7), std::make_tuple(8, 8), std::make_tuple(9L, 9));
+    static_assert(decltype(mixed)::strategy == FirstMatchStrategy::Linear);
+    EXPECT_EQ(mixed.apply(9), 9);
+}
+
+TEST(ApplyFirstMatch, DenseTable) {
+    constexpr auto applyFirstMatch = makeIdentityMatch(1, std::make_index_sequence<32>{});
+
+    static_assert(applyFirstMatch.apply(0) == 0);
+    static_assert(applyFirstMatch.apply(31) == 31);
+    for (int i = 0; i != 32; ++i) {
+        EXPECT_EQ(applyFirstMatch.apply(i), i);
+    }
+    EXPECT_EQ(applyFirstMatch.apply(-1), -1);
+    EXPECT_EQ(applyFirstMatch.apply(32), -1);
+    EXPECT_EQ(applyFirstMatch.apply(5u), 5);
+    EXPECT_EQ(applyFirstMatch.apply(5L), 5);
+    EXPECT_EQ(applyFirstMatch.apply(std::numeric_limits<int64_t>::max()), -1);
+    EXPECT_EQ(applyFirstMatch.apply(std::numeric_limits<uint64_t>::max()), -1);
+}
+
+TEST(ApplyFirstMatch, BinarySearch) {
+    constexpr auto applyFirstMatch = makeIdentityMatch(-1000, std::make_index_sequence<32>{});
+
+    static_assert(applyFirstMatch.apply(-31000) == 31);
+    for (int i = 0; i != 32; ++i) {
+        EXPECT_EQ(applyFirstMatch.apply(-1000 * i), i);
+        EXPECT_EQ(applyFirstMatch.apply(-1000 * i + 1), -1);
+    }
+    EXPECT_EQ(applyFirstMatch.apply(std::numeric_limits<int>::min()), -1);
+    EXPECT_EQ(applyFirstMatch.apply(std::numeric_limits<int>::max()), -1);
+}
+
+TEST(ApplyFirstMatch, EqualKeysIndexed) {
+    auto applyFirstMatch = details::makeFirstMatch(0, std::make_tuple('a', 1), std::make_tuple('b', 2), std::make_tuple('c', 3)
+            , std::make_tuple('b', 4), std::make_tuple('d', 5), std::make_tuple('e', 6)
+            , std::make_tuple('a', 7), std::make_tuple('f', 8), std::make_tuple('g', 9));
+    static_assert(decltype(applyFirstMatch)::strategy == details::FirstMatchStrategy::Integral);
+
+    EXPECT_EQ(applyFirstMatch.apply('a'), 1);
+    EXPECT_EQ(applyFirstMatch.apply('b'), 2);
+    EXPECT_EQ(applyFirstMatch.apply('g'), 9);
+    EXPECT_EQ(applyFirstMatch.apply('z'), 0);
+}
+
+TEST(ApplyFirstMatch, Enum) {
+    using enum Colour;
+    constexpr auto applyFirstMatch = details::makeFirstMatch(0, std::make_tuple(C9, 10), std::make_tuple(C1, 2), std::make_tuple(C2, 3)
+            , std::make_tuple(C3, 4), std::make_tuple(C4, 5), std::make_tuple(C5, 6)
+            , std::make_tuple(C6, 7), std::make_tuple(C7, 8), std::make_tuple(C8, 9));
+    static_assert(decltype(applyFirstMatch)::strategy == details::FirstMatchStrategy::Integral);
+
+    static_assert(applyFirstMatch.apply(C9) == 10);
+    EXPECT_EQ(applyFirstMatch.apply(C1), 2);
+    EXPECT_EQ(applyFirstMatch.apply(C8), 9);
+    EXPECT_EQ(applyFirstMatch.apply(C0), 0);
+}
+
+TEST(ApplyFirstMatch, StringKeys) {
+    using namespace std::string_view_literals;
+
+    auto applyFirstMatch = details::makeFirstMatch(0, std::make_tuple("null"sv, 1), std::make_tuple("true"sv, 2), std::make_tuple("false"sv, 3)
+            , std::make_tuple("nan"sv, 4), std::make_tuple("inf"sv, 5), std::make_tuple(""sv, 6)
+            , std::make_tuple("infinity"sv, 7), std::make_tuple("true"sv, 8), std::make_tuple("n"sv, 9));
+
+    EXPECT_EQ(applyFirstMatch.apply("null"sv), 1);
+    EXPECT_EQ(applyFirstMatch.apply(std::string("true")), 2);
+    EXPECT_EQ(applyFirstMatch.apply("false"), 3);
+    EXPECT_EQ(applyFirstMatch.apply(""sv), 6);
+    EXPECT_EQ(applyFirstMatch.apply("infinity"sv), 7);
+    EXPECT_EQ(applyFirstMatch.apply("n"sv), 9);
+    EXPECT_EQ(applyFirstMatch.apply("nul"sv), 0);
+    EXPECT_EQ(applyFirstMatch.apply("truE"sv), 0);
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "../testHelper.h"
 
+#include <atomic>
+#include <thread>
+
 
 TEST(Memoizer, CommonInt) {
     auto cacher = makeMapMemoizer<int>([](int a) {
@@ -53,4 +56,161 @@ TEST(Memoizer, MultiArguments) {
     EXPECT_EQ(counter, 1);
     EXPECT_EQ(cacher(3, 3), 6);
     EXPECT_EQ(counter, 2);
-}
\ No newline at end of file
+}
+
+TEST(Memoizer, HeterogeneousKey) {
+    int counter = 0;
+    auto cacher = makeTMemoizer<details::HashMapStorage, std::string>([&](std::string const& s) {
+        ++counter;
+        return s.size();
+    });
+
+    using namespace std::string_view_literals;
+    EXPECT_EQ(cacher("abc"sv), 3);
+    EXPECT_EQ(cacher(std::string("abc")), 3);
+    EXPECT_EQ(cacher("abc"), 3);
+    EXPECT_EQ(counter, 1);
+
+    auto mapCacher = makeMapMemoizer<std::string>([&](std::string const& s) {
+        ++counter;
+        return s.size();
+    });
+    EXPECT_EQ(mapCacher("abcd"sv), 4);
+    EXPECT_EQ(mapCacher(std::string("abcd")), 4);
+    EXPECT_EQ(counter, 2);
+}
+
+TEST(Memoizer, Clock) {
+    int counter = 0;
+    auto cacher = makeTMemoizer<details::ClockStorage, int>([&](int a) {
+        ++counter;
+        return a * 2;
+    });
+    static_assert(std::is_same_v<decltype(cacher(1)), int>);
+
+    for (int i = 0; i != 64; ++i) {
+        EXPECT_EQ(cacher(i), i * 2);
+    }
+    EXPECT_EQ(counter, 64);
+    EXPECT_EQ(cacher(0), 0);
+    EXPECT_EQ(counter, 64);
+
+    EXPECT_EQ(cacher(64), 128); // evicts 1, 0 has the second chance
+    EXPECT_EQ(counter, 65);
+    EXPECT_EQ(cacher(0), 0);
+    EXPECT_EQ(counter, 65);
+    EXPECT_EQ(cacher(1), 2);
+    EXPECT_EQ(counter, 66);
+}
+
+TEST(Memoizer, ClockCapacity) {
+    details::ClockStorage<int, int, 2> storage;
+    int counter = 0;
+    auto make = [&] {
+        return ++counter;
+    };
+
+    EXPECT_EQ(storage.getOrCreate(1, make), 1);
+    EXPECT_EQ(storage.getOrCreate(2, make), 2);
+    EXPECT_EQ(storage.getOrCreate(3, make), 3);
+    EXPECT_EQ(storage.size(), 2);
+    EXPECT_EQ(storage.getOrCreate(2, make), 2);
+    EXPECT_EQ(storage.getOrCreate(1, make), 4);
+}
+
+TEST(Memoizer, ClockThrowingMake) {
+    details::ClockStorage<int, int, 2> storage;
+    auto const fail = []() -> int {
+        throw std::runtime_error("make");
+    };
+
+    EXPECT_THROW(storage.getOrCreate(1, fail), std::runtime_error);
+    EXPECT_EQ(storage.size(), 0);
+    EXPECT_EQ(storage.getOrCreate(1, [] { return 1; }), 1);
+    EXPECT_EQ(storage.getOrCreate(2, [] { return 2; }), 2);
+    EXPECT_THROW(storage.getOrCreate(3, fail), std::runtime_error);
+    EXPECT_EQ(storage.getOrCreate(1, [] { return 10; }), 1);
+    EXPECT_EQ(storage.getOrCreate(2, [] { return 20; }), 2);
+}
+
+template <template <typename, typename> typename Storage>
+void concurrentMemoizer() {
+    std::atomic<int> counter = 0;
+    auto cacher = makeTMemoizer<Storage, int>([&](int a) {
+        ++counter;
+        return a + 1;
+    });
+
+    constexpr int THREADS = 4;
+    constexpr int KEYS = 1000;
+    std::vector<std::thread> threads;
+    std::atomic<bool> wrong = false;
+    for (int t = 0; t != THREADS; ++t) {
+        threads.emplace_back([&cacher, &wrong, t] {
+            for (int i = 0; i != KEYS; ++i) {
+                int const key = (i * 7 + t) % KEYS;
+                if (cacher(key) != key + 1) {
+                    wrong = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(wrong);
+    EXPECT_GE(counter, KEYS);
+    EXPECT_LE(counter, KEYS * THREADS);
+}
+
+TEST(Memoizer, Sharded) {
+    concurrentMemoizer<details::ShardedStorage>();
+
+    int counter = 0;
+    auto cacher = makeTMemoizer<details::ShardedStorage, int>([&](int a) {
+        ++counter;
+        return a + 1;
+    });
+    auto copy = cacher;
+    EXPECT_EQ(cacher(1), 2);
+    EXPECT_EQ(copy(1), 2);
+    EXPECT_EQ(counter, 1);
+}
+
+TEST(Memoizer, PerThread) {
+    concurrentMemoizer<details::PerThreadStorage>();
+
+    int counter = 0;
+    auto cacher = makeTMemoizer<details::PerThreadStorage, int>([&](int a) {
+        ++counter;
+        return a + 1;
+    });
+    EXPECT_EQ(cacher(1), 2);
+    EXPECT_EQ(cacher(1), 2);
+    EXPECT_EQ(counter, 1);
+    std::thread([&] {
+        EXPECT_EQ(cacher(1), 2);
+    }).join();
+    EXPECT_EQ(counter, 2);
+}
+
+TEST(Memoizer, PerThreadRelease) {
+    auto const value = std::make_shared<int>(1);
+    {
+        auto cacher = makeTMemoizer<details::PerThreadStorage, int>([&](int) {
+            return value;
+        });
+        auto copy = cacher;
+        EXPECT_EQ(cacher(1), value);
+        std::thread([&] {
+            EXPECT_EQ(copy(2), value);
+            EXPECT_EQ(value.use_count(), 3);
+        }).join();
+        // the storage of the finished thread is released
+        EXPECT_EQ(value.use_count(), 2);
+        EXPECT_EQ(copy(1), value);
+        EXPECT_EQ(value.use_count(), 2);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
@@ -0,0 +1,54 @@
+#include "../testHelper.h"
+
+#include <thread>
+
+
+TEST(CapacityHint, P90) {
+    details::CapacityStats stats;
+    EXPECT_EQ(stats.hint(), 0);
+    for (size_t i = 0; i != 100; ++i) {
+        stats.record(i % 20 == 0 ? 1000 : 3);
+    }
+    EXPECT_EQ(stats.hint(), 3);
+
+    for (size_t i = 0; i != 100; ++i) {
+        stats.record(100);
+    }
+    EXPECT_EQ(stats.hint(), 127);
+}
+
+TEST(CapacityHint, Threads) {
+    details::CapacityStats stats;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t != 4; ++t) {
+        threads.emplace_back([&stats] {
+            for (size_t i = 0; i != 10000; ++i) {
+                stats.record(20);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(stats.hint(), 31);
+}
+
+TEST(CapacityHint, RepeatAdaptive) {
+    auto parser = charFrom('a', 'b').repeatAdaptive();
+    auto copy = parser;
+    std::string const str(100, 'a');
+    for (size_t i = 0; i != 64; ++i) {
+        success_parsing(copy, std::vector<char>(100, 'a'), str);
+    }
+
+    Stream s{str};
+    auto result = parser(s);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data().size(), 100);
+    EXPECT_EQ(result.data().capacity(), 127);
+
+    auto delimited = number<int>().repeatAdaptive(charFrom(','));
+    success_parsing(delimited, {1, 2, 3}, "1,2,3;", ";");
+    success_parsing(delimited, {}, "x", "x");
+    failed_parsing(charFrom('a').repeatAdaptive<3>(), 3, "aaaa");
+}
@@ -0,0 +1,100 @@
+#include "../testHelper.h"
+
+
+TEST(ChunkedStream, SplitRecords) {
+    ChunkedStream input;
+    auto parser = (letters() << charFrom('=')) >> number<int>() << charFrom('\n');
+
+    input.feed("a=1\nbb=2");
+    auto first = input.next(parser);
+    ASSERT_TRUE(first.isData());
+    EXPECT_EQ(*first.data, 1);
+    EXPECT_EQ(input.committed(), 4);
+
+    auto second = input.next(parser);
+    EXPECT_EQ(second.status, ChunkStatus::NeedMoreInput);
+    EXPECT_EQ(input.committed(), 4);
+
+    input.feed("2\nccc=3");
+    second = input.next(parser);
+    ASSERT_TRUE(second.isData());
+    EXPECT_EQ(*second.data, 22);
+    EXPECT_EQ(input.next(parser).status, ChunkStatus::NeedMoreInput);
+
+    input.finish();
+    auto third = input.next(parser);
+    EXPECT_EQ(third.status, ChunkStatus::Error);
+    EXPECT_EQ(third.error.pos, 15);
+
+    auto tail = input.next((letters() << charFrom('=')) >> number<int>());
+    ASSERT_TRUE(tail.isData());
+    EXPECT_EQ(*tail.data, 3);
+    EXPECT_EQ(input.next(parser).status, ChunkStatus::EndOfInput);
+}
+
+TEST(ChunkedStream, ByteByByte) {
+    std::string text;
+    std::vector<int> answer;
+    for (int i = 0; i != 1000; ++i) {
+        text += "key=" + std::to_string(i) + "\n";
+        answer.push_back(i);
+    }
+
+    ChunkedStream input;
+    auto parser = (letters() << charFrom('=')) >> number<int>() << charFrom('\n');
+    std::vector<int> result;
+    size_t maxBuffered = 0;
+    for (char c : text) {
+        input.feed(std::string_view(&c, 1));
+        maxBuffered = std::max(maxBuffered, input.buffered());
+        for (auto r = input.next(parser); r.isData(); r = input.next(parser)) {
+            result.push_back(*r.data);
+        }
+    }
+    input.finish();
+    EXPECT_EQ(input.next(parser).status, ChunkStatus::EndOfInput);
+    EXPECT_EQ(result, answer);
+    EXPECT_EQ(input.committed(), text.size());
+    EXPECT_LE(maxBuffered, 9);
+}
+
+TEST(ChunkedStream, SkipRecord) {
+    ChunkedStream input;
+    auto parser = number<int>() << charFrom('\n');
+
+    input.feed("1\nerr");
+    ASSERT_TRUE(input.next(parser).isData());
+    EXPECT_EQ(input.next(parser).status, ChunkStatus::NeedMoreInput);
+    EXPECT_FALSE(input.skipRecord());
+
+    input.feed("or\n3\n");
+    auto error = input.next(parser);
+    EXPECT_EQ(error.status, ChunkStatus::Error);
+    EXPECT_EQ(error.error.pos, 2);
+    EXPECT_TRUE(input.skipRecord());
+
+    auto last = input.next(parser);
+    ASSERT_TRUE(last.isData());
+    EXPECT_EQ(*last.data, 3);
+
+    EXPECT_EQ(input.next(spaces()).status, ChunkStatus::NeedMoreInput);
+    input.feed("\n");
+    EXPECT_EQ(input.next(parser.maybe()).status, ChunkStatus::Error);
+}
+
+TEST(ChunkedStream, Context) {
+    ChunkedStream input{';'};
+    ContextWrapper<HitCounterType<>> ctx{0};
+    auto parser = hitCounter() >> number<int>() << charFrom(';');
+
+    input.feed("1;2;3");
+    while (input.next(parser, ctx).isData());
+    EXPECT_EQ(ctx.get(), 2);
+    EXPECT_EQ(input.committed(), 4);
+
+    input.finish();
+    EXPECT_EQ(input.next(parser, ctx).status, ChunkStatus::Error);
+    EXPECT_EQ(input.next(hitCounter() >> number<int>(), ctx).status, ChunkStatus::Data);
+    EXPECT_EQ(input.next(parser, ctx).status, ChunkStatus::EndOfInput);
+    EXPECT_EQ(ctx.get(), 4);
+}
\ No newline at end of file
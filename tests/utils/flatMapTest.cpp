@@ -0,0 +1,58 @@
+#include "../testHelper.h"
+
+
+TEST(FlatMap, SortOnce) {
+    FlatMap<std::string, int> map;
+    map.append("b", 1);
+    map.append("a", 2);
+    map.append("c", 3);
+    map.append("a", 4);
+    map.sort();
+
+    ASSERT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at("a"), 4);
+    EXPECT_EQ(map.at(std::string_view("b")), 1);
+    EXPECT_TRUE(map.contains("c"));
+    EXPECT_FALSE(map.contains("d"));
+    EXPECT_THROW(map.at("d"), std::out_of_range);
+    EXPECT_TRUE(std::is_sorted(map.begin(), map.end()));
+}
+
+TEST(FlatMap, LargeKeepLast) {
+    FlatMap<int, int> map;
+    for (int i = 0; i != 1000; ++i) {
+        map.append((i * 7) % 100, int{i});
+    }
+    map.sort();
+
+    ASSERT_EQ(map.size(), 100);
+    for (int i = 0; i != 100; ++i) {
+        int last = 0;
+        for (int j = 0; j != 1000; ++j) {
+            if ((j * 7) % 100 == i) {
+                last = j;
+            }
+        }
+        EXPECT_EQ(map.at(i), last);
+    }
+}
+
+TEST(HashMap, InsertOrAssign) {
+    HashMap<std::string, int> map;
+    for (int i = 0; i != 1000; ++i) {
+        map.insert_or_assign(std::to_string(i % 300), int{i});
+    }
+
+    ASSERT_EQ(map.size(), 300);
+    EXPECT_EQ(map.at("0"), 900);
+    EXPECT_EQ(map.at("299"), 899);
+    EXPECT_EQ(map.begin()->first, "0");
+    EXPECT_FALSE(map.contains("300"));
+    EXPECT_THROW(map.at("300"), std::out_of_range);
+
+    HashMap<std::string, int> other{{"a", 1}, {"b", 2}};
+    EXPECT_EQ(other, (HashMap<std::string, int>{{"b", 2}, {"a", 1}}));
+    EXPECT_NE(other, (HashMap<std::string, int>{{"b", 2}, {"a", 2}}));
+    HashMap<int, int> empty;
+    EXPECT_TRUE(empty.find(1) == empty.end());
+}
@@ -0,0 +1,46 @@
+#include "../testHelper.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+
+static std::string writeTmpFile(std::string const& name, std::string const& content) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file{path, std::ios::binary};
+    file << content;
+    return path;
+}
+
+TEST(MappedFile, Parse) {
+    auto path = writeTmpFile("parsecpp_mapped_file_test.txt", "test 1 2 3");
+    MappedFile file{path};
+    EXPECT_EQ(file.sv(), "test 1 2 3");
+    EXPECT_EQ(file.size(), 10);
+
+    auto parser = letters() >> (spaces() >> number<int>()).repeat();
+    auto stream = file.stream();
+    auto result = parser(stream);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data(), std::vector<int>({1, 2, 3}));
+    EXPECT_TRUE(stream.eos());
+
+    MappedFile moved = std::move(file);
+    EXPECT_EQ(moved.sv(), "test 1 2 3");
+    EXPECT_TRUE(file.sv().empty());
+
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, Empty) {
+    auto path = writeTmpFile("parsecpp_mapped_file_empty.txt", "");
+    MappedFile file{path, MapAdvice::Random};
+    EXPECT_TRUE(file.sv().empty());
+    EXPECT_TRUE(file.stream().eos());
+
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, NoFile) {
+    EXPECT_THROW(MappedFile{"parsecpp_file_does_not_exist.txt"}, std::system_error);
+}
@@ -0,0 +1,108 @@
+#include "../testHelper.h"
+
+
+static std::string makeLog(size_t lines, bool withBad = true) {
+    std::string text;
+    for (size_t i = 0; i != lines; ++i) {
+        text += "id=" + std::to_string(i) + (withBad && i % 7 == 0 ? " bad\n" : "\n");
+    }
+    return text;
+}
+
+static auto logItem() {
+    auto record = literal("id=") >> number<int>() << charFrom('\n');
+    return skipToNext(record, searchText("\n"));
+}
+
+TEST(ParallelRepeat, SameAsRepeat) {
+    auto const text = makeLog(5000);
+    Stream sequential{text};
+    auto expected = logItem().repeat()(sequential);
+    ASSERT_FALSE(expected.isError());
+
+    for (size_t threads : {1, 2, 3, 8}) {
+        for (size_t minChunkSize : {1, 64, 1 << 20}) {
+            Stream stream{text};
+            auto result = parallelRepeat(stream, logItem(), searchText("\n"), threads, minChunkSize);
+            ASSERT_FALSE(result.isError());
+            EXPECT_EQ(result.data(), expected.data());
+            EXPECT_EQ(stream.pos(), sequential.pos());
+            EXPECT_TRUE(stream.eos());
+        }
+    }
+}
+
+TEST(ParallelRepeat, StopAtFirstFail) {
+    auto text = makeLog(3000, false);
+    auto const brokenPos = text.size() / 2 + text.substr(text.size() / 2).find('\n') + 1;
+    text.insert(brokenPos, "x");
+
+    auto record = literal("id=") >> number<int>() << charFrom('\n');
+    Stream sequential{text};
+    auto expected = record.repeat()(sequential);
+    ASSERT_FALSE(expected.isError());
+    EXPECT_EQ(sequential.pos(), brokenPos);
+
+    Stream stream{text};
+    auto result = parallelRepeat(stream, record, searchText("\n"), 4, 16);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data(), expected.data());
+    EXPECT_EQ(stream.pos(), brokenPos);
+}
+
+TEST(ParallelRepeat, GlobalPositions) {
+    auto const text = makeLog(2000);
+    auto record = Parser<std::string_view>::make([](Stream& stream) {
+        auto start = stream.pos();
+        stream.move(stream.remaining().find('\n') + 1);
+        return Parser<std::string_view>::data(stream.get_sv(start, stream.pos()));
+    }).cond([](std::string_view line) {
+        return line.size() > 1;
+    });
+
+    Stream sequential{text};
+    auto expected = record.repeat()(sequential);
+    Stream stream{text};
+    auto result = parallelRepeat(stream, record, searchText("\n"), 4, 16);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data(), expected.data());
+    EXPECT_EQ(result.data().back().data() + result.data().back().size(), text.data() + text.size());
+}
+
+TEST(ParallelRepeat, MaxIteration) {
+    auto const text = makeLog(1000);
+    for (size_t threads : {1, 2, 4, 8}) {
+        Stream stream{text};
+        Stream expectedStream{text};
+        auto result = parallelRepeat<300>(stream, logItem(), searchText("\n"), threads, 16);
+        auto expected = logItem().repeat<0, 300>()(expectedStream);
+        ASSERT_TRUE(result.isError()) << threads;
+        ASSERT_TRUE(expected.isError());
+        EXPECT_EQ(result.error().pos, expected.error().pos) << threads;
+        EXPECT_EQ(stream.pos(), expectedStream.pos()) << threads;
+    }
+
+    // the limit is not reached
+    Stream stream{text};
+    auto result = parallelRepeat<2000>(stream, logItem(), searchText("\n"), 4, 16);
+    ASSERT_FALSE(result.isError());
+    EXPECT_TRUE(stream.eos());
+}
+
+TEST(ParallelRepeat, StartInTheMiddle) {
+    std::string text = "header\n" + makeLog(1000);
+    Stream stream{text};
+    ASSERT_FALSE((letters() >> charFrom('\n'))(stream).isError());
+
+    auto result = parallelRepeat(stream, logItem(), searchText("\n"), 4, 16);
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.data().size(), 857);
+    EXPECT_EQ(result.data().back(), 999);
+    EXPECT_TRUE(stream.eos());
+}
+
+TEST(ParallelRepeat, Exception) {
+    auto const text = makeLog(1000);
+    Stream stream{text};
+    EXPECT_THROW(parallelRepeat(stream, exceptionParser(), searchText("\n"), 4, 16), std::runtime_error);
+}
@@ -0,0 +1,111 @@
+#include "../testHelper.h"
+
+#include <memory>
+#include <stdexcept>
+
+
+TEST(SmallVector, Inline) {
+    SmallVector<std::string, 2> vec;
+    vec.push_back("a");
+    vec.emplace_back(3, 'b');
+    EXPECT_TRUE(vec.isInline());
+    ASSERT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec.back(), "bbb");
+
+    vec.emplace_back("spill");
+    EXPECT_FALSE(vec.isInline());
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_GE(vec.capacity(), 3);
+    EXPECT_EQ(vec, (SmallVector<std::string, 2>{"a", "bbb", "spill"}));
+
+    vec.pop_back();
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+}
+
+TEST(SmallVector, CopyMove) {
+    using Vec = SmallVector<std::unique_ptr<int>, 2>;
+    Vec small;
+    small.emplace_back(std::make_unique<int>(1));
+    Vec big;
+    for (int i = 0; i != 5; ++i) {
+        big.emplace_back(std::make_unique<int>(i));
+    }
+
+    Vec movedSmall = std::move(small);
+    EXPECT_TRUE(movedSmall.isInline());
+    EXPECT_EQ(*movedSmall[0], 1);
+    EXPECT_TRUE(small.empty());
+
+    auto const* data = big.data();
+    Vec movedBig = std::move(big);
+    EXPECT_EQ(movedBig.data(), data);
+    EXPECT_TRUE(big.empty() && big.isInline());
+
+    movedSmall = std::move(movedBig);
+    ASSERT_EQ(movedSmall.size(), 5);
+    EXPECT_EQ(*movedSmall[4], 4);
+
+    SmallVector<std::string, 1> strings{"x", "y"};
+    auto copy = strings;
+    strings = copy;
+    EXPECT_EQ(copy, strings);
+}
+
+TEST(SmallVector, Aliasing) {
+    SmallVector<std::string, 2> vec{std::string(40, 'a'), "b"};
+    vec.push_back(vec[0]);
+    vec.push_back(std::move(vec[1]));
+    vec.emplace_back(vec.back());
+    EXPECT_EQ(vec, (SmallVector<std::string, 2>{std::string(40, 'a'), "", std::string(40, 'a'), "b", "b"}));
+}
+
+namespace {
+
+struct ThrowingCopy {
+    ThrowingCopy(int v) : value(v) {}
+    ThrowingCopy(ThrowingCopy const& other) : value(other.value) {
+        if (value < 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    int value;
+};
+
+}
+
+TEST(SmallVector, GrowThrows) {
+    SmallVector<ThrowingCopy, 2> vec;
+    vec.emplace_back(1);
+    vec.emplace_back(-1);
+    EXPECT_THROW(vec.reserve(8), std::runtime_error);
+    EXPECT_THROW(vec.emplace_back(3), std::runtime_error);
+    EXPECT_THROW(vec.push_back(vec[1]), std::runtime_error);
+    EXPECT_TRUE(vec.isInline());
+    ASSERT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[1].value, -1);
+}
+
+TEST(SmallVector, Repeat) {
+    using Point = SmallVector<int, 2>;
+    auto point = charFrom('[') >> number<int>().repeatSmall<2>(charFrom(',')) << charFrom(']');
+    success_parsing(point, Point{1, 2}, "[1,2]");
+    success_parsing(point, Point{1, 2, 3}, "[1,2,3]");
+    success_parsing(point, Point{}, "[]");
+    failed_parsing(point, 4, "[1,2");
+
+    auto letters = charFrom('a', 'b').repeatSmall<4>();
+    success_parsing(letters, SmallVector<char, 4>{'a', 'b', 'a'}, "abac", "c");
+    failed_parsing(charFrom('a').repeatSmall<1, 3>(), 3, "aaaa");
+
+    auto points = point.repeat(charFrom(','));
+    Stream s{"[1,2],[3,4],[5]"};
+    auto result = points(s);
+    ASSERT_FALSE(result.isError());
+    ASSERT_EQ(result.data().size(), 3);
+    EXPECT_TRUE(std::all_of(result.data().begin(), result.data().end(), [](Point const& p) {
+        return p.isInline();
+    }));
+}